@@ -33,6 +33,9 @@
 #define HCE_AI_ASSERT(cond) do{if(!(cond)){::hce::ai::inference::hceAiAssertFail(#cond, __LINE__, __FILE__, \
     __func__);}} while(false);
 
+// directory of the on-disk compiled model cache, set by the server and read by the inference backend, unset disables it
+#define MODEL_CACHE_DIR_ENV "HCE_AI_MODEL_CACHE_DIR"
+
 namespace hce{
 
 namespace ai{
@@ -46,6 +46,8 @@
 #define DEFAULT_INFERENCE_REGION_TYPE 0
 #define DEFAULT_RESHAPE_MODEL_INPUT false
 #define DEFAULT_BATCH_SIZE 0
+#define DEFAULT_BATCH_TIMEOUT_MS 0.0f
+#define DEFAULT_WARM_UP false
 #define DEFAULT_RESHAPE_WIDTH 0
 #define DEFAULT_RESHAPE_HEIGHT 0
 
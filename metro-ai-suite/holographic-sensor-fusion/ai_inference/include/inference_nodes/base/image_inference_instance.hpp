@@ -85,6 +85,8 @@ typedef struct _InferenceProperty {
     unsigned int inference_interval;
     unsigned int nireq;                             // infer request number
     unsigned int batch_size;
+    float batch_timeout_ms;                         // > 0: a partial batch is started once its oldest input waited this long
+    bool warm_up;                                   // run a dummy inference on every infer request of a newly compiled model
 
     std::vector<std::string> inference_config;
 
@@ -197,6 +199,10 @@ private:
         const std::vector<ModelInputInfo::Ptr>& model_input_processor_info,
         InferenceConfig& config);
 
+    void UpdateConfigWithImagePreProcInfo(
+        const std::vector<ModelInputInfo::Ptr>& model_input_processor_info,
+        InferenceConfig& config);
+
     // MemoryType GetMemoryType(MemoryType input_image_memory_type, ImagePreprocessorType image_preprocessor_type);
 
     void ApplyImageBoundaries(std::shared_ptr<InferenceBackend::Image>& image,
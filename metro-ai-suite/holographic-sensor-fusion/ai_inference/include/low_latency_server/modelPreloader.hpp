@@ -0,0 +1,80 @@
+/*
+ * INTEL CONFIDENTIAL
+ * 
+ * Copyright (C) 2025 Intel Corporation.
+ * 
+ * This software and the related documents are Intel copyrighted materials, and your use of
+ * them is governed by the express license under which they were provided to you (License).
+ * Unless the License provides otherwise, you may not use, modify, copy, publish, distribute,
+ * disclose or transmit this software or the related documents without Intel's prior written permission.
+ * 
+ * This software and the related documents are provided as is, with no express or implied warranties,
+ * other than those that are expressly stated in the License.
+*/
+
+#ifndef HCE_AI_INF_LL_MODEL_PRELOADER_HPP
+#define HCE_AI_INF_LL_MODEL_PRELOADER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <inc/api/hvaNode.hpp>
+#include <inc/api/hvaNodeRegistry.hpp>
+#include "common/logger.hpp"
+#include "common/common.hpp"
+
+#define PRELOAD_ENTRY_DELIMITER ':'                     //!< separates the node class name from its configure string
+
+namespace hce{
+
+namespace ai{
+
+namespace inference{
+
+/**
+ * @brief compiles and warms up the models of inference nodes before the service accepts pipelines
+ *
+ * Every entry instantiates an inference node and one worker of it, the worker compiles the model with the
+ * configure string of the node and runs a dummy inference on every infer request. A pipeline later configured
+ * with the same node settings shares the compiled model and its infer requests instead of compiling it again.
+ * The nodes are kept until unload(), which keeps the models loaded.
+ */
+class HCE_AI_DECLSPEC ModelPreloader{
+public:
+    ModelPreloader() = default;
+
+    ~ModelPreloader();
+
+    ModelPreloader(const ModelPreloader&) = delete;
+
+    ModelPreloader& operator=(const ModelPreloader&) = delete;
+
+    /**
+     * @brief load the models of the listed inference nodes
+     * @param entries "NodeClassName:ConfigureString" per model, e.g.
+     *                "DetectionNode:ModelPath=(STRING)yolo/yolo.xml;InferReqNumber=(INT)2", the configure
+     *                string has to match the one of the pipelines for them to share the model
+     * @return hceAiSuccess if every model is loaded, the models failing to load are skipped
+     */
+    hceAiStatus_t load(const std::vector<std::string>& entries);
+
+    /**
+     * @brief release the pre-loaded models, pipelines still using them keep them alive
+     */
+    void unload();
+
+private:
+    hceAiStatus_t loadOne(const std::string& entry);
+
+    std::vector<std::shared_ptr<hva::hvaNode_t>> m_nodes;
+    std::vector<std::shared_ptr<hva::hvaNodeWorker_t>> m_workers;
+};
+
+}
+
+}
+
+}
+
+#endif //#ifndef HCE_AI_INF_LL_MODEL_PRELOADER_HPP
@@ -134,6 +134,9 @@ private:
 /**
  * @brief Predict bounding boxes based on anchor boxes with predicted offsets 
  * 
+ * For every anchor a threshold pass over the objectness plane (or the best class score when the model has no
+ * objectness) picks the candidate cells first, only those cells are decoded. Sigmoid and exp run on AVX2 when the
+ * CPU supports it. Decoded detections are written back into the output blob, in anchor, cell x, cell y order.
  */
 class AnchorTransformProcessor final : public ModelPostProcessor {
 public:
@@ -192,6 +195,12 @@ private:
     std::vector<std::pair<float, float>> m_anchors;         // prior anchors size: (w, h)
     bbox_prediction_t m_bbox_predition;                     // bbox prediction coefficients
     bool m_clip_normalized_rect = false;
+
+    // element strides in the output blob according to model_output.layout, 0 for a layout without anchors
+    size_t m_cell_stride = 0;                               // between two neighbouring grid cells
+    size_t m_field_stride = 0;                              // between two fields of a detection, e.g. x and y
+    size_t m_anchor_stride = 0;                             // between the detections of two anchors in one cell
+    float m_raw_conf_thresh;                                // conf_thresh before the output activation, lowered a bit
     
     /**
      * @brief supported transform function
@@ -202,47 +211,19 @@ private:
      * @brief check transform function, convert to enum TransfromFunction_t {}
      */
     TransfromFunction_t checkFunctions(std::string func_name);
-    
-    /**
-     * @brief get output index in blob data
-     * @param index  index of detection output field, such as: [x, y, w, h, class_0, class_1, ...]
-     *
-    */
-    size_t getIndex(size_t index, size_t anchor_index, size_t cell_index_x, size_t cell_index_y);
 
     /**
-     * @brief sigmoid(x) if m_output_sigmoid_activation = true
-    */
-    float trySigmoid(float x);
+     * @brief set the blob strides for model_output.layout
+     */
+    void setLayoutStrides();
 
     /**
-     * @brief transform function apply on x according to the function type
-    */
-    float tryTransform(float x);
-
-    // /**
-    //  * @brief convert DetOutputDimsLayout_t::BCxCy to DetOutputDimsLayout_t::CxCyB
-    // */
-    // void tryConvertLayout(float* data) {
-    //     float feature_w = m_out_feature.first;
-    //     float feature_h = m_out_feature.second;
-    //     size_t dets = m_anchors.size() * m_model_output_cfg.detection_output.size;
-    //     // B*Cx*Cy
-    //     size_t one_blob_size = dets * feature_w * feature_h;
-
-    //     std::vector<float> vdata(data, data + one_blob_size);
-    //     if (m_model_output_cfg.layout == DetOutputDimsLayout_t::BCxCy) {
-            
-    //         // BCxCy to CxCyB
-    //         for (size_t d = 0; d < dets; d ++) {
-    //             for (size_t cx = 0; cx < feature_w; cx ++) {
-    //                 for (size_t cy = 0; cy < feature_h; cy ++) {
-    //                     data[cx * feature_h * dets + cy * dets + d] = vdata[d * feature_w * feature_h + cx * feature_h + cy];
-    //                 }
-    //             }
-    //         }
-    //     }
-    // };
+     * @brief decode the detections of one anchor whose confidence passes conf_thresh
+     * @param anchor_data output blob of the anchor, i.e. the blob offset by anchor_index * m_anchor_stride
+     * @param boxes output, detection_output.size floats per detection
+     * @return number of detections written into boxes
+     */
+    size_t decodeAnchor(const float* anchor_data, size_t anchor_index, float* boxes);
 };
 
 
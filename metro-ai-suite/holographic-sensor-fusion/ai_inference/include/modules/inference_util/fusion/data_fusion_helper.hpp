@@ -17,6 +17,7 @@
 #ifndef HCE_AI_INF_DATA_FUSION_HELPER_HPP
 #define HCE_AI_INF_DATA_FUSION_HELPER_HPP
 
+#include <array>
 #include <cstdint>
 #include <fstream>
 #include <memory>
@@ -31,6 +32,10 @@
 
 #define FUSION_PI (3.141592653589793f)  //!< define pi
 
+#define MULTI_CAMERA_FUSER_BOX_WIDTH (4.2f)        //!< size in x of a camera detection on the radar plane
+#define MULTI_CAMERA_FUSER_BOX_HEIGHT (1.7f)       //!< size in y of a camera detection on the radar plane
+#define MULTI_CAMERA_FUSER_MAX_GRID_CELLS (4096)   //!< the merge grid is coarsened beyond this many cells
+
 namespace hce {
 
 namespace ai {
@@ -58,6 +63,43 @@ size_t getBinSize(std::string path);
  */
 size_t readBin(std::string path, char *buf, size_t size);
 
+/**
+ * @brief Implementations of the ROI reductions of CoordinateTransformation, they select the same points and their
+ * sums agree up to rounding
+ */
+enum class RoiSumKernel {
+    Scalar = 0,
+    AVX2 = 1
+};
+
+/**
+ * @brief Best ROI reduction kernel supported by the running CPU
+ */
+RoiSumKernel detectRoiSumKernel();
+
+bool isRoiSumKernelSupported(RoiSumKernel kernel);
+
+/**
+ * @brief reproject the disparity pixels [x0, x1] x [y0, y1] with q and sum up the points inside the bounds
+ *
+ * A point is selected iff every coordinate lies in (lower, upper], NaN is never selected. An unsupported kernel falls
+ * back to the scalar one.
+ *
+ * @param q disparity to depth projection matrix
+ * @param bounds lower and upper bound of x, y and z, in this order
+ * @param sums per coordinate sums of the selected points
+ * @return number of selected points
+ */
+size_t sumDisparityRoi(RoiSumKernel kernel, const cv::Mat &disparityMap, int x0, int y0, int x1, int y1, const double q[4][4], const float bounds[6],
+                       double sums[3]);
+
+/**
+ * @brief sum up the points of an xyz pcl in [x0, x1] x [y0, y1] which are above the lower bounds in every coordinate
+ *
+ * @return number of selected points
+ */
+size_t sumPclRoi(RoiSumKernel kernel, const cv::Mat &pcl, int x0, int y0, int x1, int y1, const float lowerBounds[3], double sums[3]);
+
 class CoordinateTransformation {
   public:
     CoordinateTransformation() {};
@@ -86,12 +128,26 @@ class CoordinateTransformation {
     /**
      * @brief convert detections from camera to radar coordinate
      *
+     * Only the disparity pixels inside the detection are reprojected.
+     *
      * @param disparityMap input disparity map
      * @param rect camera detection
      * @return cv::Rect2f
      */
     cv::Rect2f camera2Radar(cv::Mat &disparityMap, cv::Rect2i &rect);
 
+    /**
+     * @brief convert all the detections of a frame from camera to radar coordinate
+     *
+     * The detections are reprojected one by one, unless together they cover more pixels than the frame has. Then the
+     * point cloud of the whole frame is generated once and shared by all detections.
+     *
+     * @param disparityMap input disparity map
+     * @param rects camera detections
+     * @return one cv::Rect2f per detection
+     */
+    std::vector<cv::Rect2f> camera2Radar(cv::Mat &disparityMap, std::vector<cv::Rect2i> &rects);
+
     /**
      * @brief convert detections from camera to radar coordinate
      *
@@ -118,6 +174,40 @@ class CoordinateTransformation {
     cv::Mat_<float> m_qMatrix;             // disparity to depth projection matrix
     cv::Mat_<float> m_registrationMatrix;  // camera to radar projection matrix
     cv::Mat_<float> m_homographyMatrix;    // pixel to radar homography matrix
+    double m_q[4][4] = {};                 // m_qMatrix in double, as cv::reprojectImageTo3D uses it
+    cv::Mat m_pcl;                         // full frame pcl, reused across frames
+    RoiSumKernel m_roiSumKernel = detectRoiSumKernel();
+
+    /**
+     * @brief clip a detection to the frame, rows and columns are inclusive of rect.y + rect.height and rect.x + rect.width
+     *
+     * @return false if nothing is left
+     */
+    bool clipRoi(const cv::Mat &frame, const cv::Rect2i &rect, int &x0, int &y0, int &x1, int &y1);
+
+    /**
+     * @brief reproject the disparity pixels of a detection and sum up the points within the pcl constraints
+     *
+     * @param disparityMap input disparity map
+     * @param rect camera detection
+     * @param sums per coordinate sums of the selected points
+     * @return number of selected points
+     */
+    size_t accumulateRoi(cv::Mat &disparityMap, cv::Rect2i &rect, double sums[3]);
+
+    /**
+     * @brief sum up the points of a generated pcl inside a detection which are above the pcl lower bounds
+     *
+     * @return number of selected points
+     */
+    size_t accumulatePclRoi(cv::Mat &pcl, cv::Rect2i &rect, double sums[3]);
+
+    /**
+     * @brief project the mean of the selected points to radar coordinate
+     *
+     * @return cv::Rect2f, empty if fewer than 100 points were selected
+     */
+    cv::Rect2f meanToRadar(const double sums[3], size_t count);
 
     /**
      * @brief generate pcl from disparity map
@@ -162,11 +252,36 @@ class CoordinateTransformation {
     hva::hvaStatus_t getCalibrationParameters();
 };
 
+/**
+ * @brief fuses the detections of several cameras on the radar plane
+ *
+ * The box centers of one camera are warped in a single pass with its homography coefficients, kept in double as
+ * cv::perspectiveTransform uses them. The warped boxes are then merged per class by non-maximum suppression: a box is
+ * only compared with the boxes of its neighbouring cells in a grid of box-sized cells, as boxes further apart cannot
+ * overlap. The buffers are members and reused across frames, so a fuser is not thread-safe.
+ */
 class MultiCameraFuser {
   private:
     float m_nmsThreshold;
 
     std::unordered_map<int32_t, cv::Mat_<float>> m_homographyMatrixMap;  // pixel to radar homography matrix
+    std::unordered_map<int32_t, std::array<double, 9>> m_warpTables;    // the same matrices as row-major coefficients
+
+    // detections of the current frame, structure of arrays
+    std::vector<float> m_detX, m_detY;
+    std::vector<float> m_detConfidence;
+    std::vector<const std::string *> m_detLabel;
+    std::vector<int32_t> m_detClass;
+    std::vector<int32_t> m_detCamera;
+    std::vector<uint32_t> m_detTrackingId;
+
+    // merge buffers, indexed by rank: detections ordered by class, then by confidence from high to low
+    std::vector<const std::string *> m_classLabels;
+    std::vector<int32_t> m_order;
+    std::vector<uint8_t> m_keep;
+    std::vector<int32_t> m_cellOf;
+    std::vector<int32_t> m_cellStart;
+    std::vector<int32_t> m_cellItems;
 
     /**
      * @brief read parameters from bin file
@@ -177,9 +292,21 @@ class MultiCameraFuser {
 
     float computeIoU(const cv::Rect2f &a, const cv::Rect2f &b);
 
-    DetectedObject transformDetection(const hva::hvaROI_t &det, int32_t cameraID);
+    /**
+     * @brief warp the box centers of one camera to the radar plane and append them to the frame detections
+     */
+    void transformDetections(const std::vector<hva::hvaROI_t> &dets, int32_t cameraID);
 
-    std::vector<DetectedObject> performClassNMerge(const std::vector<DetectedObject> &objects);
+    /**
+     * @brief suppress the ranks [begin, end) of one class in m_keep
+     */
+    void suppressClass(size_t begin, size_t end);
+
+    /**
+     * @brief run the per-class merge over the frame detections
+     * @param results output, kept detections, grouped by class in order of first appearance, by confidence from high to low inside a class
+     */
+    void mergeDetections(std::vector<DetectedObject> &results);
 
   public:
     using Ptr = std::shared_ptr<MultiCameraFuser>;
@@ -199,6 +326,11 @@ class MultiCameraFuser {
      */
     std::vector<DetectedObject> fuse2Camera(const std::vector<hva::hvaROI_t> &leftDets, const std::vector<hva::hvaROI_t> &rightDets);
 
+    /**
+     * @brief fuse 2 Camera into results, which keeps its capacity across frames
+     */
+    void fuse2Camera(const std::vector<hva::hvaROI_t> &leftDets, const std::vector<hva::hvaROI_t> &rightDets, std::vector<DetectedObject> &results);
+
     /**
      * @brief fuse 4 Camera
      * @return camera fusion result
@@ -208,6 +340,15 @@ class MultiCameraFuser {
                                             const std::vector<hva::hvaROI_t> &thirdDets,
                                             const std::vector<hva::hvaROI_t> &fourthDets);
 
+    /**
+     * @brief fuse 4 Camera into results, which keeps its capacity across frames
+     */
+    void fuse4Camera(const std::vector<hva::hvaROI_t> &firstDets,
+                     const std::vector<hva::hvaROI_t> &secondDets,
+                     const std::vector<hva::hvaROI_t> &thirdDets,
+                     const std::vector<hva::hvaROI_t> &fourthDets,
+                     std::vector<DetectedObject> &results);
+
     MultiCameraFuser(float nmsThreshold) : m_nmsThreshold(nmsThreshold) {}
 
     MultiCameraFuser() : m_nmsThreshold(0.5) {}
@@ -0,0 +1,116 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you (License). Unless the License provides otherwise, you may not
+ * use, modify, copy, publish, distribute, disclose or transmit this software or
+ * the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ */
+
+#ifndef HCE_AI_INF_FUSION_OUTPUT_POOL_HPP
+#define HCE_AI_INF_FUSION_OUTPUT_POOL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "inc/api/hvaLogger.hpp"
+#include "nodes/radarDatabaseMeta.hpp"
+
+#define FUSION_OUTPUT_RESERVED_ROIS (64)     //!< detections per camera a pooled output is reserved for
+#define FUSION_OUTPUT_RESERVED_TRACKS (64)   //!< radar tracks a pooled output is reserved for
+#define FUSION_OUTPUT_POOL_WARN_SIZE (256)   //!< pool size above which the growth is reported, a hint that outputs are never released
+
+namespace hce {
+
+namespace ai {
+
+namespace inference {
+
+/**
+ * @brief recycles the FusionOutput of a fusion node
+ *
+ * The pool keeps one reference to every output it has created. An output is handed out again once the pool holds the
+ * only reference, i.e. once every blob that carried it as meta was released or erased the meta, so no allocation
+ * happens per frame after the pipeline has filled up. The pool grows by one output whenever all of them are in
+ * flight, so its size settles at the number of frames the pipeline holds at once.
+ *
+ * One pool is shared by all the workers of a fusion node, acquire() is thread-safe.
+ */
+class FusionOutputPool {
+  public:
+    using Ptr = std::shared_ptr<FusionOutputPool>;
+
+    FusionOutputPool(size_t roisPerCamera = FUSION_OUTPUT_RESERVED_ROIS, size_t numOfTracks = FUSION_OUTPUT_RESERVED_TRACKS)
+        : m_roisPerCamera(roisPerCamera), m_numOfTracks(numOfTracks), m_next(0)
+    {}
+
+    ~FusionOutputPool() {}
+
+    /**
+     * @brief get an empty output for a frame of numOfCams cameras
+     */
+    FusionOutput::Ptr acquire(int32_t numOfCams)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        size_t size = m_outputs.size();
+        for (size_t i = 0; i < size; i++) {
+            size_t slot = (m_next + i) % size;
+            // nobody else holds the output, so nobody else can take a new reference to it while we look
+            if (1 == m_outputs[slot].use_count()) {
+                // pairs with the release done by the last holder when it dropped its reference
+                std::atomic_thread_fence(std::memory_order_acquire);
+                m_next = (slot + 1) % size;
+                m_outputs[slot]->reset(numOfCams);
+                return m_outputs[slot];
+            }
+        }
+
+        FusionOutput::Ptr output = std::make_shared<FusionOutput>(numOfCams);
+        output->reserve(m_roisPerCamera, m_numOfTracks);
+        m_outputs.push_back(output);
+        m_next = 0;
+        if (FUSION_OUTPUT_POOL_WARN_SIZE == m_outputs.size()) {
+            HVA_WARNING("Fusion output pool holds %zu outputs, are fusion outputs released downstream?", m_outputs.size());
+        }
+        else {
+            HVA_DEBUG("Fusion output pool grows to %zu outputs", m_outputs.size());
+        }
+        return output;
+    }
+
+    /**
+     * @brief number of outputs created so far
+     */
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_outputs.size();
+    }
+
+  private:
+    size_t m_roisPerCamera;
+    size_t m_numOfTracks;
+
+    std::mutex m_mutex;
+    std::vector<FusionOutput::Ptr> m_outputs;
+    size_t m_next;  // slot the next search starts from, so the outputs are reused in turn
+};
+
+}  // namespace inference
+
+}  // namespace ai
+
+}  // namespace hce
+
+#endif  // #ifndef HCE_AI_INF_FUSION_OUTPUT_POOL_HPP
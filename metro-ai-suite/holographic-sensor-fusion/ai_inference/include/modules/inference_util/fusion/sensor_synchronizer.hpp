@@ -0,0 +1,447 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you (License). Unless the License provides otherwise, you may not
+ * use, modify, copy, publish, distribute, disclose or transmit this software or
+ * the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ */
+
+#ifndef HCE_AI_INF_SENSOR_SYNCHRONIZER_HPP
+#define HCE_AI_INF_SENSOR_SYNCHRONIZER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "inc/api/hvaBlob.hpp"
+#include "inc/api/hvaLogger.hpp"
+#include "inc/util/hvaConfigStringParser.hpp"
+#include "nodes/databaseMeta.hpp"
+
+#define SENSOR_SYNC_SKEW_BINS (16)            //!< number of skew histogram bins, the last one collects everything beyond
+#define SENSOR_SYNC_REPORT_INTERVAL (1000)    //!< fused frames between two statistics reports of a fusion node
+
+namespace hce {
+
+namespace ai {
+
+namespace inference {
+
+enum SensorSyncMode {
+    SENSOR_SYNC_NONE = 0,   // ports are fetched in lockstep, one blob from every port per call
+    SENSOR_SYNC_FRAME_ID,   // frames of the different ports are matched by frameId
+    SENSOR_SYNC_TIMESTAMP   // frames of the different ports are matched by capture timestamp
+};
+
+enum SensorSyncLatePolicy {
+    SENSOR_SYNC_LATE_DROP = 0,     // a port without a matching frame contributes nothing to the fused frame
+    SENSOR_SYNC_LATE_INTERPOLATE   // the last frame of the port stands in, moved to the reference time where possible
+};
+
+struct SensorSyncConfig
+{
+    SensorSyncMode mode = SENSOR_SYNC_NONE;
+    SensorSyncLatePolicy latePolicy = SENSOR_SYNC_LATE_DROP;
+    double toleranceMs = 20.0;  // largest timestamp skew of a matched frame
+    size_t maxPending = 8;      // frames held per port
+    double maxWaitMs = 100.0;   // a reference frame waits at most this long for the other ports
+    double maxHoldMs = 200.0;   // a stand-in frame is at most this much older or newer than the reference frame
+    double skewBinMs = 5.0;     // width of one skew histogram bin
+};
+
+/**
+ * @brief parse the optional synchronisation keys of a fusion node
+ *
+ * SyncMode: none (default), frameId or timestamp
+ * SyncLatePolicy: drop (default) or interpolate
+ * SyncToleranceMs, SyncMaxPending, SyncMaxWaitMs, SyncMaxHoldMs, SyncSkewBinMs
+ *
+ * @return false on an unknown or out of range value
+ */
+inline bool parseSensorSyncConfig(hva::hvaConfigStringParser_t &parser, SensorSyncConfig &config)
+{
+    std::string mode = "none";
+    parser.getVal<std::string>("SyncMode", mode);
+    if (mode == "none") {
+        config.mode = SENSOR_SYNC_NONE;
+    }
+    else if (mode == "frameId") {
+        config.mode = SENSOR_SYNC_FRAME_ID;
+    }
+    else if (mode == "timestamp") {
+        config.mode = SENSOR_SYNC_TIMESTAMP;
+    }
+    else {
+        HVA_ERROR("Unknown SyncMode %s, need none, frameId or timestamp!", mode.c_str());
+        return false;
+    }
+
+    std::string latePolicy = "drop";
+    parser.getVal<std::string>("SyncLatePolicy", latePolicy);
+    if (latePolicy == "drop") {
+        config.latePolicy = SENSOR_SYNC_LATE_DROP;
+    }
+    else if (latePolicy == "interpolate") {
+        config.latePolicy = SENSOR_SYNC_LATE_INTERPOLATE;
+    }
+    else {
+        HVA_ERROR("Unknown SyncLatePolicy %s, need drop or interpolate!", latePolicy.c_str());
+        return false;
+    }
+
+    float toleranceMs = config.toleranceMs;
+    parser.getVal<float>("SyncToleranceMs", toleranceMs);
+    int maxPending = config.maxPending;
+    parser.getVal<int>("SyncMaxPending", maxPending);
+    float maxWaitMs = config.maxWaitMs;
+    parser.getVal<float>("SyncMaxWaitMs", maxWaitMs);
+    float maxHoldMs = config.maxHoldMs;
+    parser.getVal<float>("SyncMaxHoldMs", maxHoldMs);
+    float skewBinMs = config.skewBinMs;
+    parser.getVal<float>("SyncSkewBinMs", skewBinMs);
+    if (toleranceMs < 0 || maxPending < 1 || maxWaitMs < 0 || maxHoldMs < 0 || skewBinMs <= 0) {
+        HVA_ERROR("Illegal sync parameters: SyncToleranceMs %f, SyncMaxPending %d, SyncMaxWaitMs %f, SyncMaxHoldMs %f, SyncSkewBinMs %f", toleranceMs,
+                  maxPending, maxWaitMs, maxHoldMs, skewBinMs);
+        return false;
+    }
+    config.toleranceMs = toleranceMs;
+    config.maxPending = maxPending;
+    config.maxWaitMs = maxWaitMs;
+    config.maxHoldMs = maxHoldMs;
+    config.skewBinMs = skewBinMs;
+
+    return true;
+}
+
+/**
+ * @brief current time in ms, on the clock of TimeStamp_t
+ */
+inline double sensorSyncNowMs()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief capture time of a blob in ms, taken from the TimeStamp_t meta the input nodes attach
+ * @param fallbackMs returned when the buffer carries no timestamp
+ */
+inline double sensorCaptureTimeMs(const hva::hvaBlob_t::Ptr &blob, int buffIndex, double fallbackMs)
+{
+    hva::hvaBuf_t::Ptr buf = blob->get(buffIndex);
+    TimeStamp_t timeMeta;
+    if (buf && buf->getMeta(timeMeta) == hva::hvaSuccess) {
+        return std::chrono::duration<double, std::milli>(timeMeta.timeStamp.time_since_epoch()).count();
+    }
+    return fallbackMs;
+}
+
+/**
+ * @brief move radar tracks along their velocity, used when a radar frame stands in for a later or earlier reference frame
+ * @param dtSec reference time minus radar frame time
+ */
+inline void extrapolateRadarTracks(std::vector<trackerOutputDataType> &tracks, float dtSec)
+{
+    for (auto &item : tracks) {
+        item.S_hat[0] += item.S_hat[2] * dtSec;
+        item.S_hat[1] += item.S_hat[3] * dtSec;
+    }
+}
+
+/**
+ * @brief matches the frames of several sensor ports in time
+ *
+ * One port is the reference, every frame of it is released exactly once and in order, so the frameId sequence seen
+ * downstream has no gaps. For each reference frame the synchronizer picks, on every other port, the frame closest to
+ * it within the tolerance. A port which has no such frame yet is waited for until the reference frame is older than
+ * `maxWaitMs` or `maxPending` reference frames are queued; a port whose frames already moved past the reference
+ * frame is settled at once. An unmatched port is then left empty, or with the interpolate policy it gets its last
+ * frame as a stand-in while that is within `maxHoldMs` of the reference frame. Frames which no reference frame can
+ * match any more, and the oldest frames of a port holding more than `maxPending`, are dropped.
+ *
+ * In frameId mode the frames are matched on equal frameIds, timestamps only feed the skew statistics.
+ *
+ * Not thread-safe, owned by the single worker of a fusion node. Times are in ms on any clock shared by all calls.
+ */
+template <typename T>
+class SensorSynchronizer {
+public:
+    struct Slot
+    {
+        T item;
+        bool valid = false;   // false when the port contributes nothing
+        bool held = false;    // a stand-in frame instead of a matched one
+        double skewMs = 0.0;  // frame time minus reference frame time
+    };
+
+    struct PortStats
+    {
+        uint64_t matched = 0;
+        uint64_t held = 0;
+        uint64_t missed = 0;
+        uint64_t dropped = 0;
+        uint64_t skewHistogram[SENSOR_SYNC_SKEW_BINS] = {0};
+    };
+
+    SensorSynchronizer(size_t numPorts, size_t referencePort, const SensorSyncConfig &config)
+        : m_config(config), m_referencePort(referencePort), m_queues(numPorts), m_last(numPorts), m_stats(numPorts)
+    {
+        m_config.maxPending = std::max(m_config.maxPending, (size_t)1);
+        if (m_config.mode == SENSOR_SYNC_FRAME_ID) {
+            m_config.toleranceMs = 0.0;
+        }
+    }
+
+    /**
+     * @brief queue a frame of one port
+     * @param timeMs capture time of the frame
+     * @param nowMs arrival time of the frame
+     */
+    void push(size_t port, unsigned frameId, double timeMs, T item, double nowMs)
+    {
+        Frame frame;
+        frame.item = std::move(item);
+        frame.frameId = frameId;
+        frame.timeMs = timeMs;
+        frame.arrivalMs = nowMs;
+        frame.key = (m_config.mode == SENSOR_SYNC_FRAME_ID) ? (double)frameId : timeMs;
+
+        // frames of one sensor come almost always in order, the insertion point is searched from the back
+        std::deque<Frame> &queue = m_queues[port];
+        auto it = queue.end();
+        while (it != queue.begin() && (it - 1)->key > frame.key) {
+            --it;
+        }
+        queue.insert(it, std::move(frame));
+
+        if (port != m_referencePort) {
+            while (queue.size() > m_config.maxPending) {
+                dropFront(port);
+            }
+        }
+    }
+
+    /**
+     * @brief release the next reference frame once it is matched or settled
+     * @param slots one entry per port, the reference port entry is always valid
+     * @return false while the next reference frame still waits for other ports
+     */
+    bool pop(double nowMs, std::vector<Slot> &slots)
+    {
+        return release(nowMs, slots, false);
+    }
+
+    /**
+     * @brief release the next reference frame without waiting for the other ports, used at the end of the streams
+     *
+     * The other ports are settled with what is queued, unmatched ports are left empty or get their stand-in as in pop().
+     * @return false once no reference frame is queued
+     */
+    bool flush(double nowMs, std::vector<Slot> &slots)
+    {
+        return release(nowMs, slots, true);
+    }
+
+    /**
+     * @brief forget every queued frame, stand-in and statistic, used when the pipeline is reset
+     */
+    void clear()
+    {
+        for (auto &queue : m_queues) {
+            queue.clear();
+        }
+        for (auto &last : m_last) {
+            last = LastFrame();
+        }
+        for (auto &stats : m_stats) {
+            stats = PortStats();
+        }
+        m_released = 0;
+    }
+
+    /**
+     * @brief number of reference frames released so far
+     */
+    uint64_t released() const
+    {
+        return m_released;
+    }
+
+    const PortStats &stats(size_t port) const
+    {
+        return m_stats[port];
+    }
+
+    /**
+     * @brief one line per non-reference port with its counters and skew histogram, empty bins are left out
+     */
+    std::string summary() const
+    {
+        std::stringstream ss;
+        for (size_t port = 0; port < m_stats.size(); port++) {
+            if (port == m_referencePort) {
+                continue;
+            }
+            const PortStats &stats = m_stats[port];
+            ss << "port " << port << ": matched " << stats.matched << ", held " << stats.held << ", missed " << stats.missed << ", dropped "
+               << stats.dropped << ", |skew| ms";
+            for (size_t bin = 0; bin < SENSOR_SYNC_SKEW_BINS; bin++) {
+                if (stats.skewHistogram[bin] == 0) {
+                    continue;
+                }
+                if (bin + 1 < SENSOR_SYNC_SKEW_BINS) {
+                    ss << " [" << bin * m_config.skewBinMs << "," << (bin + 1) * m_config.skewBinMs << "):" << stats.skewHistogram[bin];
+                }
+                else {
+                    ss << " [" << bin * m_config.skewBinMs << ",inf):" << stats.skewHistogram[bin];
+                }
+            }
+            ss << "\n";
+        }
+        return ss.str();
+    }
+
+private:
+    /**
+     * @param force settle every port with what is queued instead of waiting
+     */
+    bool release(double nowMs, std::vector<Slot> &slots, bool force)
+    {
+        std::deque<Frame> &refQueue = m_queues[m_referencePort];
+        if (refQueue.empty()) {
+            return false;
+        }
+        const Frame &ref = refQueue.front();
+        force = force || (refQueue.size() > m_config.maxPending) || (nowMs - ref.arrivalMs >= m_config.maxWaitMs);
+
+        for (size_t port = 0; port < m_queues.size(); port++) {
+            if (port == m_referencePort) {
+                continue;
+            }
+            // frames too old for this and for every following reference frame
+            std::deque<Frame> &queue = m_queues[port];
+            while (!queue.empty() && queue.front().key < ref.key - m_config.toleranceMs) {
+                dropFront(port);
+            }
+            if (queue.empty() && !force) {
+                return false;
+            }
+        }
+
+        slots.assign(m_queues.size(), Slot());
+        for (size_t port = 0; port < m_queues.size(); port++) {
+            Slot &slot = slots[port];
+            if (port == m_referencePort) {
+                slot.item = ref.item;
+                slot.valid = true;
+                continue;
+            }
+
+            std::deque<Frame> &queue = m_queues[port];
+            size_t best = queue.size();
+            for (size_t i = 0; i < queue.size() && queue[i].key <= ref.key + m_config.toleranceMs; i++) {
+                if (best == queue.size() || std::fabs(queue[i].key - ref.key) < std::fabs(queue[best].key - ref.key)) {
+                    best = i;
+                }
+            }
+
+            PortStats &stats = m_stats[port];
+            if (best < queue.size()) {
+                // frames in front of the match are skipped, they are older than it
+                for (size_t i = 0; i < best; i++) {
+                    dropFront(port);
+                }
+                slot.item = queue.front().item;
+                slot.valid = true;
+                slot.skewMs = queue.front().timeMs - ref.timeMs;
+                stats.matched++;
+                addSkew(stats, slot.skewMs);
+                setLast(port, queue.front());
+                queue.pop_front();
+            }
+            else if (m_config.latePolicy == SENSOR_SYNC_LATE_INTERPOLATE && m_last[port].valid &&
+                     std::fabs(m_last[port].timeMs - ref.timeMs) <= m_config.maxHoldMs) {
+                slot.item = m_last[port].item;
+                slot.valid = true;
+                slot.held = true;
+                slot.skewMs = m_last[port].timeMs - ref.timeMs;
+                stats.held++;
+            }
+            else {
+                stats.missed++;
+            }
+        }
+
+        refQueue.pop_front();
+        m_released++;
+        return true;
+    }
+
+    struct Frame
+    {
+        T item;
+        unsigned frameId;
+        double timeMs;
+        double arrivalMs;
+        double key;  // frameId or timeMs, the value frames are matched on
+    };
+
+    struct LastFrame
+    {
+        T item;
+        bool valid = false;
+        double key = 0.0;
+        double timeMs = 0.0;
+    };
+
+    void dropFront(size_t port)
+    {
+        setLast(port, m_queues[port].front());
+        m_queues[port].pop_front();
+        m_stats[port].dropped++;
+    }
+
+    void setLast(size_t port, const Frame &frame)
+    {
+        LastFrame &last = m_last[port];
+        if (!last.valid || frame.key >= last.key) {
+            last.item = frame.item;
+            last.valid = true;
+            last.key = frame.key;
+            last.timeMs = frame.timeMs;
+        }
+    }
+
+    void addSkew(PortStats &stats, double skewMs)
+    {
+        size_t bin = (size_t)(std::fabs(skewMs) / m_config.skewBinMs);
+        stats.skewHistogram[std::min(bin, (size_t)SENSOR_SYNC_SKEW_BINS - 1)]++;
+    }
+
+    SensorSyncConfig m_config;
+    size_t m_referencePort;
+    std::vector<std::deque<Frame>> m_queues;
+    std::vector<LastFrame> m_last;
+    std::vector<PortStats> m_stats;
+    uint64_t m_released = 0;
+};
+
+}  // namespace inference
+
+}  // namespace ai
+
+}  // namespace hce
+
+#endif  // #ifndef HCE_AI_INF_SENSOR_SYNCHRONIZER_HPP
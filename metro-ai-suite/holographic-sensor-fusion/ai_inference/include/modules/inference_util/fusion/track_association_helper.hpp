@@ -0,0 +1,202 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you (License). Unless the License provides otherwise, you may not
+ * use, modify, copy, publish, distribute, disclose or transmit this software or
+ * the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ */
+
+#ifndef HCE_AI_INF_TRACK_ASSOCIATION_HELPER_HPP
+#define HCE_AI_INF_TRACK_ASSOCIATION_HELPER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+#define T2T_ASSOCIATION_COST_THRESHOLD (1.6f)  //!< a radar / camera pair is kept while 1 - CIoU is below this
+#define T2T_ASSOCIATION_MAX_GRID_CELLS (4096)  //!< the camera grid is coarsened beyond this many cells
+
+namespace hce {
+
+namespace ai {
+
+namespace inference {
+
+/**
+ * @brief one radar detection matched to one camera detection
+ */
+struct AssociationPair
+{
+    int32_t radarIdx;
+    int32_t cameraIdx;
+    float cost;        // 1 - CIoU of the two boxes
+    float confidence;  // 1 for identical boxes, falls to 0 at the cost threshold
+};
+
+/**
+ * @brief id of a camera track across frames, 0 for a detection the camera tracker did not pick up
+ *
+ * @param cameraId index of the camera, the same tracking id on two cameras belongs to two tracks
+ * @param trackingId id given by the camera tracker, 0 if untracked
+ */
+inline uint64_t cameraTrackKey(int32_t cameraId, uint32_t trackingId)
+{
+    return 0 == trackingId ? 0 : ((uint64_t)(uint32_t)(cameraId + 1) << 32) | trackingId;
+}
+
+/**
+ * @brief matches radar detections to camera detections, both given as boxes in radar coordinates
+ *
+ * The camera boxes are bucketed into a uniform grid by center, and a radar box is only compared with the camera boxes
+ * of its neighbouring cells. The cell size is the largest center distance at which a pair can still score below the
+ * cost threshold, so the grid never drops a pair that could be kept. The remaining pairs are scored in one pass over
+ * structure-of-arrays candidates, and every connected group of pairs is solved optimally on its own with the
+ * hungarian algorithm, where leaving a radar box unmatched costs the threshold.
+ *
+ * associateTracks() adds memory across frames: the pairs of radar and camera tracks found by the previous call are
+ * only re-checked against the threshold, and the full matching runs on the boxes left over.
+ *
+ * Not thread-safe, each node worker owns one associator and reuses its buffers across frames.
+ */
+class Track2TrackAssociator {
+  public:
+    using Ptr = std::shared_ptr<Track2TrackAssociator>;
+
+    explicit Track2TrackAssociator(float costThreshold = T2T_ASSOCIATION_COST_THRESHOLD);
+
+    ~Track2TrackAssociator() {}
+
+    void setCostThreshold(float costThreshold);
+
+    float getCostThreshold() const
+    {
+        return m_costThreshold;
+    }
+
+    /**
+     * @brief match radar boxes to camera boxes
+     *
+     * @param radarBoxes radar detections
+     * @param cameraBoxes camera detections
+     * @param pairs output, at most one pair per radar box and per camera box, sorted by radar index
+     */
+    void associate(const std::vector<cv::Rect2f> &radarBoxes, const std::vector<cv::Rect2f> &cameraBoxes, std::vector<AssociationPair> &pairs);
+
+    /**
+     * @brief match radar tracks to camera tracks, keeping the pairs of the previous call
+     *
+     * A pair of the previous call is kept without search while both tracks are still there and the pair stays under
+     * the cost threshold, even if a cheaper pair shows up, which holds the fused tracks steady. The radar and camera
+     * boxes left over are matched by associate(). A reused radar id is caught by the same threshold check.
+     *
+     * @param radarBoxes radar detections
+     * @param radarIds track id of every radar detection
+     * @param cameraBoxes camera detections
+     * @param cameraIds cameraTrackKey() of every camera detection, a detection with key 0 is matched anew every call
+     * @param pairs output, at most one pair per radar box and per camera box, sorted by radar index
+     */
+    void associateTracks(const std::vector<cv::Rect2f> &radarBoxes,
+                         const std::vector<int32_t> &radarIds,
+                         const std::vector<cv::Rect2f> &cameraBoxes,
+                         const std::vector<uint64_t> &cameraIds,
+                         std::vector<AssociationPair> &pairs);
+
+    /**
+     * @brief forget the track pairs kept by associateTracks()
+     */
+    void resetTracks();
+
+    /**
+     * @brief number of pairs the last associateTracks() call kept from the previous call
+     */
+    size_t getKeptPairs() const
+    {
+        return m_keptPairs;
+    }
+
+    /**
+     * @brief 1 - CIoU of two boxes, the reference the batched kernel follows
+     */
+    static float computeCost(const cv::Rect2f &r1, const cv::Rect2f &r2);
+
+  private:
+    float m_costThreshold;
+    float m_gateScale;  // squared center distance gate as a multiple of max(w)^2 + max(h)^2, 0 when unbounded
+
+    /**
+     * @brief bucket the camera boxes into m_cellStart / m_cellItems by center
+     */
+    void buildGrid(const std::vector<cv::Rect2f> &cameraBoxes, float cellSize);
+
+    /**
+     * @brief append the gated radar / camera candidates of radar box r to the candidate arrays
+     */
+    void gatherCandidates(int32_t r, const std::vector<cv::Rect2f> &radarBoxes, const std::vector<cv::Rect2f> &cameraBoxes);
+
+    /**
+     * @brief score all the candidates into m_candCost
+     */
+    void computeCandidateCosts();
+
+    int32_t findRoot(int32_t node);
+
+    /**
+     * @brief solve the pairs m_edges[begin, end) of one connected group
+     */
+    void assignComponent(size_t begin, size_t end, int32_t nRadar);
+
+    // camera grid
+    float m_gridX0, m_gridY0, m_cellSize;
+    int32_t m_gridW, m_gridH;
+    std::vector<int32_t> m_cellStart;
+    std::vector<int32_t> m_cellItems;
+    std::vector<int32_t> m_cellOf;
+
+    // aspect ratio term of each box
+    std::vector<float> m_radarAtan;
+    std::vector<float> m_cameraAtan;
+
+    // candidates, structure of arrays
+    std::vector<int32_t> m_candRadar, m_candCamera;
+    std::vector<float> m_candX1, m_candY1, m_candW1, m_candH1, m_candA1;
+    std::vector<float> m_candX2, m_candY2, m_candW2, m_candH2, m_candA2;
+    std::vector<float> m_candCost;
+
+    // gated pairs and their connected groups, radar r is node r and camera c is node nRadar + c
+    std::vector<int32_t> m_edges;
+    std::vector<int32_t> m_parent;
+    std::vector<int32_t> m_localIndex;
+    std::vector<int32_t> m_localRadar;
+    std::vector<int32_t> m_localCamera;
+    std::vector<int32_t> m_localCand;
+    std::vector<int32_t> m_matchedCand;  // candidate picked for each radar box, -1 if none
+
+    // track pairs of the last associateTracks() call as (radar id, camera key), sorted by radar id
+    std::vector<std::pair<int32_t, uint64_t>> m_trackPairs;
+    size_t m_keptPairs;
+    std::vector<std::pair<uint64_t, int32_t>> m_cameraById;  // tracked camera boxes of the frame as (camera key, index), sorted
+    std::vector<AssociationPair> m_radarPair;                // pair of each radar box, cameraIdx -1 if none
+    std::vector<uint8_t> m_cameraTaken;
+
+    // boxes left over for the full matching, with their index in the frame
+    std::vector<cv::Rect2f> m_restRadarBoxes, m_restCameraBoxes;
+    std::vector<int32_t> m_restRadarIdx, m_restCameraIdx;
+    std::vector<AssociationPair> m_restPairs;
+};
+
+}  // namespace inference
+
+}  // namespace ai
+
+}  // namespace hce
+
+#endif  // #ifndef HCE_AI_INF_TRACK_ASSOCIATION_HELPER_HPP
@@ -32,6 +32,14 @@ namespace inference {
     #define ALIGN_ALLOC(align, size) aligned_alloc((align), (size))
 #endif
 
+/**
+ * @brief reorganise a raw cn x (tn x rn) x sn ADC frame into the tr x c x s cube of libradar and remove the
+ * per-chirp mean in the same pass
+ * @param frame interleaved real/imag samples of one frame
+ * @param rc destination cube, rc.mat must hold rn * tn * cn * sn samples
+ */
+void formatRadarCube(const cfloat* frame, RadarCube& rc);
+
 class RadarTracker {
  public:
   static RadarTracker* CreateInstance(RadarParam m_lib_radar_config_);
@@ -0,0 +1,215 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you (License). Unless the License provides otherwise, you may not
+ * use, modify, copy, publish, distribute, disclose or transmit this software or
+ * the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ */
+
+#ifndef HCE_AI_INF_RADAR_ADMISSION_CONTROLLER_HPP
+#define HCE_AI_INF_RADAR_ADMISSION_CONTROLLER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#define RADAR_ADMISSION_EWMA_ALPHA (0.2f)      //!< weight of the newest frame in the service time estimates
+#define RADAR_ADMISSION_RECOVER_RATIO (0.8f)   //!< full processing resumes once it is predicted below this share of the SLO
+#define RADAR_ADMISSION_MAX_DECIMATION (4)     //!< default, at most this many frames are shed in a row
+#define RADAR_ADMISSION_REPORT_INTERVAL (100)  //!< frames between two summary reports of the decisions
+
+namespace hce {
+
+namespace ai {
+
+namespace inference {
+
+enum RadarAdmissionAction {
+    RADAR_ADMISSION_FULL = 0,   // processed with the configured DOA estimator
+    RADAR_ADMISSION_DEGRADED,   // processed with FFT DOA in place of the configured estimator
+    RADAR_ADMISSION_DECIMATED,  // shed, only one of several frames is processed while the backlog is too long
+    RADAR_ADMISSION_DROPPED,    // shed, the frame would miss the latency objective however it is processed
+    RADAR_ADMISSION_ACTION_NUM
+};
+
+inline const char *radarAdmissionActionName(RadarAdmissionAction action)
+{
+    switch (action) {
+        case RADAR_ADMISSION_FULL:
+            return "full";
+        case RADAR_ADMISSION_DEGRADED:
+            return "degraded";
+        case RADAR_ADMISSION_DECIMATED:
+            return "decimated";
+        case RADAR_ADMISSION_DROPPED:
+            return "dropped";
+        default:
+            return "unknown";
+    }
+}
+
+struct RadarAdmissionConfig
+{
+    float latencySloMs = 0.0f;                          // latency objective of a radar frame up to the end of tracking, 0 turns the controller off
+    bool degradeDoa = true;                             // allow FFT DOA in place of the configured estimator under load
+    int32_t maxDecimation = RADAR_ADMISSION_MAX_DECIMATION;  // at most this many frames are shed in a row, so the tracker keeps being fed
+};
+
+/**
+ * @brief decision taken for one radar frame, attached to the radar output buffer as meta
+ */
+struct RadarAdmissionDecision
+{
+    RadarAdmissionAction action = RADAR_ADMISSION_FULL;
+    float ageMs = 0.0f;        // time the frame spent before this stage, 0 when it carries no TimeStamp_t
+    uint32_t inFlight = 0;     // frames admitted by the input node and not yet through detection, this one included
+    float predictedMs = 0.0f;  // predicted latency for the action taken, 0 before the first service time is measured
+};
+
+/**
+ * @brief decides per radar frame whether to process it in full, with a cheaper DOA estimator, or not at all
+ *
+ * The controller keeps a moving average of the service time of the stage in full and in degraded mode. For a frame of
+ * age `a` with `n` frames in flight it predicts the latency of the newest frame of the backlog as a + n * service time,
+ * i.e. the time until the queue is drained if every frame is processed the same way, and takes the most accurate
+ * action that keeps the prediction under the SLO:
+ * - full processing, resumed after an overload only once the prediction falls below RADAR_ADMISSION_RECOVER_RATIO of
+ *   the SLO, so the mode does not flip every frame,
+ * - degraded processing with FFT DOA,
+ * - decimation: one frame of k is processed in the cheapest mode, k is the factor by which the backlog overshoots,
+ * - a frame which misses the SLO even in the cheapest mode is dropped.
+ * Shedding stops after `maxDecimation` frames in a row, the next frame is processed in the cheapest mode.
+ *
+ * Until the first service time is measured every frame is processed in full. The first frame that cannot be processed
+ * in full is processed in degraded mode, which measures it.
+ *
+ * Not thread-safe, each node worker owns one controller.
+ */
+class RadarAdmissionController {
+public:
+    /**
+     * @param canDegrade whether the stage has a degraded mode to fall back to
+     */
+    RadarAdmissionController(const RadarAdmissionConfig& config, bool canDegrade)
+        : m_config(config), m_canDegrade(canDegrade), m_fullMs(-1.0f), m_degradedMs(-1.0f), m_underLoad(false), m_shedInRow(0),
+          m_decisions(0), m_counts{0, 0, 0, 0} {
+        m_config.maxDecimation = std::max(m_config.maxDecimation, (int32_t)0);
+    }
+
+    bool enabled() const {
+        return m_config.latencySloMs > 0.0f;
+    }
+
+    /**
+     * @brief decide what to do with the next frame
+     * @param ageMs time the frame spent before this stage
+     * @param inFlight frames waiting for or in this stage, this one included
+     */
+    RadarAdmissionDecision decide(float ageMs, uint32_t inFlight) {
+        RadarAdmissionDecision decision;
+        decision.ageMs = std::max(ageMs, 0.0f);
+        decision.inFlight = std::max(inFlight, (uint32_t)1);
+
+        if (!enabled() || m_fullMs < 0.0f) {
+            decision.action = RADAR_ADMISSION_FULL;
+            decision.predictedMs = m_fullMs < 0.0f ? 0.0f : decision.ageMs + m_fullMs;
+            return count(decision);
+        }
+
+        float slo = m_config.latencySloMs;
+        float degradedMs = m_degradedMs < 0.0f ? m_fullMs : m_degradedMs;
+        RadarAdmissionAction cheapest = RADAR_ADMISSION_FULL;
+        float cheapestMs = m_fullMs;
+        if (m_canDegrade && (m_degradedMs < 0.0f || degradedMs < m_fullMs)) {
+            cheapest = RADAR_ADMISSION_DEGRADED;
+            cheapestMs = degradedMs;
+        }
+        float backlogFull = decision.ageMs + decision.inFlight * m_fullMs;
+        float backlogDegraded = decision.ageMs + decision.inFlight * degradedMs;
+        bool mayShed = m_shedInRow < (uint32_t)m_config.maxDecimation;
+
+        if (backlogFull <= (m_underLoad ? slo * RADAR_ADMISSION_RECOVER_RATIO : slo)) {
+            decision.action = RADAR_ADMISSION_FULL;
+            decision.predictedMs = decision.ageMs + m_fullMs;
+            m_underLoad = false;
+            return count(decision);
+        }
+
+        m_underLoad = true;
+        if (m_canDegrade && (m_degradedMs < 0.0f || backlogDegraded <= slo)) {
+            decision.action = RADAR_ADMISSION_DEGRADED;
+            decision.predictedMs = decision.ageMs + degradedMs;
+        }
+        else if (mayShed && decision.ageMs + cheapestMs > slo) {
+            decision.action = RADAR_ADMISSION_DROPPED;
+            decision.predictedMs = decision.ageMs + cheapestMs;
+        }
+        else {
+            // shed k - 1 frames of every k, k being the factor by which the backlog overshoots the objective
+            uint32_t k = (uint32_t)std::ceil((decision.ageMs + decision.inFlight * cheapestMs) / slo);
+            k = std::min(std::max(k, (uint32_t)2), (uint32_t)m_config.maxDecimation + 1);
+            decision.action = (mayShed && m_shedInRow + 1 < k) ? RADAR_ADMISSION_DECIMATED : cheapest;
+            decision.predictedMs = decision.ageMs + cheapestMs;
+        }
+        return count(decision);
+    }
+
+    /**
+     * @brief report the measured service time of a processed frame
+     */
+    void record(RadarAdmissionAction action, float serviceMs) {
+        float& estimate = (RADAR_ADMISSION_DEGRADED == action) ? m_degradedMs : m_fullMs;
+        estimate = estimate < 0.0f ? serviceMs : RADAR_ADMISSION_EWMA_ALPHA * serviceMs + (1.0f - RADAR_ADMISSION_EWMA_ALPHA) * estimate;
+    }
+
+    /**
+     * @brief moving average of the service time in full or degraded mode, -1 before the first measurement
+     */
+    float serviceMs(bool degraded) const {
+        return degraded ? m_degradedMs : m_fullMs;
+    }
+
+    uint64_t decisions() const {
+        return m_decisions;
+    }
+
+    uint64_t count(RadarAdmissionAction action) const {
+        return m_counts[action];
+    }
+
+private:
+    RadarAdmissionDecision count(const RadarAdmissionDecision& decision) {
+        bool shed = (RADAR_ADMISSION_DECIMATED == decision.action) || (RADAR_ADMISSION_DROPPED == decision.action);
+        m_shedInRow = shed ? m_shedInRow + 1 : 0;
+        m_decisions++;
+        m_counts[decision.action]++;
+        return decision;
+    }
+
+    RadarAdmissionConfig m_config;
+    bool m_canDegrade;
+
+    float m_fullMs;       // service time estimates, -1 before the first measurement
+    float m_degradedMs;
+    bool m_underLoad;     // the last frame was not processed in full for lack of time
+    uint32_t m_shedInRow; // frames shed since the last processed one
+
+    uint64_t m_decisions;
+    uint64_t m_counts[RADAR_ADMISSION_ACTION_NUM];
+};
+
+}  // namespace inference
+
+}  // namespace ai
+
+}  // namespace hce
+
+#endif  // #ifndef HCE_AI_INF_RADAR_ADMISSION_CONTROLLER_HPP
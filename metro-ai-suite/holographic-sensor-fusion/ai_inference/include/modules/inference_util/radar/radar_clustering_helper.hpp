@@ -20,6 +20,9 @@
 #include "inc/api/hvaLogger.hpp"
 #include "nodes/radarDatabaseMeta.hpp"
 
+#include <cstdint>
+#include <vector>
+
 namespace hce {
 
 namespace ai {
@@ -148,7 +151,7 @@ typedef struct
 
     char *scratchPad;
     char *visited;
-    char *scope;
+    int *scope;  // id of the seed whose cluster already holds the point, replaces a per-seed copy of visited
     int *neighbors;
     // float *distances;
     // clusteringDBscanDebugInfo *debugInfo;
@@ -163,6 +166,174 @@ typedef struct
 
 typedef enum { POINT_UNKNOWN = 0, POINT_VISITED } clusteringDBscanPointState;
 
+/**
+ * @brief Implementations of the DBSCAN distance kernel, all of them return the same neighbours bit for bit
+ */
+enum class DBscanKernel {
+    Scalar = 0,
+    AVX2 = 1,
+    AVX512 = 2
+};
+
+/**
+ * @brief Uniform grid over (x, y, sqrt(weight) * speed) with cell size epsilon for the DBSCAN neighbour search.
+ *
+ * The grid is rebuilt once per frame. Any epsilon-neighbour of a point lies in one of the 27 cells around the
+ * point's cell, so a query only tests those cells instead of the whole point cloud. Points are stored sorted
+ * by cell, which keeps every cell a contiguous run of x/y/speed values.
+ * The distance test is the one of the original brute-force scan and the neighbours are returned in ascending
+ * point index, so the clustering output does not change.
+ * The distance kernel runs on AVX-512 or AVX2 when the CPU supports it, see DBscanKernel.
+ */
+class DBscanGridIndex {
+  public:
+    DBscanGridIndex();
+
+    /**
+     * @brief Best kernel supported by the running CPU
+     */
+    static DBscanKernel detectKernel();
+
+    static bool isKernelSupported(DBscanKernel kernel);
+
+    static const char *kernelName(DBscanKernel kernel);
+
+    /**
+     * @brief Force a kernel, used by benchmarks and for debugging
+     * @return false if the running CPU does not support the kernel, the current kernel is kept then
+     */
+    bool setKernel(DBscanKernel kernel);
+
+    DBscanKernel kernel() const
+    {
+        return m_kernel;
+    }
+
+    /**
+     * @brief Rebuild the index for a new frame, buffers are kept and only grow with the point count
+     */
+    void build(const clusteringDBscanPoint2d *pointArray, const float *speedArray, int numPoints, float epsilon, float weight);
+
+    /**
+     * @brief Find the neighbours of a point that are neither visited nor already claimed by the current seed
+     * @param point index of the point to search around
+     * @param visited per point visited state
+     * @param scope per point id of the seed which claimed it
+     * @param scopeId id of the current seed
+     * @param neigh output, indices of the found neighbours in ascending order
+     * @return number of neighbours found
+     */
+    int findNeighbors(int point, const char *visited, const int *scope, int scopeId, int *neigh) const;
+
+  private:
+    struct Cell {
+        int32_t ix;
+        int32_t iy;
+        int32_t iv;
+        int begin;  // first slot of the cell in the sorted point arrays
+        int end;
+    };
+
+    int lookupCell(int32_t ix, int32_t iy, int32_t iv) const;
+    int scanRange(int begin, int end, float x, float y, float speed, const char *visited, const int *scope, int scopeId, int *neigh) const;
+
+    // writes the slots in [begin, end) closer than epsilon to the query point into hits, returns their count
+    typedef int (*SpanKernel)(const float *x, const float *y, const float *speed, int begin, int end, float qx, float qy, float qSpeed, float weight,
+                              float epsilon2, int *hits);
+
+    DBscanKernel m_kernel;
+    SpanKernel m_spanKernel;
+
+    int m_numPoints = 0;
+    float m_epsilon2 = 0.f;
+    float m_weight = 0.f;
+    bool m_useGrid = false;    // false when epsilon/weight do not allow a grid, queries scan every point
+    bool m_speedAxis = false;  // false when weight is zero, the grid is then 2-D
+
+    // per point cell coordinates and its slot in the sorted arrays
+    std::vector<int32_t> m_cellX;
+    std::vector<int32_t> m_cellY;
+    std::vector<int32_t> m_cellV;
+    std::vector<int> m_slot;
+
+    // points sorted by cell, structure of arrays
+    std::vector<int> m_order;
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_speed;
+    mutable std::vector<int> m_hits;  // kernel output of the running query
+
+    std::vector<Cell> m_cells;
+    std::vector<int> m_hashTable;  // open addressing, index into m_cells or -1
+    size_t m_hashMask = 0;
+};
+
+/**
+ * @brief DBSCAN over the point cloud of one radar frame
+ *
+ * Points are placed at (range * cos(angle), range * sin(angle)) and clustered together with their weighted speed, the
+ * neighbour search runs on a DBscanGridIndex. The scratch buffers are sized for maxPoints by create() and reused by
+ * every run(). Shared by RadarClusteringNode and the in-tree libradar.
+ *
+ * Not thread-safe, each user owns one clusterer.
+ */
+class DBscanClusterer {
+  public:
+    DBscanClusterer();
+
+    ~DBscanClusterer();
+
+    /**
+     * @brief allocate the scratch buffers, a second call replaces the configuration
+     */
+    clusteringDBscanErrorCodes create(const RadarClusteringConfig &config);
+
+    /**
+     * @brief cluster one frame
+     * @param input point cloud of the frame, at most maxPoints points
+     * @param output InputArray is resized to the point count and holds the cluster id of every point, 0 for noise,
+     * report is resized to maxClusters and its first numCluster entries describe the clusters
+     * @return DBSCAN_ERROR_CLUSTER_LIMIT_REACHED when the frame holds more than maxClusters clusters, output then
+     * holds the first maxClusters of them
+     */
+    clusteringDBscanErrorCodes run(const clusteringDBscanInput *input, clusteringDBscanOutput *output);
+
+    /**
+     * @brief force a distance kernel, see DBscanGridIndex::setKernel()
+     */
+    bool setKernel(DBscanKernel kernel)
+    {
+        return m_gridIndex.setKernel(kernel);
+    }
+
+    DBscanKernel kernel() const
+    {
+        return m_gridIndex.kernel();
+    }
+
+    int maxClusters() const
+    {
+        return m_inst ? m_inst->maxClusters : 0;
+    }
+
+  private:
+    void destroy();
+
+    void calcInfo(const clusteringDBscanPoint2d *pointArray,
+                  const float *speedArray,
+                  const float *SNRArray,
+                  const float *aoaVar,
+                  const int *neighStart,
+                  const int *neighLast,
+                  clusteringDBscanReport *report);
+
+    clusteringDBscanInstance *m_inst;
+
+    DBscanGridIndex m_gridIndex;  // neighbour index over the current frame, rebuilt by every run
+
+    std::vector<float> m_pointArray;  // x, y of the current frame, reserved for maxPoints
+};
+
 }  // namespace inference
 
 }  // namespace ai
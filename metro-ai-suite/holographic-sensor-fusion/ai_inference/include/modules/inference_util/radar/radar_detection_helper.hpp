@@ -37,6 +37,8 @@
 #include "inc/api/hvaLogger.hpp"
 #include "nodes/radarDatabaseMeta.hpp"
 #include "modules/inference_util/radar/complex_op.hpp"
+#include "modules/inference_util/radar/radar_tensor.hpp"
+#include "modules/inference_util/radar/radar_thread_pool.hpp"
 
 namespace hce{
 
@@ -46,146 +48,123 @@ namespace inference{
 
 #define PI 3.141592653589793
 
-template<typename T>
-class TwoDimArray{
-    
-    public:
-    // T* array;
-    std::shared_ptr<T[]> array;
-    int m_width;
-    int m_height;
-
-
-    public:
-    using Ptr = std::shared_ptr<TwoDimArray>;
-    TwoDimArray(int w, int h): m_width(w),m_height(h){
-        array =std::shared_ptr<T[]>(new T[w*h]());
+// smallest share of a stage handed to one thread of the intra-frame pool, smaller stages run inline
+#define RADAR_MIN_ROWS_PER_TASK 16    // fft rows, range bins or doppler bins
+#define RADAR_MIN_POINTS_PER_TASK 32  // detected points in doa estimation
+
+/**
+ * @brief Key of a committed DFTI descriptor: transform length, batch geometry, precision and placement
+ */
+struct FFTPlanKey {
+    MKL_LONG length;              // length of one 1-D transform
+    MKL_LONG numTransforms;       // DFTI_NUMBER_OF_TRANSFORMS
+    MKL_LONG stride;              // distance between two elements of one transform
+    MKL_LONG distance;            // distance between the first elements of two consecutive transforms
+    DFTI_CONFIG_VALUE precision;  // DFTI_SINGLE or DFTI_DOUBLE
+    DFTI_CONFIG_VALUE placement;  // DFTI_INPLACE or DFTI_NOT_INPLACE
+
+    bool operator==(const FFTPlanKey& other) const{
+        return length == other.length && numTransforms == other.numTransforms && stride == other.stride &&
+               distance == other.distance && precision == other.precision && placement == other.placement;
     }
-    ~TwoDimArray(){}
-
-    TwoDimArray(const TwoDimArray& obj){
-        array = obj.array;
-        m_width = obj.m_width;
-        m_height =obj.m_height;
-    }
-
-    T at(int x, int y) const{
-        return array[index(x, y)];
+};
 
+struct FFTPlanKeyHash {
+    size_t operator()(const FFTPlanKey& key) const{
+        size_t seed = 0;
+        for (size_t v : {(size_t)key.length, (size_t)key.numTransforms, (size_t)key.stride, (size_t)key.distance,
+                         (size_t)key.precision, (size_t)key.placement}) {
+            seed ^= std::hash<size_t>()(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
     }
-    void setValue(int x, int y, T value){
-        array[index(x,y)] = value;
-    }
-    protected:
-    int index(int x, int y)const{
-        return x+m_width*y;
-        // return x*m_width +y;
-    }
-
 };
-template<typename T>
-class ThreeDimArray{
-
-    public:
-    // T* array;
-    std::shared_ptr<T[]> array;
-    int m_width;
-    int m_height;
-    int m_depth;
 
-    public:
-    using Ptr = std::shared_ptr<ThreeDimArray>;
+/**
+ * @brief Cache of committed MKL DFTI descriptors.
+ * Descriptors are created and committed on first use and then reused by every following frame,
+ * the cache is not thread-safe so each node worker owns its own instance.
+ */
+class FFTPlanCache {
+public:
+    using Ptr = std::shared_ptr<FFTPlanCache>;
 
-    ThreeDimArray(int w, int h, int d):  m_width(w), m_height(h),m_depth(d){
-        array =std::shared_ptr<T[]>(new T[w*h*d]());
+    FFTPlanCache(){};
+    ~FFTPlanCache(){
+        clear();
     }
+    FFTPlanCache(const FFTPlanCache&) = delete;
+    FFTPlanCache& operator=(const FFTPlanCache&) = delete;
 
-    ~ThreeDimArray(){};
+    /**
+     * @brief Get a committed descriptor for the key, creating it on cache miss
+     * @return descriptor handle, or nullptr if MKL failed to create or commit it
+     */
+    DFTI_DESCRIPTOR_HANDLE getPlan(const FFTPlanKey& key);
 
-    ThreeDimArray(const ThreeDimArray& obj){
-        // copy constructor
-        array = obj.array;
-        m_width =obj.m_width;
-        m_height =obj.m_height;
-        m_depth =obj.m_depth;
-    }
-
-    void setValue(int x, int y, int z, T value){
-        array[index(x,y,z)] = value;
-    }
+    void clear();
 
-    std::shared_ptr<T[]> getArray(){
-        return array;
+    size_t size() const{
+        return m_plans.size();
     }
 
-    T at(int x, int y, int z) const{
-        return array[index(x, y, z)];
-    }
-    protected:
-    int index(int x, int y, int z) const{
-        return x*m_height+y +z*m_width*m_height;
-    }
+private:
+    std::unordered_map<FFTPlanKey, DFTI_DESCRIPTOR_HANDLE, FFTPlanKeyHash> m_plans;
 };
 
 class RadarCube {
 public:
     using Ptr = std::shared_ptr<RadarCube>;
-    RadarCube(ComplexFloat* frame, int frame_size,int frame_idx, RadarBasicConfig radar_conf):frame_id(frame_idx),radar_basic_conf_(radar_conf),m_n_samples_(radar_conf.adcSamples),m_n_chirps_(radar_conf.numChirps),m_n_tx_(radar_conf.numTx), m_n_rx_(radar_conf.numRx),m_n_vrx_(radar_conf.numRx*radar_conf.numTx), radarCube_(radar_conf.adcSamples,radar_conf.numChirps,radar_conf.numRx*radar_conf.numTx) {
-    //   frame_ = frame;
+    RadarCube(const ComplexFloat* frame, int frame_size,int frame_idx, RadarBasicConfig radar_conf):frame_id(frame_idx),radar_basic_conf_(radar_conf),m_n_samples_(radar_conf.adcSamples),m_n_chirps_(radar_conf.numChirps),m_n_tx_(radar_conf.numTx), m_n_rx_(radar_conf.numRx),m_n_vrx_(radar_conf.numRx*radar_conf.numTx), radarCube_(radar_conf.adcSamples,radar_conf.numChirps,radar_conf.numRx*radar_conf.numTx,RadarTensorLayout::ChirpMajor) {
       frameSize_  = frame_size;
-    //   radarCube_ = std::make_shared<ThreeDimArray<ComplexFloat>>(radar_conf.adcSamples,radar_conf.numChirps,radar_conf.numRx*radar_conf.numTx);
     };
-    ~RadarCube(){}
-    void  radarCube_format(ComplexFloat* frame){
-        TwoDimArray<ComplexFloat> cdata(m_n_vrx_, m_n_samples_* m_n_chirps_);
-        HVA_DEBUG("Debug frame[0] data: real%d, imag%d", (int)frame[0].real(), (int)frame[0].imag());
-        for(int k=0;k<m_n_samples_* m_n_vrx_*m_n_chirps_;k++){
-            int temp_chirp = k/(m_n_samples_* m_n_vrx_);
-            int temp_sample = k%(m_n_samples_* m_n_vrx_);
 
-            int line_rx = temp_sample/m_n_samples_;
-            int sample_number = temp_sample%m_n_samples_;
-          
+    /**
+     * @brief empty cube for a RadarObjectPool, sized by reset()
+     */
+    RadarCube():frameSize_(0),m_n_samples_(0),m_n_chirps_(0),m_n_tx_(0),m_n_rx_(0),m_n_vrx_(0),frame_id(0) {}
+    ~RadarCube(){}
 
-            cdata.setValue(line_rx,temp_chirp*m_n_samples_+sample_number, frame[temp_chirp*m_n_vrx_*m_n_samples_+line_rx*m_n_samples_+sample_number] );
-        }
-       
-        for(int k=0;k<m_n_vrx_; k++){
-            for(int i=0;i<m_n_samples_; i++){
-                for(int j=0;j<m_n_chirps_; j++){
-                    radarCube_.setValue(i,j,k, cdata.at(k, j*m_n_samples_+i));
-                
-                }
-            }
-        }
-        // for radical, other dataset need to verify the correctness
-      
-        // for (int k = 0; k < m_n_vrx_; k++) {
-        //   for (int i = 0; i < m_n_samples_; i++) {
-        //     for (int j = 0; j < m_n_chirps_; j++) {
-        //       //nTX=2
-        //      int vx = (k%m_n_rx_)*m_n_tx_ +k/m_n_rx_;
-        //      radarCube_->setValue(i,j, vx, data_radar.at(i,j,k));
-
-        //     }
-        //   }
-        // }
-        
-        // remove static clutter 
-        TwoDimArray<ComplexFloat> avg(m_n_chirps_, m_n_vrx_);
+    /**
+     * @brief prepare a pooled cube for a new frame, the storage is only reallocated when the radar dimensions change
+     */
+    void reset(int frame_size, int frame_idx, const RadarBasicConfig& radar_conf){
+      const int vrx = radar_conf.numRx * radar_conf.numTx;
+      if (radarCube_.empty() || m_n_samples_ != radar_conf.adcSamples || m_n_chirps_ != radar_conf.numChirps || m_n_vrx_ != vrx) {
+        radarCube_ = RadarTensor<ComplexFloat>(radar_conf.adcSamples, radar_conf.numChirps, vrx, RadarTensorLayout::ChirpMajor);
+      }
+      radar_basic_conf_ = radar_conf;
+      m_n_samples_ = radar_conf.adcSamples;
+      m_n_chirps_ = radar_conf.numChirps;
+      m_n_tx_ = radar_conf.numTx;
+      m_n_rx_ = radar_conf.numRx;
+      m_n_vrx_ = vrx;
+      frameSize_ = frame_size;
+      frame_id = frame_idx;
+    }
 
+    /**
+     * @brief reorder the raw chirp x vrx x sample frame into the chirp-major cube and remove static clutter in a single pass
+     */
+    void  radarCube_format(const ComplexFloat* frame){
+        HVA_DEBUG("Debug frame[0] data: real%d, imag%d", (int)frame[0].real(), (int)frame[0].imag());
+        // both the raw frame and the chirp-major cube keep the samples of one chirp contiguous,
+        // so every (chirp, vrx) row is read once, averaged and written with the average removed
         for (int j = 0; j < m_n_chirps_; j++)
         {
             for (int m = 0; m < m_n_vrx_; m++)
             {
+                const ComplexFloat* src = frame + (j * m_n_vrx_ + m) * m_n_samples_;
+                ComplexFloat* dst = radarCube_.plane(m) + j * m_n_samples_;
+                ComplexFloat avg(0, 0);
                 for (int i = 0; i < m_n_samples_; i++)
                 {
-                    avg.setValue(j, m, avg.at(j, m) + radarCube_.at(i, j, m));
+                    avg = avg + src[i];
                 }
-                avg.setValue(j, m, avg.at(j, m) / m_n_samples_); // need operater/
+                avg = avg / m_n_samples_;
                 for (int i = 0; i < m_n_samples_; i++)
                 {
-                    radarCube_.setValue(i, j, m, radarCube_.at(i, j, m) - avg.at(j, m));
+                    dst[i] = src[i] - avg;
                 }
             }
         }
@@ -194,15 +173,15 @@ public:
 
     }
 
-    std::shared_ptr<ComplexFloat[]> get_radar_cube_data(){
-        return radarCube_.array;
+    std::shared_ptr<ComplexFloat> get_radar_cube_data(){
+        return radarCube_.getArray();
     }
 
     int getRadarFrameSize(){
         return frameSize_;
     }
 
-    ThreeDimArray<ComplexFloat>& getRadarCube(){
+    RadarTensor<ComplexFloat>& getRadarCube(){
         return radarCube_;
     }
 
@@ -214,15 +193,14 @@ public:
 
 private:
 
-    // ComplexFloat* frame_;
-    ThreeDimArray<ComplexFloat> radarCube_;
+    RadarTensor<ComplexFloat> radarCube_;
     RadarBasicConfig radar_basic_conf_;
     int frameSize_;
-    const int m_n_samples_;
-    const int m_n_chirps_;
-    const int m_n_tx_;
-    const int m_n_rx_;
-    const int m_n_vrx_;
+    int m_n_samples_;
+    int m_n_chirps_;
+    int m_n_tx_;
+    int m_n_rx_;
+    int m_n_vrx_;
     int frame_id;
     
 };
@@ -263,11 +241,85 @@ struct phaseParameter{
     int virtualAntenna;
 };
 
+/**
+ * @brief Sliding-window cfar noise estimator for one row of a range-doppler map
+ *
+ * The training window of a cell under test is a lead part [j - train - guard, j - guard - 1) and a lag part
+ * [j + guard + 1, j + train + guard). With CFAR_EDGE_TRUNCATED the first train + guard cells only use the lag part
+ * and the last ones a one-sided lead window [j - train - guard, j), their thresholds are scaled by the edge factors.
+ * With CFAR_EDGE_CYCLIC every cell uses the full window wrapped around the row.
+ *
+ * CA-CFAR takes the window means from a running prefix sum, OS-CFAR keeps the window sorted and replaces the cells
+ * that slide in and out instead of sorting the whole window per cell. The cost per cell no longer grows with the
+ * training length for CA-CFAR and is one binary search plus a short move for OS-CFAR.
+ */
+class CfarEngine
+{
+public:
+    CfarEngine(CfarMethod method, float pfa, int guardLen, int trainLen, CfarEdgeMode edgeMode, float lowEdgeScale, float highEdgeScale);
+
+    /**
+     * @brief estimate noise and detection threshold of every cell of a contiguous row
+     */
+    void estimate(const float* row, int len);
+
+    const float* noise() const {
+        return m_noise.data();
+    }
+    const float* threshold() const {
+        return m_threshold.data();
+    }
+    // cells of the last row that use the full two-sided window, everything else is an edge cell
+    int interiorBegin() const {
+        return m_interiorBegin;
+    }
+    int interiorEnd() const {
+        return m_interiorEnd;
+    }
+
+private:
+    // training window relative to the cell under test, half-open ranges
+    struct Window {
+        int leadBegin;
+        int leadEnd;
+        int lagBegin;
+        int lagEnd;
+    };
+
+    void estimateCells(const float* data, int dataLen, int offset, int begin, int end, const Window& window, float scale);
+    void estimateCellsCA(const float* data, int dataLen, int offset, int begin, int end, const Window& window, float scale);
+    void estimateCellsOS(const float* data, int dataLen, int offset, int begin, int end, const Window& window, float scale);
+
+    CfarMethod m_method;
+    float m_pfa;
+    int m_guardLen;
+    int m_trainLen;
+    CfarEdgeMode m_edgeMode;
+    float m_lowEdgeScale;
+    float m_highEdgeScale;
+
+    int m_interiorBegin = 0;
+    int m_interiorEnd = 0;
+    std::vector<float> m_noise;
+    std::vector<float> m_threshold;
+    std::vector<float> m_padded;  // row extended by the wrapped cells in cyclic mode
+    std::vector<double> m_prefix;
+    std::vector<float> m_sorted;
+};
+
+/**
+ * @brief two-pass cfar: doppler cfar on every range row, then range cfar on the doppler bins that had a hit
+ * @param pool optional, splits the range rows of the doppler pass and the doppler bins of the range pass, every chunk
+ * works on its own copy of the engines and the detections keep the serial order
+ */
+void cfar2DDetection(const RadarTensor<float>& rd, CfarEngine& dopplerCfar, CfarEngine& rangeCfar, detectionCFAR_output_& output,
+                     RadarThreadPool* pool = nullptr);
+
 class CfarDetection
 {
 public:
 
-    CfarDetection(RadarDetectionConfig radar_conf, int n_samples, int n_chirps, std::shared_ptr<TwoDimArray<float>>& RD) : cfar_conf(radar_conf), n_samples_(n_samples), n_chirps_(n_chirps){
+    CfarDetection(RadarDetectionConfig radar_conf, int n_samples, int n_chirps, std::shared_ptr<RadarTensor<float>>& RD) : cfar_conf(radar_conf), n_samples_(n_samples), n_chirps_(n_chirps){
         RD_spec = RD;
         cfar_output_.RD_after_cfar.resize(n_samples_);
         for(int i=0;i<n_samples_;i++){
@@ -285,16 +337,22 @@ public:
     RadarDetectionConfig getConfig(){
         return cfar_conf;
     }
-    void setCfarInput(std::shared_ptr<TwoDimArray<float>> rd){
+    void setCfarInput(std::shared_ptr<RadarTensor<float>> rd){
         RD_spec = rd;
     }
+    void setThreadPool(RadarThreadPool::Ptr pool){
+        thread_pool_ = pool;
+    }
+
+protected:
+    RadarThreadPool::Ptr thread_pool_;
 
 private:
     RadarDetectionConfig cfar_conf;
     int n_chirps_;
     int n_samples_;
 
-    std::shared_ptr<TwoDimArray<float>> RD_spec;
+    std::shared_ptr<RadarTensor<float>> RD_spec;
     detectionCFAR_output_ cfar_output_;
 
 };
@@ -302,7 +360,7 @@ private:
 class CACFAR : public CfarDetection
 {
 public:
-    CACFAR(RadarDetectionConfig radar_conf, int n_samples, int n_chirps, std::shared_ptr<TwoDimArray<float>> &RD) : n_samples_(n_samples), n_chirps_(n_chirps), dopplerPfa_(radar_conf.DopplerPfa), rangePfa_(radar_conf.RangePfa), dopplerWinGuardLen_(radar_conf.DopplerWinGuardLen), dopplerWinTrainLen_(radar_conf.DopplerWinTrainLen), rangeWinGuardLen_(radar_conf.RangeWinGuardLen), rangeWinTrainLen_(radar_conf.RangeWinTrainLen)
+    CACFAR(RadarDetectionConfig radar_conf, int n_samples, int n_chirps, std::shared_ptr<RadarTensor<float>> &RD) : n_samples_(n_samples), n_chirps_(n_chirps), dopplerPfa_(radar_conf.DopplerPfa), rangePfa_(radar_conf.RangePfa), dopplerWinGuardLen_(radar_conf.DopplerWinGuardLen), dopplerWinTrainLen_(radar_conf.DopplerWinTrainLen), rangeWinGuardLen_(radar_conf.RangeWinGuardLen), rangeWinTrainLen_(radar_conf.RangeWinTrainLen), dopplerEdge_(radar_conf.m_doppler_cfar_edge_), rangeEdge_(radar_conf.m_range_cfar_edge_)
     {
         RD_spec = RD;
         cfar_output_.RD_after_cfar.resize(n_samples_);
@@ -318,7 +376,7 @@ public:
         return cfar_output_;
     }
 private:
-    std::shared_ptr<TwoDimArray<float>> RD_spec;
+    std::shared_ptr<RadarTensor<float>> RD_spec;
     detectionCFAR_output_ cfar_output_;
     int n_samples_;
     int n_chirps_;
@@ -329,6 +387,8 @@ private:
     int dopplerWinTrainLen_; // number of doppler cfar training cells
     int rangeWinGuardLen_;   // number of range cfar guard cells
     int rangeWinTrainLen_;   // number of range cfar training cells
+    CfarEdgeMode dopplerEdge_;
+    CfarEdgeMode rangeEdge_;
     // CfarMethod m_doppler_cfar_method_;                          // enum, doppler cfar method
     // CfarMethod m_range_cfar_method_;                            // enum, range cfar method
 };
@@ -336,7 +396,7 @@ private:
 class OSCFAR : public CfarDetection
 {
 public:
-    OSCFAR(RadarDetectionConfig radar_conf, int n_samples, int n_chirps, std::shared_ptr<TwoDimArray<float>> &RD) : n_samples_(n_samples), n_chirps_(n_chirps), dopplerPfa_(radar_conf.DopplerPfa), rangePfa_(radar_conf.RangePfa), dopplerWinGuardLen_(radar_conf.DopplerWinGuardLen), dopplerWinTrainLen_(radar_conf.DopplerWinTrainLen), rangeWinGuardLen_(radar_conf.RangeWinGuardLen), rangeWinTrainLen_(radar_conf.RangeWinTrainLen)
+    OSCFAR(RadarDetectionConfig radar_conf, int n_samples, int n_chirps, std::shared_ptr<RadarTensor<float>> &RD) : n_samples_(n_samples), n_chirps_(n_chirps), dopplerPfa_(radar_conf.DopplerPfa), rangePfa_(radar_conf.RangePfa), dopplerWinGuardLen_(radar_conf.DopplerWinGuardLen), dopplerWinTrainLen_(radar_conf.DopplerWinTrainLen), rangeWinGuardLen_(radar_conf.RangeWinGuardLen), rangeWinTrainLen_(radar_conf.RangeWinTrainLen), dopplerEdge_(radar_conf.m_doppler_cfar_edge_), rangeEdge_(radar_conf.m_range_cfar_edge_)
     {
         RD_spec = RD;
         cfar_output_.RD_after_cfar.resize(n_samples_);
@@ -351,7 +411,7 @@ public:
         return cfar_output_;
     }
 private:
-    std::shared_ptr<TwoDimArray<float>> RD_spec;
+    std::shared_ptr<RadarTensor<float>> RD_spec;
     detectionCFAR_output_ cfar_output_;
     int n_samples_;
     int n_chirps_;
@@ -363,12 +423,86 @@ private:
     int dopplerWinTrainLen_; // number of doppler cfar training cells
     int rangeWinGuardLen_;   // number of range cfar guard cells
     int rangeWinTrainLen_;   // number of range cfar training cells
+    CfarEdgeMode dopplerEdge_;
+    CfarEdgeMode rangeEdge_;
 };
 
 
+#define DOA_ANGLE_GRID_SIZE 360  // -90 to 89.5 degree in 0.5 degree steps
+#define DOA_CAPON_DIAGONAL_LOADING 1e-8
+
+/**
+ * @brief Batched DBF / Capon (MVDR) / MUSIC angle estimation on a fixed angle grid
+ *
+ * The steering matrix of the angle grid and the per doppler bin TDM phase compensation are computed once per radar
+ * geometry. All detected points of a frame are then handled as one problem: the beamformer response of every point
+ * on every grid angle is a single complex gemm of the conjugated steering matrix with the n_vrx x N snapshot matrix.
+ *
+ * With one snapshot per point the covariance is the rank one x x^H, diagonally loaded for MVDR. Both pseudo-spectra
+ * then follow from the response a(theta)^H x in closed form, so the N small Hermitian inversions / eigen problems
+ * reduce to per-point scalars:
+ *   MVDR:  1 / a^H (x x^H + l I)^-1 a = l / (n - |a^H x|^2 / (l + |x|^2))   (Sherman-Morrison)
+ *   MUSIC: 1 / a^H (I - x x^H / |x|^2) a = 1 / (n - |a^H x|^2 / |x|^2)       (noise subspace projector)
+ *
+ * Not thread-safe, each node worker owns its own instance. estimate() splits the points over the thread pool if one is set.
+ */
+class DOAEngine {
+public:
+    using Ptr = std::shared_ptr<DOAEngine>;
+
+    DOAEngine(){};
+    DOAEngine(const DOAEngine&) = delete;
+    DOAEngine& operator=(const DOAEngine&) = delete;
+
+    /**
+     * @brief build the steering and compensation tables, a no-op while the geometry is unchanged
+     */
+    void configure(int numTx, int numRx, int numChirps);
+
+    /**
+     * @brief estimate the angle of every point
+     * @param method DBF, CAPON or MUSIC
+     * @param snapshots antenna vectors of the points, numPoints x n_vrx, one point after the other
+     * @param angles output, angle in degree of the spectrum peak of every point
+     */
+    void estimate(AoaEstimationType method, const ComplexFloat* snapshots, int numPoints, float* angles);
+
+    /**
+     * @brief TDM-MIMO phase compensation exp(-j * tx * phi(dopplerBin)) of every virtual antenna
+     */
+    const ComplexFloat* compensation(int dopplerBin) const{
+        return m_compensation.data() + (size_t)dopplerBin * m_numVrx;
+    }
+
+    void setThreadPool(RadarThreadPool::Ptr pool){
+        m_threadPool = pool;
+    }
+
+    int numVrx() const{
+        return m_numVrx;
+    }
+    int numChirps() const{
+        return m_numChirps;
+    }
+
+private:
+    void peakSearch(AoaEstimationType method, const ComplexFloat* snapshots, int begin, int end, float* angles) const;
+
+    int m_numTx = 0;
+    int m_numRx = 0;
+    int m_numChirps = 0;
+    int m_numVrx = 0;
+    RadarThreadPool::Ptr m_threadPool;
+
+    std::vector<ComplexFloat> m_steering;      // n_vrx x grid, column g is a(theta_g)
+    std::vector<float> m_gridAngles;           // degree
+    std::vector<ComplexFloat> m_compensation;  // numChirps x n_vrx
+    std::vector<ComplexFloat> m_response;      // grid x points, a(theta)^H x of the current frame
+};
+
 class DOAEstimation{
     public:
-    DOAEstimation(RadarBasicConfig& radar_basic_conf, std::shared_ptr<ThreeDimArray<ComplexFloat>>& doppler_profile): radar_basic_config_(radar_basic_conf){
+    DOAEstimation(RadarBasicConfig& radar_basic_conf, std::shared_ptr<RadarTensor<ComplexFloat>>& doppler_profile): radar_basic_config_(radar_basic_conf){
         dopplerProfile_ = doppler_profile;
         n_samples_ = radar_basic_conf.adcSamples;
         n_chirps_ = radar_basic_conf.numChirps;
@@ -388,10 +522,27 @@ class DOAEstimation{
     virtual void setPeakSearchOutput(peakSearch_output_& peakOutput)=0;
     virtual void setCfarOutput(detectionCFAR_output_& cfarOutput)=0;
     virtual std::shared_ptr<pointClouds>& getPCL()=0;
+    // fill a caller provided point cloud, e.g. one recycled from the node's arena
+    virtual void setPCL(const std::shared_ptr<pointClouds>& pcl)=0;
     void generateCompCoff(phaseParameter& phase_parameter, int speedBin, std::vector<ComplexFloat>& compCoffVec);
     void calculate_pcls(std::shared_ptr<pointClouds>& input, std::shared_ptr<pointClouds>& output, RadarBasicConfig& radar_basic_config);
+    void setFFTPlanCache(FFTPlanCache::Ptr plan_cache){
+        fft_plan_cache_ = plan_cache;
+    }
+    void setDOAEngine(DOAEngine::Ptr doa_engine){
+        doa_engine_ = doa_engine;
+    }
+protected:
+    /**
+     * @brief angles of all points with the batched engine, one gemm for the whole frame
+     */
+    void estimateBatched(AoaEstimationType method, const std::vector<PointList2D>& points, RadarTensor<ComplexFloat>& dopplerProfile,
+                         std::vector<float>& angles);
+
+    FFTPlanCache::Ptr fft_plan_cache_;
+    DOAEngine::Ptr doa_engine_;
 private:
-    std::shared_ptr<ThreeDimArray<ComplexFloat>> dopplerProfile_;
+    std::shared_ptr<RadarTensor<ComplexFloat>> dopplerProfile_;
     RadarBasicConfig radar_basic_config_;
     int n_samples_;
     int n_chirps_;
@@ -408,7 +559,7 @@ private:
 class FFTAngleEstimation: public DOAEstimation
 {
 public:
-    FFTAngleEstimation(RadarBasicConfig &radar_basic_conf, std::shared_ptr<ThreeDimArray<ComplexFloat>> &doppler_profile) : radar_basic_config_(radar_basic_conf),DOAEstimation(radar_basic_conf,doppler_profile)
+    FFTAngleEstimation(RadarBasicConfig &radar_basic_conf, std::shared_ptr<RadarTensor<ComplexFloat>> &doppler_profile) : radar_basic_config_(radar_basic_conf),DOAEstimation(radar_basic_conf,doppler_profile)
     {
         doppler_profile_ = doppler_profile;
         n_samples_ = radar_basic_conf.adcSamples;
@@ -433,6 +584,9 @@ public:
     std::shared_ptr<pointClouds>& getPCL() override{
         return pointClouds_;
     }
+    void setPCL(const std::shared_ptr<pointClouds>& pcl) override{
+        pointClouds_ = pcl;
+    }
 
     phaseParameter setPhaseParameters(){
         phaseParameter phaseParam;
@@ -475,7 +629,7 @@ public:
     }
 
 private: 
-    std::shared_ptr<ThreeDimArray<ComplexFloat>> doppler_profile_;
+    std::shared_ptr<RadarTensor<ComplexFloat>> doppler_profile_;
     peakSearch_output_ peakOutput_;
     detectionCFAR_output_ cfar_output_;// get snr from cfar_output
     // pointClouds pointClouds_;
@@ -491,7 +645,7 @@ private:
 class DBFAngleEstimation: public DOAEstimation
 {
 public:
-    DBFAngleEstimation(RadarBasicConfig &radar_basic_conf, std::shared_ptr<ThreeDimArray<ComplexFloat>> &doppler_profile) : radar_basic_config_(radar_basic_conf),DOAEstimation(radar_basic_conf,doppler_profile)
+    DBFAngleEstimation(RadarBasicConfig &radar_basic_conf, std::shared_ptr<RadarTensor<ComplexFloat>> &doppler_profile) : radar_basic_config_(radar_basic_conf),DOAEstimation(radar_basic_conf,doppler_profile)
     {
         doppler_profile_ = doppler_profile;
         n_samples_ = radar_basic_conf.adcSamples;
@@ -513,6 +667,9 @@ public:
     std::shared_ptr<pointClouds>& getPCL() override{
         return pointClouds_;
     }
+    void setPCL(const std::shared_ptr<pointClouds>& pcl) override{
+        pointClouds_ = pcl;
+    }
 
     phaseParameter setPhaseParameters(){
         phaseParameter phaseParam;
@@ -542,7 +699,6 @@ public:
 
         return result;
     }
-    void angleDBF(ComplexFloat *frameData, float &angle);
     void init(int num)
     {
         pointClouds_->num = num;
@@ -555,7 +711,7 @@ public:
     }
 
 private: 
-    std::shared_ptr<ThreeDimArray<ComplexFloat>> doppler_profile_;
+    std::shared_ptr<RadarTensor<ComplexFloat>> doppler_profile_;
     peakSearch_output_ peakOutput_;
     detectionCFAR_output_ cfar_output_;// get snr from cfar_output
     // pointClouds pointClouds_;
@@ -571,7 +727,7 @@ private:
 class CaponAngleEstimation: public DOAEstimation
 {
 public:
-    CaponAngleEstimation(RadarBasicConfig &radar_basic_conf, std::shared_ptr<ThreeDimArray<ComplexFloat>> &doppler_profile) : radar_basic_config_(radar_basic_conf),DOAEstimation(radar_basic_conf,doppler_profile)
+    CaponAngleEstimation(RadarBasicConfig &radar_basic_conf, std::shared_ptr<RadarTensor<ComplexFloat>> &doppler_profile) : radar_basic_config_(radar_basic_conf),DOAEstimation(radar_basic_conf,doppler_profile)
     {
         doppler_profile_ = doppler_profile;
         n_samples_ = radar_basic_conf.adcSamples;
@@ -593,6 +749,9 @@ public:
     std::shared_ptr<pointClouds>& getPCL() override{
         return pointClouds_;
     }
+    void setPCL(const std::shared_ptr<pointClouds>& pcl) override{
+        pointClouds_ = pcl;
+    }
 
     phaseParameter setPhaseParameters(){
         phaseParameter phaseParam;
@@ -622,7 +781,6 @@ public:
 
         return result;
     }
-    void angleCapon(ComplexFloat *frameData, float &angle);
     void init(int num)
     {
         pointClouds_->num = num;
@@ -635,7 +793,7 @@ public:
     }
 
 private: 
-    std::shared_ptr<ThreeDimArray<ComplexFloat>> doppler_profile_;
+    std::shared_ptr<RadarTensor<ComplexFloat>> doppler_profile_;
     peakSearch_output_ peakOutput_;
     detectionCFAR_output_ cfar_output_;// get snr from cfar_output
     // pointClouds pointClouds_;
@@ -652,7 +810,7 @@ private:
 class MusicAngleEstimation: public DOAEstimation
 {
 public:
-    MusicAngleEstimation(RadarBasicConfig &radar_basic_conf, std::shared_ptr<ThreeDimArray<ComplexFloat>> &doppler_profile) : radar_basic_config_(radar_basic_conf),DOAEstimation(radar_basic_conf,doppler_profile)
+    MusicAngleEstimation(RadarBasicConfig &radar_basic_conf, std::shared_ptr<RadarTensor<ComplexFloat>> &doppler_profile) : radar_basic_config_(radar_basic_conf),DOAEstimation(radar_basic_conf,doppler_profile)
     {
         doppler_profile_ = doppler_profile;
         n_samples_ = radar_basic_conf.adcSamples;
@@ -674,6 +832,9 @@ public:
     std::shared_ptr<pointClouds>& getPCL() override{
         return pointClouds_;
     }
+    void setPCL(const std::shared_ptr<pointClouds>& pcl) override{
+        pointClouds_ = pcl;
+    }
 
     phaseParameter setPhaseParameters(){
         phaseParameter phaseParam;
@@ -703,7 +864,6 @@ public:
 
         return result;
     }
-    void angleMusic(ComplexFloat *frameData, float &angle);
     void init(int num)
     {
         pointClouds_->num = num;
@@ -716,7 +876,7 @@ public:
     }
 
 private: 
-    std::shared_ptr<ThreeDimArray<ComplexFloat>> doppler_profile_;
+    std::shared_ptr<RadarTensor<ComplexFloat>> doppler_profile_;
     peakSearch_output_ peakOutput_;
     detectionCFAR_output_ cfar_output_;// get snr from cfar_output
     // pointClouds pointClouds_;
@@ -733,22 +893,66 @@ class RadarDetection{
 public:
     using Ptr = std::shared_ptr<RadarDetection>;
 
-    RadarDetection(ThreeDimArray<ComplexFloat> radarcube, int frame_idx, int frame_size, RadarBasicConfig radar_basic_conf, RadarDetectionConfig radar_conf) : frame_id_(frame_idx), frame_size_(frame_size), m_n_samples_(radarcube.m_width), m_n_chirps_(radarcube.m_height), m_n_vrx_(radarcube.m_depth), radar_basic_config_(radar_basic_conf), radar_detection_config_(radar_conf)
+    /**
+     * @brief empty detection to be kept by a node worker, bound to a frame by reset()
+     */
+    RadarDetection() : frame_id_(0), frame_size_(0), m_n_samples_(0), m_n_chirps_(0), m_n_vrx_(0) {}
+
+    RadarDetection(RadarTensor<ComplexFloat> radarcube, int frame_idx, int frame_size, RadarBasicConfig radar_basic_conf, RadarDetectionConfig radar_conf, FFTPlanCache::Ptr plan_cache = nullptr, DOAEngine::Ptr doa_engine = nullptr, RadarThreadPool::Ptr thread_pool = nullptr) : RadarDetection()
     {
+        reset(radarcube, frame_idx, frame_size, radar_basic_conf, radar_conf, plan_cache, doa_engine, thread_pool);
+    };
 
-        radarDataPtr_ = std::make_shared<ThreeDimArray<ComplexFloat>>(radarcube);
-        rangeProfilePtr = std::make_shared<ThreeDimArray<ComplexFloat>>(m_n_samples_, m_n_chirps_, m_n_vrx_);
-        dopplerProfilePtr = std::make_shared<ThreeDimArray<ComplexFloat>>(m_n_samples_, m_n_chirps_, m_n_vrx_);
-        RadarBeforeCfarPtr = std::make_shared<TwoDimArray<float>>(m_n_samples_, m_n_chirps_);
-        cfar_output.RD_after_cfar.resize(m_n_samples_);
-        peak_output.RD_peakSearch.resize(m_n_samples_);
-        for (int i = 0; i < m_n_samples_; i++)
-        {
-            cfar_output.RD_after_cfar[i].resize(m_n_chirps_);
-            peak_output.RD_peakSearch[i].resize(m_n_chirps_);
+    /**
+     * @brief bind the detection to a new frame, the intermediate profiles are only reallocated when the radar dimensions change
+     */
+    void reset(const RadarTensor<ComplexFloat>& radarcube, int frame_idx, int frame_size, const RadarBasicConfig& radar_basic_conf, const RadarDetectionConfig& radar_conf, FFTPlanCache::Ptr plan_cache = nullptr, DOAEngine::Ptr doa_engine = nullptr, RadarThreadPool::Ptr thread_pool = nullptr)
+    {
+        frame_id_ = frame_idx;
+        frame_size_ = frame_size;
+        radar_basic_config_ = radar_basic_conf;
+        radar_detection_config_ = radar_conf;
+
+        // plans are owned by the node worker so that they survive across frames
+        if (plan_cache || !fft_plan_cache_) {
+            fft_plan_cache_ = plan_cache ? plan_cache : std::make_shared<FFTPlanCache>();
         }
-        
-    };
+        if (doa_engine || !doa_engine_) {
+            doa_engine_ = doa_engine ? doa_engine : std::make_shared<DOAEngine>();
+        }
+        // without a pool every stage runs inline on the calling thread
+        if (thread_pool || !thread_pool_) {
+            thread_pool_ = thread_pool ? thread_pool : std::make_shared<RadarThreadPool>(1);
+        }
+
+        if (radarDataPtr_) {
+            *radarDataPtr_ = radarcube;
+        } else {
+            radarDataPtr_ = std::make_shared<RadarTensor<ComplexFloat>>(radarcube);
+        }
+
+        peak_output.numberDetected = 0;
+        peak_output.points.clear();
+        if (rangeProfilePtr && m_n_samples_ == radarcube.samples() && m_n_chirps_ == radarcube.chirps() && m_n_vrx_ == radarcube.vrx()) {
+            // non coherent combining accumulates into the range-doppler map, peak search only writes the detected cells
+            RadarBeforeCfarPtr->fill(0.0f);
+            for (auto& row : peak_output.RD_peakSearch) {
+                std::fill(row.begin(), row.end(), 0.0f);
+            }
+            return;
+        }
+
+        m_n_samples_ = radarcube.samples();
+        m_n_chirps_ = radarcube.chirps();
+        m_n_vrx_ = radarcube.vrx();
+        // range fft reads unit-stride chirps, doppler fft and doa read unit-stride range bins
+        rangeProfilePtr = std::make_shared<RadarTensor<ComplexFloat>>(m_n_samples_, m_n_chirps_, m_n_vrx_, RadarTensorLayout::ChirpMajor);
+        dopplerProfilePtr = std::make_shared<RadarTensor<ComplexFloat>>(m_n_samples_, m_n_chirps_, m_n_vrx_, RadarTensorLayout::SampleMajor);
+        RadarBeforeCfarPtr = std::make_shared<RadarTensor<float>>(m_n_samples_, m_n_chirps_, 1, RadarTensorLayout::SampleMajor);
+        cfar_output.RD_after_cfar.assign(m_n_samples_, std::vector<float>(m_n_chirps_));
+        peak_output.RD_peakSearch.assign(m_n_samples_, std::vector<float>(m_n_chirps_));
+    }
+
     ~RadarDetection(){};
 
     ComplexFloat getData(int i,int j,int k){
@@ -782,6 +986,12 @@ public:
     std::shared_ptr<pointClouds>& getPCL(){
         return point_clouds;
     }
+    /**
+     * @brief write the detections into `pcl` instead of a newly allocated point cloud
+     */
+    void setPCL(const std::shared_ptr<pointClouds>& pcl){
+        point_clouds = pcl;
+    }
   
 private:
     int frame_id_;
@@ -790,11 +1000,11 @@ private:
     int m_n_chirps_;
     int m_n_vrx_;
 
-    std::shared_ptr<ThreeDimArray<ComplexFloat>> radarDataPtr_;
+    std::shared_ptr<RadarTensor<ComplexFloat>> radarDataPtr_;
 
-    std::shared_ptr<ThreeDimArray<ComplexFloat>> rangeProfilePtr;
-    std::shared_ptr<ThreeDimArray<ComplexFloat>> dopplerProfilePtr;
-    std::shared_ptr<TwoDimArray<float>> RadarBeforeCfarPtr;
+    std::shared_ptr<RadarTensor<ComplexFloat>> rangeProfilePtr;
+    std::shared_ptr<RadarTensor<ComplexFloat>> dopplerProfilePtr;
+    std::shared_ptr<RadarTensor<float>> RadarBeforeCfarPtr;
     RadarDetectionConfig radar_detection_config_;
     RadarBasicConfig radar_basic_config_;
     CfarDetection* cfar_detection;
@@ -803,6 +1013,9 @@ private:
     // pointClouds point_clouds;
     std::shared_ptr<pointClouds> point_clouds;
     FFTAngleEstimation* fft_doa;
+    FFTPlanCache::Ptr fft_plan_cache_;
+    DOAEngine::Ptr doa_engine_;
+    RadarThreadPool::Ptr thread_pool_;
   
 };
 
@@ -0,0 +1,343 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2024 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you (License). Unless the License provides otherwise, you may not
+ * use, modify, copy, publish, distribute, disclose or transmit this software or
+ * the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ */
+
+#ifndef HCE_AI_INF_RADAR_FRAME_POOL_HPP
+#define HCE_AI_INF_RADAR_FRAME_POOL_HPP
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "nodes/radarDatabaseMeta.hpp"
+
+namespace hce {
+
+namespace ai {
+
+namespace inference {
+
+#define RADAR_META_ARENA_DEFAULT_IDLE 8  // released results kept per type when the owner does not size the arena
+#define RADAR_META_ARENA_MAX_TRACKERS 64  // tracks reserved per tracker output, both trackers report at most 64
+
+/**
+ * @brief raw radar ADC frame, shared by reference between the input node and the radar processing nodes
+ *
+ * Downstream nodes should take the frame as `RadarFrame::Ptr` from the hva buffer and only read it through the const view,
+ * copying the pointer never copies the samples.
+ */
+class RadarFrame {
+public:
+    using Ptr = std::shared_ptr<RadarFrame>;
+
+    RadarFrame() {}
+    RadarFrame(const RadarFrame&) = delete;
+    RadarFrame& operator=(const RadarFrame&) = delete;
+
+    /**
+     * @brief resize to `len` samples, the storage is kept across reuses so this only allocates while the pool warms up
+     */
+    ComplexFloat_t* resize(size_t len) {
+        m_samples.resize(len);
+        return m_samples.data();
+    }
+
+    const ComplexFloat_t* data() const {
+        return m_samples.data();
+    }
+    ComplexFloat_t* data() {
+        return m_samples.data();
+    }
+    size_t size() const {
+        return m_samples.size();
+    }
+    bool empty() const {
+        return m_samples.empty();
+    }
+    const radarVec_t& samples() const {
+        return m_samples;
+    }
+
+private:
+    radarVec_t m_samples;
+};
+
+/**
+ * @brief free list of the shared_ptr control blocks of one pool
+ *
+ * Every control block of a pool has the same size, the first released block sets it. Up to `maxIdle` released blocks
+ * are kept, so handing out a recycled object does not allocate a new control block. Thread-safe.
+ */
+class RadarBlockCache {
+public:
+    explicit RadarBlockCache(size_t maxIdle) : m_maxIdle(maxIdle), m_blockSize(0) {
+        m_free.reserve(maxIdle);
+    }
+
+    ~RadarBlockCache() {
+        for (void* block : m_free) {
+            ::operator delete(block);
+        }
+    }
+
+    void* allocate(size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (bytes == m_blockSize && !m_free.empty()) {
+                void* block = m_free.back();
+                m_free.pop_back();
+                return block;
+            }
+        }
+        return ::operator new(bytes);
+    }
+
+    void deallocate(void* block, size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_blockSize == 0) {
+                m_blockSize = bytes;
+            }
+            if (bytes == m_blockSize && m_free.size() < m_maxIdle) {
+                m_free.push_back(block);
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<void*> m_free;
+    size_t m_maxIdle;
+    size_t m_blockSize;
+};
+
+/**
+ * @brief allocator of the shared_ptr control blocks handed out by a RadarObjectPool, backed by a RadarBlockCache
+ */
+template <typename U>
+struct RadarBlockAllocator {
+    using value_type = U;
+
+    explicit RadarBlockAllocator(std::shared_ptr<RadarBlockCache> cache) : m_cache(std::move(cache)) {}
+
+    template <typename V>
+    RadarBlockAllocator(const RadarBlockAllocator<V>& other) : m_cache(other.m_cache) {}
+
+    U* allocate(size_t n) {
+        return static_cast<U*>(m_cache->allocate(n * sizeof(U)));
+    }
+
+    void deallocate(U* p, size_t n) {
+        m_cache->deallocate(p, n * sizeof(U));
+    }
+
+    template <typename V>
+    bool operator==(const RadarBlockAllocator<V>& other) const {
+        return m_cache == other.m_cache;
+    }
+
+    template <typename V>
+    bool operator!=(const RadarBlockAllocator<V>& other) const {
+        return m_cache != other.m_cache;
+    }
+
+    std::shared_ptr<RadarBlockCache> m_cache;  // keeps the cache alive as long as a block of it is in use
+};
+
+/**
+ * @brief pool of objects recycled once the last holder of an object releases it
+ *
+ * Recycled objects are handed out as they were released, containers inside keep their capacity so refilling them does
+ * not allocate. The shared_ptr control blocks are recycled too, a warm pool never calls the heap.
+ * acquire() is thread-safe. Objects may outlive the pool, they are freed instead of recycled in that case.
+ */
+template <typename T>
+class RadarObjectPool : public std::enable_shared_from_this<RadarObjectPool<T>> {
+public:
+    using Ptr = std::shared_ptr<RadarObjectPool<T>>;
+    using Init = std::function<void(T&)>;
+
+    /**
+     * @param maxIdle maximum number of released objects kept for reuse
+     * @param init optional, called once on every newly created object, e.g. to reserve capacity
+     */
+    static Ptr create(size_t maxIdle, Init init = Init()) {
+        return Ptr(new RadarObjectPool<T>(maxIdle, std::move(init)));
+    }
+
+    std::shared_ptr<T> acquire() {
+        T* object = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_idle.empty()) {
+                object = m_idle.back().release();
+                m_idle.pop_back();
+            }
+        }
+        if (!object) {
+            object = new T();
+            if (m_init) {
+                m_init(*object);
+            }
+        }
+        std::weak_ptr<RadarObjectPool<T>> pool = this->shared_from_this();
+        return std::shared_ptr<T>(
+            object,
+            [pool](T* o) {
+                if (auto p = pool.lock()) {
+                    p->release(o);
+                } else {
+                    delete o;
+                }
+            },
+            RadarBlockAllocator<T>(m_blocks));
+    }
+
+    size_t idleCount() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_idle.size();
+    }
+
+private:
+    RadarObjectPool(size_t maxIdle, Init init)
+        : m_maxIdle(maxIdle), m_init(std::move(init)), m_blocks(std::make_shared<RadarBlockCache>(maxIdle)) {
+        m_idle.reserve(maxIdle);
+    }
+
+    void release(T* object) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_idle.size() < m_maxIdle) {
+            m_idle.emplace_back(object);
+        } else {
+            delete object;
+        }
+    }
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<T>> m_idle;
+    size_t m_maxIdle;
+    Init m_init;
+    std::shared_ptr<RadarBlockCache> m_blocks;  // control blocks of the handed out objects
+};
+
+/**
+ * @brief pool of radar frames recycled once the last holder of a frame releases it
+ */
+using RadarFramePool = RadarObjectPool<RadarFrame>;
+
+/**
+ * @brief per node worker arena of the radar results passed downstream: point clouds, cluster reports and tracks
+ *
+ * New objects reserve room for `maxPoints` points, `maxClusters` clusters and RADAR_META_ARENA_MAX_TRACKERS tracks,
+ * objects released by the downstream nodes are refilled in place. Once the arena is warm, producing the results of a frame does not touch the heap, as
+ * long as a frame stays within these limits. Each worker owns its arena, so workers of different radars never
+ * contend on the allocator or on a shared pool lock.
+ */
+class RadarMetaArena {
+public:
+    using Ptr = std::shared_ptr<RadarMetaArena>;
+
+    /**
+     * @param maxIdle released objects kept per type, should cover the frames in flight downstream of the owner
+     */
+    static Ptr create(int maxPoints, int maxClusters, size_t maxIdle = RADAR_META_ARENA_DEFAULT_IDLE) {
+        return Ptr(new RadarMetaArena(std::max(maxPoints, 0), std::max(maxClusters, 0), maxIdle));
+    }
+
+    static Ptr create(const RadarClusteringConfig& config, size_t maxIdle = RADAR_META_ARENA_DEFAULT_IDLE) {
+        return create(config.maxPoints, config.maxClusters, maxIdle);
+    }
+
+    /**
+     * @brief empty point cloud, num is 0 and the arrays keep their capacity
+     */
+    pointClouds::Ptr acquirePointClouds() {
+        pointClouds::Ptr pcl = m_pointClouds->acquire();
+        pcl->num = 0;
+        pcl->rangeIdxArray.clear();
+        pcl->rangeFloat.clear();
+        pcl->speedIdxArray.clear();
+        pcl->speedFloat.clear();
+        pcl->SNRArray.clear();
+        pcl->aoaVar.clear();
+        return pcl;
+    }
+
+    /**
+     * @brief empty clustering output, numCluster is 0 and the arrays keep their capacity
+     */
+    clusteringDBscanOutput::Ptr acquireClusters() {
+        clusteringDBscanOutput::Ptr clusters = m_clusters->acquire();
+        clusters->numCluster = 0;
+        clusters->InputArray.clear();
+        clusters->report.clear();
+        return clusters;
+    }
+
+    /**
+     * @brief empty tracker output, outputInfo keeps its capacity
+     */
+    trackerOutput::Ptr acquireTracks() {
+        trackerOutput::Ptr tracks = m_tracks->acquire();
+        tracks->outputInfo.clear();
+        return tracks;
+    }
+
+    int maxPoints() const {
+        return m_maxPoints;
+    }
+    int maxClusters() const {
+        return m_maxClusters;
+    }
+
+private:
+    RadarMetaArena(int maxPoints, int maxClusters, size_t maxIdle) : m_maxPoints(maxPoints), m_maxClusters(maxClusters) {
+        m_pointClouds = RadarObjectPool<pointClouds>::create(maxIdle, [maxPoints](pointClouds& pcl) {
+            pcl.num = 0;
+            pcl.rangeIdxArray.reserve(maxPoints);
+            pcl.rangeFloat.reserve(maxPoints);
+            pcl.speedIdxArray.reserve(maxPoints);
+            pcl.speedFloat.reserve(maxPoints);
+            pcl.SNRArray.reserve(maxPoints);
+            pcl.aoaVar.reserve(maxPoints);
+        });
+        m_clusters = RadarObjectPool<clusteringDBscanOutput>::create(maxIdle, [maxPoints, maxClusters](clusteringDBscanOutput& clusters) {
+            clusters.numCluster = 0;
+            clusters.InputArray.reserve(maxPoints);
+            clusters.report.reserve(maxClusters);
+        });
+        m_tracks = RadarObjectPool<trackerOutput>::create(maxIdle, [](trackerOutput& tracks) {
+            tracks.outputInfo.reserve(RADAR_META_ARENA_MAX_TRACKERS);
+        });
+    }
+
+    int m_maxPoints;
+    int m_maxClusters;
+    RadarObjectPool<pointClouds>::Ptr m_pointClouds;
+    RadarObjectPool<clusteringDBscanOutput>::Ptr m_clusters;
+    RadarObjectPool<trackerOutput>::Ptr m_tracks;
+};
+
+}  // namespace inference
+
+}  // namespace ai
+
+}  // namespace hce
+
+#endif  // #ifndef HCE_AI_INF_RADAR_FRAME_POOL_HPP
@@ -0,0 +1,108 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2024 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you (License). Unless the License provides otherwise, you may not
+ * use, modify, copy, publish, distribute, disclose or transmit this software or
+ * the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ */
+
+#ifndef HCE_AI_INF_RADAR_FRAME_SEQUENCER_HPP
+#define HCE_AI_INF_RADAR_FRAME_SEQUENCER_HPP
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace hce {
+
+namespace ai {
+
+namespace inference {
+
+/**
+ * @brief re-orders the frames of one stream by frameId
+ *
+ * Upstream radar stages may run with several worker threads, so consecutive frames can finish out of order. The
+ * sequencer holds early frames until every frame before them went through, input nodes number the frames of a stream
+ * from 0. At most `maxPending` frames are held: when a frame never arrives the window is full and the sequencer skips
+ * ahead to the oldest held frame instead of stalling the stream.
+ *
+ * Not thread-safe, owned by the single worker of the stage that needs ordered input.
+ */
+template <typename T>
+class FrameSequencer {
+public:
+    explicit FrameSequencer(size_t maxPending = 16) : m_maxPending(std::max(maxPending, (size_t)1)) {}
+
+    /**
+     * @brief hand a frame in and collect the frames that are now in order
+     * @param ready frames that can be processed, appended in frameId order
+     * @return number of frames skipped because they were missing while the window was full
+     * A frame older than the frames already released is late, it is appended to `late` and never reaches `ready`.
+     */
+    unsigned push(unsigned frameId, T item, std::vector<T>& ready, std::vector<T>& late) {
+        if (frameId < m_next) {
+            late.push_back(std::move(item));
+            return 0;
+        }
+        m_pending.emplace(frameId, std::move(item));
+
+        unsigned skipped = 0;
+        if (m_pending.size() > m_maxPending) {
+            skipped = m_pending.begin()->first - m_next;
+            m_next = m_pending.begin()->first;
+        }
+        auto it = m_pending.begin();
+        while (it != m_pending.end() && it->first == m_next) {
+            ready.push_back(std::move(it->second));
+            it = m_pending.erase(it);
+            m_next++;
+        }
+        return skipped;
+    }
+
+    /**
+     * @brief release every held frame in frameId order regardless of gaps, e.g. at the end of a stream
+     */
+    void flush(std::vector<T>& ready) {
+        for (auto& item : m_pending) {
+            ready.push_back(std::move(item.second));
+            m_next = item.first + 1;
+        }
+        m_pending.clear();
+    }
+
+    void reset() {
+        m_pending.clear();
+        m_next = 0;
+    }
+
+    size_t pending() const {
+        return m_pending.size();
+    }
+
+    unsigned nextFrameId() const {
+        return m_next;
+    }
+
+private:
+    size_t m_maxPending;
+    unsigned m_next = 0;
+    std::map<unsigned, T> m_pending;
+};
+
+}  // namespace inference
+
+}  // namespace ai
+
+}  // namespace hce
+
+#endif  // #ifndef HCE_AI_INF_RADAR_FRAME_SEQUENCER_HPP
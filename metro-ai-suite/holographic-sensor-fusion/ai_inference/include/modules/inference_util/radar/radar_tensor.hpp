@@ -0,0 +1,259 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you (License). Unless the License provides otherwise, you may not
+ * use, modify, copy, publish, distribute, disclose or transmit this software or
+ * the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ */
+
+#ifndef HCE_AI_INF_RADAR_TENSOR_HPP
+#define HCE_AI_INF_RADAR_TENSOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace hce {
+
+namespace ai {
+
+namespace inference {
+
+#define RADAR_TENSOR_ALIGNMENT 64
+
+/**
+ * @brief memory order of the two inner dimensions of a radar tensor, the outermost dimension is always the virtual antenna
+ *
+ * SampleMajor: vrx x sample x chirp, the chirps of one range bin are contiguous (doppler rows)
+ * ChirpMajor:  vrx x chirp x sample, the samples of one chirp are contiguous (range rows)
+ */
+enum class RadarTensorLayout {
+    SampleMajor = 0,
+    ChirpMajor = 1
+};
+
+/**
+ * @brief non-owning 1-D view with an element stride into a radar tensor
+ */
+template <typename T>
+struct RadarTensorView {
+    T* ptr = nullptr;
+    int length = 0;
+    size_t stride = 1;
+
+    inline T& operator[](int i) const {
+        return ptr[i * stride];
+    }
+    int size() const {
+        return length;
+    }
+    bool contiguous() const {
+        return stride == 1;
+    }
+};
+
+/**
+ * @brief dense radar tensor of vrx planes of sample x chirp cells in 64-byte aligned storage
+ *
+ * The virtual antenna is the outermost dimension, the order of the two inner ones is given by RadarTensorLayout.
+ * Copies share the underlying buffer, so a tensor can be passed through hva buffers without copying the frame.
+ * A 2-D map such as the range-doppler spectrum is a tensor with a single virtual antenna.
+ */
+template <typename T>
+class RadarTensor {
+public:
+    using Ptr = std::shared_ptr<RadarTensor>;
+
+    RadarTensor() {}
+
+    RadarTensor(int samples, int chirps, int vrx = 1, RadarTensorLayout layout = RadarTensorLayout::SampleMajor)
+        : m_samples(samples), m_chirps(chirps), m_vrx(vrx), m_layout(layout) {
+        const size_t count = size();
+        if (count > 0) {
+            void* mem = ::operator new(count * sizeof(T), std::align_val_t(RADAR_TENSOR_ALIGNMENT));
+            std::memset(mem, 0, count * sizeof(T));
+            m_data = std::shared_ptr<T>(static_cast<T*>(mem), [](T* p) { ::operator delete(p, std::align_val_t(RADAR_TENSOR_ALIGNMENT)); });
+        }
+    }
+
+    ~RadarTensor() {}
+
+    /**
+     * @brief tensor over memory owned by the caller, which has to outlive every copy of the tensor
+     */
+    static RadarTensor wrap(T* data, int samples, int chirps, int vrx = 1, RadarTensorLayout layout = RadarTensorLayout::SampleMajor) {
+        RadarTensor tensor;
+        tensor.m_samples = samples;
+        tensor.m_chirps = chirps;
+        tensor.m_vrx = vrx;
+        tensor.m_layout = layout;
+        tensor.m_data = std::shared_ptr<T>(data, [](T*) {});
+        return tensor;
+    }
+
+    /**
+     * @brief copy of the tensor which keeps `owner` alive instead of the storage, e.g. the pooled object holding it,
+     * so the owner is only released once the last copy is gone
+     */
+    template <typename U>
+    RadarTensor shareWith(const std::shared_ptr<U>& owner) const {
+        RadarTensor tensor(*this);
+        tensor.m_data = std::shared_ptr<T>(owner, m_data.get());
+        return tensor;
+    }
+
+    int samples() const {
+        return m_samples;
+    }
+    int chirps() const {
+        return m_chirps;
+    }
+    int vrx() const {
+        return m_vrx;
+    }
+    RadarTensorLayout layout() const {
+        return m_layout;
+    }
+    size_t size() const {
+        return (size_t)m_samples * m_chirps * m_vrx;
+    }
+    bool empty() const {
+        return m_data == nullptr;
+    }
+
+    T* data() {
+        return m_data.get();
+    }
+    const T* data() const {
+        return m_data.get();
+    }
+    std::shared_ptr<T> getArray() {
+        return m_data;
+    }
+
+    size_t sampleStride() const {
+        return m_layout == RadarTensorLayout::SampleMajor ? (size_t)m_chirps : 1;
+    }
+    size_t chirpStride() const {
+        return m_layout == RadarTensorLayout::SampleMajor ? 1 : (size_t)m_samples;
+    }
+    size_t vrxStride() const {
+        return (size_t)m_samples * m_chirps;
+    }
+
+    inline size_t offset(int sample, int chirp, int vrx = 0) const {
+        return sample * sampleStride() + chirp * chirpStride() + vrx * vrxStride();
+    }
+
+    inline T& operator()(int sample, int chirp, int vrx = 0) {
+        return m_data.get()[offset(sample, chirp, vrx)];
+    }
+    inline const T& operator()(int sample, int chirp, int vrx = 0) const {
+        return m_data.get()[offset(sample, chirp, vrx)];
+    }
+    inline T at(int sample, int chirp, int vrx = 0) const {
+        return m_data.get()[offset(sample, chirp, vrx)];
+    }
+    inline void setValue(int sample, int chirp, int vrx, T value) {
+        m_data.get()[offset(sample, chirp, vrx)] = value;
+    }
+
+    /**
+     * @brief sample x chirp plane of one virtual antenna, stored in the tensor layout
+     */
+    T* plane(int vrx) {
+        return m_data.get() + vrx * vrxStride();
+    }
+    const T* plane(int vrx) const {
+        return m_data.get() + vrx * vrxStride();
+    }
+
+    /**
+     * @brief all samples of one chirp, unit-stride in ChirpMajor layout
+     */
+    RadarTensorView<T> rangeLine(int chirp, int vrx = 0) {
+        return {m_data.get() + offset(0, chirp, vrx), m_samples, sampleStride()};
+    }
+
+    /**
+     * @brief all chirps of one range bin, unit-stride in SampleMajor layout
+     */
+    RadarTensorView<T> dopplerLine(int sample, int vrx = 0) {
+        return {m_data.get() + offset(sample, 0, vrx), m_chirps, chirpStride()};
+    }
+
+    /**
+     * @brief all virtual antennas of one range-doppler cell
+     */
+    RadarTensorView<T> antennaLine(int sample, int chirp) {
+        return {m_data.get() + offset(sample, chirp, 0), m_vrx, vrxStride()};
+    }
+
+    void fill(T value) {
+        std::fill(m_data.get(), m_data.get() + size(), value);
+    }
+
+private:
+    std::shared_ptr<T> m_data;
+    int m_samples = 0;
+    int m_chirps = 0;
+    int m_vrx = 0;
+    RadarTensorLayout m_layout = RadarTensorLayout::SampleMajor;
+};
+
+/**
+ * @brief cache-blocked out-of-place transpose of a row-major rows x cols matrix into a cols x rows matrix
+ */
+template <typename T>
+void blockedTranspose(const T* src, T* dst, int rows, int cols, int block = 16) {
+    for (int r0 = 0; r0 < rows; r0 += block) {
+        const int r1 = std::min(r0 + block, rows);
+        for (int c0 = 0; c0 < cols; c0 += block) {
+            const int c1 = std::min(c0 + block, cols);
+            for (int r = r0; r < r1; r++) {
+                const T* srcRow = src + (size_t)r * cols;
+                for (int c = c0; c < c1; c++) {
+                    dst[(size_t)c * rows + r] = srcRow[c];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief corner turn of the virtual antenna planes [vrxBegin, vrxEnd) from one layout into the other
+ */
+template <typename T>
+void transposeLayout(const RadarTensor<T>& src, RadarTensor<T>& dst, int vrxBegin, int vrxEnd) {
+    const int rows = src.layout() == RadarTensorLayout::SampleMajor ? src.samples() : src.chirps();
+    const int cols = src.layout() == RadarTensorLayout::SampleMajor ? src.chirps() : src.samples();
+    for (int v = vrxBegin; v < vrxEnd; v++) {
+        blockedTranspose(src.plane(v), dst.plane(v), rows, cols);
+    }
+}
+
+/**
+ * @brief corner turn of every virtual antenna plane from one layout into the other
+ */
+template <typename T>
+void transposeLayout(const RadarTensor<T>& src, RadarTensor<T>& dst) {
+    transposeLayout(src, dst, 0, src.vrx());
+}
+
+}  // namespace inference
+
+}  // namespace ai
+
+}  // namespace hce
+
+#endif  // #ifndef HCE_AI_INF_RADAR_TENSOR_HPP
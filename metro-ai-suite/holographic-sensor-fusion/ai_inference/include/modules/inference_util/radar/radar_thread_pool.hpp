@@ -0,0 +1,198 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2024 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you (License). Unless the License provides otherwise, you may not
+ * use, modify, copy, publish, distribute, disclose or transmit this software or
+ * the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ */
+
+#ifndef HCE_AI_INF_RADAR_THREAD_POOL_HPP
+#define HCE_AI_INF_RADAR_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hce {
+
+namespace ai {
+
+namespace inference {
+
+/**
+ * @brief fixed thread budget for the stages of one radar frame
+ *
+ * The budget counts the calling thread, a pool of n threads starts n - 1 workers and the caller of parallelFor() runs
+ * chunks too, so a budget of 1 runs everything inline on the hva worker thread. Frames still go through the node one
+ * at a time, only the work inside a frame is split, which keeps the frame order the tracker relies on.
+ *
+ * parallelFor() is meant to be called by one thread at a time, each node worker owns its own pool.
+ */
+class RadarThreadPool {
+public:
+    using Ptr = std::shared_ptr<RadarThreadPool>;
+
+    /**
+     * @brief per chunk task, chunk is in [0, numChunks(count)) and [begin, end) is its share of the range
+     */
+    using Task = std::function<void(int chunk, int begin, int end)>;
+
+    explicit RadarThreadPool(int numThreads) : m_numThreads(std::max(numThreads, 1)) {
+        for (int i = 1; i < m_numThreads; i++) {
+            m_workers.emplace_back(&RadarThreadPool::workerLoop, this);
+        }
+    }
+
+    ~RadarThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    RadarThreadPool(const RadarThreadPool&) = delete;
+    RadarThreadPool& operator=(const RadarThreadPool&) = delete;
+
+    int numThreads() const {
+        return m_numThreads;
+    }
+
+    /**
+     * @brief number of chunks parallelFor() splits `count` items into, at least `grain` items per chunk
+     */
+    int numChunks(int count, int grain = 1) const {
+        if (count <= 0) {
+            return 0;
+        }
+        grain = std::max(grain, 1);
+        return std::max(1, std::min(m_numThreads, count / grain));
+    }
+
+    /**
+     * @brief split [0, count) into numChunks(count, grain) contiguous chunks and run them on the pool, returns once
+     * every chunk is done
+     *
+     * Chunk c covers [count * c / n, count * (c + 1) / n), so chunk sizes differ by at most one item.
+     */
+    void parallelFor(int count, const Task& task, int grain = 1) {
+        const int chunks = numChunks(count, grain);
+        if (chunks == 0) {
+            return;
+        }
+        if (chunks == 1) {
+            task(0, 0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = &task;
+            m_count = count;
+            m_chunks = chunks;
+            m_next = 0;
+            m_pending = chunks;
+            m_generation++;
+        }
+        m_wake.notify_all();
+
+        runChunks(&task, count, chunks);
+
+        // workers still holding this job keep it alive, wait for them too so the next job starts clean
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_pending == 0 && m_busy == 0; });
+        m_task = nullptr;
+    }
+
+private:
+    // claim chunks of one job until none is left
+    void runChunks(const Task* task, int count, int chunks) {
+        int finished = 0;
+        int chunk;
+        while ((chunk = m_next.fetch_add(1)) < chunks) {
+            (*task)(chunk, (int)((long)count * chunk / chunks), (int)((long)count * (chunk + 1) / chunks));
+            finished++;
+        }
+        if (finished > 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending -= finished;
+            if (m_pending == 0 && m_busy == 0) {
+                m_done.notify_all();
+            }
+        }
+    }
+
+    void workerLoop() {
+        unsigned seen = 0;
+        while (true) {
+            const Task* task;
+            int count;
+            int chunks;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop) {
+                    return;
+                }
+                seen = m_generation;
+                task = m_task;
+                count = m_count;
+                chunks = m_chunks;
+                if (!task) {
+                    // woke up after the job was already finished by the other threads
+                    continue;
+                }
+                m_busy++;
+            }
+            runChunks(task, count, chunks);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_busy--;
+                if (m_pending == 0 && m_busy == 0) {
+                    m_done.notify_all();
+                }
+            }
+        }
+    }
+
+    const int m_numThreads;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    bool m_stop = false;
+    unsigned m_generation = 0;
+
+    // current job, written under the mutex before the workers are woken up
+    const Task* m_task = nullptr;
+    int m_count = 0;
+    int m_chunks = 0;
+    std::atomic<int> m_next{0};
+    int m_pending = 0;
+    int m_busy = 0;  // workers inside runChunks()
+};
+
+}  // namespace inference
+
+}  // namespace ai
+
+}  // namespace hce
+
+#endif  // #ifndef HCE_AI_INF_RADAR_THREAD_POOL_HPP
@@ -18,6 +18,10 @@
 #define HCE_AI_INF_RADAR_TRACKING_HELPER_HPP
 
 #include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
 #include "inc/api/hvaLogger.hpp"
 // #include "modules/inference_util/radar/radar_detection_helper.hpp"
 #include "modules/inference_util/radar/radar_clustering_helper.hpp"
@@ -114,6 +118,33 @@ typedef struct trackerInternalDataType_
 } trackerInternalDataType;
 
 
+/*************************************************************************************************
+ * @brief  Kalman filter state of a batch of trackers as structure of arrays, lane k holds one tracker.
+ *         Each step runs over all the lanes at once, the lanes of a row are contiguous so the
+ *         compiler maps consecutive trackers onto the SIMD lanes.
+ *************************************************************************************************/
+struct trackerBatchDataType
+{
+    int num;                                                /**< lanes in use */
+    int numHit;                                             /**< lanes [0, numHit) have a measurement, the rest only predict */
+    int tid[CT_MAX_NUM_TRACKER];                            /**< tracker of each lane */
+    alignas(64) float S_hat[4][CT_MAX_NUM_TRACKER];
+    alignas(64) float P[16][CT_MAX_NUM_TRACKER];
+    alignas(64) float C[9][CT_MAX_NUM_TRACKER];
+    alignas(64) float P_apriori[16][CT_MAX_NUM_TRACKER];
+    alignas(64) float S_apriori_hat[4][CT_MAX_NUM_TRACKER];
+    alignas(64) float H_s_apriori_hat[3][CT_MAX_NUM_TRACKER];
+    alignas(64) float measure[3][CT_MAX_NUM_TRACKER];       /**< combined measurement: range, azimuth, doppler */
+    alignas(64) float R[9][CT_MAX_NUM_TRACKER];             /**< measurement noise */
+    // temporaries of the update step
+    alignas(64) float J[12][CT_MAX_NUM_TRACKER];
+    alignas(64) float K[12][CT_MAX_NUM_TRACKER];
+    alignas(64) float temp1[16][CT_MAX_NUM_TRACKER];
+    alignas(64) float temp2[16][CT_MAX_NUM_TRACKER];
+    alignas(64) float temp3[9][CT_MAX_NUM_TRACKER];
+    alignas(64) float invMatrix[9][CT_MAX_NUM_TRACKER];
+};
+
 typedef struct trackerListElement_
 {
     int tid;
@@ -162,6 +193,7 @@ struct clusterTrackerHandle
     trackerInputInternalDataType *inputInfo;
     int *numAssoc;
     float *dist;  // pointer to the distance matrix
+    TrackerAssociationMethod associationMethod;
 };
 
 void tracker_matrixMultiply(int m1, int m2, int m3, float *A, float *B, float *C);
@@ -203,6 +235,30 @@ void clusterTracker_kalmanUpdate(trackerInternalDataType *tracker,
 
 void clusterTracker_kalmanUpdateWithNoMeasure(trackerInternalDataType *tracker, float *F, float *Q);
 
+/**
+ * @brief prediction of all the lanes: S_apriori_hat = F * S_hat and its range, azimuth and doppler
+ */
+void clusterTracker_batchTimeUpdate(trackerBatchDataType *batch, float *F);
+
+/**
+ * @brief kalman update of all the lanes, lanes [0, numHit) as clusterTracker_kalmanUpdate() with their measurement,
+ * the other lanes as clusterTracker_kalmanUpdateWithNoMeasure()
+ */
+void clusterTracker_batchKalmanUpdate(trackerBatchDataType *batch, float *F, float *Q);
+
+template <typename T>
+class HungarianOptimizer;
+
+/**
+ * @brief measurement / tracker pair that passed the association gate
+ */
+struct clusterTrackerAssocEdge
+{
+    int mid;     /**< measurement index */
+    int slot;    /**< position of the tracker in the active tracker list */
+    float dist;  /**< association distance */
+};
+
 
 class ClusterTracker {
   public:
@@ -255,7 +311,7 @@ class ClusterTracker {
 
     void clusterTracker_updateTrackerStateMachine(trackerInternalDataType *tracker, bool hitFlag);
 
-    void clusterTracker_updateTrackers(float *scratchPad);
+    void clusterTracker_updateTrackers();
 
     void clusterTracker_reportTrackers(trackerOutput *output);
 
@@ -264,8 +320,52 @@ class ClusterTracker {
                                           std::vector<trackerInputDataType> &inputInfo,
                                           // std::vector<trackerInputInternalDataType> &internalInputInfo
                                           trackerInputInternalDataType *internalInputInfo);
+
+    /**
+     * @brief collect the measurement / tracker pairs within the association threshold of the tracker into m_assocEdges
+     *
+     * Trackers are sorted by predicted range, the squared distance of a pair is at least the square of their range
+     * difference, so each measurement only tests the trackers inside a range band around it.
+     */
+    void clusterTracker_gateCandidates();
+
+    /**
+     * @brief one-to-one assignment of the measurements and trackers of one connected group of gated pairs
+     * @param begin, end range of m_assocEdges holding the group
+     */
+    void clusterTracker_assignComponent(size_t begin, size_t end);
+
+    int clusterTracker_findRoot(int node);
+
+    // scratch of the gated association, kept across frames so a warm tracker does not allocate
+    std::vector<int> m_activeTids;                     // tid per slot, slots follow the active tracker list
+    std::vector<float> m_assocGate;                    // association threshold per slot
+    std::vector<std::pair<float, int>> m_rangeOrder;   // (predicted range, slot) sorted by range
+    std::vector<clusterTrackerAssocEdge> m_assocEdges; // gated pairs, grouped by connected component
+    std::vector<int> m_nearestSlot;                    // nearest gated tracker per measurement, -1 if none
+    std::vector<int> m_matchedSlot;                    // tracker assigned per measurement, -1 if none
+    std::vector<int> m_assocParent;                    // union-find over measurements then slots
+    std::vector<int> m_localIndex;                     // row / column of a node inside the current component
+    std::vector<int> m_localMeas;
+    std::vector<int> m_localSlots;
+    std::vector<float> m_assocCosts;                   // flat row-major cost buffer of the current component
+    std::vector<std::pair<size_t, size_t>> m_assignments;
+    std::unique_ptr<HungarianOptimizer<float>> m_optimizer;
+
+    std::unique_ptr<trackerBatchDataType> m_batch;                       // kalman lanes of the active trackers
+    trackerInputInternalDataType m_combinedInput[CT_MAX_NUM_TRACKER];   // combined measurement per hit lane
 };
 
+/**
+ * @brief read the optional "associationMethod" of one RadarTrackingConfig entry, config keeps its method when absent
+ */
+inline void readTrackerAssociationMethod(const nlohmann::json &items, RadarTrackingConfig &config)
+{
+    if (items.contains("associationMethod")) {
+        config.associationMethod = items.at("associationMethod").get<TrackerAssociationMethod>();
+    }
+}
+
 }  // namespace inference
 
 }  // namespace ai
@@ -21,6 +21,8 @@
 #include "inc/util/hvaConfigStringParser.hpp"
 #include "inc/util/hvaUtil.hpp"
 #include "modules/inference_util/fusion/data_fusion_helper.hpp"
+#include "modules/inference_util/fusion/fusion_output_pool.hpp"
+#include "modules/inference_util/fusion/sensor_synchronizer.hpp"
 
 #define CAMERA_2CFUSION_MODULE_INPORT_NUM 3
 
@@ -85,7 +87,9 @@ class Camera2CFusionNodeWorker : public hva::hvaNodeWorker_t {
                              const std::string &homographyMatrixFilePath,
                              const std::vector<int> &pclConstraints,
                              const int32_t &inMediaNum,
-                             const camera2CFusionInPortsInfo_t &camera2CFusionInPortsInfo);
+                             const camera2CFusionInPortsInfo_t &camera2CFusionInPortsInfo,
+                             const SensorSyncConfig &syncConfig,
+                             const FusionOutputPool::Ptr &fusionOutputPool);
 
     virtual ~Camera2CFusionNodeWorker();
 
@@ -103,6 +107,17 @@ class Camera2CFusionNodeWorker : public hva::hvaNodeWorker_t {
      */
     virtual void process(std::size_t batchIdx) override;
 
+    /**
+     * @brief Called by hva framework once after the last process(), releases the frames still queued for synchronisation
+     * @param batchIdx Internal parameter handled by hvaframework
+     */
+    virtual void processByLastRun(std::size_t batchIdx) override;
+
+    /**
+     * @brief Forgets the frames queued for synchronisation
+     */
+    virtual hva::hvaStatus_t reset() override;
+
   private:
     class Impl;
     std::unique_ptr<Impl> m_impl;
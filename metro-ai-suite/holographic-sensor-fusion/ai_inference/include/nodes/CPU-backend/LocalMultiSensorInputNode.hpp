@@ -26,8 +26,10 @@
 
 #include "nodes/databaseMeta.hpp"
 #include "nodes/radarDatabaseMeta.hpp"
+#include "modules/inference_util/radar/radar_frame_pool.hpp"
 
 #define MULTI_SENSOR_INPUT_NUM 2
+#define RADAR_FRAME_POOL_DEFAULT_IDLE 8  // idle radar frames kept for reuse when InputCapacity is not set
 
 namespace hce{
 
@@ -38,7 +40,7 @@ namespace inference{
 struct MultiDatasetField_t {
   std::string imageContent;
   size_t imageSize = 0;
-  radarVec_t radarContent;
+  RadarFrame::Ptr radarContent;
   size_t radarSize = 0;
 };
 
@@ -107,6 +109,7 @@ private:
     float m_frameRate;
     std::string m_controlType;
     int m_workStreamId;
+    RadarFramePool::Ptr m_radarFramePool;  // radar frames are recycled once every downstream node released them
 };
 
 }
@@ -21,6 +21,7 @@
 #include "inc/util/hvaConfigStringParser.hpp"
 #include "inc/util/hvaUtil.hpp"
 #include "modules/inference_util/radar/radar_clustering_helper.hpp"
+#include "modules/inference_util/radar/radar_frame_pool.hpp"
 // #include "modules/inference_util/radar/radar_detection_helper.hpp"
 
 namespace hce {
@@ -24,6 +24,7 @@
 #include <inc/api/hvaPipeline.hpp>
 #include <inc/util/hvaConfigStringParser.hpp>
 #include "modules/inference_util/radar/radar_detection_helper.hpp"
+#include "modules/inference_util/radar/radar_frame_pool.hpp"
 namespace hce{
 
 namespace ai{
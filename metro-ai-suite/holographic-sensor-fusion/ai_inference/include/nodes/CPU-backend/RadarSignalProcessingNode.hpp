@@ -27,6 +27,7 @@
 #include <boost/property_tree/json_parser.hpp>
 #include "modules/inference_util/radar/radar_config_parser.hpp"
 #include "modules/inference_util/radar/libradar_helper.hpp"
+#include "modules/inference_util/radar/radar_admission_controller.hpp"
 namespace hce{
 
 namespace ai{
@@ -73,7 +74,10 @@ private:
 
 class RadarSignalProcessingNodeWorker : public hva::hvaNodeWorker_t{
 public:
-    RadarSignalProcessingNodeWorker(hva::hvaNode_t* parentNode, RadarConfigParam m_radar_config);
+    /**
+     * @param admissionConfig latency objective and load shedding limits of the worker
+     */
+    RadarSignalProcessingNodeWorker(hva::hvaNode_t* parentNode, RadarConfigParam m_radar_config, const RadarAdmissionConfig& admissionConfig);
 
     virtual ~RadarSignalProcessingNodeWorker() override;
 
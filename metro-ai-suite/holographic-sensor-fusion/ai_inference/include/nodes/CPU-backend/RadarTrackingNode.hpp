@@ -22,6 +22,8 @@
 #include "inc/util/hvaUtil.hpp"
 #include "modules/inference_util/radar/radar_tracking_helper.hpp"
 
+#define RADAR_TRACKING_MAX_REORDER_FRAMES 16  // default of "MaxReorderFrames"
+
 namespace hce {
 
 namespace ai {
@@ -67,7 +69,10 @@ class RadarTrackingNode : public hva::hvaNode_t {
 
 class RadarTrackingNodeWorker : public hva::hvaNodeWorker_t {
   public:
-    RadarTrackingNodeWorker(hva::hvaNode_t *parentNode);
+    /**
+     * @param maxReorderFrames frames held back per stream while an earlier frame is still in flight
+     */
+    RadarTrackingNodeWorker(hva::hvaNode_t *parentNode, size_t maxReorderFrames);
 
     virtual ~RadarTrackingNodeWorker();
 
@@ -85,6 +90,17 @@ class RadarTrackingNodeWorker : public hva::hvaNodeWorker_t {
      */
     virtual void process(std::size_t batchIdx) override;
 
+    /**
+     * @brief Called by hva framework once after the last process(), tracks the frames still held back for reordering
+     * @param batchIdx Internal parameter handled by hvaframework
+     */
+    virtual void processByLastRun(std::size_t batchIdx) override;
+
+    /**
+     * @brief Tracks the frames still held back for reordering and forgets the streams
+     */
+    virtual hva::hvaStatus_t reset() override;
+
   private:
     class Impl;
     std::unique_ptr<Impl> m_impl;
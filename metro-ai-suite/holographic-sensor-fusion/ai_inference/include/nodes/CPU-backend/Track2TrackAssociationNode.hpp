@@ -33,6 +33,19 @@ class Track2TrackAssociationNode : public hva::hvaNode_t {
 
     virtual ~Track2TrackAssociationNode();
 
+    /**
+     * @brief Parse params, called by hva framework right after node instantiate.
+     * @param config Configure string required by this node.
+     * @return hva status
+     */
+    virtual hva::hvaStatus_t configureByString(const std::string &config) override;
+
+    /**
+     * @brief do nothing in this node, place holder
+     * @return hva status
+     */
+    virtual hva::hvaStatus_t validateConfiguration() const override;
+
     /**
      * @brief Constructs and returns a node worker instance:
      * Track2TrackAssociationNodeWorker.
@@ -53,7 +66,11 @@ class Track2TrackAssociationNode : public hva::hvaNode_t {
 
 class Track2TrackAssociationNodeWorker : public hva::hvaNodeWorker_t {
   public:
-    Track2TrackAssociationNodeWorker(hva::hvaNode_t *parentNode);
+    /**
+     * @param costThreshold radar / camera pairs at or above this 1 - CIoU are never associated
+     * @param trackMode keep the radar / camera track pairs across frames instead of associating every frame anew
+     */
+    Track2TrackAssociationNodeWorker(hva::hvaNode_t *parentNode, float costThreshold, bool trackMode);
 
     virtual ~Track2TrackAssociationNodeWorker();
 
@@ -17,6 +17,7 @@
 
 #include <vector>
 #include <complex>
+#include <memory>
 #include "common/common.hpp"
 #include "inc/buffer/hvaVideoFrameWithROIBuf.hpp"
 
@@ -38,7 +39,7 @@ typedef std::vector<ComplexFloat_t> radarVec_t;
  * #include <inc/buffer/hvaVideoFrameWithMetaROIBuf.hpp>
  *
  * > define buffer
- * hva::hvaVideoFrameWithMetaROIBuf::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf::make_buffer<ThreeDimArray<ComplexFloat>>(*test_matrix, radar_frame_size);
+ * hva::hvaVideoFrameWithMetaROIBuf::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf::make_buffer<RadarTensor<ComplexFloat>>(*test_matrix, radar_frame_size);
  *
  * > frame-level
  * //
@@ -66,9 +67,9 @@ typedef std::vector<ComplexFloat_t> radarVec_t;
  * hvabuf->rois.push_back(roi);
  * for(unsigned i_roi = 0; i_roi < hvabuf->rois.size(); ++i_roi){
  *     hva::hvaMetaROI_t _get_roi = hvabuf->rois[i_roi];
- *     if(_get_roi.containMeta<trackerOutput>()) {
+ *     if(_get_roi.containMeta<trackerOutput::Ptr>()) {
  *         // success
- *         trackerOutput _get_tracker_output;
+ *         trackerOutput::Ptr _get_tracker_output;
  *         _get_roi.getMeta(_get_tracker_output)
  *         // now you get the exact values passing from previous node: _get_tracker_output
  *     }
@@ -88,6 +89,12 @@ enum WinType { Hanning = 1, Hamming = 2, Cheyshev = 3 };
 enum AoaEstimationType { FFT = 1, MUSIC = 2, DBF = 3, CAPON = 4 };
 
 enum CfarMethod { CA_CFAR = 1, SO_CFAR = 2, GO_CFAR = 3, OS_CFAR = 4 };
+// how the cfar training window is formed near the ends of a row
+// truncated: one-sided window with a scaled threshold, cyclic: the window wraps around the row
+enum CfarEdgeMode { CFAR_EDGE_TRUNCATED = 0, CFAR_EDGE_CYCLIC = 1 };
+// how the cluster tracker pairs clusters with trackers
+// nearest: every cluster joins its nearest tracker, global: gated one-to-one assignment solved per group of conflicting pairs
+enum TrackerAssociationMethod { ASSOCIATION_NEAREST = 0, ASSOCIATION_GLOBAL = 1 };
 
 struct RadarBasicConfig
 {
@@ -117,6 +124,9 @@ struct RadarDetectionConfig
     float RangePfa;                            // desired false alarm rate.
     int RangeWinGuardLen;                      // number of range cfar guard cells
     int RangeWinTrainLen;                      // number of range cfar training cells
+    CfarEdgeMode m_doppler_cfar_edge_ = CFAR_EDGE_TRUNCATED;  // enum, doppler cfar edge handling, optional "DopplerCfarEdge"
+    CfarEdgeMode m_range_cfar_edge_ = CFAR_EDGE_TRUNCATED;    // enum, range cfar edge handling, optional "RangeCfarEdge"
+    int m_num_threads_ = 1;                                   // intra-frame thread budget of this radar, optional "NumThreads"
 };
 
 struct RadarClusteringConfig
@@ -135,6 +145,7 @@ struct RadarTrackingConfig
     float iirForgetFactor;              // IIR filter forgettting factor
     int trackerActiveThreshold;         // counter threshold for tracker  to turn from detect to active.
     int trackerForgetThreshold;         // counter threshold for tracker to turn from active to expire.
+    TrackerAssociationMethod associationMethod = ASSOCIATION_GLOBAL;  // enum, cluster to tracker association, optional "associationMethod"
 };
 
 struct RadarConfigParam
@@ -155,6 +166,8 @@ struct RadarConfigParam
 
 struct pointClouds
 {
+    using Ptr = std::shared_ptr<pointClouds>;
+
     int num;
     std::vector<int> rangeIdxArray;
     std::vector<float> rangeFloat;
@@ -188,6 +201,8 @@ struct clusteringDBscanReport
 // Structure of clusrering output
 struct clusteringDBscanOutput
 {
+    using Ptr = std::shared_ptr<clusteringDBscanOutput>;
+
     // int *InputArray;                                         // clustering result index array
     std::vector<int> InputArray;  // clustering result index array
     int numCluster;               // number of cluster detected
@@ -214,6 +229,8 @@ struct trackerOutputDataType
 
 class trackerOutput {
   public:
+    using Ptr = std::shared_ptr<trackerOutput>;
+
     // int totalNumOfOutput;
     // trackerOutputDataType* outputInfo;
     std::vector<trackerOutputDataType> outputInfo;
@@ -230,6 +247,43 @@ struct BBox
     BBox(float x_ = 0.0f, float y_ = 0.0f, float width_ = 0.0f, float height_ = 0.0f) : x(x_), y(y_), width(width_), height(height_) {}
 };
 
+/**
+ * @brief fixed number of flags, one bit each
+ * reset() keeps the allocated words, so a reused set does not allocate once it has held as many flags
+ */
+class FusionBitset {
+  public:
+    void reset(size_t size)
+    {
+        m_size = size;
+        m_words.assign((size + 63) / 64, 0);
+    }
+
+    void reserve(size_t size)
+    {
+        m_words.reserve((size + 63) / 64);
+    }
+
+    void set(size_t index)
+    {
+        m_words[index >> 6] |= (uint64_t)1 << (index & 63);
+    }
+
+    bool test(size_t index) const
+    {
+        return (m_words[index >> 6] >> (index & 63)) & 1;
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+  private:
+    std::vector<uint64_t> m_words;
+    size_t m_size = 0;
+};
+
 /*************************************************************************************************
  * @brief Radar-Media fusion processing related meta data: coordinateTransformationOutput
  *************************************************************************************************/
@@ -239,7 +293,8 @@ class coordinateTransformationOutput {
     std::vector<trackerOutputDataType> m_radarOutput;
 
     std::vector<BBox> m_cameraRadarCoords;
-    std::vector<std::vector<uint8_t>> m_isAssociated;
+    FusionBitset m_isAssociated;  // radar r and camera c are associated if bit r * m_cameraSize + c is set
+    size_t m_cameraSize = 0;
     std::vector<int32_t> m_radarAssociatedCameraIndex;
 
   public:
@@ -251,8 +306,8 @@ class coordinateTransformationOutput {
         : m_cameraRois(rois), m_radarOutput(radarOutput)
     {
         if (0 != cameraSize && 0 != radarSize) {
-            std::vector<uint8_t> temp(cameraSize, 0);
-            m_isAssociated.resize(radarSize, temp);
+            m_cameraSize = cameraSize;
+            m_isAssociated.reset(radarSize * cameraSize);
             m_radarAssociatedCameraIndex.resize(radarSize, -1);
         }
     }
@@ -265,25 +320,45 @@ class coordinateTransformationOutput {
         // for camera radar coordinates
         m_cameraRadarCoords.push_back(std::move(box));
     }
+
+    void setAssociated(size_t radarIdx, size_t cameraIdx)
+    {
+        m_isAssociated.set(radarIdx * m_cameraSize + cameraIdx);
+    }
+
+    bool isAssociated(size_t radarIdx, size_t cameraIdx) const
+    {
+        return m_isAssociated.test(radarIdx * m_cameraSize + cameraIdx);
+    }
 };
 struct DetectedObject
 {
     BBox bbox;  // can be camera pixel roi or bev roi
     float confidence = 0.0f;
     std::string label = "";
+    int32_t cameraId = -1;    // camera the detection comes from, -1 if unknown
+    uint32_t trackingId = 0;  // camera tracker id, 0 if untracked
 
-    DetectedObject() : bbox(), confidence(0.0f), label("dummy") {}
+    DetectedObject() : bbox(), confidence(0.0f), label("dummy"), cameraId(-1), trackingId(0) {}
 
-    DetectedObject(const BBox &bbox_, float confidence_ = 0.0f, const std::string &label_ = "dummy") : bbox(bbox_), confidence(confidence_), label(label_) {}
+    DetectedObject(const BBox &bbox_, float confidence_ = 0.0f, const std::string &label_ = "dummy", int32_t cameraId_ = -1, uint32_t trackingId_ = 0)
+        : bbox(bbox_), confidence(confidence_), label(label_), cameraId(cameraId_), trackingId(trackingId_)
+    {}
 };
 
 struct FusionBBox
 {
     trackerOutputDataType radarOutput;  // radar output
     DetectedObject det;                 // corresponding camera detections after fusion, no value if no corresponding camera detections
-    FusionBBox() : radarOutput(), det() {}
+    float associationConfidence;        // confidence of the radar / camera association in [0, 1], 0 if not associated
+    FusionBBox() : radarOutput(), det(), associationConfidence(0.0f) {}
 };
 
+/**
+ * @brief radar & camera fusion result of one frame
+ * fusion nodes hand it downstream as FusionOutput::Ptr from a FusionOutputPool, reset() clears it for the next frame
+ * and keeps the capacity of every member
+ */
 class FusionOutput {
   public:
     int32_t m_numOfCams;
@@ -291,9 +366,9 @@ class FusionOutput {
     std::vector<std::vector<BBox>> m_cameraRadarCoords;    // the radar roi of corresponding camera detections
     std::vector<trackerOutputDataType> m_radarOutput;      // original radar output
 
-    std::vector<DetectedObject> m_cameraFusionRadarCoords;      // the radar coordinates of fusion camera detections
-    std::vector<int8_t> m_cameraFusionRadarCoordsIsAssociated;  // whether the radar coordinates of fusion camera detections is associated with radar
-    std::vector<FusionBBox> m_fusionBBox;                       // final radar&camera fusion results
+    std::vector<DetectedObject> m_cameraFusionRadarCoords;  // the radar coordinates of fusion camera detections
+    FusionBitset m_cameraFusionRadarCoordsIsAssociated;     // whether the radar coordinates of fusion camera detections is associated with radar
+    std::vector<FusionBBox> m_fusionBBox;                   // final radar&camera fusion results
 
   public:
     using Ptr = std::shared_ptr<FusionOutput>;
@@ -310,7 +385,40 @@ class FusionOutput {
         m_cameraRadarCoords.resize(m_numOfCams);
     }
 
-    void addCameraROI(int32_t cameraID, std::vector<hva::hvaROI_t> &rois, std::vector<BBox> &bbox)
+    /**
+     * @brief reserve room for a frame of up to roisPerCamera detections per camera and numOfTracks radar tracks
+     */
+    void reserve(size_t roisPerCamera, size_t numOfTracks)
+    {
+        for (int32_t i = 0; i < m_numOfCams; ++i) {
+            m_cameraRois[i].reserve(roisPerCamera);
+            m_cameraRadarCoords[i].reserve(roisPerCamera);
+        }
+        m_radarOutput.reserve(numOfTracks);
+        m_cameraFusionRadarCoords.reserve(roisPerCamera * m_numOfCams);
+        m_cameraFusionRadarCoordsIsAssociated.reserve(roisPerCamera * m_numOfCams);
+        m_fusionBBox.reserve(numOfTracks);
+    }
+
+    /**
+     * @brief empty every member for a new frame of numOfCams cameras
+     */
+    void reset(int32_t numOfCams)
+    {
+        m_numOfCams = numOfCams;
+        m_cameraRois.resize(m_numOfCams);
+        m_cameraRadarCoords.resize(m_numOfCams);
+        for (int32_t i = 0; i < m_numOfCams; ++i) {
+            m_cameraRois[i].clear();
+            m_cameraRadarCoords[i].clear();
+        }
+        m_radarOutput.clear();
+        m_cameraFusionRadarCoords.clear();
+        m_cameraFusionRadarCoordsIsAssociated.reset(0);
+        m_fusionBBox.clear();
+    }
+
+    void addCameraROI(int32_t cameraID, const std::vector<hva::hvaROI_t> &rois, const std::vector<BBox> &bbox)
     {
         m_cameraRois[cameraID] = rois;
         m_cameraRadarCoords[cameraID] = bbox;
@@ -319,10 +427,15 @@ class FusionOutput {
     void setCameraFusionRadarCoords(std::vector<DetectedObject> &cameraFusionRadarCoords)
     {
         m_cameraFusionRadarCoords = cameraFusionRadarCoords;
-        m_cameraFusionRadarCoordsIsAssociated.resize(cameraFusionRadarCoords.size());
-        for (int32_t i = 0; i < cameraFusionRadarCoords.size(); ++i) {
-            m_cameraFusionRadarCoordsIsAssociated[i] = 0;
-        }
+        m_cameraFusionRadarCoordsIsAssociated.reset(cameraFusionRadarCoords.size());
+    }
+
+    /**
+     * @brief mark every fusion camera detection as not associated, after m_cameraFusionRadarCoords was filled in place
+     */
+    void resetCameraFusionAssociation()
+    {
+        m_cameraFusionRadarCoordsIsAssociated.reset(m_cameraFusionRadarCoords.size());
     }
 
     void setRadarOutput(std::vector<trackerOutputDataType> &radarOutput)
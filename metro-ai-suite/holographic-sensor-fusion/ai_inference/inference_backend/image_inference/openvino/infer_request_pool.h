@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <openvino/openvino.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+// Infer requests of one compiled model, shared by every OpenVINOImageInference running the model.
+//
+// A user leases a request for one batch and releases it once the batch is inferred. Requests are granted in the order
+// they were asked for, except that a user holding its fair share (pool size / users, rounded up) is passed over while
+// a user below its share waits, so one busy pipeline cannot starve the others.
+// A user may hold a partially filled batch for a while, the pool therefore keeps at least one request per user.
+class InferRequestPool {
+  public:
+    using CompletionCallback = std::function<void(std::exception_ptr)>;
+
+    InferRequestPool(const ov::CompiledModel &compiled_model, size_t size) : compiled_model_(compiled_model) {
+        for (size_t i = 0; i < size; i++) {
+            add_slot();
+        }
+    }
+
+    // NO COPY
+    InferRequestPool(const InferRequestPool &) = delete;
+    InferRequestPool &operator=(const InferRequestPool &) = delete;
+
+    size_t size() {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return slots_.size();
+    }
+
+    void attach(const void *user) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        held_.emplace(user, 0);
+        while (slots_.size() < held_.size()) {
+            add_slot();
+        }
+        grant();
+    }
+
+    void detach(const void *user) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        held_.erase(user);
+        grant();
+    }
+
+    // Blocks until a request is granted to the user, callback is called at the end of every inference started on it
+    size_t acquire(const void *user, CompletionCallback callback) {
+        std::unique_lock<std::mutex> lk(mutex_);
+        Waiter waiter{user, -1};
+        waiters_.push_back(&waiter);
+        grant();
+        granted_.wait(lk, [&waiter] { return waiter.slot >= 0; });
+        slots_[waiter.slot].callback = std::move(callback);
+        return static_cast<size_t>(waiter.slot);
+    }
+
+    // One synchronous inference on zeroed inputs per request, the completion callbacks are not called.
+    // Dynamic inputs are sized to their upper bound. Only call it while no request is leased.
+    void warm_up() {
+        std::lock_guard<std::mutex> lk(mutex_);
+        for (auto &slot : slots_) {
+            for (const auto &input : compiled_model_.inputs()) {
+                const ov::PartialShape &shape = input.get_partial_shape();
+                ov::Tensor tensor;
+                if (shape.is_static()) {
+                    tensor = slot.request.get_tensor(input);
+                } else {
+                    if (!shape.rank().is_static())
+                        throw std::runtime_error("input " + input.get_any_name() + " has a dynamic rank");
+                    for (const auto &dim : shape) {
+                        if (!dim.get_interval().has_upper_bound())
+                            throw std::runtime_error("input " + input.get_any_name() + " has an unbounded dimension");
+                    }
+                    tensor = ov::Tensor(input.get_element_type(), shape.get_max_shape());
+                    slot.request.set_tensor(input, tensor);
+                }
+                std::memset(tensor.data(), 0, tensor.get_byte_size());
+            }
+            slot.request.infer();
+        }
+    }
+
+    ov::InferRequest request(size_t slot) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return slots_[slot].request;
+    }
+
+    // May be called from the completion callback of the request
+    void release(const void *user, size_t slot) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        slots_[slot].callback = nullptr;
+        auto it = held_.find(user);
+        if (it != held_.end() && it->second > 0)
+            it->second--;
+        free_.push_back(slot);
+        grant();
+    }
+
+  private:
+    struct Slot {
+        ov::InferRequest request;
+        CompletionCallback callback;
+    };
+
+    struct Waiter {
+        const void *user;
+        int slot;
+    };
+
+    // mutex_ is held by the caller
+    void add_slot() {
+        const size_t index = slots_.size();
+        slots_.emplace_back();
+        slots_[index].request = compiled_model_.create_infer_request();
+        // the request keeps this callback for its lifetime, the lessee's callback is looked up per completion
+        slots_[index].request.set_callback([this, index](std::exception_ptr ex) {
+            CompletionCallback callback;
+            {
+                std::lock_guard<std::mutex> lk(mutex_);
+                callback = slots_[index].callback;
+            }
+            if (callback)
+                callback(ex);
+        });
+        free_.push_back(index);
+    }
+
+    // mutex_ is held by the caller
+    void grant() {
+        bool granted = false;
+        while (!free_.empty() && !waiters_.empty()) {
+            const size_t users = std::max<size_t>(held_.size(), 1);
+            const size_t fair_share = (slots_.size() + users - 1) / users;
+            auto it = std::find_if(waiters_.begin(), waiters_.end(), [&](const Waiter *waiter) {
+                auto held = held_.find(waiter->user);
+                return held == held_.end() || held->second < fair_share;
+            });
+            if (it == waiters_.end())
+                it = waiters_.begin();
+
+            (*it)->slot = static_cast<int>(free_.front());
+            free_.pop_front();
+            held_[(*it)->user]++;
+            waiters_.erase(it);
+            granted = true;
+        }
+        if (granted)
+            granted_.notify_all();
+    }
+
+    ov::CompiledModel compiled_model_;
+    std::deque<Slot> slots_; // references stay valid while the pool grows
+    std::deque<size_t> free_;
+    std::deque<Waiter *> waiters_;
+    std::map<const void *, size_t> held_; // requests leased per attached user
+    std::mutex mutex_;
+    std::condition_variable granted_;
+};
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include "inference_backend/input_image_layer_descriptor.h"
+
+#include <algorithm>
+#include <cstddef>
+
+// model_proc resize and padding folded into the model by the IE pre-processor.
+//
+// The image is resized into the model input less `stride` on each side, keeping its aspect ratio or not, and centered
+// in the model input. This is what CustomImageConvert() of the OpenCV pre-processor does without crop.
+struct Letterbox {
+    bool enabled = false;
+    bool keep_aspect_ratio = false;
+    size_t model_w = 0;
+    size_t model_h = 0;
+    size_t stride_x = 0; // border kept on each side of the resized image
+    size_t stride_y = 0;
+
+    // Image resized into the letterbox
+    struct Resized {
+        bool resized = false; // false when the image already has the target size
+        double scale_x = 1;
+        double scale_y = 1;
+        size_t width = 0;
+        size_t height = 0;
+    };
+
+    size_t target_w() const {
+        return model_w - 2 * stride_x;
+    }
+    size_t target_h() const {
+        return model_h - 2 * stride_y;
+    }
+
+    // The scales are computed in double and the resized size truncated, as CustomImageConvert() does with cv::Size
+    Resized resize(size_t image_width, size_t image_height) const {
+        Resized r;
+        r.width = image_width;
+        r.height = image_height;
+        if (image_width == target_w() && image_height == target_h())
+            return r;
+        r.resized = true;
+        r.scale_x = static_cast<double>(target_w()) / image_width;
+        r.scale_y = static_cast<double>(target_h()) / image_height;
+        if (keep_aspect_ratio)
+            r.scale_x = r.scale_y = std::min(r.scale_x, r.scale_y);
+        r.width = static_cast<size_t>(image_width * r.scale_x);
+        r.height = static_cast<size_t>(image_height * r.scale_y);
+        return r;
+    }
+};
+
+// Resize and padding of the letterbox for an image, reported as the OpenCV pre-processor reports them
+inline void letterbox_transform(const Letterbox &lb, size_t image_width, size_t image_height,
+                                InferenceBackend::ImageTransformationParams &info) {
+    const Letterbox::Resized r = lb.resize(image_width, image_height);
+    if (r.resized)
+        info.ResizeHasDone(r.scale_x, r.scale_y);
+    info.PaddingHasDone((lb.model_w - r.width) / 2, (lb.model_h - r.height) / 2);
+}
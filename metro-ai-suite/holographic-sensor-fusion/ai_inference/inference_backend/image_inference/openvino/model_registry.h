@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Process-wide registry of compiled models, keyed by everything that goes into compiling a model.
+//
+// Every user of a key gets the same model, which is created on the first acquire() and destroyed when its last user
+// drops it. Creating a model only blocks the users of the same key.
+template <class Model>
+class ModelRegistry {
+  public:
+    using Factory = std::function<std::shared_ptr<Model>()>;
+
+    static ModelRegistry &instance() {
+        static ModelRegistry registry;
+        return registry;
+    }
+
+    std::shared_ptr<Model> acquire(const std::string &key, const Factory &create) {
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            // forget evicted models nobody is creating again
+            for (auto it = entries_.begin(); it != entries_.end();) {
+                if (it->second.use_count() == 1 && it->second->model.expired())
+                    it = entries_.erase(it);
+                else
+                    ++it;
+            }
+            auto &slot = entries_[key];
+            if (!slot)
+                slot = std::make_shared<Entry>();
+            entry = slot;
+        }
+
+        std::lock_guard<std::mutex> lk(entry->mutex);
+        std::shared_ptr<Model> model = entry->model.lock();
+        if (!model) {
+            model = create();
+            entry->model = model;
+        }
+        return model;
+    }
+
+  private:
+    ModelRegistry() = default;
+    ModelRegistry(const ModelRegistry &) = delete;
+    ModelRegistry &operator=(const ModelRegistry &) = delete;
+
+    struct Entry {
+        std::mutex mutex;
+        std::weak_ptr<Model> model;
+    };
+
+    std::map<std::string, std::shared_ptr<Entry>> entries_;
+    std::mutex mutex_;
+};
@@ -6,6 +6,7 @@
 
 // #include "dlstreamer_logger.h"
 
+#include <openvino/opsets/opset11.hpp>
 #include <openvino/runtime/properties.hpp>
 #include "inference_backend/logger.h"
 #include "inference_backend/pre_proc.h"
@@ -17,9 +18,13 @@
 #include "openvino_image_inference.h"
 // #include "wrap_image.h"
 
+#include "infer_request_pool.h"
+#include "letterbox.h"
+#include "model_registry.h"
 #include "openvino_blob_wrapper.h"
 #include "safe_arithmetic.hpp"
 #include "utils.h"
+#include "common/common.hpp"
 
 #ifdef ENABLE_VAAPI
 #include <modules/vaapi/context.h>
@@ -29,6 +34,10 @@
 #endif
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <functional>
 #include <stdio.h>
 #include <thread>
@@ -246,10 +255,46 @@ struct ConfigHelper {
         return std::stoi(base_config.at(KEY_BATCH_SIZE));
     }
 
+    float batch_timeout_ms() const {
+        const std::string &timeout = base_get_or_empty(KEY_BATCH_TIMEOUT_MS);
+        if (timeout == empty_str)
+            return 0.0f;
+        return std::stof(timeout);
+    }
+
+    bool warm_up() const {
+        const std::string &warm_up = base_get_or_empty(KEY_WARM_UP);
+        return !warm_up.empty() && std::stoi(warm_up) != 0;
+    }
+
     const std::string &image_format() const {
         return base_get_or_empty(KEY_IMAGE_FORMAT);
     }
 
+    // model_proc resize, empty if the IE pre-processor does not resize the image as model_proc describes
+    const std::string &resize_type() const {
+        return base_get_or_empty(KEY_RESIZE_TYPE);
+    }
+
+    std::pair<size_t, size_t> padding_stride() const {
+        return {base_get_or(KEY_PADDING_STRIDE_X, 0), base_get_or(KEY_PADDING_STRIDE_Y, 0)};
+    }
+
+    float padding_fill_value() const {
+        const std::string &fill_value = base_get_or_empty(KEY_PADDING_FILL_VALUE);
+        if (fill_value == empty_str)
+            return 0.0f;
+        return std::stof(fill_value);
+    }
+
+    std::vector<float> mean_values() const {
+        return base_get_floats(KEY_MEAN_VALUES);
+    }
+
+    std::vector<float> std_values() const {
+        return base_get_floats(KEY_STD_VALUES);
+    }
+
     const std::string &model_format() const {
         static const std::string bgr_str = std::string("BGR");
         const std::string &format = base_get_or_empty(KEY_MODEL_FORMAT);
@@ -291,6 +336,15 @@ struct ConfigHelper {
         return it->second;
     }
 
+    std::vector<float> base_get_floats(const std::string &key) const {
+        std::vector<float> values;
+        std::stringstream ss(base_get_or_empty(key));
+        std::string item;
+        while (std::getline(ss, item, ','))
+            values.push_back(std::stof(item));
+        return values;
+    }
+
     size_t base_get_or(const std::string &key, size_t or_value) const {
         const auto it = base_config.find(key);
         if (it == base_config.cend())
@@ -394,6 +448,27 @@ struct ConfigHelper {
 
 } // namespace
 
+// Everything that goes into compiling a model, pipelines with the same key share the compiled model.
+// Every GPU/NPU pipeline wraps the VADisplay of its device in a context of its own, the remote context is made from
+// the display, so the display is keyed rather than the wrapper.
+std::string model_registry_key(const InferenceBackend::InferenceConfig &config, MemoryType memory_type,
+                               const hce::ai::inference::ContextPtr &context) {
+    const void *va_display = context ? context->handle(hce::ai::inference::BaseContext::key::va_display) : nullptr;
+    std::string key = fmt::format("memory_type={};va_display={}", static_cast<int>(memory_type), va_display);
+    for (const auto &section : config) {
+        for (const auto &item : section.second) {
+            // warming up does not change the compiled model
+            if (item.first == KEY_WARM_UP)
+                continue;
+            // any batch deadline compiles the same model with a dynamic batch dimension
+            const std::string value =
+                item.first == KEY_BATCH_TIMEOUT_MS ? std::to_string(std::stof(item.second) > 0.0f) : item.second;
+            key += fmt::format(";{}.{}={}", section.first, item.first, value);
+        }
+    }
+    return key;
+}
+
 void print_inputs_config(const ConfigHelper::InputsConfig &inputs_cfg) {
     if (inputs_cfg.empty()) {
         GVA_INFO("Inputs configuration is not provided");
@@ -425,11 +500,8 @@ class OpenVinoNewApiImpl {
     };
 
   public:
-    OpenVinoNewApiImpl(const ConfigHelper &config, hce::ai::inference::ContextPtr context,
-                       ImageInference::CallbackFunc callback, ImageInference::ErrorHandlingFunc error_handler,
-                       MemoryType memory_type)
-        : _app_context(std::move(context)), _memory_type(memory_type), _callback(callback),
-          _error_handler(error_handler) {
+    OpenVinoNewApiImpl(const ConfigHelper &config, hce::ai::inference::ContextPtr context, MemoryType memory_type)
+        : _app_context(std::move(context)), _memory_type(memory_type) {
 
         // log_api_message();
 
@@ -473,6 +545,10 @@ class OpenVinoNewApiImpl {
         if (!_nireq)
             _nireq = _compiled_model.get_property(ov::optimal_number_of_infer_requests);
         // GVA_DEBUG("Num of inference req: %d", _nireq);
+        _request_pool = std::make_unique<InferRequestPool>(_compiled_model, _nireq);
+
+        if (config.warm_up())
+            warm_up();
     }
 
     ~OpenVinoNewApiImpl() {
@@ -674,7 +750,7 @@ class OpenVinoNewApiImpl {
             GVA_DEBUG("get_model_image_input_info(): using wa, w=%zu, h=%zu", width, height);
         }
 
-        if (batch_size == 0) {
+        if (batch_size == 0 || _dynamic_batch) {
             batch_size = _batch_size;
         }
 
@@ -939,10 +1015,37 @@ class OpenVinoNewApiImpl {
 
     // Singleton core object
     static ov::Core &core() {
-        static ov::Core ovcore;
+        static ov::Core ovcore = create_core();
+        return ovcore;
+    }
+
+    // Compiled models are cached on disk when MODEL_CACHE_DIR_ENV is set. OpenVINO names every blob by a hash of the
+    // model, the compile properties, the device and the runtime version, a changed IR or an upgrade is compiled again.
+    static ov::Core create_core() {
+        ov::Core ovcore;
+        const char *cache_dir = std::getenv(MODEL_CACHE_DIR_ENV);
+        if (cache_dir && *cache_dir) {
+            ovcore.set_property(ov::cache_dir(cache_dir));
+            GVA_INFO("Compiled models are cached in %s", cache_dir);
+        }
         return ovcore;
     }
 
+    // Runs the infer requests once before the first frame, so it does not pay for lazy allocations and kernel setup
+    void warm_up() {
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            _request_pool->warm_up();
+        } catch (const std::exception &e) {
+            GVA_WARNING("Warm-up of %s failed: %s", _model->get_friendly_name().c_str(), e.what());
+            return;
+        }
+        const auto elapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        GVA_INFO("Warmed up %d infer requests of %s in %ld ms", _nireq, _model->get_friendly_name().c_str(),
+                 static_cast<long>(elapsed.count()));
+    }
+
   protected:
     std::shared_ptr<ov::Model> _model;
     std::string _device;
@@ -950,17 +1053,19 @@ class OpenVinoNewApiImpl {
     hce::ai::inference::ContextPtr _app_context;
     hce::ai::inference::OpenVINOContextPtr _openvino_context;
     ov::CompiledModel _compiled_model;
+    std::unique_ptr<InferRequestPool> _request_pool; // infer requests of every user of the compiled model
     MemoryType _memory_type;
     int _nireq = 0;
     int _batch_size = 0;
+    bool _dynamic_batch = false; // batch dimension is [1, _batch_size]
 
     // FIXME: get rid of these. "Original" model input width/height
     size_t _origin_model_in_w = 0;
     size_t _origin_model_in_h = 0;
     bool _was_resize = false;
 
-    ImageInference::CallbackFunc _callback;
-    ImageInference::ErrorHandlingFunc _error_handler;
+    // model_proc resize and padding of the IE pre-processor, see letterbox_resize()
+    Letterbox _letterbox;
 
     void configure_model(const ConfigHelper &config) {
 
@@ -989,8 +1094,10 @@ class OpenVinoNewApiImpl {
         }
 
         _batch_size = config.batch_size();
+        // with a batch deadline a partial batch is inferred as is, which needs a dynamic batch dimension
+        _dynamic_batch = _batch_size > 1 && config.batch_timeout_ms() > 0.0f;
         // GVA_DEBUG("Setting batch size of %d to model", _batch_size);
-        ov::set_batch(_model, _batch_size);
+        ov::set_batch(_model, _dynamic_batch ? ov::Dimension(1, _batch_size) : ov::Dimension(_batch_size));
 
         // GVA_DEBUG("Model inputs after configuration:");
         size_t idx = 0;
@@ -1159,7 +1266,11 @@ class OpenVinoNewApiImpl {
                     input.tensor().set_spatial_dynamic_shape();
                 }
 
-                if (apply_resize) {
+                if (!config.resize_type().empty()) {
+                    // resized as model_proc describes once the image is in model precision, see letterbox_resize()
+                    _letterbox.enabled = true;
+                    _was_resize = true;
+                } else if (apply_resize) {
                     // GVA_INFO("apply resize %d", apply_resize);
                     if (img_width > _origin_model_in_w || img_height > _origin_model_in_h) {
                         input.preprocess().resize(ov::preprocess::ResizeAlgorithm::RESIZE_LINEAR);
@@ -1201,10 +1312,29 @@ class OpenVinoNewApiImpl {
 
         // If defined, scale the image by the defined value
         float scale_factor = config.image_scale();
-        if (scale_factor != 1.0) {
+        if (scale_factor != 1.0 && pp_type != ImagePreprocessorType::IE) {
             input.preprocess().scale(scale_factor);
         }
 
+        // model_proc resize, normalization and padding, in the order the OpenCV pre-processor applies them on the
+        // host, then the image scale it leaves to the model, so the border is scaled as well
+        if (pp_type == ImagePreprocessorType::IE) {
+            if (_letterbox.enabled)
+                letterbox_resize(config, input, node);
+            const std::vector<float> mean = config.mean_values();
+            if (!mean.empty()) {
+                if (node_element_type.is_real())
+                    input.preprocess().mean(mean).scale(config.std_values());
+                else
+                    GVA_WARNING("Input '%s' is %s, model_proc mean/std are not applied", node.get_any_name().c_str(),
+                                node_element_type.get_type_name().c_str());
+            }
+            if (_letterbox.enabled)
+                letterbox_pad(config, input);
+            if (scale_factor != 1.0)
+                input.preprocess().scale(scale_factor);
+        }
+
         // OV preprocessor does implicit layout conversion. If original layout is unknown, assume it is NCHW.
         ov::Layout model_layout = get_ov_node_layout(node);
         if (model_layout.empty()) {
@@ -1216,6 +1346,89 @@ class OpenVinoNewApiImpl {
         }
     }
 
+    // model_proc resize into the model input less the padding stride, the border is added by letterbox_pad()
+    void letterbox_resize(const ConfigHelper &config, ov::preprocess::InputInfo &input,
+                          const ov::Output<ov::Node> &node) {
+        const ov::Layout layout = get_ov_node_layout(node, true);
+        const ov::PartialShape &shape = node.get_partial_shape();
+        if (layout.empty() || !ov::layout::has_height(layout) || !ov::layout::has_width(layout) ||
+            shape[ov::layout::height_idx(layout)].is_dynamic() || shape[ov::layout::width_idx(layout)].is_dynamic())
+            throw std::runtime_error("model_proc resize needs a model input of static height and width");
+
+        _letterbox.keep_aspect_ratio = config.resize_type() == "aspect-ratio";
+        _letterbox.model_h = shape[ov::layout::height_idx(layout)].get_length();
+        _letterbox.model_w = shape[ov::layout::width_idx(layout)].get_length();
+        std::tie(_letterbox.stride_x, _letterbox.stride_y) = config.padding_stride();
+        if (2 * _letterbox.stride_x >= _letterbox.model_w || 2 * _letterbox.stride_y >= _letterbox.model_h)
+            throw std::runtime_error("model_proc padding stride leaves no room for the image");
+
+        const Letterbox lb = _letterbox;
+        input.preprocess().custom([lb](const ov::Output<ov::Node> &image) {
+            // NHWC, the target size is computed from the image shape, so dynamic ROI inputs work as well
+            using namespace ov::opset11;
+            const auto i64 = ov::element::i64;
+            const auto axis0 = Constant::create(i64, ov::Shape{}, {0});
+            const auto hw_axes = Constant::create(i64, ov::Shape{2}, {1, 2});
+            ov::Output<ov::Node> new_hw;
+            const ov::PartialShape &image_shape = image.get_partial_shape();
+            if (image_shape.rank().is_static() && image_shape[1].is_static() && image_shape[2].is_static()) {
+                // the size letterbox_transform() reports, truncated from double as the OpenCV pre-processor does
+                const Letterbox::Resized r = lb.resize(image_shape[2].get_length(), image_shape[1].get_length());
+                new_hw = Constant::create(i64, ov::Shape{2}, {r.height, r.width});
+            } else {
+                // ROI of dynamic size, the smaller of the two scales in integer arithmetic and the floor of the scaled
+                // size, which only differs from the double computation when that one rounds an exact size down
+                const auto shape = std::make_shared<ShapeOf>(image, i64);
+                const auto in_h = std::make_shared<Gather>(shape, Constant::create(i64, ov::Shape{1}, {1}), axis0);
+                const auto in_w = std::make_shared<Gather>(shape, Constant::create(i64, ov::Shape{1}, {2}), axis0);
+                const auto target_h = Constant::create(i64, ov::Shape{1}, {lb.target_h()});
+                const auto target_w = Constant::create(i64, ov::Shape{1}, {lb.target_w()});
+                ov::Output<ov::Node> new_h = target_h;
+                ov::Output<ov::Node> new_w = target_w;
+                if (lb.keep_aspect_ratio) {
+                    const auto width_bound = std::make_shared<LessEqual>(std::make_shared<Multiply>(target_w, in_h),
+                                                                         std::make_shared<Multiply>(target_h, in_w));
+                    new_h = std::make_shared<Select>(
+                        width_bound, std::make_shared<Divide>(std::make_shared<Multiply>(in_h, target_w), in_w),
+                        target_h);
+                    new_w = std::make_shared<Select>(
+                        width_bound, target_w,
+                        std::make_shared<Divide>(std::make_shared<Multiply>(in_w, target_h), in_h));
+                }
+                new_hw = std::make_shared<Concat>(ov::OutputVector{new_h, new_w}, 0);
+            }
+
+            Interpolate::InterpolateAttrs attrs;
+            attrs.mode = Interpolate::InterpolateMode::LINEAR_ONNX;
+            attrs.shape_calculation_mode = Interpolate::ShapeCalcMode::SIZES;
+            attrs.coordinate_transformation_mode = Interpolate::CoordinateTransformMode::HALF_PIXEL;
+            return ov::Output<ov::Node>(std::make_shared<Interpolate>(image, new_hw, hw_axes, attrs));
+        });
+    }
+
+    // Centers the resized image in the model input, the border is filled after normalization as model_proc expects
+    void letterbox_pad(const ConfigHelper &config, ov::preprocess::InputInfo &input) {
+        const Letterbox lb = _letterbox;
+        const float fill_value = config.padding_fill_value();
+        input.preprocess().custom([lb, fill_value](const ov::Output<ov::Node> &image) {
+            using namespace ov::opset11;
+            const auto i64 = ov::element::i64;
+            const auto hw_axes = Constant::create(i64, ov::Shape{2}, {1, 2});
+            const auto in_hw = std::make_shared<Gather>(std::make_shared<ShapeOf>(image, i64), hw_axes,
+                                                        Constant::create(i64, ov::Shape{}, {0}));
+            const auto model_hw = Constant::create(i64, ov::Shape{2}, {lb.model_h, lb.model_w});
+            const auto border = std::make_shared<Subtract>(model_hw, in_hw);
+            const auto begin_hw = std::make_shared<Divide>(border, Constant::create(i64, ov::Shape{}, {2}));
+            const auto end_hw = std::make_shared<Subtract>(border, begin_hw);
+            const auto zero = Constant::create(i64, ov::Shape{1}, {0});
+            const auto pads_begin = std::make_shared<Concat>(ov::OutputVector{zero, begin_hw, zero}, 0);
+            const auto pads_end = std::make_shared<Concat>(ov::OutputVector{zero, end_hw, zero}, 0);
+            const auto pad_value = Constant::create(image.get_element_type(), ov::Shape{}, {fill_value});
+            return ov::Output<ov::Node>(
+                std::make_shared<Pad>(image, pads_begin, pads_end, pad_value, ov::op::PadMode::CONSTANT));
+        });
+    }
+
     void reshape_model(size_t image_height, size_t image_width) {
 
         // GVA_INFO("Reshaping model to %zdx%zd", image_height, image_width);
@@ -1358,7 +1571,7 @@ class OpenVinoNewApiImpl {
     }
 };
 
-void OpenVINOImageInference::SetCompletionCallback(std::shared_ptr<BatchRequest> &batch_request) {
+void OpenVINOImageInference::LeaseRequest(std::shared_ptr<BatchRequest> &batch_request) {
     assert(batch_request && "Batch request is null");
 
     auto cb = [=](std::exception_ptr ex) {
@@ -1379,31 +1592,34 @@ void OpenVINOImageInference::SetCompletionCallback(std::shared_ptr<BatchRequest>
 
         FreeRequest(batch_request);
     };
-    batch_request->infer_request_new.set_callback(cb);
+    // may wait for another pipeline running the same compiled model
+    batch_request->pool_slot = safe_convert<int>(_impl->_request_pool->acquire(this, cb));
+    batch_request->infer_request_new = _impl->_request_pool->request(batch_request->pool_slot);
 }
 
 OpenVINOImageInference::OpenVINOImageInference(const InferenceBackend::InferenceConfig &config, Allocator *,
                                                hce::ai::inference::ContextPtr context, CallbackFunc callback,
                                                ErrorHandlingFunc error_handler, MemoryType memory_type)
     : context_(context), memory_type(memory_type), callback(callback), handleError(error_handler),
-      batch_size(std::stoi(config.at(KEY_BASE).at(KEY_BATCH_SIZE))), requests_processing_(0U) {
+      batch_size(std::stoi(config.at(KEY_BASE).at(KEY_BATCH_SIZE))), requests_processing_(0U), batch_timeout_(0),
+      dynamic_batch_(false), pending_batch_(false), stop_dispatcher_(false), reported_batches_(0) {
 
     try {
         ConfigHelper cfg_helper(config);
-        _impl = std::make_unique<OpenVinoNewApiImpl>(cfg_helper, context, callback, error_handler, memory_type);
+        _impl = ModelRegistry<OpenVinoNewApiImpl>::instance().acquire(
+            model_registry_key(config, memory_type, context), [&]() {
+                return std::make_shared<OpenVinoNewApiImpl>(cfg_helper, context, memory_type);
+            });
+        if (_impl.use_count() > 1)
+            GVA_INFO("Sharing the compiled model %s with %ld other pipelines", config.at(KEY_BASE).at(KEY_MODEL).c_str(),
+                     _impl.use_count() - 1);
 
         model_name = _impl->_model->get_friendly_name();
         // GVA_INFO("model name : %s", model_name.c_str());
         nireq = _impl->_nireq;
         image_layer = _impl->_image_input_name;
-
-        for (int i = 0; i < nireq; i++) {
-            std::shared_ptr<BatchRequest> batch_request = std::make_shared<BatchRequest>();
-            batch_request->infer_request_new = _impl->_compiled_model.create_infer_request();
-            batch_request->in_tensors.resize(_impl->_model->inputs().size());
-            SetCompletionCallback(batch_request);
-            freeRequests.push(batch_request);
-        }
+        dynamic_batch_ = _impl->_dynamic_batch;
+        batch_timeout_ = std::chrono::microseconds(static_cast<int64_t>(cfg_helper.batch_timeout_ms() * 1000.0f));
 
         const auto pp_type = cfg_helper.pp_type();
 
@@ -1415,7 +1631,29 @@ OpenVINOImageInference::OpenVINOImageInference(const InferenceBackend::Inference
             pre_processor.reset(InferenceBackend::ImagePreprocessor::Create(pp_type));
         }
 
+        for (int i = 0; i < nireq; i++) {
+            std::shared_ptr<BatchRequest> batch_request = std::make_shared<BatchRequest>();
+            batch_request->in_tensors.resize(_impl->_model->inputs().size());
+            if (dynamic_batch_ && DoNeedImagePreProcessing()) {
+                // the request has no input tensor of its own while the batch dimension is dynamic
+                const auto input = _impl->_compiled_model.input(image_layer);
+                batch_request->batch_tensor =
+                    ov::Tensor(input.get_element_type(), input.get_partial_shape().get_max_shape());
+            }
+            freeRequests.push(batch_request);
+        }
+
+        // attach last, the pool keeps a pointer to this
+        _impl->_request_pool->attach(this);
+        if (dynamic_batch_) {
+            GVA_INFO("Batching up to %d inputs with a deadline of %ld us", batch_size, batch_timeout_.count());
+            batch_dispatcher_ = std::thread(&OpenVINOImageInference::BatchDispatcherFunction, this);
+        }
+
     } catch (const std::exception &e) {
+        // the destructor does not run for a partially constructed object
+        if (_impl)
+            _impl->_request_pool->detach(this);
         std::throw_with_nested(std::runtime_error("Failed to construct OpenVINOImageInference"));
     }
 }
@@ -1423,6 +1661,8 @@ OpenVINOImageInference::OpenVINOImageInference(const InferenceBackend::Inference
 OpenVINOImageInference::~OpenVINOImageInference() {
     GVA_DEBUG("Image Inference destruct");
     Close();
+    if (_impl)
+        _impl->_request_pool->detach(this);
 }
 
 void OpenVINOImageInference::FreeRequest(std::shared_ptr<BatchRequest> request) {
@@ -1431,11 +1671,99 @@ void OpenVINOImageInference::FreeRequest(std::shared_ptr<BatchRequest> request)
     for (auto &in_vec : request->in_tensors) {
         in_vec.clear();
     }
+    if (request->pool_slot >= 0) {
+        _impl->_request_pool->release(this, safe_convert<size_t>(request->pool_slot));
+        request->pool_slot = -1;
+    }
     freeRequests.push(request);
     requests_processing_ -= buffer_size;
     request_processed_.notify_all();
 }
 
+void OpenVINOImageInference::StartBatch(std::shared_ptr<BatchRequest> &request, BatchTrigger trigger) {
+    // requests_mutex_ is held by the caller
+    pending_batch_ = false;
+    if (dynamic_batch_)
+        BindPartialBatch(request);
+    UpdateBatchingStats(request->buffers.size(), trigger);
+    request->start_async();
+}
+
+void OpenVINOImageInference::BindPartialBatch(std::shared_ptr<BatchRequest> &request) {
+    const size_t batch_fill = request->buffers.size();
+    if (DoNeedImagePreProcessing()) {
+        // the first batch_fill images of the full batch tensor are contiguous
+        ov::Shape shape = request->batch_tensor.get_shape();
+        shape[0] = batch_fill;
+        request->infer_request_new.set_tensor(
+            image_layer, ov::Tensor(request->batch_tensor.get_element_type(), shape, request->batch_tensor.data()));
+    } else if (batch_fill < safe_convert<size_t>(batch_size)) {
+        // a full batch was bound by BypassImageProcessing
+        for (size_t i = 0; i < request->in_tensors.size(); i++) {
+            request->infer_request_new.set_input_tensors(i, request->in_tensors[i]);
+        }
+    }
+}
+
+void OpenVINOImageInference::UpdateBatchingStats(size_t batch_fill, BatchTrigger trigger) {
+    BatchingStats snapshot;
+    {
+        std::lock_guard<std::mutex> lk(stats_mutex_);
+        const unsigned int queue_depth = requests_processing_;
+        stats_.batches++;
+        stats_.frames += batch_fill;
+        stats_.full_batches += (trigger == BatchTrigger::FULL);
+        stats_.deadline_batches += (trigger == BatchTrigger::DEADLINE);
+        stats_.flush_batches += (trigger == BatchTrigger::FLUSH);
+        stats_.queue_depth += queue_depth;
+        stats_.max_queue_depth = std::max(stats_.max_queue_depth, queue_depth);
+        if (stats_.batches % BATCHING_STATS_REPORT_INTERVAL != 0)
+            return;
+        snapshot = stats_;
+        reported_batches_ = stats_.batches;
+    }
+    ReportBatchingStats(snapshot);
+}
+
+void OpenVINOImageInference::ReportBatchingStats(const BatchingStats &stats) {
+    if (stats.batches == 0)
+        return;
+    GVA_INFO("%s batching: %lu batches, fill %.1f%% of %d, %lu full, %lu on deadline, %lu on flush, "
+             "queue depth avg %.1f max %u",
+             model_name.c_str(), stats.batches, 100.0 * stats.frames / (stats.batches * batch_size), batch_size,
+             stats.full_batches, stats.deadline_batches, stats.flush_batches,
+             static_cast<double>(stats.queue_depth) / stats.batches, stats.max_queue_depth);
+}
+
+OpenVINOImageInference::BatchingStats OpenVINOImageInference::GetBatchingStats() {
+    std::lock_guard<std::mutex> lk(stats_mutex_);
+    return stats_;
+}
+
+void OpenVINOImageInference::BatchDispatcherFunction() {
+    std::unique_lock<std::mutex> lk(requests_mutex_);
+    while (!stop_dispatcher_) {
+        if (!pending_batch_) {
+            batch_deadline_cv_.wait(lk);
+            continue;
+        }
+        if (std::chrono::steady_clock::now() < pending_deadline_) {
+            batch_deadline_cv_.wait_until(lk, pending_deadline_);
+            continue;
+        }
+
+        // the partially filled request is always at the front of freeRequests
+        auto request = freeRequests.pop();
+        try {
+            StartBatch(request, BatchTrigger::DEADLINE);
+        } catch (const std::exception &e) {
+            GVA_ERROR("Couldn't start inference on batch deadline: %s", e.what());
+            this->handleError(request->buffers);
+            FreeRequest(request);
+        }
+    }
+}
+
 #if 0
 InferenceEngine::RemoteContext::Ptr
 OpenVINOImageInference::CreateRemoteContext(const InferenceBackend::InferenceConfig &config) {
@@ -1594,7 +1922,8 @@ void OpenVINOImageInference::SubmitImageProcessing(const std::string &input_name
     // GVA_INFO("input_name %s", input_name.c_str());
     // FIXME: single input
     if (request->in_tensors.front().empty()) {
-        request->in_tensors.front().push_back(request->infer_request_new.get_tensor(input_name));
+        request->in_tensors.front().push_back(dynamic_batch_ ? request->batch_tensor
+                                                             : request->infer_request_new.get_tensor(input_name));
     }
     const size_t batch_index = request->buffers.size();
 
@@ -1620,8 +1949,15 @@ void OpenVINOImageInference::SubmitImageProcessing(const std::string &input_name
 }
 
 void OpenVINOImageInference::BypassImageProcessing(const std::string &input_name, std::shared_ptr<BatchRequest> request,
-                                                   const Image &src_img, size_t batch_size) {
+                                                   const Image &src_img, size_t batch_size,
+                                                   const ImageTransformationParams::Ptr image_transform_info) {
     ITT_TASK(__FUNCTION__);
+    // the image is resized inside the model, post-processing still needs to know how
+    if (image_transform_info && _impl->_letterbox.enabled) {
+        const auto &r = src_img.rect;
+        letterbox_transform(_impl->_letterbox, r.width ? r.width : src_img.width,
+                            r.height ? r.height : src_img.height, *image_transform_info);
+    }
     // GVA_INFO("src_img.size %d  %d", src_img.width, src_img.height);
     auto ov_tensor = _impl->image_to_tensors(src_img);
     // GVA_INFO("Debug: batch_size: %d", batch_size);
@@ -1732,6 +2068,8 @@ void OpenVINOImageInference::SubmitImage(
     std::shared_ptr<BatchRequest> request = freeRequests.pop();
     // GVA_INFO("Checking need image pre processing");
     try {
+        if (request->pool_slot < 0)
+            LeaseRequest(request);
         if (DoNeedImagePreProcessing()) {
             SubmitImageProcessing(
                 image_layer, request, *frame->GetImage(),
@@ -1743,7 +2081,8 @@ void OpenVINOImageInference::SubmitImage(
             // released
             frame->SetImage(nullptr);
         } else {
-            BypassImageProcessing(image_layer, request, *frame->GetImage(), safe_convert<size_t>(batch_size));
+            BypassImageProcessing(image_layer, request, *frame->GetImage(), safe_convert<size_t>(batch_size),
+                                  frame->GetImageTransformationParams());
         }
         // GVA_INFO("Preparing apply input preprocessors");
         ApplyInputPreprocessors(request, input_preprocessors);
@@ -1757,8 +2096,14 @@ void OpenVINOImageInference::SubmitImage(
     try {
         // start inference asynchronously if enough buffers for batching
         if (request->buffers.size() >= safe_convert<size_t>(batch_size)) {
-            request->start_async();
+            StartBatch(request, BatchTrigger::FULL);
         } else {
+            if (dynamic_batch_ && request->buffers.size() == 1) {
+                // the deadline of a batch is set by its oldest input
+                pending_batch_ = true;
+                pending_deadline_ = std::chrono::steady_clock::now() + batch_timeout_;
+                batch_deadline_cv_.notify_one();
+            }
             freeRequests.push_front(request);
         }
     } catch (const std::exception &e) {
@@ -1813,8 +2158,8 @@ void OpenVINOImageInference::Flush() {
 
         if (request->buffers.size() > 0) {
             try {
-                // WA: Fill non-complete batch with last element. Can be removed once supported in OV
-                if (batch_size > 1 && !DoNeedImagePreProcessing()) {
+                // WA: Fill non-complete batch with last element, a dynamic batch is inferred as is
+                if (!dynamic_batch_ && batch_size > 1 && !DoNeedImagePreProcessing()) {
                     size_t input_idx = 0;
                     for (auto &input_vec : request->in_tensors) {
                         for (int i = input_vec.size(); i < batch_size; i++)
@@ -1825,7 +2170,7 @@ void OpenVINOImageInference::Flush() {
                     }
                 }
 
-                request->start_async();
+                StartBatch(request, BatchTrigger::FLUSH);
             } catch (const std::exception &e) {
                 GVA_ERROR("Couldn't start inferece on flush: %s", e.what());
                 this->handleError(request->buffers);
@@ -1842,11 +2187,29 @@ void OpenVINOImageInference::Flush() {
 }
 
 void OpenVINOImageInference::Close() {
+    if (batch_dispatcher_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lk(requests_mutex_);
+            stop_dispatcher_ = true;
+        }
+        batch_deadline_cv_.notify_all();
+        batch_dispatcher_.join();
+    }
     Flush();
+    // the requests stay in the shared pool, their completion callbacks were dropped on release
     while (!freeRequests.empty()) {
-        auto req = freeRequests.pop();
-        req->infer_request_new.set_callback([](std::exception_ptr) {});
+        freeRequests.pop();
+    }
+
+    BatchingStats stats;
+    {
+        std::lock_guard<std::mutex> lk(stats_mutex_);
+        if (stats_.batches == reported_batches_)
+            return;
+        stats = stats_;
+        reported_batches_ = stats_.batches;
     }
+    ReportBatchingStats(stats);
 }
 
 void OpenVINOImageInference::WorkingFunction(const std::shared_ptr<BatchRequest> &request) {
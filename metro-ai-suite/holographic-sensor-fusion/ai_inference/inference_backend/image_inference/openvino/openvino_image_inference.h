@@ -13,6 +13,8 @@
 #include <openvino/openvino.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 // #include <gst/gst.h>
 #include <map>
 #include <string>
@@ -22,8 +24,21 @@
 // #include "config.h"
 #include "safe_queue.h"
 
+#define BATCHING_STATS_REPORT_INTERVAL 1000 // batches between two reports of the batching statistics
+
 class OpenVINOImageInference : public InferenceBackend::ImageInference {
   public:
+    // Counters of the started batches, reported every BATCHING_STATS_REPORT_INTERVAL batches and on Close()
+    struct BatchingStats {
+        uint64_t batches = 0;
+        uint64_t frames = 0;           // frames and ROIs in the started batches
+        uint64_t full_batches = 0;     // started because batch_size inputs were collected
+        uint64_t deadline_batches = 0; // started because the oldest input reached the batch deadline
+        uint64_t flush_batches = 0;    // started by Flush(), e.g. at the end of a stream
+        uint64_t queue_depth = 0;      // sum over the batches of the inputs submitted and not yet inferred
+        unsigned int max_queue_depth = 0;
+    };
+
     OpenVINOImageInference(const InferenceBackend::InferenceConfig &config, InferenceBackend::Allocator *allocator,
                            hce::ai::inference::ContextPtr context, CallbackFunc callback, ErrorHandlingFunc error_handler,
                            InferenceBackend::MemoryType memory_type);
@@ -51,13 +66,17 @@ class OpenVINOImageInference : public InferenceBackend::ImageInference {
 
     void Close() override;
 
+    BatchingStats GetBatchingStats();
+
   protected:
-    std::unique_ptr<class OpenVinoNewApiImpl> _impl;
+    std::shared_ptr<class OpenVinoNewApiImpl> _impl; // compiled model and infer requests, shared through the model registry
 
     struct BatchRequest {
         ov::InferRequest infer_request_new;
+        int pool_slot = -1; // request leased from the shared pool, -1 while the batch is empty
         std::vector<IFrameBase::Ptr> buffers;
         std::vector<ov::TensorVector> in_tensors;
+        ov::Tensor batch_tensor; // full batch image input filled by the pre-processor, dynamic batch only
 
         void start_async() {
             return this->infer_request_new.start_async();
@@ -87,16 +106,35 @@ class OpenVINOImageInference : public InferenceBackend::ImageInference {
     std::condition_variable request_processed_;
     std::mutex flush_mutex;
 
+    // Batch deadline, the partially filled request is always at the front of freeRequests
+    enum class BatchTrigger { FULL, DEADLINE, FLUSH };
+    std::chrono::microseconds batch_timeout_;
+    bool dynamic_batch_;
+    bool pending_batch_;                                      // guarded by requests_mutex_
+    std::chrono::steady_clock::time_point pending_deadline_; // guarded by requests_mutex_
+    std::condition_variable batch_deadline_cv_;
+    std::thread batch_dispatcher_;
+    bool stop_dispatcher_;
+    std::mutex stats_mutex_;
+    BatchingStats stats_;
+    uint64_t reported_batches_;
+
   private:
     void FreeRequest(std::shared_ptr<BatchRequest> request);
+    void StartBatch(std::shared_ptr<BatchRequest> &request, BatchTrigger trigger);
+    void BindPartialBatch(std::shared_ptr<BatchRequest> &request);
+    void UpdateBatchingStats(size_t batch_fill, BatchTrigger trigger);
+    void BatchDispatcherFunction();
+    void ReportBatchingStats(const BatchingStats &stats);
     bool DoNeedImagePreProcessing() const;
     void SubmitImageProcessing(const std::string &input_name, std::shared_ptr<BatchRequest> request,
                                const InferenceBackend::Image &src_img,
                                const InferenceBackend::InputImageLayerDesc::Ptr &pre_proc_info,
                                const InferenceBackend::ImageTransformationParams::Ptr image_transform_info);
     void BypassImageProcessing(const std::string &input_name, std::shared_ptr<BatchRequest> request,
-                               const InferenceBackend::Image &src_img, size_t batch_size);
-    void SetCompletionCallback(std::shared_ptr<BatchRequest> &batch_request);
+                               const InferenceBackend::Image &src_img, size_t batch_size,
+                               const InferenceBackend::ImageTransformationParams::Ptr image_transform_info);
+    void LeaseRequest(std::shared_ptr<BatchRequest> &batch_request);
     void
     ApplyInputPreprocessors(std::shared_ptr<BatchRequest> &request,
                             const std::map<std::string, InferenceBackend::InputLayerDesc::Ptr> &input_preprocessors);
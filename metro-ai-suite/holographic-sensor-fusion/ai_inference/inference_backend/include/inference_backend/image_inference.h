@@ -172,6 +172,8 @@ __DECLARE_CONFIG_KEY(IMAGE_FORMAT);
 __DECLARE_CONFIG_KEY(MODEL_FORMAT);
 __DECLARE_CONFIG_KEY(RESHAPE);
 __DECLARE_CONFIG_KEY(BATCH_SIZE);
+__DECLARE_CONFIG_KEY(BATCH_TIMEOUT_MS); // deadline of a partial batch, 0 waits for a full batch or Flush()
+__DECLARE_CONFIG_KEY(WARM_UP);          // "1": run a dummy inference on every infer request once the model is compiled
 __DECLARE_CONFIG_KEY(RESHAPE_WIDTH);
 __DECLARE_CONFIG_KEY(RESHAPE_HEIGHT);
 __DECLARE_CONFIG_KEY(IMAGE_WIDTH);
@@ -181,6 +183,13 @@ __DECLARE_CONFIG_KEY(CAPS_FEATURE);
 __DECLARE_CONFIG_KEY(VAAPI_THREAD_POOL_SIZE);
 __DECLARE_CONFIG_KEY(VAAPI_FAST_SCALE_LOAD_FACTOR);
 __DECLARE_CONFIG_KEY(SCALE_FACTOR);
+// model_proc image pre-processing folded into the model by the IE pre-processor
+__DECLARE_CONFIG_KEY(RESIZE_TYPE);        // "aspect-ratio" or "no-aspect-ratio"
+__DECLARE_CONFIG_KEY(PADDING_STRIDE_X);   // border kept around the resized image on each side
+__DECLARE_CONFIG_KEY(PADDING_STRIDE_Y);
+__DECLARE_CONFIG_KEY(PADDING_FILL_VALUE);
+__DECLARE_CONFIG_KEY(MEAN_VALUES);        // comma separated per channel, (x - mean) / std
+__DECLARE_CONFIG_KEY(STD_VALUES);
 #undef __DECLARE_CONFIG_KEY
 #undef __CONFIG_KEY
 
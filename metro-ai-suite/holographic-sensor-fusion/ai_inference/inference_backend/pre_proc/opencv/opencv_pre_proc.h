@@ -6,6 +6,13 @@
 
 #include "inference_backend/pre_proc.h"
 
+#include <opencv2/core.hpp>
+
+// Resize, crop, color conversion, normalization and padding as model_proc describes them, applied by Convert()
+cv::Mat CustomImageConvert(const cv::Mat &orig_image, const int src_color_format, const cv::Size &input_size,
+                           const InferenceBackend::InputImageLayerDesc::Ptr &pre_proc_info,
+                           const InferenceBackend::ImageTransformationParams::Ptr &image_transform_info);
+
 namespace InferenceBackend {
 
 class OpenCV_VPP : public ImagePreprocessor {
@@ -0,0 +1,408 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you (License). Unless the License provides otherwise, you may not
+ * use, modify, copy, publish, distribute, disclose or transmit this software or
+ * the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ */
+
+/**
+ * In-tree implementation of the libradar C ABI on top of the radar helpers of the pipeline nodes:
+ * - radarDetection runs RadarDetection, the processing of RadarDetectionNode,
+ * - radarClustering runs DBscanClusterer, the processing of RadarClusteringNode,
+ * - radarTracking runs ClusterTracker, the processing of RadarTrackingNode.
+ *
+ * RadarParam carries no window or CFAR method, detection uses the ones of the sample RadarConfig.json: Hanning
+ * windows, CA-CFAR on both axes and truncated CFAR edges.
+ *
+ * The handle is constructed in the buffer given to radarInitHandle(), the working buffers of the helpers are sized
+ * there and reused by every frame. A handle is not thread-safe, MULTITHREAD_BACKEND uses threads of its own.
+ */
+
+#include "libradar.h"
+
+#include "modules/inference_util/radar/radar_clustering_helper.hpp"
+#include "modules/inference_util/radar/radar_detection_helper.hpp"
+#include "modules/inference_util/radar/radar_thread_pool.hpp"
+#include "modules/inference_util/radar/radar_tracking_helper.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <vector>
+
+using hce::ai::inference::ClusterTracker;
+using hce::ai::inference::ComplexFloat;
+using hce::ai::inference::DBscanClusterer;
+using hce::ai::inference::DBscanGridIndex;
+using hce::ai::inference::DBscanKernel;
+using hce::ai::inference::DOAEngine;
+using hce::ai::inference::FFTPlanCache;
+using hce::ai::inference::RadarBasicConfig;
+using hce::ai::inference::RadarClusteringConfig;
+using hce::ai::inference::RadarDetection;
+using hce::ai::inference::RadarDetectionConfig;
+using hce::ai::inference::RadarTensor;
+using hce::ai::inference::RadarTensorLayout;
+using hce::ai::inference::RadarThreadPool;
+using hce::ai::inference::RadarTrackingConfig;
+using hce::ai::inference::clusteringDBscanOutput;
+using hce::ai::inference::pointClouds;
+using hce::ai::inference::trackerInput;
+using hce::ai::inference::trackerOutput;
+
+static_assert(sizeof(cfloat) == sizeof(ComplexFloat), "cfloat and ComplexFloat must share their layout");
+
+#define LIBRADAR_MAX_TRACKERS CT_MAX_NUM_TRACKER  //!< tracks reported when the caller gives no track array
+
+struct RadarHandle
+{
+    RadarParam param;
+    RadarBasicConfig basicConfig;
+    RadarDetectionConfig detectionConfig;
+    RadarClusteringConfig clusteringConfig;
+    RadarTrackingConfig trackingConfig;
+    int frameIdx;
+
+    // detection, plans and steering tables are kept across frames
+    FFTPlanCache::Ptr planCache;
+    DOAEngine::Ptr doaEngine;
+    RadarThreadPool::Ptr threadPool;
+    std::shared_ptr<pointClouds> detections;
+    std::vector<ushort> rangeIdx;  // index arrays of the detections in the width of the C ABI
+    std::vector<ushort> speedIdx;
+
+    // clustering
+    DBscanClusterer clusterer;
+    pointClouds clusterInput;
+    clusteringDBscanOutput clusters;
+    std::vector<ClusterDescription> clusterDesc;
+
+    // tracking, the tracks live across frames
+    ClusterTracker tracker;
+    trackerInput trackInput;
+    trackerOutput tracks;
+    std::vector<TrackingDescription> trackDesc;
+};
+
+static bool toAoaEstimationType(RadarDoaType doaType, hce::ai::inference::AoaEstimationType &type)
+{
+    switch (doaType) {
+        case FFT_DOA:
+            type = hce::ai::inference::FFT;
+            return true;
+        case MUSIC_DOA:
+            type = hce::ai::inference::MUSIC;
+            return true;
+        case DBF_DOA:
+            type = hce::ai::inference::DBF;
+            return true;
+        case CAPON_DOA:
+            type = hce::ai::inference::CAPON;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static RadarErrorCode checkParam(const RadarParam *rp)
+{
+    if (rp == nullptr) {
+        return R_NULLPTR;
+    }
+    hce::ai::inference::AoaEstimationType type;
+    if (rp->rn <= 0 || rp->tn <= 0 || rp->sn <= 0 || rp->cn <= 0 || rp->mp <= 0 || rp->mc <= 0 || !toAoaEstimationType(rp->doaType, type) ||
+        rp->backend < REFERENCE_BACKEND || rp->backend >= MAXLEN_BACKEND) {
+        return R_OVERFLOW;
+    }
+    return R_SUCCESS;
+}
+
+static void initHandle(RadarHandle *h, const RadarParam *rp)
+{
+    h->param = *rp;
+    h->frameIdx = 0;
+
+    h->basicConfig.numRx = rp->rn;
+    h->basicConfig.numTx = rp->tn;
+    h->basicConfig.Start_frequency = rp->startFreq;
+    h->basicConfig.idle = rp->idle;
+    h->basicConfig.adcStartTime = rp->adcStartTime;
+    h->basicConfig.rampEndTime = rp->rampEndTime;
+    h->basicConfig.freqSlopeConst = rp->freqSlopeConst;
+    h->basicConfig.adcSampleRate = rp->adcSampleRate;
+    h->basicConfig.adcSamples = rp->sn;
+    h->basicConfig.numChirps = rp->cn;
+    h->basicConfig.fps = rp->fps;
+
+    h->detectionConfig.m_range_win_type_ = hce::ai::inference::Hanning;
+    h->detectionConfig.m_doppler_win_type_ = hce::ai::inference::Hanning;
+    toAoaEstimationType(rp->doaType, h->detectionConfig.m_aoa_estimation_type_);
+    h->detectionConfig.m_doppler_cfar_method_ = hce::ai::inference::CA_CFAR;
+    h->detectionConfig.DopplerPfa = rp->dFAR;
+    h->detectionConfig.DopplerWinGuardLen = rp->dGWL;
+    h->detectionConfig.DopplerWinTrainLen = rp->dTWL;
+    h->detectionConfig.m_range_cfar_method_ = hce::ai::inference::CA_CFAR;
+    h->detectionConfig.RangePfa = rp->rFAR;
+    h->detectionConfig.RangeWinGuardLen = rp->rGWL;
+    h->detectionConfig.RangeWinTrainLen = rp->rTWL;
+    h->detectionConfig.m_num_threads_ = (MULTITHREAD_BACKEND == rp->backend) ? std::max(rp->nt, 1) : 1;
+
+    h->clusteringConfig.eps = rp->eps;
+    h->clusteringConfig.weight = rp->weight;
+    h->clusteringConfig.minPointsInCluster = rp->mpc;
+    h->clusteringConfig.maxClusters = rp->mc;
+    h->clusteringConfig.maxPoints = rp->mp;
+
+    h->trackingConfig.trackerAssociationThreshold = rp->tat;
+    h->trackingConfig.measurementNoiseVariance = rp->mnv;
+    h->trackingConfig.timePerFrame = rp->tpf;
+    h->trackingConfig.iirForgetFactor = rp->iff;
+    h->trackingConfig.trackerActiveThreshold = rp->at;
+    h->trackingConfig.trackerForgetThreshold = rp->ft;
+
+    h->planCache = std::make_shared<FFTPlanCache>();
+    h->doaEngine = std::make_shared<DOAEngine>();
+    h->threadPool = std::make_shared<RadarThreadPool>(h->detectionConfig.m_num_threads_);
+
+    h->detections = std::make_shared<pointClouds>();
+    h->detections->num = 0;
+    h->rangeIdx.reserve(rp->mp);
+    h->speedIdx.reserve(rp->mp);
+
+    h->clusterer.setKernel(REFERENCE_BACKEND == rp->backend ? DBscanKernel::Scalar : DBscanGridIndex::detectKernel());
+    h->clusterInput.num = 0;
+    h->clusters.numCluster = 0;
+    h->clusters.InputArray.reserve(rp->mp);
+    h->clusterDesc.resize(rp->mc);
+
+    h->trackInput.numCluster = 0;
+    h->trackDesc.resize(LIBRADAR_MAX_TRACKERS);
+}
+
+extern "C" {
+
+RadarErrorCode radarGetMemSize(RadarParam *rp, ulong *sz)
+{
+    if (sz == nullptr) {
+        return R_NULLPTR;
+    }
+    RadarErrorCode ret = checkParam(rp);
+    if (ret != R_SUCCESS) {
+        return ret;
+    }
+    // room to align the handle inside a buffer of any alignment
+    *sz = sizeof(RadarHandle) + alignof(RadarHandle) - 1;
+    return R_SUCCESS;
+}
+
+RadarErrorCode radarInitHandle(RadarHandle **h, RadarParam *rp, void *buf, ulong sz)
+{
+    if (h == nullptr || buf == nullptr) {
+        return R_NULLPTR;
+    }
+    RadarErrorCode ret = checkParam(rp);
+    if (ret != R_SUCCESS) {
+        return ret;
+    }
+
+    void *mem = buf;
+    size_t space = sz;
+    if (std::align(alignof(RadarHandle), sizeof(RadarHandle), mem, space) == nullptr) {
+        return R_OVERFLOW;
+    }
+
+    RadarHandle *handle = new (mem) RadarHandle();
+    initHandle(handle, rp);
+    if (handle->clusterer.create(handle->clusteringConfig) != hce::ai::inference::DBSCAN_OK ||
+        handle->tracker.clusterTrackerCreate(&handle->trackingConfig) != hce::ai::inference::CLUSTERTRACKER_NO_ERROR) {
+        handle->~RadarHandle();
+        return R_OVERFLOW;
+    }
+    *h = handle;
+    return R_SUCCESS;
+}
+
+RadarErrorCode radarDetection(RadarHandle *h, RadarCube *c, RadarPointClouds *rr)
+{
+    if (h == nullptr || c == nullptr || c->mat == nullptr || rr == nullptr) {
+        return R_NULLPTR;
+    }
+    const RadarParam &rp = h->param;
+    if (c->rn != rp.rn || c->tn != rp.tn || c->sn != rp.sn || c->cn != rp.cn) {
+        return R_OVERFLOW;
+    }
+
+    // the tr x c x s cube of the ABI is the chirp-major tensor of the helpers, detection only reads it
+    RadarTensor<ComplexFloat> cube =
+        RadarTensor<ComplexFloat>::wrap(reinterpret_cast<ComplexFloat *>(c->mat), rp.sn, rp.cn, rp.rn * rp.tn, RadarTensorLayout::ChirpMajor);
+    RadarDetection detection(cube, h->frameIdx++, (int)(cube.size() * sizeof(cfloat)), h->basicConfig, h->detectionConfig, h->planCache, h->doaEngine,
+                             h->threadPool);
+    detection.setPCL(h->detections);
+    detection.runDetection();
+
+    pointClouds &pcl = *h->detections;
+    int limit = std::min(rp.mp, rr->maxLen > 0 ? rr->maxLen : rp.mp);
+    int len = std::min(pcl.num, limit);
+
+    h->rangeIdx.resize(len);
+    h->speedIdx.resize(len);
+    for (int i = 0; i < len; i++) {
+        h->rangeIdx[i] = (ushort)pcl.rangeIdxArray[i];
+        h->speedIdx[i] = (ushort)pcl.speedIdxArray[i];
+    }
+
+    // arrays the caller left empty point into the handle, valid until the next radarDetection
+    if (rr->rangeIdx == nullptr) {
+        rr->rangeIdx = h->rangeIdx.data();
+        rr->speedIdx = h->speedIdx.data();
+        rr->range = pcl.rangeFloat.data();
+        rr->speed = pcl.speedFloat.data();
+        rr->angle = pcl.aoaVar.data();
+        rr->snr = pcl.SNRArray.data();
+    }
+    else {
+        if (rr->speedIdx == nullptr || rr->range == nullptr || rr->speed == nullptr || rr->angle == nullptr || rr->snr == nullptr) {
+            return R_NULLPTR;
+        }
+        std::copy_n(h->rangeIdx.data(), len, rr->rangeIdx);
+        std::copy_n(h->speedIdx.data(), len, rr->speedIdx);
+        std::copy_n(pcl.rangeFloat.data(), len, rr->range);
+        std::copy_n(pcl.speedFloat.data(), len, rr->speed);
+        std::copy_n(pcl.aoaVar.data(), len, rr->angle);
+        std::copy_n(pcl.SNRArray.data(), len, rr->snr);
+    }
+    rr->len = len;
+
+    return len < pcl.num ? R_OVERFLOW : R_SUCCESS;
+}
+
+RadarErrorCode radarClustering(RadarHandle *h, RadarPointClouds *rr, ClusterResult *cr)
+{
+    if (h == nullptr || rr == nullptr || cr == nullptr) {
+        return R_NULLPTR;
+    }
+    int len = std::min(std::max(rr->len, 0), h->param.mp);
+    if (len > 0 && (rr->range == nullptr || rr->speed == nullptr || rr->angle == nullptr || rr->snr == nullptr)) {
+        return R_NULLPTR;
+    }
+
+    pointClouds &input = h->clusterInput;
+    input.num = len;
+    input.rangeFloat.assign(rr->range, rr->range + len);
+    input.speedFloat.assign(rr->speed, rr->speed + len);
+    input.aoaVar.assign(rr->angle, rr->angle + len);
+    input.SNRArray.assign(rr->snr, rr->snr + len);
+
+    hce::ai::inference::clusteringDBscanErrorCodes err = h->clusterer.run(&input, &h->clusters);
+    if (err != hce::ai::inference::DBSCAN_OK && err != hce::ai::inference::DBSCAN_ERROR_CLUSTER_LIMIT_REACHED) {
+        return R_OVERFLOW;
+    }
+
+    const clusteringDBscanOutput &clusters = h->clusters;
+    for (int i = 0; i < clusters.numCluster; i++) {
+        const hce::ai::inference::clusteringDBscanReport &report = clusters.report[i];
+        ClusterDescription &cd = h->clusterDesc[i];
+        cd.n = report.numPoints;
+        cd.cx = report.xCenter;
+        cd.cy = report.yCenter;
+        cd.rx = report.xSize;
+        cd.ry = report.ySize;
+        cd.av = report.avgVel;
+        cd.vr = report.centerRangeVar;
+        cd.vv = report.centerDopplerVar;
+        cd.va = report.centerAngleVar;
+    }
+
+    // idx holds the cluster of every point, 0 for noise
+    if (cr->idx == nullptr) {
+        cr->idx = h->clusters.InputArray.data();
+    }
+    else {
+        std::copy_n(clusters.InputArray.data(), len, cr->idx);
+    }
+    if (cr->cd == nullptr) {
+        cr->cd = h->clusterDesc.data();
+    }
+    else {
+        std::copy_n(h->clusterDesc.data(), clusters.numCluster, cr->cd);
+    }
+    cr->n = clusters.numCluster;
+
+    return err == hce::ai::inference::DBSCAN_OK ? R_SUCCESS : R_OVERFLOW;
+}
+
+RadarErrorCode radarTracking(RadarHandle *h, ClusterResult *cr, TrackingResult *tr)
+{
+    if (h == nullptr || cr == nullptr || tr == nullptr) {
+        return R_NULLPTR;
+    }
+    // the tracker takes at most CT_MAX_NUM_CLUSTER clusters a frame
+    int n = std::min(std::max(cr->n, 0), CT_MAX_NUM_CLUSTER);
+    if (n > 0 && cr->cd == nullptr) {
+        return R_NULLPTR;
+    }
+
+    trackerInput &input = h->trackInput;
+    input.numCluster = n;
+    input.report.resize(n);
+    for (int i = 0; i < n; i++) {
+        const ClusterDescription &cd = cr->cd[i];
+        hce::ai::inference::clusteringDBscanReport &report = input.report[i];
+        report.numPoints = cd.n;
+        report.xCenter = cd.cx;
+        report.yCenter = cd.cy;
+        report.xSize = cd.rx;
+        report.ySize = cd.ry;
+        report.avgVel = cd.av;
+        report.centerRangeVar = cd.vr;
+        report.centerDopplerVar = cd.vv;
+        report.centerAngleVar = cd.va;
+    }
+
+    // same frame period as RadarTrackingNode
+    float dt = (float)1000 / h->trackingConfig.timePerFrame / 1000;
+    h->tracks.outputInfo.clear();
+    if (h->tracker.clusterTrackerRun(&input, dt, &h->tracks) != hce::ai::inference::CLUSTERTRACKER_NO_ERROR) {
+        return R_OVERFLOW;
+    }
+
+    if (tr->td == nullptr) {
+        tr->td = h->trackDesc.data();
+        tr->maxLen = (int)h->trackDesc.size();
+    }
+    int total = (int)h->tracks.outputInfo.size();
+    int len = std::min(total, tr->maxLen);
+    for (int i = 0; i < len; i++) {
+        const hce::ai::inference::trackerOutputDataType &info = h->tracks.outputInfo[i];
+        TrackingDescription &td = tr->td[i];
+        td.tid = info.trackerID;
+        std::copy_n(info.S_hat, 4, td.sHat);
+        td.rx = info.xSize;
+        td.ry = info.ySize;
+    }
+    tr->len = len;
+
+    return (len < total || n < cr->n) ? R_OVERFLOW : R_SUCCESS;
+}
+
+RadarErrorCode radarDestroyHandle(RadarHandle *h)
+{
+    if (h == nullptr) {
+        return R_NULLPTR;
+    }
+    // the buffer belongs to the caller, only the handle is torn down
+    h->~RadarHandle();
+    return R_SUCCESS;
+}
+
+}  // extern "C"
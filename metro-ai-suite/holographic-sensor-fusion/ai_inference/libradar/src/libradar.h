@@ -17,6 +17,12 @@ typedef enum RadarDoaType{
     CAPON_DOA,
     MAXLEN_DOA
 }RadarDoaType;
+typedef enum RadarBackendType{ //implementation of the in-tree library, ignored by the prebuilt one
+    REFERENCE_BACKEND = 0, //scalar kernels on the calling thread
+    SIMD_BACKEND, //AVX2 / AVX-512 kernels picked at runtime, on the calling thread
+    MULTITHREAD_BACKEND, //SIMD kernels, detection stages split over nt threads
+    MAXLEN_BACKEND
+}RadarBackendType;
 typedef struct cfloat{
     float   real;
     float   imag;
@@ -57,6 +63,10 @@ typedef struct RadarParam{
     float iff; //IIR filter forgetting factor
     int at; //tracker Active Threshold;
     int	ft; //tracker Forget Threshold;
+
+    //backend, appended so that the prebuilt library keeps reading the fields above
+    RadarBackendType backend;
+    int	    nt; //threads of MULTITHREAD_BACKEND
 }RadarParam;
 typedef struct RadarCube{
     int	    rn;
@@ -51,6 +51,8 @@ baseImageInferenceNode::baseImageInferenceNode(std::size_t totalThreadNum) : hva
     // model
     m_inferenceProperties.reshape_model_input = DEFAULT_RESHAPE_MODEL_INPUT;
     m_inferenceProperties.batch_size = DEFAULT_BATCH_SIZE;
+    m_inferenceProperties.batch_timeout_ms = DEFAULT_BATCH_TIMEOUT_MS;
+    m_inferenceProperties.warm_up = DEFAULT_WARM_UP;
     m_inferenceProperties.reshape_width = DEFAULT_RESHAPE_WIDTH;
     m_inferenceProperties.reshape_height = DEFAULT_RESHAPE_HEIGHT;
 
@@ -118,6 +120,17 @@ hva::hvaStatus_t baseImageInferenceNode::configureByString(const std::string& co
     m_configParser.getVal<int>("InferBatchSize", batch_size);
     m_inferenceProperties.batch_size = (unsigned int)batch_size;
 
+    // batch deadline in ms, 0 waits for a full batch or the end of a stream
+    // e.g., InferBatchTimeoutMs=(FLOAT)10: frames from every stream are batched together, but none waits longer than 10ms
+    float batch_timeout_ms = DEFAULT_BATCH_TIMEOUT_MS;
+    m_configParser.getVal<float>("InferBatchTimeoutMs", batch_timeout_ms);
+    m_inferenceProperties.batch_timeout_ms = batch_timeout_ms;
+
+    // warm up the infer requests when the model is compiled, set by the model pre-load of the inference service
+    bool warmUp = DEFAULT_WARM_UP;
+    m_configParser.getVal<bool>("WarmUp", warmUp);
+    m_inferenceProperties.warm_up = warmUp;
+
     // openVINO param, e.g., InferConfig=(STRING_ARRAY)[CPU_THROUGHPUT_STREAMS=6,CPU_THREADS_NUM=6,CPU_BIND_THREAD=NUMA]
     std::vector<std::string> inference_config;
     m_configParser.getVal<std::vector<std::string>>("InferConfig", inference_config);
@@ -391,6 +391,7 @@ void ImageInferenceInstance::CreateModel(InferenceProperty& inference_property)
     UpdateModelReshapeInfo(inference_property);
     InferenceConfig inference_config = CreateNestedInferenceConfig(inference_property);
     UpdateConfigWithLayerInfo(m_model.input_processor_info, inference_config);
+    UpdateConfigWithImagePreProcInfo(m_model.input_processor_info, inference_config);
 
     // // TODO: input memory type should be configurable
     // // how do we know the input_image_memory_type at runtime? Seems should not set here? 
@@ -552,6 +553,8 @@ InferenceConfig ImageInferenceInstance::CreateNestedInferenceConfig(InferencePro
     base[InferenceBackend::KEY_SCALE_FACTOR] = scale_factor_str;
 
     base[InferenceBackend::KEY_BATCH_SIZE] = std::to_string(inference_property.batch_size);
+    base[InferenceBackend::KEY_BATCH_TIMEOUT_MS] = std::to_string(inference_property.batch_timeout_ms);
+    base[InferenceBackend::KEY_WARM_UP] = std::to_string(inference_property.warm_up);
     base[InferenceBackend::KEY_RESHAPE] = std::to_string(inference_property.reshape_model_input);
     HVA_INFO("inference_property.reshape_model_input: %d", inference_property.reshape_model_input);
     HVA_INFO("inference_property.reshape_width: %d", inference_property.reshape_width);
@@ -618,6 +621,78 @@ void ImageInferenceInstance::UpdateConfigWithLayerInfo(
     config[InferenceBackend::KEY_FORMAT] = input_format;
 }
 
+/**
+ * @brief Hand the model_proc image pre-processing to the ie pre-processor, which folds it into the compiled model.
+ * Steps it can not fold, i.e. crop and grayscale/yuv conversion, switch the model to the opencv pre-processor.
+ */
+void ImageInferenceInstance::UpdateConfigWithImagePreProcInfo(
+    const std::vector<ModelInputInfo::Ptr>& model_input_processor_info,
+    InferenceConfig& config) {
+
+    std::map<std::string, std::string>& base = config[InferenceBackend::KEY_BASE];
+    if (static_cast<ImagePreprocessorType>(std::stoi(base[InferenceBackend::KEY_PRE_PROCESSOR_TYPE])) !=
+        ImagePreprocessorType::IE) {
+        return;
+    }
+
+    for (const ModelInputInfo::Ptr& preproc : model_input_processor_info) {
+        if (preproc->format != "image") {
+            continue;
+        }
+        InputImageLayerDesc::Ptr desc = PreProcParamsParser(preproc->params).parse();
+        if (!desc || !desc->isDefined()) {
+            return;
+        }
+
+        InputImageLayerDesc::ColorSpace colorSpace = desc->getTargetColorSpace();
+        bool foldableColor = colorSpace == InputImageLayerDesc::ColorSpace::NO ||
+                             colorSpace == InputImageLayerDesc::ColorSpace::RGB ||
+                             colorSpace == InputImageLayerDesc::ColorSpace::BGR;
+        if (desc->doNeedCrop() || !foldableColor) {
+            base[InferenceBackend::KEY_PRE_PROCESSOR_TYPE] = std::to_string(static_cast<int>(ImagePreprocessorType::OPENCV));
+            HVA_WARNING("model_proc of %s asks for crop or a color space the ie pre-processor can not fold into the model, "
+                        "change preprocess type from ie to opencv!", preproc->layer_name.c_str());
+            return;
+        }
+
+        if (colorSpace != InputImageLayerDesc::ColorSpace::NO) {
+            base[InferenceBackend::KEY_MODEL_FORMAT] = colorSpace == InputImageLayerDesc::ColorSpace::RGB ? "RGB" : "BGR";
+        }
+        if (desc->doNeedResize()) {
+            base[InferenceBackend::KEY_RESIZE_TYPE] =
+                desc->getResizeType() == InputImageLayerDesc::Resize::ASPECT_RATIO ? "aspect-ratio" : "no-aspect-ratio";
+        }
+
+        if (desc->doNeedPadding()) {
+            const auto& padding = desc->getPadding();
+            base[InferenceBackend::KEY_PADDING_STRIDE_X] = std::to_string(padding.stride_x);
+            base[InferenceBackend::KEY_PADDING_STRIDE_Y] = std::to_string(padding.stride_y);
+            if (!padding.fill_value.empty()) {
+                if (std::any_of(padding.fill_value.begin(), padding.fill_value.end(),
+                                [&padding](double v) { return v != padding.fill_value.front(); })) {
+                    HVA_WARNING("ie pre-processor pads every channel with the first padding fill_value");
+                }
+                base[InferenceBackend::KEY_PADDING_FILL_VALUE] = std::to_string(padding.fill_value.front());
+            }
+        }
+
+        if (desc->doNeedDistribNormalization()) {
+            const auto& distrib = desc->getDistribNormalization();
+            std::string meanValues, stdValues;
+            for (size_t i = 0; i < distrib.mean.size(); i++) {
+                meanValues += (i ? "," : "") + std::to_string(distrib.mean[i]);
+            }
+            for (size_t i = 0; i < distrib.std.size(); i++) {
+                stdValues += (i ? "," : "") + std::to_string(distrib.std[i]);
+            }
+            base[InferenceBackend::KEY_MEAN_VALUES] = meanValues;
+            base[InferenceBackend::KEY_STD_VALUES] = stdValues;
+        }
+        HVA_DEBUG("model_proc image pre-processing of %s is folded into the model", preproc->layer_name.c_str());
+        return;
+    }
+}
+
 void ImageInferenceInstance::ApplyImageBoundaries(std::shared_ptr<InferenceBackend::Image>& image,
                             const VideoRegionOfInterestMeta& meta,
                             InferenceRegionType inference_region) {
@@ -15,6 +15,7 @@
 #include <csignal>
 #include <cstring>
 #include <fstream>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <boost/exception/all.hpp>
 #include "common/logger.hpp"
@@ -22,6 +23,7 @@
 #include "low_latency_server/http_server/lowLatencyServer.hpp"
 #include "low_latency_server/grpc_server/grpcPipelineManager.hpp"
 #include "low_latency_server/grpc_server/grpcServer.hpp"
+#include "low_latency_server/modelPreloader.hpp"
 
 using namespace hce::ai::inference;
 
@@ -42,6 +44,9 @@ struct Config{
     unsigned maxConcurrentWorkload;
     unsigned maxPipelineLifetime;
     unsigned pipelineManagerPoolSize;
+
+    std::string modelCacheDir;
+    std::vector<std::string> preloadModels;
 };
 
 Config parseConf(int argc, char** argv){
@@ -81,7 +86,12 @@ Config parseConf(int argc, char** argv){
             ("Pipeline.maxPipelineLifetime", po::value<unsigned>(&config.maxPipelineLifetime)->default_value(30),
                                               "Max pipeline lifetime (seconds). Default as 30.")
             ("Pipeline.pipelineManagerPoolSize", po::value<unsigned>(&config.pipelineManagerPoolSize)->default_value(1),
-                                              "Pipeline manager pool size. Default as 1.");
+                                              "Pipeline manager pool size. Default as 1.")
+
+            ("Inference.modelCacheDir", po::value<std::string>(&config.modelCacheDir),
+                                              "directory of the compiled model cache, models are compiled at every start if not set")
+            ("Inference.preloadModel", po::value<std::vector<std::string>>(&config.preloadModels)->composing(),
+                                              "NodeClassName:ConfigureString of a model to compile and warm up before the servers start, repeatable");
 
         po::variables_map confVm;
         std::ifstream ifile(confPath, std::ifstream::in);
@@ -148,10 +158,24 @@ int main(int argc, char* argv[]){
 
     Logger::init(config.logDir, config.logMaxFileCount, config.logMaxFileSize, config.logSeverity);
 
+    // the inference backend reads it when the first model is compiled
+    if(!config.modelCacheDir.empty()){
+        setenv(MODEL_CACHE_DIR_ENV, config.modelCacheDir.c_str(), 1);
+        _INF("Compiled model cache: {}", config.modelCacheDir);
+    }
+
+    // models are compiled and warmed up before the listeners open
+    ModelPreloader preloader;
+    if(preloader.load(config.preloadModels) != hceAiSuccess){
+        _WRN("Some models failed to pre-load, they are loaded by the first pipeline using them");
+    }
+
     std::thread t1([config](){startHTTPServer(config);});
     std::thread t2([config](){startgRPCServer(config);});
     t1.join();
     t2.join();
 
+    preloader.unload();
+
     return 0;
 }
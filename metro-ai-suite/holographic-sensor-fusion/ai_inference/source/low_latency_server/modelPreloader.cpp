@@ -0,0 +1,100 @@
+/*
+ * INTEL CONFIDENTIAL
+ * 
+ * Copyright (C) 2025 Intel Corporation.
+ * 
+ * This software and the related documents are Intel copyrighted materials, and your use of
+ * them is governed by the express license under which they were provided to you (License).
+ * Unless the License provides otherwise, you may not use, modify, copy, publish, distribute,
+ * disclose or transmit this software or the related documents without Intel's prior written permission.
+ * 
+ * This software and the related documents are provided as is, with no express or implied warranties,
+ * other than those that are expressly stated in the License.
+*/
+
+#include <chrono>
+
+#include "low_latency_server/modelPreloader.hpp"
+
+namespace hce{
+
+namespace ai{
+
+namespace inference{
+
+ModelPreloader::~ModelPreloader(){
+    unload();
+}
+
+hceAiStatus_t ModelPreloader::load(const std::vector<std::string>& entries){
+    if(entries.empty()){
+        return hceAiSuccess;
+    }
+
+    hva::hvaNodeRegistry::getInstance().init(HVA_NODE_REGISTRY_NO_DLCLOSE | HVA_NODE_REGISTRY_RTLD_GLOBAL);
+
+    auto start = std::chrono::steady_clock::now();
+    hceAiStatus_t ret = hceAiSuccess;
+    for(const auto& entry : entries){
+        if(loadOne(entry) != hceAiSuccess){
+            ret = hceAiFailure;
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    _INF("Pre-loaded {} of {} models in {} ms", m_workers.size(), entries.size(), elapsed);
+    return ret;
+}
+
+hceAiStatus_t ModelPreloader::loadOne(const std::string& entry){
+    std::size_t pos = entry.find(PRELOAD_ENTRY_DELIMITER);
+    if(pos == std::string::npos || pos == 0){
+        _ERR("Illegal model pre-load entry: {}, expecting NodeClassName{}ConfigureString", entry, PRELOAD_ENTRY_DELIMITER);
+        return hceAiBadArgument;
+    }
+    std::string className = entry.substr(0, pos);
+    std::string configureString = entry.substr(pos + 1) + ";WarmUp=(BOOL)true";
+
+    try{
+        auto ctor = hva::hvaNodeRegistry::getInstance()[className];
+        if(!ctor){
+            _ERR("Model pre-load: node class {} is not registered", className);
+            return hceAiBadArgument;
+        }
+        std::shared_ptr<hva::hvaNode_t> node(ctor(1));
+        if(node->configureByString(configureString) != hva::hvaSuccess){
+            _ERR("Model pre-load: failed to configure {} with {}", className, configureString);
+            return hceAiBadArgument;
+        }
+        if(node->prepare() != hva::hvaSuccess){
+            _ERR("Model pre-load: failed to prepare {}", className);
+            return hceAiFailure;
+        }
+        // the worker compiles the model and warms it up
+        std::shared_ptr<hva::hvaNodeWorker_t> worker = node->createNodeWorker();
+        if(!worker){
+            _ERR("Model pre-load: failed to create the worker of {}", className);
+            return hceAiFailure;
+        }
+        m_nodes.push_back(node);
+        m_workers.push_back(worker);
+    }
+    catch(const std::exception& e){
+        _ERR("Model pre-load: failed to load {}, error: {}", entry, e.what());
+        return hceAiFailure;
+    }
+
+    _INF("Model pre-loaded: {}", entry);
+    return hceAiSuccess;
+}
+
+void ModelPreloader::unload(){
+    // workers hold the models and refer to their nodes
+    m_workers.clear();
+    m_nodes.clear();
+}
+
+}
+
+}
+
+}
@@ -14,6 +14,11 @@
 
 #include "modules/inference_util/detection/detection_post_processor.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <immintrin.h>
 
 namespace hce{
 
@@ -234,6 +239,148 @@ void BBoxTransformProcessor::process(std::vector<float*>& inputs) {
 }
 
 
+// ============================================================================
+//                          Anchor Transform Kernels
+// ============================================================================
+
+#define ANCHOR_EXP_HI (88.0f)      //!< exp() input is clamped to [ANCHOR_EXP_LO, ANCHOR_EXP_HI], keeps 2^n a normal float
+#define ANCHOR_EXP_LO (-87.3f)
+#define ANCHOR_LOGIT_MARGIN (1e-3f)  //!< the raw threshold pass keeps this margin, candidates are checked exactly afterwards
+#define ANCHOR_LOGIT_MAX (16.0f)     //!< sigmoid() rounds to 1 above ~16.6, a higher raw threshold would drop such cells
+
+//
+// exp(x) = 2^n * p(r) with n = round(x / ln2), r = x - n * ln2 and the Cephes polynomial p, below 2 ulp from std::exp.
+// The scalar and the AVX2 variant run the same operations in the same order, this file is built with
+// -ffp-contract=off so that none of them gets fused into an FMA and both decode the same boxes.
+//
+
+static inline float anchorExpScalar(float x) {
+    x = std::min(std::max(x, ANCHOR_EXP_LO), ANCHOR_EXP_HI);
+    const float n = std::floor(x * 1.44269504088896341f + 0.5f);
+    float r = x - n * 0.693359375f;
+    r = r - n * -2.12194440e-4f;
+    float p = 1.9875691500e-4f;
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    p = p * (r * r) + r + 1.0f;
+
+    const int32_t bits = ((int32_t)n + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+static void anchorExpArrayScalar(float* v, size_t n) {
+    for (size_t k = 0; k < n; k++) {
+        v[k] = anchorExpScalar(v[k]);
+    }
+}
+
+static void anchorSigmoidArrayScalar(float* v, size_t n) {
+    for (size_t k = 0; k < n; k++) {
+        v[k] = 1.0f / (1.0f + anchorExpScalar(-v[k]));
+    }
+}
+
+static size_t anchorScanScalar(const float* plane, size_t n, size_t stride, float thresh, int32_t* cells) {
+    size_t count = 0;
+    for (size_t k = 0; k < n; k++) {
+        if (plane[k * stride] >= thresh) {
+            cells[count++] = (int32_t)k;
+        }
+    }
+    return count;
+}
+
+__attribute__((target("avx2"))) static inline __m256 anchorExpAVX2(__m256 x) {
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(ANCHOR_EXP_LO)), _mm256_set1_ps(ANCHOR_EXP_HI));
+    const __m256 n = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)), _mm256_set1_ps(0.5f)));
+    __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(n, _mm256_set1_ps(0.693359375f)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(n, _mm256_set1_ps(-2.12194440e-4f)));
+    __m256 p = _mm256_set1_ps(1.9875691500e-4f);
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.3981999507e-3f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(8.3334519073e-3f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(4.1665795894e-2f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.6666665459e-1f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(5.0000001201e-1f));
+    p = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p, _mm256_mul_ps(r, r)), r), _mm256_set1_ps(1.0f));
+
+    const __m256i bits = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(n), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(p, _mm256_castsi256_ps(bits));
+}
+
+__attribute__((target("avx2"))) static void anchorExpArrayAVX2(float* v, size_t n) {
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        _mm256_storeu_ps(v + k, anchorExpAVX2(_mm256_loadu_ps(v + k)));
+    }
+    anchorExpArrayScalar(v + k, n - k);
+}
+
+__attribute__((target("avx2"))) static void anchorSigmoidArrayAVX2(float* v, size_t n) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        const __m256 e = anchorExpAVX2(_mm256_xor_ps(_mm256_loadu_ps(v + k), sign));
+        _mm256_storeu_ps(v + k, _mm256_div_ps(one, _mm256_add_ps(one, e)));
+    }
+    anchorSigmoidArrayScalar(v + k, n - k);
+}
+
+__attribute__((target("avx2"))) static size_t anchorScanAVX2(const float* plane, size_t n, size_t stride, float thresh, int32_t* cells) {
+    const __m256 vthresh = _mm256_set1_ps(thresh);
+    const __m256i lanes = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((int32_t)stride));
+    size_t count = 0;
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        // channels-first planes are contiguous, channels-last ones are gathered
+        const __m256 v = stride == 1 ? _mm256_loadu_ps(plane + k) : _mm256_i32gather_ps(plane + k * stride, lanes, 4);
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(v, vthresh, _CMP_GE_OQ));
+        while (mask) {
+            cells[count++] = (int32_t)k + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    for (; k < n; k++) {
+        if (plane[k * stride] >= thresh) {
+            cells[count++] = (int32_t)k;
+        }
+    }
+    return count;
+}
+
+struct AnchorKernels {
+    void (*exp)(float* v, size_t n);
+    void (*sigmoid)(float* v, size_t n);
+    size_t (*scan)(const float* plane, size_t n, size_t stride, float thresh, int32_t* cells);
+};
+
+static const AnchorKernels& anchorKernels() {
+    static const AnchorKernels kernels = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return AnchorKernels{anchorExpArrayAVX2, anchorSigmoidArrayAVX2, anchorScanAVX2};
+        }
+        return AnchorKernels{anchorExpArrayScalar, anchorSigmoidArrayScalar, anchorScanScalar};
+    }();
+    return kernels;
+}
+
+// per thread scratch of the decoder, the processor is shared by the workers of a node. Buffers only grow.
+struct AnchorDecodeScratch {
+    std::vector<int32_t> cells;          // candidate cells of the current anchor
+    std::vector<float> max_cls;          // best raw class score of every cell, models without objectness
+    std::vector<float> conf, cls;        // candidates, structure of arrays
+    std::vector<float> x, y, w, h;
+    std::vector<float> boxes;            // decoded detections of the blob
+};
+
+static thread_local AnchorDecodeScratch t_anchorScratch;
+
 /**
  * @brief parse required parameters for this Processor
  */
@@ -342,6 +489,21 @@ AnchorTransformProcessor::AnchorTransformProcessor(
 
     // params.bbox_prediction.pred_bbox_wh.scale_h
     m_bbox_predition.pred_bbox_wh.scale_h = pred_bbox_wh_items["scale_h"].get<float>();
+
+    setLayoutStrides();
+
+    // sigmoid is monotonic, the threshold pass compares the raw outputs against logit(conf_thresh)
+    const float conf_thresh = m_model_output_cfg.conf_thresh;
+    if (!m_output_sigmoid_activation) {
+        m_raw_conf_thresh = conf_thresh;
+    }
+    else if (conf_thresh <= 0.0f) {
+        m_raw_conf_thresh = -INFINITY;
+    }
+    else {
+        m_raw_conf_thresh = conf_thresh < 1.0f ? std::log(conf_thresh / (1.0f - conf_thresh)) : ANCHOR_LOGIT_MAX;
+        m_raw_conf_thresh = std::min(m_raw_conf_thresh, ANCHOR_LOGIT_MAX) - ANCHOR_LOGIT_MARGIN;
+    }
 }
 
 AnchorTransformProcessor::~AnchorTransformProcessor() {
@@ -357,10 +519,8 @@ void AnchorTransformProcessor::process(std::vector<float*>& inputs) {
     if(inputs.size() == 0) {
         return;
     }
-    std::vector<std::vector<float>> voutputs;
     std::vector<float*> outputs;
     
-    std::vector<int> location_index = m_model_output_cfg.detection_output.location_index;
     int confidence_index = m_model_output_cfg.detection_output.confidence_index;
     int first_class_prob_index =
         m_model_output_cfg.detection_output.first_class_prob_index;
@@ -368,123 +528,258 @@ void AnchorTransformProcessor::process(std::vector<float*>& inputs) {
     // for sanity
     HVA_ASSERT(confidence_index >= 0 || first_class_prob_index >= 0);
 
-    int num_classes = m_model_output_cfg.num_classes;
-    int detection_output_size = m_model_output_cfg.detection_output.size;
+    size_t detection_output_size = m_model_output_cfg.detection_output.size;
 
     // for sanity
     if (m_model_output_cfg.detection_output.bbox_format != DetBBoxFormat_t::CENTER_SIZE) {
         throw std::invalid_argument(
             "AnchorTransform only support for detection_output.bbox_format with CENTER_SIZE!");
     }
+    if (m_cell_stride == 0) {
+        char log[512];
+        sprintf(log,
+                "Invalid model_output layput: DetOutputDimsLayout_t %d "
+                "recieved for processor: %s",
+                (int)m_model_output_cfg.layout, ProcessorName().c_str());
+        throw std::invalid_argument(log);
+    }
+
+    const size_t feature_size = (size_t)m_out_feature.first * (size_t)m_out_feature.second;
+    const size_t max_boxes = m_anchors.size() * feature_size;
+    AnchorDecodeScratch& scratch = t_anchorScratch;
+    if (scratch.boxes.size() < max_boxes * detection_output_size) {
+        scratch.boxes.resize(max_boxes * detection_output_size);
+    }
 
     // parse data in  output layer to bounding boxes
     for (auto& data : inputs) {
+        size_t num_boxes = 0;
         for (size_t anchor_index = 0; anchor_index < m_anchors.size(); ++anchor_index) {
-            const float anchor_scale_w = m_anchors[anchor_index].first;
-            const float anchor_scale_h = m_anchors[anchor_index].second;
-
-            for (size_t cell_index_x = 0; cell_index_x < m_out_feature.first; ++cell_index_x) {
-                for (size_t cell_index_y = 0; cell_index_y < m_out_feature.second; ++cell_index_y) {
-                    
-                    float confidence = 1.0;
-                    if (confidence_index >= 0) {
-                        confidence = trySigmoid(data[getIndex(confidence_index, anchor_index, cell_index_x, cell_index_y)]);
-                        // early filter bboxes with low confidence
-                        if (confidence < m_model_output_cfg.conf_thresh) {
-                            continue;
-                        }
-                    }
+            num_boxes += decodeAnchor(data + anchor_index * m_anchor_stride, anchor_index,
+                                      scratch.boxes.data() + num_boxes * detection_output_size);
+        }
 
-                    // obj class_prob exists, update confidence witho bbox_conf * class_prob
-                    if (first_class_prob_index >= 0) {
-                        float max_cls_prob = data[getIndex(first_class_prob_index, anchor_index, cell_index_x, cell_index_y)];
-                        for (size_t cls_idx = 1; cls_idx < num_classes; cls_idx ++) {
-                            
-                            const float bbox_class_prob = data[getIndex(first_class_prob_index + cls_idx, anchor_index, cell_index_x, cell_index_y)];
-                            max_cls_prob = bbox_class_prob > max_cls_prob ? bbox_class_prob : max_cls_prob;
-                        }
-                        confidence = confidence * trySigmoid(max_cls_prob);
-                        // early filter bboxes with low confidence
-                        if (confidence < m_model_output_cfg.conf_thresh) {
-                            continue;
-                        }
-                    }
+        // reuse the data pointer to save processed detection_outputs, there is at most one per anchor and cell
+        std::memcpy(data, scratch.boxes.data(), num_boxes * detection_output_size * sizeof(data[0]));
+        for (size_t idx = 0; idx < num_boxes; idx ++) {
+            outputs.push_back(data + idx * detection_output_size);
+        }
+    }
+    inputs = outputs;
+}
 
-                    // 
-                    // @brief anchor transform for yolo series
-                    // > (x, y) - coordinates of box center
-                    // > (h, w) - height and width of box, apply exponential function and multiply them by 
-                    //          the corresponding anchors to get the absolute height and width values 
-                    // 
-                    
-                    // get raw data from output blob
-                    float raw_x_center = trySigmoid(data[getIndex(location_index[0], anchor_index, cell_index_x, cell_index_y)]);
-                    float raw_y_center = trySigmoid(data[getIndex(location_index[1], anchor_index, cell_index_x, cell_index_y)]);
-                    float raw_w = trySigmoid(data[getIndex(location_index[2], anchor_index, cell_index_x, cell_index_y)]);
-                    float raw_h = trySigmoid(data[getIndex(location_index[3], anchor_index, cell_index_x, cell_index_y)]);
-
-                    // grid offset, i.e. y = factor * x + grid_offset
-                    // in YoloV2/V3, factor = 1.0, grid_offset = 0
-                    // in YoloV5, factor = 2.0, grid_offset = -0.5
-                    auto pred_bbox_xy = m_bbox_predition.pred_bbox_xy;
-                    const float bbox_x_center =
-                        (cell_index_x + raw_x_center * pred_bbox_xy.factor +
-                        pred_bbox_xy.grid_offset) /
-                        pred_bbox_xy.scale_w;
-                    const float bbox_y_center =
-                        (cell_index_y + raw_y_center * pred_bbox_xy.factor +
-                        pred_bbox_xy.grid_offset) /
-                        pred_bbox_xy.scale_h;
-                        
-                    // in YoloV2/V3, factor = 1.0, transform function is exponential
-                    // in YoloV5, factor = 2.0, transform function is square
-                    auto pred_bbox_wh = m_bbox_predition.pred_bbox_wh;
-                    const float bbox_w = (tryTransform(raw_w * pred_bbox_wh.factor) * anchor_scale_w) / pred_bbox_wh.scale_w;
-                    const float bbox_h = (tryTransform(raw_h * pred_bbox_wh.factor) * anchor_scale_h) / pred_bbox_wh.scale_h;
-
-                    // center to corner
-                    const float bbox_x = bbox_x_center - bbox_w / 2;
-                    const float bbox_y = bbox_y_center - bbox_h / 2;
-
-                    // assemble pure detection_outputs
-                    std::vector<float> vdata(detection_output_size);
-                    for (size_t det_idx = 0; det_idx < detection_output_size; det_idx ++) {
-
-                        // update bbox predictions
-                        if (det_idx == location_index[0]) {
-                            vdata[det_idx] = m_clip_normalized_rect ? clipNormalizedVal(bbox_x) : bbox_x;
-                        }
-                        else if (det_idx == location_index[1]) {
-                            vdata[det_idx] = m_clip_normalized_rect ? clipNormalizedVal(bbox_y) : bbox_y;
-                        }
-                        else if (det_idx == location_index[2]) {
-                            vdata[det_idx] = m_clip_normalized_rect ? clipNormalizedVal(bbox_w) : bbox_w;
-                        }
-                        else if (det_idx == location_index[3]) {
-                            vdata[det_idx] = m_clip_normalized_rect ? clipNormalizedVal(bbox_h) : bbox_h;
-                        }
-                        else {
-                            // sigmoid (if need) other fields in detection_outputs
-                            vdata[det_idx] = trySigmoid(data[getIndex(det_idx, anchor_index, cell_index_x, cell_index_y)]);
-                        }
-                    }
-                    voutputs.push_back(vdata);
+/**
+ * @brief decode the detections of one anchor whose confidence passes conf_thresh
+ */
+size_t AnchorTransformProcessor::decodeAnchor(const float* anchor_data, size_t anchor_index, float* boxes) {
+
+    const AnchorKernels& kernels = anchorKernels();
+    AnchorDecodeScratch& scratch = t_anchorScratch;
+
+    const std::vector<int>& location_index = m_model_output_cfg.detection_output.location_index;
+    const int confidence_index = m_model_output_cfg.detection_output.confidence_index;
+    const int first_class_prob_index = m_model_output_cfg.detection_output.first_class_prob_index;
+    const size_t num_classes = m_model_output_cfg.num_classes;
+    const size_t detection_output_size = m_model_output_cfg.detection_output.size;
+    const float conf_thresh = m_model_output_cfg.conf_thresh;
+
+    const size_t feature_w = m_out_feature.first;
+    const size_t feature_size = feature_w * (size_t)m_out_feature.second;
+    const float* class_data = first_class_prob_index >= 0 ? anchor_data + first_class_prob_index * m_field_stride : nullptr;
+
+    // 
+    // Step 1. threshold pass over the objectness plane, or over the best class score if there is no objectness
+    // 
+    scratch.cells.resize(feature_size);
+    size_t count;
+    if (confidence_index >= 0) {
+        count = kernels.scan(anchor_data + confidence_index * m_field_stride, feature_size, m_cell_stride,
+                             m_raw_conf_thresh, scratch.cells.data());
+    }
+    else {
+        scratch.max_cls.resize(feature_size);
+        float* max_cls = scratch.max_cls.data();
+        if (m_cell_stride == 1) {
+            // channels-first, one contiguous plane per class
+            std::memcpy(max_cls, class_data, feature_size * sizeof(float));
+            for (size_t cls_idx = 1; cls_idx < num_classes; cls_idx ++) {
+                const float* plane = class_data + cls_idx * m_field_stride;
+                for (size_t cell = 0; cell < feature_size; cell ++) {
+                    max_cls[cell] = std::max(max_cls[cell], plane[cell]);
                 }
-                int a = 0;
             }
         }
+        else {
+            for (size_t cell = 0; cell < feature_size; cell ++) {
+                const float* cls = class_data + cell * m_cell_stride;
+                max_cls[cell] = *std::max_element(cls, cls + num_classes);
+            }
+        }
+        count = kernels.scan(max_cls, feature_size, 1, m_raw_conf_thresh, scratch.cells.data());
+    }
+    if (count == 0) {
+        return 0;
+    }
 
-        // reuse the data pointer to save processed detection_outputs 
-        for (size_t idx = 0; idx < voutputs.size(); idx ++) {
-            
-            size_t offset = idx * detection_output_size;
-            memset(data + offset, 0, detection_output_size * sizeof(data[0]));
-            memcpy(data + offset, voutputs[idx].data(), detection_output_size * sizeof(data[0]));
+    // keep the cell x outer, cell y inner order of the detections
+    int32_t* cells = scratch.cells.data();
+    std::sort(cells, cells + count, [feature_w](int32_t a, int32_t b) {
+        const size_t ax = a % feature_w;
+        const size_t bx = b % feature_w;
+        return ax < bx || (ax == bx && a < b);
+    });
+
+    // 
+    // Step 2. gather the raw outputs of the candidates
+    // 
+    scratch.conf.resize(count);
+    scratch.cls.resize(count);
+    scratch.x.resize(count);
+    scratch.y.resize(count);
+    scratch.w.resize(count);
+    scratch.h.resize(count);
+    float* conf = scratch.conf.data();
+    float* cls = scratch.cls.data();
+    float* x = scratch.x.data();
+    float* y = scratch.y.data();
+    float* w = scratch.w.data();
+    float* h = scratch.h.data();
+    const size_t x_offset = location_index[0] * m_field_stride;
+    const size_t y_offset = location_index[1] * m_field_stride;
+    const size_t w_offset = location_index[2] * m_field_stride;
+    const size_t h_offset = location_index[3] * m_field_stride;
+    for (size_t i = 0; i < count; i ++) {
+        const size_t offset = cells[i] * m_cell_stride;
+        const float* cell_data = anchor_data + offset;
+        conf[i] = confidence_index >= 0 ? cell_data[confidence_index * m_field_stride] : 0.0f;
+        if (confidence_index < 0) {
+            cls[i] = scratch.max_cls[cells[i]];
+        }
+        else if (class_data) {
+            const float* cell_cls = class_data + offset;
+            float max_cls_prob = cell_cls[0];
+            for (size_t cls_idx = 1; cls_idx < num_classes; cls_idx ++) {
+                max_cls_prob = std::max(max_cls_prob, cell_cls[cls_idx * m_field_stride]);
+            }
+            cls[i] = max_cls_prob;
+        }
+        x[i] = cell_data[x_offset];
+        y[i] = cell_data[y_offset];
+        w[i] = cell_data[w_offset];
+        h[i] = cell_data[h_offset];
+    }
 
-            outputs.push_back(data + offset);
+    // 
+    // Step 3. activation and bbox transform of the candidates
+    // 
+    if (m_output_sigmoid_activation) {
+        if (confidence_index >= 0) {
+            kernels.sigmoid(conf, count);
         }
+        if (class_data) {
+            kernels.sigmoid(cls, count);
+        }
+        kernels.sigmoid(x, count);
+        kernels.sigmoid(y, count);
+        kernels.sigmoid(w, count);
+        kernels.sigmoid(h, count);
     }
-    inputs = outputs;
+
+    // in YoloV2/V3, factor = 1.0, transform function is exponential
+    // in YoloV5, factor = 2.0, transform function is square
+    const auto& pred_bbox_wh = m_bbox_predition.pred_bbox_wh;
+    for (size_t i = 0; i < count; i ++) {
+        w[i] *= pred_bbox_wh.factor;
+        h[i] *= pred_bbox_wh.factor;
+    }
+    switch (pred_bbox_wh.function) {
+        case TransfromFunction_t::EXPONENTIAL:
+            kernels.exp(w, count);
+            kernels.exp(h, count);
+            break;
+        case TransfromFunction_t::SQUARE:
+            for (size_t i = 0; i < count; i ++) {
+                w[i] *= w[i];
+                h[i] *= h[i];
+            }
+            break;
+        default:
+            throw std::invalid_argument(
+                "Unknown bbox transform function is specified in model_proc, "
+                "supported: " +
+                supportedTransformFuncs());
+    }
+
+    // 
+    // Step 4. exact confidence check, assemble the detections passing it
+    // > (x, y) - coordinates of box center
+    // > (h, w) - height and width of box, multiplied by the corresponding anchors
+    // 
+    const float anchor_scale_w = m_anchors[anchor_index].first;
+    const float anchor_scale_h = m_anchors[anchor_index].second;
+    const auto& pred_bbox_xy = m_bbox_predition.pred_bbox_xy;
+    size_t num_boxes = 0;
+    for (size_t i = 0; i < count; i ++) {
+        float confidence = 1.0;
+        if (confidence_index >= 0) {
+            confidence = conf[i];
+            if (confidence < conf_thresh) {
+                continue;
+            }
+        }
+
+        // obj class_prob exists, update confidence witho bbox_conf * class_prob
+        if (class_data) {
+            confidence = confidence * cls[i];
+            if (confidence < conf_thresh) {
+                continue;
+            }
+        }
+
+        // grid offset, i.e. y = factor * x + grid_offset
+        // in YoloV2/V3, factor = 1.0, grid_offset = 0
+        // in YoloV5, factor = 2.0, grid_offset = -0.5
+        const size_t cell_index_x = cells[i] % feature_w;
+        const size_t cell_index_y = cells[i] / feature_w;
+        const float bbox_x_center =
+            (cell_index_x + x[i] * pred_bbox_xy.factor + pred_bbox_xy.grid_offset) / pred_bbox_xy.scale_w;
+        const float bbox_y_center =
+            (cell_index_y + y[i] * pred_bbox_xy.factor + pred_bbox_xy.grid_offset) / pred_bbox_xy.scale_h;
+        const float bbox_w = (w[i] * anchor_scale_w) / pred_bbox_wh.scale_w;
+        const float bbox_h = (h[i] * anchor_scale_h) / pred_bbox_wh.scale_h;
+
+        // center to corner, kept in the arrays until the other fields are activated, num_boxes <= i
+        x[num_boxes] = bbox_x_center - bbox_w / 2;
+        y[num_boxes] = bbox_y_center - bbox_h / 2;
+        w[num_boxes] = bbox_w;
+        h[num_boxes] = bbox_h;
+
+        // raw detection_outputs of the cell
+        const float* cell_data = anchor_data + cells[i] * m_cell_stride;
+        float* box = boxes + num_boxes * detection_output_size;
+        if (m_field_stride == 1) {
+            std::memcpy(box, cell_data, detection_output_size * sizeof(float));
+        }
+        else {
+            for (size_t det_idx = 0; det_idx < detection_output_size; det_idx ++) {
+                box[det_idx] = cell_data[det_idx * m_field_stride];
+            }
+        }
+        num_boxes ++;
+    }
+
+    // sigmoid (if need) other fields in detection_outputs, then update bbox predictions
+    if (m_output_sigmoid_activation) {
+        kernels.sigmoid(boxes, num_boxes * detection_output_size);
+    }
+    for (size_t idx = 0; idx < num_boxes; idx ++) {
+        float* box = boxes + idx * detection_output_size;
+        box[location_index[0]] = m_clip_normalized_rect ? clipNormalizedVal(x[idx]) : x[idx];
+        box[location_index[1]] = m_clip_normalized_rect ? clipNormalizedVal(y[idx]) : y[idx];
+        box[location_index[2]] = m_clip_normalized_rect ? clipNormalizedVal(w[idx]) : w[idx];
+        box[location_index[3]] = m_clip_normalized_rect ? clipNormalizedVal(h[idx]) : h[idx];
+    }
+    return num_boxes;
 }
 
 /**
@@ -515,66 +810,31 @@ AnchorTransformProcessor::checkFunctions(std::string func_name) {
 
 
 /**
- * @brief get output index in blob data
- * @param index  index of detection output field, such as: [x, y, w, h, class_0, class_1, ...]
- *
-*/
-size_t AnchorTransformProcessor::getIndex(size_t index, size_t anchor_index, size_t cell_index_x, size_t cell_index_y) {
+ * @brief set the blob strides for model_output.layout
+ */
+void AnchorTransformProcessor::setLayoutStrides() {
 
-    size_t feature_w = m_out_feature.first;
-    size_t feature_h = m_out_feature.second;
-    size_t feature_size = feature_w * feature_h;                        // e.g, 13*13
+    size_t feature_size = (size_t)m_out_feature.first * (size_t)m_out_feature.second;   // e.g, 13*13
     size_t box_size = m_model_output_cfg.detection_output.size;         // e.g, len([x, y, w, h, class_0, class_1, ...]) = 85
     size_t num_anchors = m_anchors.size();                              // num anchors
 
     switch (m_model_output_cfg.layout) {
         case DetOutputDimsLayout_t::BCxCy:
-            {
-                // offset for each proposal
-                size_t offset = anchor_index * box_size * feature_size + cell_index_y * feature_w + cell_index_x;
-                return index * feature_size + offset;
-            }
+            // [anchor][field][cell_y][cell_x]
+            m_cell_stride = 1;
+            m_field_stride = feature_size;
+            m_anchor_stride = box_size * feature_size;
+            break;
         case DetOutputDimsLayout_t::CxCyB:
-            {
-                // offset for each proposal
-                size_t offset = (cell_index_y * feature_w + cell_index_x) * num_anchors * box_size + anchor_index * box_size;
-                return offset + index;
-            }
-            default: {
-                char log[512];
-                sprintf(log,
-                        "Invalid model_output layput: DetOutputDimsLayout_t %d "
-                        "recieved for processor: %s",
-                        (int)m_model_output_cfg.layout, ProcessorName().c_str());
-                throw std::invalid_argument(log);
-            } break;
-    }
-}
-
-/**
-     * @brief sigmoid(x) if m_output_sigmoid_activation = true
-    */
-float AnchorTransformProcessor::trySigmoid(float x) {
-    if (m_output_sigmoid_activation)
-        return 1 / (1 + std::exp(-x));
-    else
-        return x;
-}
-
-/**
- * @brief transform function apply on x according to the function type
-*/
-float AnchorTransformProcessor::tryTransform(float x) {
-    switch (m_bbox_predition.pred_bbox_wh.function) {
-        case TransfromFunction_t::EXPONENTIAL:
-            return std::exp(x);
-        case TransfromFunction_t::SQUARE:
-            return std::pow(x, 2);
+            // [cell_y][cell_x][anchor][field]
+            m_cell_stride = num_anchors * box_size;
+            m_field_stride = 1;
+            m_anchor_stride = box_size;
+            break;
         default:
-            throw std::invalid_argument(
-                "Unknown bbox transform function is specified in model_proc, "
-                "supported: " +
-                supportedTransformFuncs());
+            // rejected by process()
+            m_cell_stride = m_field_stride = m_anchor_stride = 0;
+            break;
     }
 }
 
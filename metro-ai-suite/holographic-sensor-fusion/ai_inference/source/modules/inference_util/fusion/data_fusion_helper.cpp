@@ -16,8 +16,11 @@
 
 #include "modules/inference_util/fusion/data_fusion_helper.hpp"
 
+#include <immintrin.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <cfloat>
 #include <cstdint>
 #include <fstream>
 #include <string>
@@ -121,14 +124,44 @@ cv::Rect2f CoordinateTransformation::pixel2Radar(cv::Rect2i &rect)
 
 cv::Rect2f CoordinateTransformation::camera2Radar(cv::Mat &disparityMap, cv::Rect2i &rect)
 {
-    cv::Mat pcl;
-
-    if (hva::hvaFailure == generatePcl(disparityMap, pcl)) {
-        HVA_ERROR("generate pcl from disparity map failed!");
+    if (disparityMap.type() != CV_32F || disparityMap.empty()) {
+        HVA_ERROR("type of disparityMap is not correct or disparityMap is empty!");
         return cv::Rect2f(0, 0, 0, 0);
     }
     // cv::Rect2i centerRect = getCenterBox(rect, 0.8, 0.7);
-    cv::Rect2f output = pcl2Radar(pcl, rect);
+    double sums[3];
+    size_t count = accumulateRoi(disparityMap, rect, sums);
+    return meanToRadar(sums, count);
+}
+
+std::vector<cv::Rect2f> CoordinateTransformation::camera2Radar(cv::Mat &disparityMap, std::vector<cv::Rect2i> &rects)
+{
+    std::vector<cv::Rect2f> output(rects.size(), cv::Rect2f(0, 0, 0, 0));
+    if (disparityMap.type() != CV_32F || disparityMap.empty()) {
+        HVA_ERROR("type of disparityMap is not correct or disparityMap is empty!");
+        return output;
+    }
+
+    // overlapping detections reproject the same pixels again, past the frame size one full pcl is cheaper
+    size_t roiArea = 0;
+    int x0, y0, x1, y1;
+    for (auto &rect : rects) {
+        if (clipRoi(disparityMap, rect, x0, y0, x1, y1)) {
+            roiArea += (size_t)(x1 - x0 + 1) * (y1 - y0 + 1);
+        }
+    }
+    bool fullFrame = rects.size() > 1 && roiArea > disparityMap.total();
+    if (fullFrame && hva::hvaFailure == generatePcl(disparityMap, m_pcl)) {
+        HVA_ERROR("generate pcl from disparity map failed!");
+        return output;
+    }
+
+    double sums[3];
+    size_t count;
+    for (size_t i = 0; i < rects.size(); i++) {
+        count = fullFrame ? accumulatePclRoi(m_pcl, rects[i], sums) : accumulateRoi(disparityMap, rects[i], sums);
+        output[i] = meanToRadar(sums, count);
+    }
     return output;
 }
 
@@ -138,8 +171,8 @@ hva::hvaStatus_t CoordinateTransformation::generatePcl(cv::Mat &disparityMap, cv
         HVA_ERROR("type of disparityMap is not correct or disparityMap is empty!");
         return hva::hvaFailure;
     }
-    // 3-channel matrix for containing the reprojected 3D world coordinates
-    pcl = cv::Mat::zeros(disparityMap.size(), CV_32FC3);
+    // 3-channel matrix for containing the reprojected 3D world coordinates, every pixel is written below
+    pcl.create(disparityMap.size(), CV_32FC3);
 
     cv::reprojectImageTo3D(disparityMap, pcl, m_qMatrix, false, CV_32F);
 
@@ -194,71 +227,255 @@ hva::hvaStatus_t CoordinateTransformation::generatePcl(cv::Mat &disparityMap, cv
     return hva::hvaSuccess;
 }
 
-cv::Rect2f CoordinateTransformation::pcl2Radar(cv::Mat &pcl, cv::Rect2i &rect)
+//
+// ROI reductions
+//
+// Both kernels reproject with the same operations in the same order, this file is built with -ffp-contract=off so
+// that none of them gets fused into an FMA and both select the same points. The AVX2 kernels keep four or eight
+// partial sums per coordinate, their sums agree with the scalar ones up to rounding.
+//
+
+static size_t sumDisparityRoiScalar(const cv::Mat &disparityMap, int x0, int y0, int x1, int y1, const double q[4][4], const float bounds[6],
+                                    double sums[3])
 {
-    cv::Mat selectedPcl;
-    // for (int i = 0; i < pclRect.rows; i++) {
-    //     cv::Vec3f *out3DPtr = pclRect.ptr<cv::Vec3f>(i);
-    //     for (int j = 0; j < pclRect.cols; j++) {
-    //         cv::Vec3f &point = out3DPtr[j];
-    //         if (point[0] > m_pclConstraints[0] && point[1] >
-    //         m_pclConstraints[2] && point[2] > m_pclConstraints[4]) {
-    //             selectedPcl.push_back(point);
-    //         }
-    //     }
-    // }
-    for (int i = rect.y; i < rect.y + rect.height + 1; i++) {
-        cv::Vec3f *out3DPtr = pcl.ptr<cv::Vec3f>(i);
-        for (int j = rect.x; j < rect.x + rect.width + 1; j++) {
-            cv::Vec3f &point = out3DPtr[j];
-            if (point[0] > m_pclConstraints[0] && point[1] > m_pclConstraints[2] && point[2] > m_pclConstraints[4]) {
-                cv::Mat temp = (cv::Mat_<float>(1, 3) << point[0], point[1], point[2]);
-                selectedPcl.push_back(temp);
-            }
+    double sumX = 0, sumY = 0, sumZ = 0;
+    size_t count = 0;
+
+    for (int y = y0; y <= y1; y++) {
+        const float *disp = disparityMap.ptr<float>(y);
+        const double qx0 = q[0][1] * y + q[0][3], qy0 = q[1][1] * y + q[1][3];
+        const double qz0 = q[2][1] * y + q[2][3], qw0 = q[3][1] * y + q[3][3];
+        for (int x = x0; x <= x1; x++) {
+            const double d = disp[x];
+            const double iW = 1. / (qw0 + q[3][0] * x + q[3][2] * d);
+            const float px = (float)((qx0 + q[0][0] * x + q[0][2] * d) * iW);
+            const float py = (float)((qy0 + q[1][0] * x + q[1][2] * d) * iW);
+            const float pz = (float)((qz0 + q[2][0] * x + q[2][2] * d) * iW);
+            const bool selected = (px > bounds[0]) & (px <= bounds[1]) & (py > bounds[2]) & (py <= bounds[3]) & (pz > bounds[4]) & (pz <= bounds[5]);
+            sumX += selected ? px : 0.0f;
+            sumY += selected ? py : 0.0f;
+            sumZ += selected ? pz : 0.0f;
+            count += selected;
         }
     }
-    if (100 > selectedPcl.rows) {
-        return cv::Rect2f(0, 0, 0, 0);
+
+    sums[0] = sumX;
+    sums[1] = sumY;
+    sums[2] = sumZ;
+    return count;
+}
+
+static size_t sumPclRoiScalar(const cv::Mat &pcl, int x0, int y0, int x1, int y1, const float lowerBounds[3], double sums[3])
+{
+    double sumX = 0, sumY = 0, sumZ = 0;
+    size_t count = 0;
+
+    for (int y = y0; y <= y1; y++) {
+        const float *point = pcl.ptr<float>(y) + 3 * x0;
+        for (int x = x0; x <= x1; x++, point += 3) {
+            const bool selected = (point[0] > lowerBounds[0]) & (point[1] > lowerBounds[1]) & (point[2] > lowerBounds[2]);
+            sumX += selected ? point[0] : 0.0f;
+            sumY += selected ? point[1] : 0.0f;
+            sumZ += selected ? point[2] : 0.0f;
+            count += selected;
+        }
     }
 
-    cv::Mat targetPoint = (cv::Mat_<float>(1, 4) << cv::mean(selectedPcl.col(0))[0], cv::mean(selectedPcl.col(1))[0], cv::mean(selectedPcl.col(2))[0], 1);
-    cv::Mat radarCoords = targetPoint * m_registrationMatrix;
-    std::cout << targetPoint << std::endl;
-    std::cout << radarCoords << std::endl;
-    HVA_DEBUG("lowerX(%f), lowerY(%f), upperX(%f), upperY(%f)", radarCoords.ptr<float>(0)[1], radarCoords.ptr<float>(0)[0], 4.2, 1.7);
-    return cv::Rect2f(radarCoords.ptr<float>(0)[1], radarCoords.ptr<float>(0)[0], 4.2, 1.7);
+    sums[0] = sumX;
+    sums[1] = sumY;
+    sums[2] = sumZ;
+    return count;
+}
 
-    // return cv::Rect2f(cv::mean(selectedPcl.col(2))[0], cv::mean(selectedPcl.col(0))[0], 4.2, 1.7);
+__attribute__((target("avx2"))) static inline double sumLanesAVX2(__m256d v)
+{
+    const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
 
-    // std::vector<cv::Mat> channels(3);
-    // cv::Mat targetPoint2 = (cv::Mat_<float>(1, 4) << medianMat(selectedPcl.col(0)), medianMat(selectedPcl.col(1)), medianMat(selectedPcl.col(2)), 1);
-    // cv::Mat radarCoords2 = targetPoint2 * m_registrationMatrix;
-    // std::cout << targetPoint2 << std::endl;
-    // std::cout << radarCoords2 << std::endl;
-    // HVA_DEBUG("lowerX(%f), lowerY(%f), upperX(%f), upperY(%f)", radarCoords2.ptr<float>(0)[1], radarCoords2.ptr<float>(0)[0], 4.2, 1.7);
-    // // return cv::Rect2f(radarCoords.ptr<float>(0)[1], radarCoords.ptr<float>(0)[0], 4.2, 1.7);
+__attribute__((target("avx2"))) static size_t sumDisparityRoiAVX2(const cv::Mat &disparityMap, int x0, int y0, int x1, int y1, const double q[4][4],
+                                                                   const float bounds[6], double sums[3])
+{
+    const __m128 lo0 = _mm_set1_ps(bounds[0]), hi0 = _mm_set1_ps(bounds[1]);
+    const __m128 lo1 = _mm_set1_ps(bounds[2]), hi1 = _mm_set1_ps(bounds[3]);
+    const __m128 lo2 = _mm_set1_ps(bounds[4]), hi2 = _mm_set1_ps(bounds[5]);
+    const __m256d q00 = _mm256_set1_pd(q[0][0]), q02 = _mm256_set1_pd(q[0][2]);
+    const __m256d q10 = _mm256_set1_pd(q[1][0]), q12 = _mm256_set1_pd(q[1][2]);
+    const __m256d q20 = _mm256_set1_pd(q[2][0]), q22 = _mm256_set1_pd(q[2][2]);
+    const __m256d q30 = _mm256_set1_pd(q[3][0]), q32 = _mm256_set1_pd(q[3][2]);
+    const __m256d one = _mm256_set1_pd(1.);
+    __m256d sumX = _mm256_setzero_pd(), sumY = _mm256_setzero_pd(), sumZ = _mm256_setzero_pd();
+    double tailX = 0, tailY = 0, tailZ = 0;
+    size_t count = 0;
+
+    for (int y = y0; y <= y1; y++) {
+        const float *disp = disparityMap.ptr<float>(y);
+        const double qx0 = q[0][1] * y + q[0][3], qy0 = q[1][1] * y + q[1][3];
+        const double qz0 = q[2][1] * y + q[2][3], qw0 = q[3][1] * y + q[3][3];
+        const __m256d vqx0 = _mm256_set1_pd(qx0), vqy0 = _mm256_set1_pd(qy0);
+        const __m256d vqz0 = _mm256_set1_pd(qz0), vqw0 = _mm256_set1_pd(qw0);
+        int x = x0;
+        for (; x + 3 <= x1; x += 4) {
+            const __m256d vx = _mm256_setr_pd(x, x + 1, x + 2, x + 3);
+            const __m256d d = _mm256_cvtps_pd(_mm_loadu_ps(disp + x));
+            const __m256d iW = _mm256_div_pd(one, _mm256_add_pd(_mm256_add_pd(vqw0, _mm256_mul_pd(q30, vx)), _mm256_mul_pd(q32, d)));
+            const __m128 px = _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(vqx0, _mm256_mul_pd(q00, vx)), _mm256_mul_pd(q02, d)), iW));
+            const __m128 py = _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(vqy0, _mm256_mul_pd(q10, vx)), _mm256_mul_pd(q12, d)), iW));
+            const __m128 pz = _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(vqz0, _mm256_mul_pd(q20, vx)), _mm256_mul_pd(q22, d)), iW));
+            const __m128 selected = _mm_and_ps(
+                _mm_and_ps(_mm_and_ps(_mm_cmp_ps(px, lo0, _CMP_GT_OQ), _mm_cmp_ps(px, hi0, _CMP_LE_OQ)),
+                           _mm_and_ps(_mm_cmp_ps(py, lo1, _CMP_GT_OQ), _mm_cmp_ps(py, hi1, _CMP_LE_OQ))),
+                _mm_and_ps(_mm_cmp_ps(pz, lo2, _CMP_GT_OQ), _mm_cmp_ps(pz, hi2, _CMP_LE_OQ)));
+            sumX = _mm256_add_pd(sumX, _mm256_cvtps_pd(_mm_and_ps(px, selected)));
+            sumY = _mm256_add_pd(sumY, _mm256_cvtps_pd(_mm_and_ps(py, selected)));
+            sumZ = _mm256_add_pd(sumZ, _mm256_cvtps_pd(_mm_and_ps(pz, selected)));
+            count += __builtin_popcount(_mm_movemask_ps(selected));
+        }
+        for (; x <= x1; x++) {
+            const double d = disp[x];
+            const double iW = 1. / (qw0 + q[3][0] * x + q[3][2] * d);
+            const float px = (float)((qx0 + q[0][0] * x + q[0][2] * d) * iW);
+            const float py = (float)((qy0 + q[1][0] * x + q[1][2] * d) * iW);
+            const float pz = (float)((qz0 + q[2][0] * x + q[2][2] * d) * iW);
+            const bool selected = (px > bounds[0]) & (px <= bounds[1]) & (py > bounds[2]) & (py <= bounds[3]) & (pz > bounds[4]) & (pz <= bounds[5]);
+            tailX += selected ? px : 0.0f;
+            tailY += selected ? py : 0.0f;
+            tailZ += selected ? pz : 0.0f;
+            count += selected;
+        }
+    }
+
+    sums[0] = sumLanesAVX2(sumX) + tailX;
+    sums[1] = sumLanesAVX2(sumY) + tailY;
+    sums[2] = sumLanesAVX2(sumZ) + tailZ;
+    return count;
+}
+
+__attribute__((target("avx2"))) static size_t sumPclRoiAVX2(const cv::Mat &pcl, int x0, int y0, int x1, int y1, const float lowerBounds[3],
+                                                             double sums[3])
+{
+    const __m256 lo0 = _mm256_set1_ps(lowerBounds[0]), lo1 = _mm256_set1_ps(lowerBounds[1]), lo2 = _mm256_set1_ps(lowerBounds[2]);
+    // x of eight interleaved xyz points, y and z follow at +1 and +2
+    const __m256i lanes = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    __m256d sumX = _mm256_setzero_pd(), sumY = _mm256_setzero_pd(), sumZ = _mm256_setzero_pd();
+    double tailX = 0, tailY = 0, tailZ = 0;
+    size_t count = 0;
+
+    for (int y = y0; y <= y1; y++) {
+        const float *point = pcl.ptr<float>(y) + 3 * x0;
+        int x = x0;
+        for (; x + 7 <= x1; x += 8, point += 24) {
+            const __m256 px = _mm256_i32gather_ps(point, lanes, 4);
+            const __m256 py = _mm256_i32gather_ps(point + 1, lanes, 4);
+            const __m256 pz = _mm256_i32gather_ps(point + 2, lanes, 4);
+            const __m256 selected = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(px, lo0, _CMP_GT_OQ), _mm256_cmp_ps(py, lo1, _CMP_GT_OQ)),
+                                                  _mm256_cmp_ps(pz, lo2, _CMP_GT_OQ));
+            const __m256 sx = _mm256_and_ps(px, selected), sy = _mm256_and_ps(py, selected), sz = _mm256_and_ps(pz, selected);
+            sumX = _mm256_add_pd(sumX, _mm256_add_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(sx)), _mm256_cvtps_pd(_mm256_extractf128_ps(sx, 1))));
+            sumY = _mm256_add_pd(sumY, _mm256_add_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(sy)), _mm256_cvtps_pd(_mm256_extractf128_ps(sy, 1))));
+            sumZ = _mm256_add_pd(sumZ, _mm256_add_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(sz)), _mm256_cvtps_pd(_mm256_extractf128_ps(sz, 1))));
+            count += __builtin_popcount(_mm256_movemask_ps(selected));
+        }
+        for (; x <= x1; x++, point += 3) {
+            const bool selected = (point[0] > lowerBounds[0]) & (point[1] > lowerBounds[1]) & (point[2] > lowerBounds[2]);
+            tailX += selected ? point[0] : 0.0f;
+            tailY += selected ? point[1] : 0.0f;
+            tailZ += selected ? point[2] : 0.0f;
+            count += selected;
+        }
+    }
+
+    sums[0] = sumLanesAVX2(sumX) + tailX;
+    sums[1] = sumLanesAVX2(sumY) + tailY;
+    sums[2] = sumLanesAVX2(sumZ) + tailZ;
+    return count;
+}
+
+RoiSumKernel detectRoiSumKernel()
+{
+    static const RoiSumKernel kernel = []() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? RoiSumKernel::AVX2 : RoiSumKernel::Scalar;
+    }();
+    return kernel;
+}
+
+bool isRoiSumKernelSupported(RoiSumKernel kernel)
+{
+    return RoiSumKernel::Scalar == kernel || RoiSumKernel::AVX2 == detectRoiSumKernel();
+}
+
+size_t sumDisparityRoi(RoiSumKernel kernel, const cv::Mat &disparityMap, int x0, int y0, int x1, int y1, const double q[4][4], const float bounds[6],
+                       double sums[3])
+{
+    if (RoiSumKernel::AVX2 == kernel && isRoiSumKernelSupported(kernel)) {
+        return sumDisparityRoiAVX2(disparityMap, x0, y0, x1, y1, q, bounds, sums);
+    }
+    return sumDisparityRoiScalar(disparityMap, x0, y0, x1, y1, q, bounds, sums);
+}
+
+size_t sumPclRoi(RoiSumKernel kernel, const cv::Mat &pcl, int x0, int y0, int x1, int y1, const float lowerBounds[3], double sums[3])
+{
+    if (RoiSumKernel::AVX2 == kernel && isRoiSumKernelSupported(kernel)) {
+        return sumPclRoiAVX2(pcl, x0, y0, x1, y1, lowerBounds, sums);
+    }
+    return sumPclRoiScalar(pcl, x0, y0, x1, y1, lowerBounds, sums);
+}
+
+bool CoordinateTransformation::clipRoi(const cv::Mat &frame, const cv::Rect2i &rect, int &x0, int &y0, int &x1, int &y1)
+{
+    x0 = std::max(rect.x, 0);
+    y0 = std::max(rect.y, 0);
+    x1 = std::min(rect.x + rect.width, frame.cols - 1);
+    y1 = std::min(rect.y + rect.height, frame.rows - 1);
+    return x0 <= x1 && y0 <= y1;
+}
+
+size_t CoordinateTransformation::accumulateRoi(cv::Mat &disparityMap, cv::Rect2i &rect, double sums[3])
+{
+    int x0, y0, x1, y1;
+    sums[0] = sums[1] = sums[2] = 0;
+    if (!clipRoi(disparityMap, rect, x0, y0, x1, y1)) {
+        return 0;
+    }
+
+    // a clamped coordinate equals its lower bound and is never selected, so a point is kept iff every coordinate
+    // lies in (lower, upper]; NaN fails every compare as it does in generatePcl
+    const float bounds[6] = {(float)m_pclConstraints[0], (float)m_pclConstraints[1], (float)m_pclConstraints[2],
+                             (float)m_pclConstraints[3], (float)m_pclConstraints[4], (float)m_pclConstraints[5]};
+    return sumDisparityRoi(m_roiSumKernel, disparityMap, x0, y0, x1, y1, m_q, bounds, sums);
+}
+
+size_t CoordinateTransformation::accumulatePclRoi(cv::Mat &pcl, cv::Rect2i &rect, double sums[3])
+{
+    int x0, y0, x1, y1;
+    sums[0] = sums[1] = sums[2] = 0;
+    if (!clipRoi(pcl, rect, x0, y0, x1, y1)) {
+        return 0;
+    }
 
-    // cv::Mat selectedPclAddOnes;
-    // cv::Mat onesColumn = cv::Mat::ones(selectedPcl.rows, 1, selectedPcl.type());
-    // cv::hconcat(selectedPcl, onesColumn, selectedPclAddOnes);
-    // cv::Mat radarCoords3 = selectedPclAddOnes * m_registrationMatrix;
+    const float lowerBounds[3] = {(float)m_pclConstraints[0], (float)m_pclConstraints[2], (float)m_pclConstraints[4]};
+    return sumPclRoi(m_roiSumKernel, pcl, x0, y0, x1, y1, lowerBounds, sums);
+}
 
-    // float lowerX, upperX;
-    // cv::Scalar colFirstMean, colFirstStd;
-    // cv::meanStdDev(radarCoords3.col(0), colFirstMean, colFirstStd);
-    // lowerX = colFirstMean[0] - colFirstStd[0] * 1.0;
-    // upperX = colFirstMean[0] + colFirstStd[0] * 1.0;
+cv::Rect2f CoordinateTransformation::meanToRadar(const double sums[3], size_t count)
+{
+    if (100 > count) {
+        return cv::Rect2f(0, 0, 0, 0);
+    }
 
-    // float lowerY, upperY;
-    // cv::Scalar colSecondMean, colSecondStd;
-    // cv::meanStdDev(radarCoords3.col(1), colSecondMean, colSecondStd);
-    // lowerY = colSecondMean[0] - colSecondStd[0] * 1.0;
-    // upperY = colSecondMean[0] + colSecondStd[0] * 1.0;
-    // HVA_DEBUG("colFirstMean(%f), colSecondMean(%f)", colFirstMean, colSecondMean);
-    // HVA_DEBUG("lowerX(%f), lowerY(%f), upperX(%f), upperY(%f)", lowerX, lowerY, upperX, upperY);
-    // // return cv::Rect2f(lowerY, lowerX, upperY - lowerY, upperX - lowerX);
+    cv::Mat targetPoint = (cv::Mat_<float>(1, 4) << sums[0] / count, sums[1] / count, sums[2] / count, 1);
+    cv::Mat radarCoords = targetPoint * m_registrationMatrix;
+    HVA_DEBUG("target point (%f, %f, %f), radar coords (%f, %f)", targetPoint.ptr<float>(0)[0], targetPoint.ptr<float>(0)[1], targetPoint.ptr<float>(0)[2],
+              radarCoords.ptr<float>(0)[0], radarCoords.ptr<float>(0)[1]);
+    return cv::Rect2f(radarCoords.ptr<float>(0)[1], radarCoords.ptr<float>(0)[0], 4.2, 1.7);
+}
 
-    // return cv::Rect2f(radarCoords.ptr<float>(0)[1], radarCoords.ptr<float>(0)[0], 4.2, 1.7);
+cv::Rect2f CoordinateTransformation::pcl2Radar(cv::Mat &pcl, cv::Rect2i &rect)
+{
+    double sums[3];
+    size_t count = accumulatePclRoi(pcl, rect, sums);
+    return meanToRadar(sums, count);
 }
 
 
@@ -327,6 +544,11 @@ hva::hvaStatus_t CoordinateTransformation::readMatrix(std::string filePath, std:
     if ("q" == type) {
         dataArr = reinterpret_cast<float *>(buf);
         m_qMatrix = cv::Mat(4, 4, CV_32FC1, dataArr).clone();
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                m_q[i][j] = dataArr[i * 4 + j];
+            }
+        }
     }
     else if ("registration" == type) {
         dataArr = reinterpret_cast<float *>(buf);
@@ -396,6 +618,10 @@ hva::hvaStatus_t MultiCameraFuser::readMatrix(std::string &filePath, int32_t cam
 
     dataArr = reinterpret_cast<float *>(buf);
     m_homographyMatrixMap[cameraID] = cv::Mat(3, 3, CV_32FC1, dataArr).clone();
+    std::array<double, 9> &table = m_warpTables[cameraID];
+    for (size_t i = 0; i < table.size(); i++) {
+        table[i] = dataArr[i];
+    }
 
     delete[] buf;
     return hva::hvaSuccess;
@@ -424,76 +650,232 @@ float MultiCameraFuser::computeIoU(const cv::Rect2f &a, const cv::Rect2f &b)
     return unionArea > 0 ? interArea / unionArea : 0;
 }
 
-DetectedObject MultiCameraFuser::transformDetection(const hva::hvaROI_t &det, int32_t cameraID)
+void MultiCameraFuser::transformDetections(const std::vector<hva::hvaROI_t> &dets, int32_t cameraID)
 {
-    float centerX = det.x + det.width / 2;
-    float centerY = det.y + det.height / 2;
-
-    std::vector<cv::Point2f> pixelPoints;
-    pixelPoints.push_back(cv::Point2f(centerX, centerY));
-    std::vector<cv::Point2f> radarPoints;
-
-    cv::perspectiveTransform(pixelPoints, radarPoints, m_homographyMatrixMap[cameraID]);
-
-    return DetectedObject(BBox(radarPoints[0].x, radarPoints[0].y, 4.2, 1.7), det.confidenceDetection, det.labelDetection);
+    if (dets.empty()) {
+        return;
+    }
+    auto table = m_warpTables.find(cameraID);
+    if (table == m_warpTables.end()) {
+        HVA_ERROR("No homography matrix for camera %d, skip its %zu detections!", cameraID, dets.size());
+        return;
+    }
+    const double *m = table->second.data();
+
+    size_t begin = m_detX.size();
+    size_t num = dets.size();
+    m_detX.resize(begin + num);
+    m_detY.resize(begin + num);
+    m_detConfidence.resize(begin + num);
+    m_detLabel.resize(begin + num);
+    m_detCamera.resize(begin + num);
+    m_detTrackingId.resize(begin + num);
+    for (size_t i = 0; i < num; i++) {
+        const hva::hvaROI_t &det = dets[i];
+        m_detX[begin + i] = det.x + det.width / 2;
+        m_detY[begin + i] = det.y + det.height / 2;
+        m_detConfidence[begin + i] = det.confidenceDetection;
+        m_detLabel[begin + i] = &det.labelDetection;
+        m_detCamera[begin + i] = cameraID;
+        m_detTrackingId[begin + i] = det.trackingId;
+    }
+
+    // warp the centers in place, with the arithmetic of cv::perspectiveTransform
+    float *xs = m_detX.data() + begin;
+    float *ys = m_detY.data() + begin;
+    for (size_t i = 0; i < num; i++) {
+        double x = xs[i];
+        double y = ys[i];
+        double w = x * m[6] + y * m[7] + m[8];
+        if (std::fabs(w) > FLT_EPSILON) {
+            w = 1. / w;
+            xs[i] = (float)((x * m[0] + y * m[1] + m[2]) * w);
+            ys[i] = (float)((x * m[3] + y * m[4] + m[5]) * w);
+        }
+        else {
+            xs[i] = 0.0f;
+            ys[i] = 0.0f;
+        }
+    }
 }
 
-std::vector<DetectedObject> MultiCameraFuser::performClassNMerge(const std::vector<DetectedObject> &objects)
+void MultiCameraFuser::suppressClass(size_t begin, size_t end)
 {
-    if (objects.empty())
-        return {};
-
-    std::vector<DetectedObject> sortedObjs = objects;
-    std::sort(sortedObjs.begin(), sortedObjs.end(), [](const DetectedObject &a, const DetectedObject &b) { return a.confidence > b.confidence; });
+    const float width = MULTI_CAMERA_FUSER_BOX_WIDTH;
+    const float height = MULTI_CAMERA_FUSER_BOX_HEIGHT;
+    size_t r, q;
 
-    std::vector<bool> keep(sortedObjs.size(), true);
-    std::vector<DetectedObject> results;
+    if (end - begin < 2) {
+        return;
+    }
+    if (!(m_nmsThreshold >= 0)) {
+        // even disjoint boxes suppress each other, only the most confident box is kept
+        for (r = begin + 1; r < end; r++) {
+            m_keep[r] = 0;
+        }
+        return;
+    }
+
+    // boxes of the same size overlap only when their corners are less than one box size apart in x and in y,
+    // so with box-sized cells a box can only be suppressed by the boxes of the 3 x 3 cells around it
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (r = begin; r < end; r++) {
+        float x = m_detX[m_order[r]];
+        float y = m_detY[m_order[r]];
+        if (std::isfinite(x) && std::isfinite(y)) {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+        }
+    }
+    if (minX > maxX) {
+        // no finite box, none of them overlaps another
+        return;
+    }
+
+    double cellW = width;
+    double cellH = height;
+    double gridW = std::floor((maxX - minX) / cellW) + 1;
+    double gridH = std::floor((maxY - minY) / cellH) + 1;
+    while (gridW * gridH > MULTI_CAMERA_FUSER_MAX_GRID_CELLS) {
+        // larger cells still hold every overlapping pair within the 3 x 3 neighbourhood
+        cellW *= 2;
+        cellH *= 2;
+        gridW = std::floor((maxX - minX) / cellW) + 1;
+        gridH = std::floor((maxY - minY) / cellH) + 1;
+    }
+    int32_t gw = (int32_t)gridW;
+    int32_t gh = (int32_t)gridH;
+
+    // counting sort of the ranks by cell, boxes with a non-finite corner stay out of the grid and are kept
+    m_cellStart.assign((size_t)gw * gh + 1, 0);
+    for (r = begin; r < end; r++) {
+        float x = m_detX[m_order[r]];
+        float y = m_detY[m_order[r]];
+        if (std::isfinite(x) && std::isfinite(y)) {
+            int32_t cx = std::min((int32_t)((x - minX) / cellW), gw - 1);
+            int32_t cy = std::min((int32_t)((y - minY) / cellH), gh - 1);
+            m_cellOf[r] = cy * gw + cx;
+            m_cellStart[m_cellOf[r]]++;
+        }
+        else {
+            m_cellOf[r] = -1;
+        }
+    }
+    // running sums give the end of each cell, filling backwards moves them to the start
+    for (size_t c = 1; c <= (size_t)gw * gh; c++) {
+        m_cellStart[c] += m_cellStart[c - 1];
+    }
+    m_cellItems.resize(m_cellStart.back());
+    for (r = end; r-- > begin;) {
+        if (m_cellOf[r] >= 0) {
+            m_cellItems[--m_cellStart[m_cellOf[r]]] = (int32_t)r;
+        }
+    }
 
-    for (size_t i = 0; i < sortedObjs.size(); ++i) {
-        if (!keep[i])
+    // greedy suppression in confidence order, the ranks inside a cell are ascending
+    for (r = begin; r < end; r++) {
+        if (!m_keep[r] || m_cellOf[r] < 0) {
             continue;
-
-        results.push_back(sortedObjs[i]);
-
-        for (size_t j = i + 1; j < sortedObjs.size(); ++j) {
-            if (!keep[j])
-                continue;
-
-            float iou = computeIoU(cv::Rect2f(sortedObjs[i].bbox.x, sortedObjs[i].bbox.y, sortedObjs[i].bbox.width, sortedObjs[i].bbox.height),
-                                   cv::Rect2f(sortedObjs[j].bbox.x, sortedObjs[j].bbox.y, sortedObjs[j].bbox.width, sortedObjs[j].bbox.height));
-            if (iou > m_nmsThreshold) {
-                keep[j] = false;
+        }
+        int32_t i = m_order[r];
+        cv::Rect2f box(m_detX[i], m_detY[i], width, height);
+        int32_t cx = m_cellOf[r] % gw;
+        int32_t cy = m_cellOf[r] / gw;
+        for (int32_t ny = std::max(cy - 1, 0); ny <= std::min(cy + 1, gh - 1); ny++) {
+            for (int32_t nx = std::max(cx - 1, 0); nx <= std::min(cx + 1, gw - 1); nx++) {
+                int32_t cell = ny * gw + nx;
+                for (int32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; k++) {
+                    q = m_cellItems[k];
+                    if (q <= r || !m_keep[q]) {
+                        continue;
+                    }
+                    int32_t j = m_order[q];
+                    if (computeIoU(box, cv::Rect2f(m_detX[j], m_detY[j], width, height)) > m_nmsThreshold) {
+                        m_keep[q] = 0;
+                    }
+                }
             }
         }
     }
-
-    return results;
 }
 
-std::vector<DetectedObject> MultiCameraFuser::fuse2Camera(const std::vector<hva::hvaROI_t> &leftDets, const std::vector<hva::hvaROI_t> &rightDets)
+void MultiCameraFuser::mergeDetections(std::vector<DetectedObject> &results)
 {
-    std::vector<DetectedObject> fusedResults;
-
-    std::vector<DetectedObject> transformedDets;
-    for (const auto &det : leftDets) {
-        transformedDets.push_back(transformDetection(det, 0));
+    size_t num = m_detX.size();
+    size_t i, c, begin;
+
+    // number the classes by first appearance, a frame holds a handful of them
+    m_classLabels.clear();
+    m_detClass.resize(num);
+    for (i = 0; i < num; i++) {
+        for (c = 0; c < m_classLabels.size(); c++) {
+            if (*m_classLabels[c] == *m_detLabel[i]) {
+                break;
+            }
+        }
+        if (c == m_classLabels.size()) {
+            m_classLabels.push_back(m_detLabel[i]);
+        }
+        m_detClass[i] = (int32_t)c;
     }
 
-    for (const auto &det : rightDets) {
-        transformedDets.push_back(transformDetection(det, 1));
+    m_order.resize(num);
+    for (i = 0; i < num; i++) {
+        m_order[i] = (int32_t)i;
     }
-
-    std::unordered_map<std::string, std::vector<DetectedObject>> classBasedMap;
-    for (const auto &det : transformedDets) {
-        classBasedMap[det.label].push_back(det);
+    // ties are broken by index, which keeps the order of a stable sort without its temporary buffer
+    std::sort(m_order.begin(), m_order.end(), [this](int32_t a, int32_t b) {
+        if (m_detClass[a] != m_detClass[b]) {
+            return m_detClass[a] < m_detClass[b];
+        }
+        if (m_detConfidence[a] != m_detConfidence[b]) {
+            return m_detConfidence[a] > m_detConfidence[b];
+        }
+        return a < b;
+    });
+
+    m_keep.assign(num, 1);
+    m_cellOf.resize(num);
+    begin = 0;
+    for (i = 1; i <= num; i++) {
+        if (i == num || m_detClass[m_order[i]] != m_detClass[m_order[begin]]) {
+            suppressClass(begin, i);
+            begin = i;
+        }
     }
 
-    for (auto &[label, objects] : classBasedMap) {
-        auto merged = performClassNMerge(objects);
-        fusedResults.insert(fusedResults.end(), merged.begin(), merged.end());
+    results.clear();
+    for (i = 0; i < num; i++) {
+        if (m_keep[i]) {
+            int32_t k = m_order[i];
+            results.push_back(DetectedObject(BBox(m_detX[k], m_detY[k], MULTI_CAMERA_FUSER_BOX_WIDTH, MULTI_CAMERA_FUSER_BOX_HEIGHT), m_detConfidence[k],
+                                             *m_detLabel[k], m_detCamera[k], m_detTrackingId[k]));
+        }
     }
+}
 
-    return fusedResults;
+std::vector<DetectedObject> MultiCameraFuser::fuse2Camera(const std::vector<hva::hvaROI_t> &leftDets, const std::vector<hva::hvaROI_t> &rightDets)
+{
+    std::vector<DetectedObject> results;
+    fuse2Camera(leftDets, rightDets, results);
+    return results;
+}
+
+void MultiCameraFuser::fuse2Camera(const std::vector<hva::hvaROI_t> &leftDets, const std::vector<hva::hvaROI_t> &rightDets, std::vector<DetectedObject> &results)
+{
+    m_detX.clear();
+    m_detY.clear();
+    m_detConfidence.clear();
+    m_detLabel.clear();
+    m_detCamera.clear();
+    m_detTrackingId.clear();
+
+    transformDetections(leftDets, 0);
+    transformDetections(rightDets, 1);
+
+    mergeDetections(results);
 }
 
 std::vector<DetectedObject> MultiCameraFuser::fuse4Camera(const std::vector<hva::hvaROI_t> &firstDets,
@@ -501,36 +883,30 @@ std::vector<DetectedObject> MultiCameraFuser::fuse4Camera(const std::vector<hva:
                                                           const std::vector<hva::hvaROI_t> &thirdDets,
                                                           const std::vector<hva::hvaROI_t> &fourthDets)
 {
-    std::vector<DetectedObject> fusedResults;
-
-    std::vector<DetectedObject> transformedDets;
-    for (const auto &det : firstDets) {
-        transformedDets.push_back(transformDetection(det, 0));
-    }
-
-    for (const auto &det : secondDets) {
-        transformedDets.push_back(transformDetection(det, 1));
-    }
-
-    for (const auto &det : thirdDets) {
-        transformedDets.push_back(transformDetection(det, 2));
-    }
-
-    for (const auto &det : fourthDets) {
-        transformedDets.push_back(transformDetection(det, 3));
-    }
-
-    std::unordered_map<std::string, std::vector<DetectedObject>> classBasedMap;
-    for (const auto &det : transformedDets) {
-        classBasedMap[det.label].push_back(det);
-    }
-
-    for (auto &[label, objects] : classBasedMap) {
-        auto merged = performClassNMerge(objects);
-        fusedResults.insert(fusedResults.end(), merged.begin(), merged.end());
-    }
+    std::vector<DetectedObject> results;
+    fuse4Camera(firstDets, secondDets, thirdDets, fourthDets, results);
+    return results;
+}
 
-    return fusedResults;
+void MultiCameraFuser::fuse4Camera(const std::vector<hva::hvaROI_t> &firstDets,
+                                   const std::vector<hva::hvaROI_t> &secondDets,
+                                   const std::vector<hva::hvaROI_t> &thirdDets,
+                                   const std::vector<hva::hvaROI_t> &fourthDets,
+                                   std::vector<DetectedObject> &results)
+{
+    m_detX.clear();
+    m_detY.clear();
+    m_detConfidence.clear();
+    m_detLabel.clear();
+    m_detCamera.clear();
+    m_detTrackingId.clear();
+
+    transformDetections(firstDets, 0);
+    transformDetections(secondDets, 1);
+    transformDetections(thirdDets, 2);
+    transformDetections(fourthDets, 3);
+
+    mergeDetections(results);
 }
 
 }  // namespace inference
@@ -0,0 +1,488 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you (License). Unless the License provides otherwise, you may not
+ * use, modify, copy, publish, distribute, disclose or transmit this software or
+ * the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ */
+
+#include "modules/inference_util/fusion/track_association_helper.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "modules/vas/components/ot/mtt/hungarian_wrap.h"
+
+namespace hce {
+
+namespace ai {
+
+namespace inference {
+
+static const float kCIoUEps = 1e-9f;
+static const float kCIoUAspectScale = (float)(4.0 / (M_PI * M_PI));
+
+Track2TrackAssociator::Track2TrackAssociator(float costThreshold)
+    : m_gridX0(0.0f), m_gridY0(0.0f), m_cellSize(0.0f), m_gridW(1), m_gridH(1), m_keptPairs(0)
+{
+    setCostThreshold(costThreshold);
+}
+
+void Track2TrackAssociator::setCostThreshold(float costThreshold)
+{
+    m_costThreshold = costThreshold;
+
+    // Boxes that do not overlap have IoU 0 and are kept only if d2 / c2 < g = T - 1, where d2 is the squared center
+    // distance and c2 the squared diagonal of the enclosing box. With l2 = max(w)^2 + max(h)^2, c2 <= (d + l)^2, so
+    // they need d < l * sqrt(g) / (1 - sqrt(g)). Overlapping boxes are always within d < l.
+    float g = costThreshold - 1.0f;
+    if (g >= 1.0f) {
+        // any distance can pass, every pair is a candidate
+        m_gateScale = 0.0f;
+    }
+    else {
+        float ratio = g > 0.0f ? std::sqrt(g) / (1.0f - std::sqrt(g)) : 0.0f;
+        // widened a little against rounding
+        m_gateScale = std::max(1.0f, ratio * ratio) * 1.01f;
+    }
+}
+
+float Track2TrackAssociator::computeCost(const cv::Rect2f &r1, const cv::Rect2f &r2)
+{
+    cv::Rect2f unionBox = r1 | r2;
+    cv::Rect2f interBox = r1 & r2;
+    float iou = interBox.area() / (unionBox.area() + kCIoUEps);
+    float c2 = unionBox.width * unionBox.width + unionBox.height * unionBox.height + kCIoUEps;
+    float dx = (r1.x + 0.5f * r1.width) - (r2.x + 0.5f * r2.width);
+    float dy = (r1.y + 0.5f * r1.height) - (r2.y + 0.5f * r2.height);
+    float dAtan = std::atan(r1.width / r1.height) - std::atan(r2.width / r2.height);
+    float v = kCIoUAspectScale * dAtan * dAtan;
+    float alpha = v / (1.0f - iou + v + kCIoUEps);
+    return 1.0f - (iou - ((dx * dx + dy * dy) / c2 + v * alpha));
+}
+
+void Track2TrackAssociator::buildGrid(const std::vector<cv::Rect2f> &cameraBoxes, float cellSize)
+{
+    int32_t nCamera = static_cast<int32_t>(cameraBoxes.size());
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (const auto &box : cameraBoxes) {
+        float cx = box.x + 0.5f * box.width;
+        float cy = box.y + 0.5f * box.height;
+        if (std::isfinite(cx) && std::isfinite(cy)) {
+            minX = std::min(minX, cx);
+            maxX = std::max(maxX, cx);
+            minY = std::min(minY, cy);
+            maxY = std::max(maxY, cy);
+        }
+    }
+
+    m_gridX0 = minX;
+    m_gridY0 = minY;
+    m_gridW = 1;
+    m_gridH = 1;
+    m_cellSize = 0.0f;
+    if (cellSize > 0.0f && std::isfinite(cellSize) && minX <= maxX) {
+        // a coarser grid only adds candidates, it never loses one
+        while (true) {
+            double w = std::floor((maxX - minX) / cellSize) + 1;
+            double h = std::floor((maxY - minY) / cellSize) + 1;
+            if (w * h <= T2T_ASSOCIATION_MAX_GRID_CELLS) {
+                m_gridW = static_cast<int32_t>(w);
+                m_gridH = static_cast<int32_t>(h);
+                break;
+            }
+            cellSize *= 2.0f;
+        }
+        m_cellSize = cellSize;
+    }
+
+    // counting sort of the camera boxes by cell
+    m_cellOf.resize(nCamera);
+    m_cellStart.assign(m_gridW * m_gridH + 1, 0);
+    for (int32_t c = 0; c < nCamera; ++c) {
+        float cx = cameraBoxes[c].x + 0.5f * cameraBoxes[c].width;
+        float cy = cameraBoxes[c].y + 0.5f * cameraBoxes[c].height;
+        if (!std::isfinite(cx) || !std::isfinite(cy)) {
+            m_cellOf[c] = -1;
+            continue;
+        }
+        int32_t gx = 0, gy = 0;
+        if (m_cellSize > 0.0f) {
+            gx = std::min(static_cast<int32_t>((cx - m_gridX0) / m_cellSize), m_gridW - 1);
+            gy = std::min(static_cast<int32_t>((cy - m_gridY0) / m_cellSize), m_gridH - 1);
+        }
+        m_cellOf[c] = gy * m_gridW + gx;
+        m_cellStart[m_cellOf[c]]++;
+    }
+    // running sums give the end of each cell, filling backwards moves them to the start
+    for (int32_t i = 1; i <= m_gridW * m_gridH; ++i) {
+        m_cellStart[i] += m_cellStart[i - 1];
+    }
+    m_cellItems.resize(m_cellStart.back());
+    for (int32_t c = nCamera - 1; c >= 0; --c) {
+        if (m_cellOf[c] >= 0) {
+            m_cellItems[--m_cellStart[m_cellOf[c]]] = c;
+        }
+    }
+}
+
+void Track2TrackAssociator::gatherCandidates(int32_t r, const std::vector<cv::Rect2f> &radarBoxes, const std::vector<cv::Rect2f> &cameraBoxes)
+{
+    const cv::Rect2f &radar = radarBoxes[r];
+    float rx = radar.x + 0.5f * radar.width;
+    float ry = radar.y + 0.5f * radar.height;
+    if (!std::isfinite(rx) || !std::isfinite(ry)) {
+        return;
+    }
+
+    int32_t gx0 = 0, gx1 = 0, gy0 = 0, gy1 = 0;
+    if (m_cellSize > 0.0f) {
+        // a kept pair is less than one cell apart on each axis
+        float fx = std::floor((rx - m_gridX0) / m_cellSize);
+        float fy = std::floor((ry - m_gridY0) / m_cellSize);
+        if (fx < -1.0f || fx > m_gridW || fy < -1.0f || fy > m_gridH) {
+            return;
+        }
+        gx0 = std::max(static_cast<int32_t>(fx) - 1, 0);
+        gx1 = std::min(static_cast<int32_t>(fx) + 1, m_gridW - 1);
+        gy0 = std::max(static_cast<int32_t>(fy) - 1, 0);
+        gy1 = std::min(static_cast<int32_t>(fy) + 1, m_gridH - 1);
+    }
+
+    for (int32_t gy = gy0; gy <= gy1; ++gy) {
+        for (int32_t gx = gx0; gx <= gx1; ++gx) {
+            int32_t cell = gy * m_gridW + gx;
+            for (int32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+                int32_t c = m_cellItems[i];
+                const cv::Rect2f &camera = cameraBoxes[c];
+                if (m_gateScale > 0.0f) {
+                    float dx = rx - (camera.x + 0.5f * camera.width);
+                    float dy = ry - (camera.y + 0.5f * camera.height);
+                    float maxW = std::max(radar.width, camera.width);
+                    float maxH = std::max(radar.height, camera.height);
+                    if (dx * dx + dy * dy >= m_gateScale * (maxW * maxW + maxH * maxH)) {
+                        continue;
+                    }
+                }
+                m_candRadar.push_back(r);
+                m_candCamera.push_back(c);
+                m_candX1.push_back(radar.x);
+                m_candY1.push_back(radar.y);
+                m_candW1.push_back(radar.width);
+                m_candH1.push_back(radar.height);
+                m_candA1.push_back(m_radarAtan[r]);
+                m_candX2.push_back(camera.x);
+                m_candY2.push_back(camera.y);
+                m_candW2.push_back(camera.width);
+                m_candH2.push_back(camera.height);
+                m_candA2.push_back(m_cameraAtan[c]);
+            }
+        }
+    }
+}
+
+void Track2TrackAssociator::computeCandidateCosts()
+{
+    const int32_t n = static_cast<int32_t>(m_candRadar.size());
+    m_candCost.resize(n);
+
+    const float *__restrict x1 = m_candX1.data();
+    const float *__restrict y1 = m_candY1.data();
+    const float *__restrict w1 = m_candW1.data();
+    const float *__restrict h1 = m_candH1.data();
+    const float *__restrict a1 = m_candA1.data();
+    const float *__restrict x2 = m_candX2.data();
+    const float *__restrict y2 = m_candY2.data();
+    const float *__restrict w2 = m_candW2.data();
+    const float *__restrict h2 = m_candH2.data();
+    const float *__restrict a2 = m_candA2.data();
+    float *__restrict cost = m_candCost.data();
+
+    // computeCost() without branches or calls, the arctangents are taken once per box
+    for (int32_t k = 0; k < n; ++k) {
+        float left = std::max(x1[k], x2[k]);
+        float top = std::max(y1[k], y2[k]);
+        float right = std::min(x1[k] + w1[k], x2[k] + w2[k]);
+        float bottom = std::min(y1[k] + h1[k], y2[k] + h2[k]);
+        float interArea = std::max(right - left, 0.0f) * std::max(bottom - top, 0.0f);
+
+        float unionW = std::max(x1[k] + w1[k], x2[k] + w2[k]) - std::min(x1[k], x2[k]);
+        float unionH = std::max(y1[k] + h1[k], y2[k] + h2[k]) - std::min(y1[k], y2[k]);
+        float iou = interArea / (unionW * unionH + kCIoUEps);
+        float c2 = unionW * unionW + unionH * unionH + kCIoUEps;
+
+        float dx = (x1[k] + 0.5f * w1[k]) - (x2[k] + 0.5f * w2[k]);
+        float dy = (y1[k] + 0.5f * h1[k]) - (y2[k] + 0.5f * h2[k]);
+        float dAtan = a1[k] - a2[k];
+        float v = kCIoUAspectScale * dAtan * dAtan;
+        float alpha = v / (1.0f - iou + v + kCIoUEps);
+        cost[k] = 1.0f - (iou - ((dx * dx + dy * dy) / c2 + v * alpha));
+    }
+}
+
+int32_t Track2TrackAssociator::findRoot(int32_t node)
+{
+    while (m_parent[node] != node) {
+        m_parent[node] = m_parent[m_parent[node]];
+        node = m_parent[node];
+    }
+    return node;
+}
+
+void Track2TrackAssociator::assignComponent(size_t begin, size_t end, int32_t nRadar)
+{
+    m_localRadar.clear();
+    m_localCamera.clear();
+    for (size_t e = begin; e < end; ++e) {
+        int32_t k = m_edges[e];
+        int32_t radarNode = m_candRadar[k];
+        int32_t cameraNode = nRadar + m_candCamera[k];
+        if (m_localIndex[radarNode] < 0) {
+            m_localIndex[radarNode] = static_cast<int32_t>(m_localRadar.size());
+            m_localRadar.push_back(radarNode);
+        }
+        if (m_localIndex[cameraNode] < 0) {
+            m_localIndex[cameraNode] = static_cast<int32_t>(m_localCamera.size());
+            m_localCamera.push_back(cameraNode);
+        }
+    }
+
+    if (m_localRadar.size() == 1 || m_localCamera.size() == 1) {
+        // only one pair can be kept, the cheapest one is the optimal assignment
+        size_t best = begin;
+        for (size_t e = begin + 1; e < end; ++e) {
+            if (m_candCost[m_edges[e]] < m_candCost[m_edges[best]]) {
+                best = e;
+            }
+        }
+        m_matchedCand[m_candRadar[m_edges[best]]] = m_edges[best];
+    }
+    else {
+        // rows are radar boxes, the first columns camera boxes and the last ones stand for "unmatched" at the threshold
+        int32_t rows = static_cast<int32_t>(m_localRadar.size());
+        int32_t cols = static_cast<int32_t>(m_localCamera.size());
+        cv::Mat_<float> costTable(rows, cols + rows, m_costThreshold);
+        m_localCand.assign(rows * cols, -1);
+        for (size_t e = begin; e < end; ++e) {
+            int32_t k = m_edges[e];
+            int32_t row = m_localIndex[m_candRadar[k]];
+            int32_t col = m_localIndex[nRadar + m_candCamera[k]];
+            costTable(row, col) = m_candCost[k];
+            m_localCand[row * cols + col] = k;
+        }
+
+        vas::ot::HungarianAlgo hungarian(costTable);
+        cv::Mat_<uint8_t> assignTable = hungarian.Solve();
+        for (int32_t row = 0; row < rows; ++row) {
+            for (int32_t col = 0; col < cols; ++col) {
+                if (assignTable(row, col) && m_localCand[row * cols + col] >= 0) {
+                    m_matchedCand[m_localRadar[row]] = m_localCand[row * cols + col];
+                    break;
+                }
+            }
+        }
+    }
+
+    for (int32_t node : m_localRadar) {
+        m_localIndex[node] = -1;
+    }
+    for (int32_t node : m_localCamera) {
+        m_localIndex[node] = -1;
+    }
+}
+
+void Track2TrackAssociator::associate(const std::vector<cv::Rect2f> &radarBoxes, const std::vector<cv::Rect2f> &cameraBoxes, std::vector<AssociationPair> &pairs)
+{
+    pairs.clear();
+    int32_t nRadar = static_cast<int32_t>(radarBoxes.size());
+    int32_t nCamera = static_cast<int32_t>(cameraBoxes.size());
+    if (nRadar == 0 || nCamera == 0) {
+        return;
+    }
+
+    float maxW = 0.0f, maxH = 0.0f;
+    m_radarAtan.resize(nRadar);
+    for (int32_t r = 0; r < nRadar; ++r) {
+        m_radarAtan[r] = std::atan(radarBoxes[r].width / radarBoxes[r].height);
+        maxW = std::max(maxW, radarBoxes[r].width);
+        maxH = std::max(maxH, radarBoxes[r].height);
+    }
+    m_cameraAtan.resize(nCamera);
+    for (int32_t c = 0; c < nCamera; ++c) {
+        m_cameraAtan[c] = std::atan(cameraBoxes[c].width / cameraBoxes[c].height);
+        maxW = std::max(maxW, cameraBoxes[c].width);
+        maxH = std::max(maxH, cameraBoxes[c].height);
+    }
+
+    // the largest center distance a kept pair can have, 0 lets every pair through
+    float cellSize = 0.0f;
+    if (m_gateScale > 0.0f) {
+        cellSize = std::sqrt(m_gateScale * (maxW * maxW + maxH * maxH));
+    }
+    buildGrid(cameraBoxes, cellSize);
+
+    m_candRadar.clear();
+    m_candCamera.clear();
+    m_candX1.clear();
+    m_candY1.clear();
+    m_candW1.clear();
+    m_candH1.clear();
+    m_candA1.clear();
+    m_candX2.clear();
+    m_candY2.clear();
+    m_candW2.clear();
+    m_candH2.clear();
+    m_candA2.clear();
+    for (int32_t r = 0; r < nRadar; ++r) {
+        gatherCandidates(r, radarBoxes, cameraBoxes);
+    }
+    computeCandidateCosts();
+
+    m_edges.clear();
+    for (int32_t k = 0; k < static_cast<int32_t>(m_candCost.size()); ++k) {
+        if (m_candCost[k] < m_costThreshold) {
+            m_edges.push_back(k);
+        }
+    }
+
+    m_parent.resize(nRadar + nCamera);
+    for (int32_t i = 0; i < nRadar + nCamera; ++i) {
+        m_parent[i] = i;
+    }
+    for (int32_t k : m_edges) {
+        int32_t a = findRoot(m_candRadar[k]);
+        int32_t b = findRoot(nRadar + m_candCamera[k]);
+        if (a != b) {
+            m_parent[b] = a;
+        }
+    }
+    for (int32_t i = 0; i < nRadar + nCamera; ++i) {
+        m_parent[i] = findRoot(i);
+    }
+
+    // group the pairs by component
+    std::sort(m_edges.begin(), m_edges.end(), [this](int32_t x, int32_t y) {
+        int32_t rx = m_parent[m_candRadar[x]];
+        int32_t ry = m_parent[m_candRadar[y]];
+        if (rx != ry) {
+            return rx < ry;
+        }
+        return x < y;
+    });
+
+    m_localIndex.assign(nRadar + nCamera, -1);
+    m_matchedCand.assign(nRadar, -1);
+    size_t begin = 0;
+    for (size_t e = 1; e <= m_edges.size(); ++e) {
+        if (e == m_edges.size() || m_parent[m_candRadar[m_edges[e]]] != m_parent[m_candRadar[m_edges[begin]]]) {
+            assignComponent(begin, e, nRadar);
+            begin = e;
+        }
+    }
+
+    for (int32_t r = 0; r < nRadar; ++r) {
+        int32_t k = m_matchedCand[r];
+        if (k >= 0) {
+            float confidence = m_costThreshold > 0.0f ? 1.0f - m_candCost[k] / m_costThreshold : 0.0f;
+            pairs.push_back({r, m_candCamera[k], m_candCost[k], std::min(std::max(confidence, 0.0f), 1.0f)});
+        }
+    }
+}
+
+void Track2TrackAssociator::resetTracks()
+{
+    m_trackPairs.clear();
+    m_keptPairs = 0;
+}
+
+void Track2TrackAssociator::associateTracks(const std::vector<cv::Rect2f> &radarBoxes,
+                                            const std::vector<int32_t> &radarIds,
+                                            const std::vector<cv::Rect2f> &cameraBoxes,
+                                            const std::vector<uint64_t> &cameraIds,
+                                            std::vector<AssociationPair> &pairs)
+{
+    int32_t nRadar = static_cast<int32_t>(radarBoxes.size());
+    int32_t nCamera = static_cast<int32_t>(cameraBoxes.size());
+
+    m_cameraById.clear();
+    for (int32_t c = 0; c < nCamera; ++c) {
+        if (0 != cameraIds[c]) {
+            m_cameraById.push_back(std::make_pair(cameraIds[c], c));
+        }
+    }
+    std::sort(m_cameraById.begin(), m_cameraById.end());
+
+    // re-check the pairs of the previous call
+    m_keptPairs = 0;
+    m_radarPair.assign(nRadar, AssociationPair{-1, -1, 0.0f, 0.0f});
+    m_cameraTaken.assign(nCamera, 0);
+    for (int32_t r = 0; r < nRadar; ++r) {
+        auto pairIt = std::lower_bound(m_trackPairs.begin(), m_trackPairs.end(), std::make_pair(radarIds[r], (uint64_t)0));
+        if (pairIt == m_trackPairs.end() || pairIt->first != radarIds[r]) {
+            continue;
+        }
+        auto cameraIt = std::lower_bound(m_cameraById.begin(), m_cameraById.end(), std::make_pair(pairIt->second, (int32_t)-1));
+        if (cameraIt == m_cameraById.end() || cameraIt->first != pairIt->second || m_cameraTaken[cameraIt->second]) {
+            continue;
+        }
+        int32_t c = cameraIt->second;
+        float cost = computeCost(radarBoxes[r], cameraBoxes[c]);
+        if (cost < m_costThreshold) {
+            float confidence = m_costThreshold > 0.0f ? 1.0f - cost / m_costThreshold : 0.0f;
+            m_radarPair[r] = {r, c, cost, std::min(std::max(confidence, 0.0f), 1.0f)};
+            m_cameraTaken[c] = 1;
+            m_keptPairs++;
+        }
+    }
+
+    // match the rest from scratch
+    m_restRadarBoxes.clear();
+    m_restRadarIdx.clear();
+    for (int32_t r = 0; r < nRadar; ++r) {
+        if (m_radarPair[r].cameraIdx < 0) {
+            m_restRadarBoxes.push_back(radarBoxes[r]);
+            m_restRadarIdx.push_back(r);
+        }
+    }
+    m_restCameraBoxes.clear();
+    m_restCameraIdx.clear();
+    for (int32_t c = 0; c < nCamera; ++c) {
+        if (!m_cameraTaken[c]) {
+            m_restCameraBoxes.push_back(cameraBoxes[c]);
+            m_restCameraIdx.push_back(c);
+        }
+    }
+    associate(m_restRadarBoxes, m_restCameraBoxes, m_restPairs);
+    for (const auto &pair : m_restPairs) {
+        int32_t r = m_restRadarIdx[pair.radarIdx];
+        m_radarPair[r] = {r, m_restCameraIdx[pair.cameraIdx], pair.cost, pair.confidence};
+    }
+
+    pairs.clear();
+    m_trackPairs.clear();
+    for (int32_t r = 0; r < nRadar; ++r) {
+        const AssociationPair &pair = m_radarPair[r];
+        if (pair.cameraIdx < 0) {
+            continue;
+        }
+        pairs.push_back(pair);
+        if (0 != cameraIds[pair.cameraIdx]) {
+            m_trackPairs.push_back(std::make_pair(radarIds[r], cameraIds[pair.cameraIdx]));
+        }
+    }
+    std::sort(m_trackPairs.begin(), m_trackPairs.end());
+}
+
+}  // namespace inference
+
+}  // namespace ai
+
+}  // namespace hce
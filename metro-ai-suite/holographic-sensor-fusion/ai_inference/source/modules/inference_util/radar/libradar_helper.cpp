@@ -20,6 +20,42 @@ namespace ai {
 
 namespace inference {
 
+void formatRadarCube(const cfloat* frame, RadarCube& rc){
+    const size_t trn = rc.rn * rc.tn;
+    const size_t cn = rc.cn;
+    const size_t sn = rc.sn;
+    const float r = 1.f / sn;
+
+    // every (chirp, antenna) row is contiguous in both the frame and the cube, the row is summed into
+    // independent lanes and written back with the mean removed while it is still in L1, both inner loops
+    // are plain float streams the compiler vectorises
+    for(size_t c = 0; c < cn; ++c){
+        for(size_t tr = 0; tr < trn; ++tr){
+            const float* src = reinterpret_cast<const float*>(frame + (c * trn + tr) * sn);
+            float* dst = reinterpret_cast<float*>(rc.mat + (tr * cn + c) * sn);
+            const size_t len = 2 * sn;
+
+            float lanes[8] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+            size_t i = 0;
+            for(; i + 8 <= len; i += 8){
+                for(size_t k = 0; k < 8; ++k){
+                    lanes[k] += src[i + k];
+                }
+            }
+            for(; i < len; ++i){
+                lanes[i & 7] += src[i];
+            }
+            const float avgReal = (lanes[0] + lanes[2] + lanes[4] + lanes[6]) * r;
+            const float avgImag = (lanes[1] + lanes[3] + lanes[5] + lanes[7]) * r;
+
+            for(size_t s = 0; s < len; s += 2){
+                dst[s] = src[s] - avgReal;
+                dst[s + 1] = src[s + 1] - avgImag;
+            }
+        }
+    }
+}
+
 RadarTracker::RadarTracker(RadarParam radarParam):m_lib_radar_config_(radarParam){
 
     maxRadarPointCloudsLen	= radarParam.mp;
@@ -14,18 +14,532 @@
 
 #include "modules/inference_util/radar/radar_clustering_helper.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include <immintrin.h>
+
 namespace hce {
 
 namespace ai {
 
 namespace inference {
 
+// cells are slightly larger than epsilon so that float rounding in the distance test can never accept a point
+// outside of the 27 neighbouring cells
+#define DBSCAN_GRID_CELL_MARGIN 1.001
+#define DBSCAN_GRID_COORD_LIMIT (1 << 28)
+
+static inline int32_t dbscanCellCoord(double value, double invCell)
+{
+    double c = std::floor(value * invCell);
+    c = std::min(std::max(c, (double)-DBSCAN_GRID_COORD_LIMIT), (double)DBSCAN_GRID_COORD_LIMIT);
+    return (int32_t)c;
+}
+
+static inline size_t dbscanCellHash(int32_t ix, int32_t iy, int32_t iv)
+{
+    return ((size_t)(uint32_t)ix * 73856093u) ^ ((size_t)(uint32_t)iy * 19349663u) ^ ((size_t)(uint32_t)iv * 83492791u);
+}
+
+//
+// Distance kernels. All of them evaluate (a * a + b * b) + (weight * c) * c with separate multiplies and adds in the
+// order of the scalar expression, this file is built with -ffp-contract=off so that no variant gets fused into an FMA
+// and the three of them accept exactly the same points.
+//
+
+static inline int dbscanSpanScalar(const float *x, const float *y, const float *speed, int begin, int end, float qx, float qy, float qSpeed,
+                                   float weight, float epsilon2, int *hits)
+{
+    int count = 0;
+    for (int k = begin; k < end; ++k) {
+        float a = x[k] - qx;
+        float b = y[k] - qy;
+        float c = speed[k] - qSpeed;
+        float sum = a * a + b * b + weight * c * c;
+        if (sum < epsilon2) {
+            hits[count++] = k;
+        }
+    }
+    return count;
+}
+
+__attribute__((target("avx2"))) static int dbscanSpanAVX2(const float *x, const float *y, const float *speed, int begin, int end, float qx,
+                                                           float qy, float qSpeed, float weight, float epsilon2, int *hits)
+{
+    const __m256 vqx = _mm256_set1_ps(qx);
+    const __m256 vqy = _mm256_set1_ps(qy);
+    const __m256 vqSpeed = _mm256_set1_ps(qSpeed);
+    const __m256 vWeight = _mm256_set1_ps(weight);
+    const __m256 vEpsilon2 = _mm256_set1_ps(epsilon2);
+
+    int count = 0;
+    int k = begin;
+    for (; k + 8 <= end; k += 8) {
+        __m256 a = _mm256_sub_ps(_mm256_loadu_ps(x + k), vqx);
+        __m256 b = _mm256_sub_ps(_mm256_loadu_ps(y + k), vqy);
+        __m256 c = _mm256_sub_ps(_mm256_loadu_ps(speed + k), vqSpeed);
+        __m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b)), _mm256_mul_ps(_mm256_mul_ps(vWeight, c), c));
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(sum, vEpsilon2, _CMP_LT_OQ));
+        while (mask) {
+            hits[count++] = k + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    return count + dbscanSpanScalar(x, y, speed, k, end, qx, qy, qSpeed, weight, epsilon2, hits + count);
+}
+
+__attribute__((target("avx512f"))) static int dbscanSpanAVX512(const float *x, const float *y, const float *speed, int begin, int end, float qx,
+                                                                float qy, float qSpeed, float weight, float epsilon2, int *hits)
+{
+    const __m512 vqx = _mm512_set1_ps(qx);
+    const __m512 vqy = _mm512_set1_ps(qy);
+    const __m512 vqSpeed = _mm512_set1_ps(qSpeed);
+    const __m512 vWeight = _mm512_set1_ps(weight);
+    const __m512 vEpsilon2 = _mm512_set1_ps(epsilon2);
+    const __m512i laneIdx = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    int count = 0;
+    for (int k = begin; k < end; k += 16) {
+        // the tail is loaded masked, the lanes past the end never pass the compare
+        const __mmask16 lanes = end - k >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (end - k)) - 1);
+        __m512 a = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, x + k), vqx);
+        __m512 b = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, y + k), vqy);
+        __m512 c = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, speed + k), vqSpeed);
+        __m512 sum = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(a, a), _mm512_mul_ps(b, b)), _mm512_mul_ps(_mm512_mul_ps(vWeight, c), c));
+        __mmask16 mask = _mm512_mask_cmp_ps_mask(lanes, sum, vEpsilon2, _CMP_LT_OQ);
+        _mm512_mask_compressstoreu_epi32(hits + count, mask, _mm512_add_epi32(_mm512_set1_epi32(k), laneIdx));
+        count += __builtin_popcount((unsigned)mask);
+    }
+    return count;
+}
+
+DBscanGridIndex::DBscanGridIndex()
+{
+    m_kernel = DBscanKernel::Scalar;
+    m_spanKernel = dbscanSpanScalar;
+    setKernel(detectKernel());
+}
+
+DBscanKernel DBscanGridIndex::detectKernel()
+{
+    static const DBscanKernel detected = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return DBscanKernel::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return DBscanKernel::AVX2;
+        }
+        return DBscanKernel::Scalar;
+    }();
+    return detected;
+}
+
+bool DBscanGridIndex::isKernelSupported(DBscanKernel kernel)
+{
+    return (int)kernel <= (int)detectKernel();
+}
+
+const char *DBscanGridIndex::kernelName(DBscanKernel kernel)
+{
+    switch (kernel) {
+        case DBscanKernel::AVX512:
+            return "avx512";
+        case DBscanKernel::AVX2:
+            return "avx2";
+        default:
+            return "scalar";
+    }
+}
+
+bool DBscanGridIndex::setKernel(DBscanKernel kernel)
+{
+    if (!isKernelSupported(kernel)) {
+        return false;
+    }
+    m_kernel = kernel;
+    switch (kernel) {
+        case DBscanKernel::AVX512:
+            m_spanKernel = dbscanSpanAVX512;
+            break;
+        case DBscanKernel::AVX2:
+            m_spanKernel = dbscanSpanAVX2;
+            break;
+        default:
+            m_spanKernel = dbscanSpanScalar;
+            break;
+    }
+    return true;
+}
+
+void DBscanGridIndex::build(const clusteringDBscanPoint2d *pointArray, const float *speedArray, int numPoints, float epsilon, float weight)
+{
+    m_numPoints = numPoints;
+    m_epsilon2 = epsilon * epsilon;
+    m_weight = weight;
+    m_useGrid = std::isfinite(epsilon) && epsilon > 0 && std::isfinite(weight) && weight >= 0;
+    m_speedAxis = weight > 0;
+
+    m_cellX.resize(numPoints);
+    m_cellY.resize(numPoints);
+    m_cellV.resize(numPoints);
+    m_slot.resize(numPoints);
+    m_hits.resize(numPoints);
+    m_order.clear();
+    m_cells.clear();
+
+    if (!m_useGrid) {
+        // keep every point in one run so that a query is the original linear scan
+        m_order.resize(numPoints);
+        m_x.resize(numPoints);
+        m_y.resize(numPoints);
+        m_speed.resize(numPoints);
+        for (int i = 0; i < numPoints; ++i) {
+            m_order[i] = i;
+            m_slot[i] = i;
+            m_x[i] = pointArray[i].x;
+            m_y[i] = pointArray[i].y;
+            m_speed[i] = speedArray[i];
+        }
+        return;
+    }
+
+    const double cell = (double)epsilon * DBSCAN_GRID_CELL_MARGIN;
+    const double invCell = 1.0 / cell;
+    const double invSpeedCell = m_speedAxis ? std::sqrt((double)weight) * invCell : 0.0;
+
+    for (int i = 0; i < numPoints; ++i) {
+        const float x = pointArray[i].x;
+        const float y = pointArray[i].y;
+        const float v = speedArray[i];
+        m_slot[i] = -1;
+        // a non-finite coordinate never passes the distance test, such points have no neighbours and are nobody's neighbour
+        if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(v)) {
+            continue;
+        }
+        m_cellX[i] = dbscanCellCoord(x, invCell);
+        m_cellY[i] = dbscanCellCoord(y, invCell);
+        m_cellV[i] = m_speedAxis ? dbscanCellCoord(v, invSpeedCell) : 0;
+        m_order.push_back(i);
+    }
+
+    // stable sort keeps ascending point index inside every cell
+    std::stable_sort(m_order.begin(), m_order.end(), [this](int a, int b) {
+        if (m_cellX[a] != m_cellX[b]) {
+            return m_cellX[a] < m_cellX[b];
+        }
+        if (m_cellY[a] != m_cellY[b]) {
+            return m_cellY[a] < m_cellY[b];
+        }
+        return m_cellV[a] < m_cellV[b];
+    });
+
+    const int numValid = (int)m_order.size();
+    m_x.resize(numValid);
+    m_y.resize(numValid);
+    m_speed.resize(numValid);
+    for (int k = 0; k < numValid; ++k) {
+        const int i = m_order[k];
+        m_slot[i] = k;
+        m_x[k] = pointArray[i].x;
+        m_y[k] = pointArray[i].y;
+        m_speed[k] = speedArray[i];
+        if (m_cells.empty() || m_cells.back().ix != m_cellX[i] || m_cells.back().iy != m_cellY[i] || m_cells.back().iv != m_cellV[i]) {
+            m_cells.push_back({m_cellX[i], m_cellY[i], m_cellV[i], k, k});
+        }
+        m_cells.back().end = k + 1;
+    }
+
+    size_t tableSize = 16;
+    while (tableSize < 2 * m_cells.size()) {
+        tableSize <<= 1;
+    }
+    m_hashMask = tableSize - 1;
+    m_hashTable.assign(tableSize, -1);
+    for (int c = 0; c < (int)m_cells.size(); ++c) {
+        size_t h = dbscanCellHash(m_cells[c].ix, m_cells[c].iy, m_cells[c].iv) & m_hashMask;
+        while (m_hashTable[h] >= 0) {
+            h = (h + 1) & m_hashMask;
+        }
+        m_hashTable[h] = c;
+    }
+}
+
+int DBscanGridIndex::lookupCell(int32_t ix, int32_t iy, int32_t iv) const
+{
+    size_t h = dbscanCellHash(ix, iy, iv) & m_hashMask;
+    while (m_hashTable[h] >= 0) {
+        const Cell &cell = m_cells[m_hashTable[h]];
+        if (cell.ix == ix && cell.iy == iy && cell.iv == iv) {
+            return m_hashTable[h];
+        }
+        h = (h + 1) & m_hashMask;
+    }
+    return -1;
+}
+
+int DBscanGridIndex::scanRange(int begin, int end, float x, float y, float speed, const char *visited, const int *scope, int scopeId, int *neigh) const
+{
+    // hits go to a scratch buffer, a cell may hold far more close points than neigh has room for available ones
+    int *hitSlots = m_hits.data();
+    const int hits = m_spanKernel(m_x.data(), m_y.data(), m_speed.data(), begin, end, x, y, speed, m_weight, m_epsilon2, hitSlots);
+    int count = 0;
+    for (int h = 0; h < hits; ++h) {
+        const int i = m_order[hitSlots[h]];
+        if (visited[i] == POINT_UNKNOWN && scope[i] != scopeId) {
+            neigh[count++] = i;
+        }
+    }
+    return count;
+}
+
+int DBscanGridIndex::findNeighbors(int point, const char *visited, const int *scope, int scopeId, int *neigh) const
+{
+    const int slot = m_slot[point];
+    if (slot < 0) {
+        return 0;
+    }
+    const float x = m_x[slot];
+    const float y = m_y[slot];
+    const float speed = m_speed[slot];
+
+    if (!m_useGrid) {
+        return scanRange(0, m_numPoints, x, y, speed, visited, scope, scopeId, neigh);
+    }
+
+    int count = 0;
+    const int32_t ix = m_cellX[point];
+    const int32_t iy = m_cellY[point];
+    const int32_t iv = m_cellV[point];
+    const int speedSpan = m_speedAxis ? 1 : 0;
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dv = -speedSpan; dv <= speedSpan; ++dv) {
+                const int c = lookupCell(ix + dx, iy + dy, iv + dv);
+                if (c >= 0) {
+                    count += scanRange(m_cells[c].begin, m_cells[c].end, x, y, speed, visited, scope, scopeId, neigh + count);
+                }
+            }
+        }
+    }
 
-//! TODO:
+    // cells come in grid order, the cluster expansion relies on the index order of the brute-force scan
+    std::sort(neigh, neigh + count);
+    return count;
+}
 
+DBscanClusterer::DBscanClusterer() : m_inst(nullptr) {}
+
+DBscanClusterer::~DBscanClusterer()
+{
+    destroy();
+}
+
+void DBscanClusterer::destroy()
+{
+    if (m_inst) {
+        free(m_inst->scratchPad);
+        free(m_inst);
+        m_inst = nullptr;
+    }
+}
+
+clusteringDBscanErrorCodes DBscanClusterer::create(const RadarClusteringConfig &config)
+{
+    destroy();
+
+    m_inst = (clusteringDBscanInstance *)aligned_alloc(8, sizeof(clusteringDBscanInstance));
+    if (m_inst == nullptr) {
+        return DBSCAN_ERROR_MEMORY_ALLOC_FAILED;
+    }
+
+    m_inst->epsilon = config.eps;
+    m_inst->weight = config.weight;
+    m_inst->maxClusters = config.maxClusters;
+    m_inst->minPointsInCluster = config.minPointsInCluster;
+    m_inst->maxPoints = config.maxPoints;
+
+    // visited is padded to 8 bytes so that the int arrays behind it stay aligned
+    const size_t visitedBytes = (m_inst->maxPoints + 7) & ~(size_t)7;
+    const size_t scratchBytes = visitedBytes + m_inst->maxPoints * sizeof(int) * 2;
+    m_inst->scratchPad = (char *)aligned_alloc(8, std::max(scratchBytes, (size_t)8));
+    if (m_inst->scratchPad == nullptr) {
+        free(m_inst);
+        m_inst = nullptr;
+        return DBSCAN_ERROR_MEMORY_ALLOC_FAILED;
+    }
+    m_inst->visited = (char *)&m_inst->scratchPad[0];
+    m_inst->scope = (int *)&m_inst->scratchPad[visitedBytes];
+    m_inst->neighbors = (int *)&m_inst->scratchPad[visitedBytes + m_inst->maxPoints * sizeof(int)];
+
+    m_pointArray.reserve(m_inst->maxPoints * 2);
+    return DBSCAN_OK;
+}
+
+clusteringDBscanErrorCodes DBscanClusterer::run(const clusteringDBscanInput *input, clusteringDBscanOutput *output)
+{
+    int *neighLast;
+    int *neighCurrent;
+    int neighCount;
+    int newCount;
+    int point, member;
+    int numPoints;
+    int clusterId;
+    int ind;
+    float epsilon, weight;
+
+    if (m_inst == nullptr) {
+        return DBSCAN_ERROR_NOT_SUPPORTED;
+    }
+
+    numPoints = input->num;
+    clusterId = 0;
+    epsilon = m_inst->epsilon;
+    weight = m_inst->weight;
+
+    output->InputArray.resize(numPoints);
+    output->report.resize(m_inst->maxClusters);
+    output->numCluster = 0;
+
+    m_pointArray.resize(numPoints * 2);
+    float *pointArray = m_pointArray.data();
+    for (int i = 0; i < numPoints; ++i) {
+        pointArray[i * 2] = input->rangeFloat[i] * cos(input->aoaVar[i] * M_PI / 180);
+        pointArray[i * 2 + 1] = input->rangeFloat[i] * sin(input->aoaVar[i] * M_PI / 180);
+    }
+
+    memset(m_inst->visited, POINT_UNKNOWN, numPoints * sizeof(char));
+    // scope id 0 is never a seed id, seeds use point + 1
+    memset(m_inst->scope, 0, numPoints * sizeof(int));
+
+    m_gridIndex.build((clusteringDBscanPoint2d *)pointArray, input->speedFloat.data(), numPoints, epsilon, weight);
+
+    // scan through all the points to find its neighbors
+    for (point = 0; point < numPoints; point++) {
+        if (m_inst->visited[point] != POINT_VISITED) {
+            neighCurrent = neighLast = m_inst->neighbors;
+            // a point is in scope of this seed once it is visited or claimed with the seed's id
+            const int scopeId = point + 1;
+
+            neighCount = newCount = m_gridIndex.findNeighbors(point, m_inst->visited, m_inst->scope, scopeId, neighLast);
+            m_inst->visited[point] = POINT_VISITED;
+            if (neighCount < m_inst->minPointsInCluster) {
+                // This point is Noise
+                output->InputArray[point] = 0;
+            }
+            else {
+                // This point belongs to a New Cluster
+                clusterId++;                            // New cluster ID
+                output->InputArray[point] = clusterId;  // This point belong to this cluster
+
+                // tag all the neighbors as visited in scope so that it will not be found again when searching neighbor's neighbor.
+                for (ind = 0; ind < newCount; ind++) {
+                    member = neighLast[ind];
+                    m_inst->scope[member] = scopeId;
+                }
+                neighLast += newCount;
+
+                while (neighCurrent != neighLast)  // neigh shall be at least minPoints in front of neighborhood pointer
+                {
+                    // Explore the neighborhood
+                    member = *neighCurrent++;                // Take point from the neighborhood
+                    output->InputArray[member] = clusterId;  // All points from the neighborhood also belong to this cluster
+                    m_inst->visited[member] = POINT_VISITED;
+                    neighCount = newCount = m_gridIndex.findNeighbors(member, m_inst->visited, m_inst->scope, scopeId, neighLast);
+
+                    if (neighCount >= m_inst->minPointsInCluster) {
+                        for (ind = 0; ind < newCount; ind++) {
+                            member = neighLast[ind];
+                            m_inst->scope[member] = scopeId;
+                        }
+                        neighLast += newCount;  // Member is a core point, and its neighborhood is added to the cluster
+                    }
+                }
+
+                // calculate the clustering center and edge information
+                calcInfo((clusteringDBscanPoint2d *)pointArray, input->speedFloat.data(), input->SNRArray.data(), input->aoaVar.data(), m_inst->neighbors,
+                         neighLast, &output->report[clusterId - 1]);
+                output->numCluster = clusterId;
+
+                if (clusterId >= m_inst->maxClusters)
+                    return DBSCAN_ERROR_CLUSTER_LIMIT_REACHED;
+            }
+        }
+    }  // for
+
+    return DBSCAN_OK;
+}
+
+void DBscanClusterer::calcInfo(const clusteringDBscanPoint2d *pointArray,
+                               const float *speedArray,
+                               const float *SNRArray,
+                               const float *aoaVar,
+                               const int *neighStart,
+                               const int *neighLast,
+                               clusteringDBscanReport *report)
+{
+    int ind, length, member;
+    float sumx, sumy, sumVel, xCenter, yCenter, xSize, ySize, avgVel, temp;
+    float range2, lengthInv, rangeVar, angleVar, velVar;
+
+    length = (neighLast - neighStart);
+    sumx = 0;
+    sumy = 0;
+    sumVel = 0;
+    rangeVar = 0;
+    if (length > 1) {
+        for (ind = 0; ind < length; ind++) {
+            member = neighStart[ind];
+            sumx += (pointArray[member].x);
+            sumy += (pointArray[member].y);
+            sumVel += (speedArray[member]);
+        }
+        lengthInv = 1.0 / (float)(length);
+        xCenter = sumx * lengthInv;
+        yCenter = sumy * lengthInv;
+        avgVel = sumVel * lengthInv;
+        xSize = 0;
+        ySize = 0;
+        velVar = 0;
+        rangeVar = 0;
+        angleVar = 0;
+        for (ind = 0; ind < length; ind++) {
+            member = neighStart[ind];
+            temp = (pointArray[member].x - xCenter);
+            temp = ((temp > 0) ? (temp) : (-temp));     // abs
+            xSize = (xSize > temp) ? (xSize) : (temp);  // max
+            temp = (pointArray[member].y - yCenter);
+            temp = ((temp > 0) ? (temp) : (-temp));       // abs
+            ySize = ((ySize > temp) ? (ySize) : (temp));  // max
+            temp = (speedArray[member] - avgVel);
+            velVar += temp * temp;
+
+            range2 = (pointArray[member].x) * (pointArray[member].x) + (pointArray[member].y) * (pointArray[member].y);
+            temp = range2 * SNRArray[member];
+            rangeVar += temp;
+
+            angleVar += aoaVar[member] * aoaVar[member];
+        }
+        report->numPoints = length;
+
+        float scale = 1.0;
+        report->xCenter = xCenter * scale;  // convert to centermeter in integer
+        report->yCenter = yCenter * scale;  // convert to centermeter in integer
+        report->xSize = xSize * scale;      // convert to centermeter in integer
+        report->ySize = ySize * scale;      // convert to centermeter in integer
+        report->avgVel = avgVel * scale;
+        report->centerRangeVar = rangeVar * scale * scale * lengthInv;                        // rangeResolution * rangeResolution * 0.25;
+        report->centerAngleVar = angleVar * DBSCAN_PIOVER180 * DBSCAN_PIOVER180 * lengthInv;  // (2 * DBSCAN_PIOVER180)^2
+        report->centerDopplerVar = velVar * scale * scale * lengthInv;                        // dopplerResolution * dopplerResolution * 0.25;
+    }
+}
 
 }  // namespace inference
 
+
 }  // namespace ai
 
-}  // namespace hce
\ No newline at end of file
+}  // namespace hce
@@ -6,6 +6,8 @@
 
 #include "modules/inference_util/radar/radar_detection_helper.hpp"
 
+#include <limits>
+
 namespace hce{
 
 namespace ai{
@@ -13,16 +15,107 @@ namespace ai{
 namespace inference{
 
 
+DFTI_DESCRIPTOR_HANDLE FFTPlanCache::getPlan(const FFTPlanKey& key) {
+  auto it = m_plans.find(key);
+  if (it != m_plans.end()) {
+    return it->second;
+  }
+
+  // stop at the first failing call, its status is the one reported
+  DFTI_DESCRIPTOR_HANDLE plan = nullptr;
+  const char* failed = nullptr;
+  MKL_LONG status =
+      DftiCreateDescriptor(&plan, key.precision, DFTI_COMPLEX, 1, key.length);
+  if (!DftiErrorClass(status, DFTI_NO_ERROR)) {
+    failed = "DftiCreateDescriptor";
+  }
+  if (!failed && key.numTransforms > 1) {
+    MKL_LONG strides[2] = {0, key.stride};
+    if (!DftiErrorClass(status = DftiSetValue(plan, DFTI_NUMBER_OF_TRANSFORMS, key.numTransforms), DFTI_NO_ERROR)) {
+      failed = "DFTI_NUMBER_OF_TRANSFORMS";
+    } else if (!DftiErrorClass(status = DftiSetValue(plan, DFTI_INPUT_STRIDES, strides), DFTI_NO_ERROR)) {
+      failed = "DFTI_INPUT_STRIDES";
+    } else if (!DftiErrorClass(status = DftiSetValue(plan, DFTI_OUTPUT_STRIDES, strides), DFTI_NO_ERROR)) {
+      failed = "DFTI_OUTPUT_STRIDES";
+    } else if (!DftiErrorClass(status = DftiSetValue(plan, DFTI_INPUT_DISTANCE, key.distance), DFTI_NO_ERROR)) {
+      failed = "DFTI_INPUT_DISTANCE";
+    } else if (!DftiErrorClass(status = DftiSetValue(plan, DFTI_OUTPUT_DISTANCE, key.distance), DFTI_NO_ERROR)) {
+      failed = "DFTI_OUTPUT_DISTANCE";
+    }
+  }
+  if (!failed && !DftiErrorClass(status = DftiSetValue(plan, DFTI_PLACEMENT, key.placement), DFTI_NO_ERROR)) {
+    failed = "DFTI_PLACEMENT";
+  }
+  if (!failed && !DftiErrorClass(status = DftiCommitDescriptor(plan), DFTI_NO_ERROR)) {
+    failed = "DftiCommitDescriptor";
+  }
+  if (failed) {
+    HVA_ERROR("Failed to create DFTI descriptor of length %d, batch %d, %s: %s", (int)key.length,
+              (int)key.numTransforms, failed, DftiErrorMessage(status));
+    if (plan) {
+      DftiFreeDescriptor(&plan);
+    }
+    return nullptr;
+  }
+
+  m_plans.emplace(key, plan);
+  return plan;
+}
+
+void FFTPlanCache::clear() {
+  for (auto& item : m_plans) {
+    DftiFreeDescriptor(&item.second);
+  }
+  m_plans.clear();
+}
+
 void fft_complex(ComplexFloat* datain, ComplexFloat* dataout,
-                 uint16_t fft_len) {
-  DFTI_DESCRIPTOR_HANDLE data_hand_;
-  MKL_LONG status;
-  status =
-      DftiCreateDescriptor(&data_hand_, DFTI_SINGLE, DFTI_COMPLEX, 1, fft_len);
-  status = DftiSetValue(data_hand_, DFTI_PLACEMENT, DFTI_NOT_INPLACE);
-  status = DftiCommitDescriptor(data_hand_);
-  status = DftiComputeForward(data_hand_, datain, dataout); 
-  status = DftiFreeDescriptor(&data_hand_);
+                 uint16_t fft_len, FFTPlanCache& plan_cache) {
+  FFTPlanKey key = {fft_len, 1, 1, fft_len, DFTI_SINGLE, DFTI_NOT_INPLACE};
+  DFTI_DESCRIPTOR_HANDLE data_hand_ = plan_cache.getPlan(key);
+  if (data_hand_) {
+    DftiComputeForward(data_hand_, datain, dataout);
+  }
+}
+
+// in-place forward fft of num_transforms sequences of fft_len elements,
+// element k of sequence n is located at data[n * distance + k * stride]
+void fft_complex_batch(ComplexFloat* data, int fft_len, int num_transforms,
+                       int stride, int distance, FFTPlanCache& plan_cache) {
+  FFTPlanKey key = {fft_len, num_transforms, stride, distance, DFTI_SINGLE, DFTI_INPLACE};
+  DFTI_DESCRIPTOR_HANDLE data_hand_ = plan_cache.getPlan(key);
+  if (data_hand_) {
+    DftiComputeForward(data_hand_, data);
+  }
+}
+
+// committed descriptors of the contiguous row chunks parallelFor() hands out for num_rows rows of fft_len elements,
+// created up front on the calling thread since the plan cache is not thread-safe. A committed descriptor may then be
+// used by concurrent DftiComputeForward calls.
+static std::vector<DFTI_DESCRIPTOR_HANDLE> fft_row_chunk_plans(int fft_len, int num_rows, int num_chunks,
+                                                              FFTPlanCache& plan_cache) {
+  std::vector<DFTI_DESCRIPTOR_HANDLE> plans(num_chunks);
+  for (int c = 0; c < num_chunks; c++) {
+    int rows = (int)((long)num_rows * (c + 1) / num_chunks - (long)num_rows * c / num_chunks);
+    FFTPlanKey key = {fft_len, rows, 1, fft_len, DFTI_SINGLE, DFTI_INPLACE};
+    plans[c] = plan_cache.getPlan(key);
+  }
+  return plans;
+}
+
+// in-place forward fft of one row chunk, MKL is kept on the calling thread while the pool runs several chunks so
+// that the two do not oversubscribe the thread budget
+static void fft_row_chunk(DFTI_DESCRIPTOR_HANDLE plan, ComplexFloat* data, bool parallel) {
+  if (!plan) {
+    return;
+  }
+  if (!parallel) {
+    DftiComputeForward(plan, data);
+    return;
+  }
+  int previous = mkl_set_num_threads_local(1);
+  DftiComputeForward(plan, data);
+  mkl_set_num_threads_local(previous);
 }
 
 enum windowing_type { hanning = 1, hamming = 2 };
@@ -70,616 +163,253 @@ void fftshift(ComplexFloat* data, int count) {
   }
 }
 
-void OSCFAR::cfar_detection(){
-  // doppler 1d cfar
-    // HVA_DEBUG("oscfar");
-    int doppler_guardLen = dopplerWinGuardLen_;
-    int doppler_trainLen = dopplerWinTrainLen_;
-    int dopplerLen = n_chirps_;
-
-
-    std::vector<int> dopplerCfarList;
-    float dopplerPFA = dopplerPfa_;
-    float noise = 0;
-
-    float cfarRDdoppler[n_samples_][n_chirps_];
-
-    int first = doppler_trainLen + doppler_guardLen;
-    int last = dopplerLen - doppler_trainLen - doppler_guardLen;
-    std::vector<float> leftcell;
-    std::vector<float> rightcell;
-    // std::vector<float> statisticcell;
-    float leftnoise;
-    float rightnoise;
-    // doppler cfar
-    for (int i = 0; i < n_samples_; i++)
-    {
-      for (int j = first; j < last; j++)
-      {
-        leftcell.clear();
-        rightcell.clear();
-        leftnoise = 0;
-        rightnoise = 0;
-
-        for (int k = j - doppler_trainLen - doppler_guardLen;
-             k < j - doppler_guardLen - 1; k++)
-        {
-          leftcell.push_back(RD_spec->at(i,k));
-        }
-        for (int k = j + doppler_guardLen + 1;
-             k < j + doppler_trainLen + doppler_guardLen; k++)
-        {
-          rightcell.push_back(RD_spec->at(i,k));
-        }
-
-        // ca-cfar
-        leftnoise =
-            std::accumulate(std::begin(leftcell), std::end(leftcell), 0.0) /
-            leftcell.size();
-        rightnoise =
-            std::accumulate(std::begin(rightcell), std::end(rightcell), 0.0) /
-            rightcell.size();
-
-        std::vector<float> noisecell(leftcell);
-        noisecell.insert(noisecell.end(),rightcell.begin(), rightcell.end());
-        int k = static_cast<int>(noisecell.size()*3/4);
-        std::sort(noisecell.begin(), noisecell.end());
-        noise = noisecell[k-1];
-
-        float indexdb =RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float doppler_threshold = dopplerPFA * noise;
-        if (targetSnr > doppler_threshold)
-        {
-          dopplerCfarList.push_back(j); // save dopplerIdx
-          cfarRDdoppler[i][j] = 1;      // save result of RD doppler cfar detection
-        }
+CfarEngine::CfarEngine(CfarMethod method, float pfa, int guardLen, int trainLen, CfarEdgeMode edgeMode, float lowEdgeScale,
+                       float highEdgeScale)
+    : m_method(method), m_pfa(pfa), m_guardLen(std::max(guardLen, 0)), m_trainLen(std::max(trainLen, 0)), m_edgeMode(edgeMode),
+      m_lowEdgeScale(lowEdgeScale), m_highEdgeScale(highEdgeScale) {}
+
+void CfarEngine::estimate(const float* row, int len){
+    m_noise.resize(len);
+    m_threshold.resize(len);
+    const int reach = m_trainLen + m_guardLen;
+    const Window interior = {-reach, -m_guardLen - 1, m_guardLen + 1, reach};
+
+    if (m_edgeMode == CFAR_EDGE_CYCLIC) {
+      // pad the row with the wrapped cells so that every cell sees a full window
+      m_padded.resize(len + 2 * reach);
+      for (int k = 0; k < (int)m_padded.size(); k++) {
+        int src = (k - reach) % len;
+        m_padded[k] = row[src < 0 ? src + len : src];
       }
+      m_interiorBegin = 0;
+      m_interiorEnd = len;
+      estimateCells(m_padded.data(), m_padded.size(), reach, 0, len, interior, 1.0f);
+      return;
+    }
+
+    m_interiorBegin = std::min(reach, len);
+    m_interiorEnd = std::max(len - reach, m_interiorBegin);
+    const Window lowEdge = {0, 0, m_guardLen + 1, reach};
+    const Window highEdge = {-reach, 0, 0, 0};
+    estimateCells(row, len, 0, 0, m_interiorBegin, lowEdge, m_lowEdgeScale);
+    estimateCells(row, len, 0, m_interiorBegin, m_interiorEnd, interior, 1.0f);
+    estimateCells(row, len, 0, m_interiorEnd, len, highEdge, m_highEdgeScale);
+}
 
-      // left edge
-      for (int j = 0; j < first; j++)
-      {
-        leftcell.clear();
-        rightcell.clear();
-        leftnoise = 0;
-        rightnoise = 0;
-
-        for (int k = j + doppler_guardLen + 1;
-             k < j + doppler_trainLen + doppler_guardLen; k++)
-        {
-          rightcell.push_back(RD_spec->at(i,k));
-        }
-
-        rightnoise =
-            std::accumulate(std::begin(rightcell), std::end(rightcell), 0.0) /
-            rightcell.size();
-
-        std::vector<float> noisecell(leftcell);
-        noisecell.insert(noisecell.end(),rightcell.begin(), rightcell.end());
-        int k = static_cast<int>(noisecell.size()*3/4);
-        std::sort(noisecell.begin(), noisecell.end());
-        noise = noisecell[k-1];
-
-        float indexdb = RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float doppler_threshold = dopplerPFA * noise * 2;
-        if (targetSnr > doppler_threshold)
-        {
-          dopplerCfarList.push_back(j); // save dopplerIdx
-          cfarRDdoppler[i][j] = 1;      // save result of RD doppler cfar detection
-        }
-      }
-
-      // right edge
-      for (int j = last; j < dopplerLen; j++)
-      {
-        leftcell.clear();
-        rightcell.clear();
-        leftnoise = 0;
-        rightnoise = 0;
-
-        for (int k = j - doppler_trainLen - doppler_guardLen; k < j; k++)
-        {
-          leftcell.push_back(RD_spec->at(i,k));
-        }
-
-        leftnoise =
-            std::accumulate(std::begin(leftcell), std::end(leftcell), 0.0) /
-            leftcell.size();
-
-        std::vector<float> noisecell(leftcell);
-        noisecell.insert(noisecell.end(),rightcell.begin(), rightcell.end());
-        int k = static_cast<int>(noisecell.size()*3/4);
-        std::sort(noisecell.begin(), noisecell.end());
-        noise = noisecell[k-1];
-
-        float indexdb = RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float doppler_threshold = dopplerPFA * noise * 2;
-        if (targetSnr > doppler_threshold)
-        {
-          dopplerCfarList.push_back(j); // save dopplerIdx
-          cfarRDdoppler[i][j] = 1;      // save result of RD doppler cfar detection
-        }
-      }
+void CfarEngine::estimateCells(const float* data, int dataLen, int offset, int begin, int end, const Window& window, float scale){
+    if (begin >= end) {
+      return;
     }
-
-    std::sort(dopplerCfarList.begin(), dopplerCfarList.end());
-
-    dopplerCfarList.erase(
-        std::unique(dopplerCfarList.begin(), dopplerCfarList.end()),
-        dopplerCfarList.end()); // now has zero value
-
-    // need to remove zero value
-    if (dopplerCfarList[0] == 0)
-    {
-      dopplerCfarList.erase(dopplerCfarList.begin()); // erase position zero
+    if (m_method == OS_CFAR) {
+      estimateCellsOS(data, dataLen, offset, begin, end, window, scale);
     }
-
-    if(dopplerCfarList.size()==0){
-      HVA_ERROR("CFAR parameters need to be tuned, please change cfar parameter in RadarConfig.json.");
+    else {
+      estimateCellsCA(data, dataLen, offset, begin, end, window, scale);
     }
+}
 
-    std::vector<PointListIndex> targetList;
-
-    //
-    // range cfar
-    float rangePFA = rangePfa_;
-    noise = 0;
-
-    int range_trainLen = rangeWinTrainLen_;
-    int range_guardLen = rangeWinGuardLen_;
-
-    std::vector<PointListIndex> rangeCfarList;
-    int rangeLen = n_samples_;
-
-    // first = range_trainLen+ range_guardLen+1;
-    first = range_trainLen + range_guardLen;
-    last = rangeLen - range_trainLen - range_guardLen;
-
-    std::vector<float> upcell;
-    std::vector<float> downcell;
-    float upnoise;
-    float downnoise;
-
-    for (auto j : dopplerCfarList)
-    {
-
-      // HVA_DEBUG("dopplerCfarList j: %d", j);
-      for (int i = first; i < last; i++)
-      {
-        upcell.clear();
-        downcell.clear();
-        upnoise = 0;
-        downnoise = 0;
-        for (int k = i - range_trainLen - range_guardLen;
-             k < i - range_guardLen - 1; k++)
-        {
-          upcell.push_back(RD_spec->at(k,j));
-        }
-        for (int k = i + range_guardLen + 1;
-             k < i + range_trainLen + range_guardLen; k++)
-        {
-          downcell.push_back(RD_spec->at(k,j));
-        }
+void CfarEngine::estimateCellsCA(const float* data, int dataLen, int offset, int begin, int end, const Window& window, float scale){
+    // double prefix sums keep the window sums as exact as the per-cell accumulation they replace
+    m_prefix.resize(dataLen + 1);
+    m_prefix[0] = 0.0;
+    for (int k = 0; k < dataLen; k++) {
+      m_prefix[k + 1] = m_prefix[k] + data[k];
+    }
 
-        // ca-cfar
-        upnoise = std::accumulate(std::begin(upcell), std::end(upcell), 0.0) /
-                  upcell.size();
-        downnoise =
-            std::accumulate(std::begin(downcell), std::end(downcell), 0.0) /
-            downcell.size();
-
-        std::vector<float> noisecell(leftcell);
-        noisecell.insert(noisecell.end(),rightcell.begin(), rightcell.end());
-        int k = static_cast<int>(noisecell.size()*3/4);
-        std::sort(noisecell.begin(), noisecell.end());
-        noise = noisecell[k-1];
-
-        float indexdb = RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float range_threshold = rangePFA * noise;
-        if (targetSnr > range_threshold)
-        {
-          PointListIndex target;
-          target.rangeIndex = i;
-          target.dopplerIndex = j;
-          targetList.push_back(target); // save dopplerIdx
-          cfar_output_.RD_after_cfar[i][j] = indexdb / noise;
-        }
-      }
+    for (int j = begin; j < end; j++) {
+      const int c = j + offset;
+      const int leadBegin = std::min(std::max(c + window.leadBegin, 0), dataLen);
+      const int leadEnd = std::min(std::max(c + window.leadEnd, leadBegin), dataLen);
+      const int lagBegin = std::min(std::max(c + window.lagBegin, 0), dataLen);
+      const int lagEnd = std::min(std::max(c + window.lagEnd, lagBegin), dataLen);
 
-      // up edge
-      for (int i = 0; i < first; i++)
-      {
-        // int rangeCfarIdx = i + guardLen + trainLen;
-        upcell.clear();
-        downcell.clear();
-        upnoise = 0;
-        downnoise = 0;
-
-        for (int k = i + range_guardLen + 1;
-             k < i + range_trainLen + range_guardLen; k++)
-        {
-          downcell.push_back(RD_spec->at(k,j));
-        }
+      float leadNoise = leadEnd > leadBegin ? (m_prefix[leadEnd] - m_prefix[leadBegin]) / (leadEnd - leadBegin) : 0;
+      float lagNoise = lagEnd > lagBegin ? (m_prefix[lagEnd] - m_prefix[lagBegin]) / (lagEnd - lagBegin) : 0;
+      float noise = (leadNoise + lagNoise) / 2;
+      m_noise[j] = noise;
+      m_threshold[j] = m_pfa * noise * scale;
+    }
+}
 
-        // ca-cfar
-        downnoise =
-            std::accumulate(std::begin(downcell), std::end(downcell), 0.0) /
-            downcell.size();
-
-        std::vector<float> noisecell(leftcell);
-        noisecell.insert(noisecell.end(),rightcell.begin(), rightcell.end());
-        int k = static_cast<int>(noisecell.size()*3/4);
-        std::sort(noisecell.begin(), noisecell.end());
-        noise = noisecell[k-1];
-
-        float indexdb = RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float range_threshold = rangePFA * noise * 2;
-        if (targetSnr > range_threshold)
-        {
-          PointListIndex target;
-          target.rangeIndex = i;
-          target.dopplerIndex = j;
-          targetList.push_back(target); // save dopplerIdx
-          cfar_output_.RD_after_cfar[i][j] = indexdb / noise;
+void CfarEngine::estimateCellsOS(const float* data, int dataLen, int offset, int begin, int end, const Window& window, float scale){
+    // clamped window parts of cell j, both ends only move forward with j
+    auto parts = [&](int j, int* range) {
+      const int c = j + offset;
+      range[0] = std::min(std::max(c + window.leadBegin, 0), dataLen);
+      range[1] = std::min(std::max(c + window.leadEnd, range[0]), dataLen);
+      range[2] = std::min(std::max(c + window.lagBegin, 0), dataLen);
+      range[3] = std::min(std::max(c + window.lagEnd, range[2]), dataLen);
+    };
+
+    int range[4];
+    parts(begin, range);
+    m_sorted.clear();
+    m_sorted.insert(m_sorted.end(), data + range[0], data + range[1]);
+    m_sorted.insert(m_sorted.end(), data + range[2], data + range[3]);
+    std::sort(m_sorted.begin(), m_sorted.end());
+
+    for (int j = begin; j < end; j++) {
+      if (j > begin) {
+        int next[4];
+        parts(j, next);
+        bool consistent = true;
+        for (int p = 0; p < 4 && consistent; p += 2) {
+          // cells leaving at the front of the part, cells entering at its back
+          for (int k = range[p]; k < next[p] && k < range[p + 1]; k++) {
+            auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), data[k]);
+            if (it == m_sorted.end() || *it != data[k]) {
+              consistent = false;  // only possible for NaN input
+              break;
+            }
+            m_sorted.erase(it);
+          }
+          for (int k = std::max(range[p + 1], next[p]); k < next[p + 1]; k++) {
+            m_sorted.insert(std::upper_bound(m_sorted.begin(), m_sorted.end(), data[k]), data[k]);
+          }
+        }
+        std::copy(next, next + 4, range);
+        if (!consistent) {
+          m_sorted.assign(data + range[0], data + range[1]);
+          m_sorted.insert(m_sorted.end(), data + range[2], data + range[3]);
+          std::sort(m_sorted.begin(), m_sorted.end());
         }
       }
 
-      // down edge
-
-      for (int i = last; i < rangeLen; i++)
-      {
-
-        upcell.clear();
-        downcell.clear();
-        upnoise = 0;
-        downnoise = 0;
-        for (int k = i - range_trainLen - range_guardLen;
-             k < i; k++)
-        {
-          upcell.push_back(RD_spec->at(k,j));
-        }
-        // ca-cfar
-        upnoise = std::accumulate(std::begin(upcell), std::end(upcell), 0.0) /
-                  upcell.size();
-
-        std::vector<float> noisecell(leftcell);
-        noisecell.insert(noisecell.end(),rightcell.begin(), rightcell.end());
-        int k = static_cast<int>(noisecell.size()*3/4);
-        std::sort(noisecell.begin(), noisecell.end());
-        noise = noisecell[k-1];
-
-        float indexdb = RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float range_threshold = rangePFA * noise * 4;
-        if (targetSnr > range_threshold)
-        {
-          PointListIndex target;
-          target.rangeIndex = i;
-          target.dopplerIndex = j;
-          targetList.push_back(target); // save dopplerIdx
-          cfar_output_.RD_after_cfar[i][j] = indexdb / noise;
-        }
+      // 3/4 order statistic of the training cells
+      const int count = m_sorted.size();
+      float noise = 0;
+      if (count > 0) {
+        int k = std::max(count * 3 / 4, 1);
+        noise = m_sorted[k - 1];
       }
+      m_noise[j] = noise;
+      m_threshold[j] = m_pfa * noise * scale;
     }
-
-    HVA_DEBUG("targetList size: %d", targetList.size());
-
-    cfar_output_.numberDetected = targetList.size();
-    // cfar_output_.SNRArray = (float*)malloc(sizeof(float)* cfar_output_.numberDetected);
-    cfar_output_.SNRArray.resize(cfar_output_.numberDetected);
-    PointList2D temp;
-    for (int i = 0; i < targetList.size(); i++)
-    {
-      temp.range_index = targetList[i].rangeIndex;
-      temp.doppler_index = targetList[i].dopplerIndex;
-      // temp.snr = cfarRD[temp.range_index][temp.doppler_index];
-      temp.snr = cfar_output_.RD_after_cfar[temp.range_index][temp.doppler_index];
-      cfar_output_.points.push_back(temp);
-      cfar_output_.SNRArray[i] = temp.snr;
-    }
-
-    HVA_DEBUG("cfar output size: %d", cfar_output_.numberDetected);
 }
 
-void CACFAR::cfar_detection(){
-
-  // doppler 1d cfar
-    int doppler_guardLen = dopplerWinGuardLen_;
-    int doppler_trainLen = dopplerWinTrainLen_;
-    int dopplerLen = n_chirps_;
-
-
-    std::vector<int> dopplerCfarList;
-    float dopplerPFA = dopplerPfa_;
-    float noise = 0;
-
-    float cfarRDdoppler[n_samples_][n_chirps_];
-
-    int first = doppler_trainLen + doppler_guardLen;
-    int last = dopplerLen - doppler_trainLen - doppler_guardLen;
-    std::vector<float> leftcell;
-    std::vector<float> rightcell;
-    float leftnoise;
-    float rightnoise;
-    // doppler cfar
-    for (int i = 0; i < n_samples_; i++)
-    {
-      for (int j = first; j < last; j++)
-      {
-        leftcell.clear();
-        rightcell.clear();
-        leftnoise = 0;
-        rightnoise = 0;
-
-        for (int k = j - doppler_trainLen - doppler_guardLen;
-             k < j - doppler_guardLen - 1; k++)
-        {
-          leftcell.push_back(RD_spec->at(i,k));
-        }
-        for (int k = j + doppler_guardLen + 1;
-             k < j + doppler_trainLen + doppler_guardLen; k++)
-        {
-          rightcell.push_back(RD_spec->at(i,k));
-        }
-
-        // ca-cfar
-        leftnoise =
-            std::accumulate(std::begin(leftcell), std::end(leftcell), 0.0) /
-            leftcell.size();
-        rightnoise =
-            std::accumulate(std::begin(rightcell), std::end(rightcell), 0.0) /
-            rightcell.size();
-
-        noise = (leftnoise + rightnoise) / 2;
-
-        float indexdb =RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float doppler_threshold = dopplerPFA * noise;
-        if (targetSnr > doppler_threshold)
-        {
-          dopplerCfarList.push_back(j); // save dopplerIdx
-          cfarRDdoppler[i][j] = 1;      // save result of RD doppler cfar detection
-        }
+void cfar2DDetection(const RadarTensor<float>& rd, CfarEngine& dopplerCfar, CfarEngine& rangeCfar, detectionCFAR_output_& output,
+                     RadarThreadPool* pool){
+    const int n_samples = rd.samples();
+    const int n_chirps = rd.chirps();
+
+    // every chunk owns a copy of the engines, chunk 0 uses the callers' engines
+    const int maxChunks = pool ? pool->numChunks(std::max(n_samples, n_chirps), RADAR_MIN_ROWS_PER_TASK) : 1;
+    std::vector<CfarEngine> dopplerEngines(std::max(maxChunks - 1, 0), dopplerCfar);
+    std::vector<CfarEngine> rangeEngines(std::max(maxChunks - 1, 0), rangeCfar);
+    auto forChunks = [&](int count, const RadarThreadPool::Task& task) {
+      if (pool) {
+        pool->parallelFor(count, task, RADAR_MIN_ROWS_PER_TASK);
+      } else {
+        task(0, 0, count);
       }
-
-      // left edge
-      for (int j = 0; j < first; j++)
+    };
+
+    // doppler cfar, one range row at a time
+    std::vector<std::vector<char>> dopplerHits(maxChunks, std::vector<char>(n_chirps, 0));
+    forChunks(n_samples, [&](int chunk, int begin, int end) {
+      CfarEngine& engine = chunk == 0 ? dopplerCfar : dopplerEngines[chunk - 1];
+      std::vector<char>& dopplerHit = dopplerHits[chunk];
+      std::vector<float> row;
+      for (int i = begin; i < end; i++)
       {
-        leftcell.clear();
-        rightcell.clear();
-        leftnoise = 0;
-        rightnoise = 0;
-
-        for (int k = j + doppler_guardLen + 1;
-             k < j + doppler_trainLen + doppler_guardLen; k++)
-        {
-          rightcell.push_back(RD_spec->at(i,k));
-        }
-
-        rightnoise =
-            std::accumulate(std::begin(rightcell), std::end(rightcell), 0.0) /
-            rightcell.size();
-
-        noise = (leftnoise + rightnoise) / 2;
-        float indexdb = RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float doppler_threshold = dopplerPFA * noise * 2;
-        if (targetSnr > doppler_threshold)
-        {
-          dopplerCfarList.push_back(j); // save dopplerIdx
-          cfarRDdoppler[i][j] = 1;      // save result of RD doppler cfar detection
+        const float* line = rd.data() + rd.offset(i, 0);
+        if (rd.chirpStride() != 1) {
+          row.resize(n_chirps);
+          for (int j = 0; j < n_chirps; j++) {
+            row[j] = rd.at(i, j);
+          }
+          line = row.data();
+        }
+        engine.estimate(line, n_chirps);
+        const float* threshold = engine.threshold();
+        for (int j = 0; j < n_chirps; j++) {
+          dopplerHit[j] |= line[j] > threshold[j];
         }
       }
+    });
 
-      // right edge
-      for (int j = last; j < dopplerLen; j++)
-      {
-        leftcell.clear();
-        rightcell.clear();
-        leftnoise = 0;
-        rightnoise = 0;
-
-        for (int k = j - doppler_trainLen - doppler_guardLen; k < j; k++)
-        {
-          leftcell.push_back(RD_spec->at(i,k));
-        }
-
-        leftnoise =
-            std::accumulate(std::begin(leftcell), std::end(leftcell), 0.0) /
-            leftcell.size();
-
-        noise = (leftnoise + rightnoise) / 2;
-        float indexdb = RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float doppler_threshold = dopplerPFA * noise * 2;
-        if (targetSnr > doppler_threshold)
-        {
-          dopplerCfarList.push_back(j); // save dopplerIdx
-          cfarRDdoppler[i][j] = 1;      // save result of RD doppler cfar detection
-        }
+    // doppler bin zero is static clutter and never searched in range
+    std::vector<int> dopplerCfarList;
+    for (int j = 1; j < n_chirps; j++) {
+      char hit = 0;
+      for (auto& dopplerHit : dopplerHits) {
+        hit |= dopplerHit[j];
+      }
+      if (hit) {
+        dopplerCfarList.push_back(j);
       }
     }
-
-    std::sort(dopplerCfarList.begin(), dopplerCfarList.end());
-
-    dopplerCfarList.erase(
-        std::unique(dopplerCfarList.begin(), dopplerCfarList.end()),
-        dopplerCfarList.end()); // now has zero value
-
-    // need to remove zero value
-    if (dopplerCfarList[0] == 0)
-    {
-      dopplerCfarList.erase(dopplerCfarList.begin()); // erase position zero
-    }
-
     if(dopplerCfarList.size()==0){
       HVA_ERROR("CFAR parameters need to be tuned, please change cfar parameter in RadarConfig.json.");
     }
 
-    std::vector<PointListIndex> targetList;
-
-    //
-    // range cfar
-    float rangePFA = rangePfa_;
-    noise = 0;
-
-    int range_trainLen = rangeWinTrainLen_;
-    int range_guardLen = rangeWinGuardLen_;
-
-    std::vector<PointListIndex> rangeCfarList;
-    int rangeLen = n_samples_;
-
-    // first = range_trainLen+ range_guardLen+1;
-    first = range_trainLen + range_guardLen;
-    last = rangeLen - range_trainLen - range_guardLen;
-
-    std::vector<float> upcell;
-    std::vector<float> downcell;
-    float upnoise;
-    float downnoise;
-
-    for (auto j : dopplerCfarList)
-    {
-
-      // HVA_DEBUG("dopplerCfarList j: %d", j);
-      for (int i = first; i < last; i++)
+    // range cfar on the detected doppler bins, interior cells first, then the two edges.
+    // chunks cover consecutive doppler bins, so joining their lists in chunk order gives the serial order
+    std::vector<std::vector<PointListIndex>> chunkTargets(maxChunks);
+    forChunks(dopplerCfarList.size(), [&](int chunk, int begin, int end) {
+      CfarEngine& engine = chunk == 0 ? rangeCfar : rangeEngines[chunk - 1];
+      std::vector<PointListIndex>& targets = chunkTargets[chunk];
+      std::vector<float> row(n_samples);
+      for (int k = begin; k < end; k++)
       {
-        upcell.clear();
-        downcell.clear();
-        upnoise = 0;
-        downnoise = 0;
-        for (int k = i - range_trainLen - range_guardLen;
-             k < i - range_guardLen - 1; k++)
-        {
-          upcell.push_back(RD_spec->at(k,j));
-        }
-        for (int k = i + range_guardLen + 1;
-             k < i + range_trainLen + range_guardLen; k++)
-        {
-          downcell.push_back(RD_spec->at(k,j));
-        }
-
-        // ca-cfar
-        upnoise = std::accumulate(std::begin(upcell), std::end(upcell), 0.0) /
-                  upcell.size();
-        downnoise =
-            std::accumulate(std::begin(downcell), std::end(downcell), 0.0) /
-            downcell.size();
-
-        noise = (upnoise + downnoise) / 2;
-        float indexdb = RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float range_threshold = rangePFA * noise;
-        if (targetSnr > range_threshold)
-        {
-          PointListIndex target;
-          target.rangeIndex = i;
-          target.dopplerIndex = j;
-          targetList.push_back(target); // save dopplerIdx
-          cfar_output_.RD_after_cfar[i][j] = indexdb / noise;
-        }
-      }
-
-      // up edge
-      for (int i = 0; i < first; i++)
-      {
-        // int rangeCfarIdx = i + guardLen + trainLen;
-        upcell.clear();
-        downcell.clear();
-        upnoise = 0;
-        downnoise = 0;
-
-        for (int k = i + range_guardLen + 1;
-             k < i + range_trainLen + range_guardLen; k++)
-        {
-          downcell.push_back(RD_spec->at(k,j));
-        }
-
-        // ca-cfar
-        downnoise =
-            std::accumulate(std::begin(downcell), std::end(downcell), 0.0) /
-            downcell.size();
-
-        noise = (upnoise + downnoise) / 2;
-        float indexdb = RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float range_threshold = rangePFA * noise * 2;
-        if (targetSnr > range_threshold)
-        {
-          PointListIndex target;
-          target.rangeIndex = i;
-          target.dopplerIndex = j;
-          targetList.push_back(target); // save dopplerIdx
-          cfar_output_.RD_after_cfar[i][j] = indexdb / noise;
-        }
-      }
-
-      // down edge
-
-      for (int i = last; i < rangeLen; i++)
-      {
-
-        upcell.clear();
-        downcell.clear();
-        upnoise = 0;
-        downnoise = 0;
-        for (int k = i - range_trainLen - range_guardLen;
-             k < i; k++)
-        {
-          upcell.push_back(RD_spec->at(k,j));
-        }
-        // ca-cfar
-        upnoise = std::accumulate(std::begin(upcell), std::end(upcell), 0.0) /
-                  upcell.size();
-
-        noise = (upnoise + downnoise) / 2;
-        float indexdb = RD_spec->at(i,j);
-        // float targetSnr = indexdb - noise;
-        float targetSnr = indexdb;
-        float range_threshold = rangePFA * noise * 4;
-        if (targetSnr > range_threshold)
-        {
-          PointListIndex target;
-          target.rangeIndex = i;
-          target.dopplerIndex = j;
-          targetList.push_back(target); // save dopplerIdx
-          cfar_output_.RD_after_cfar[i][j] = indexdb / noise;
+        const int j = dopplerCfarList[k];
+        for (int i = 0; i < n_samples; i++) {
+          row[i] = rd.at(i, j);
+        }
+        engine.estimate(row.data(), n_samples);
+        const float* noise = engine.noise();
+        const float* threshold = engine.threshold();
+        const int spans[3][2] = {{engine.interiorBegin(), engine.interiorEnd()},
+                                 {0, engine.interiorBegin()},
+                                 {engine.interiorEnd(), n_samples}};
+        for (auto& span : spans) {
+          for (int i = span[0]; i < span[1]; i++) {
+            if (row[i] > threshold[i]) {
+              PointListIndex target;
+              target.rangeIndex = i;
+              target.dopplerIndex = j;
+              targets.push_back(target);
+              output.RD_after_cfar[i][j] = row[i] / noise[i];
+            }
+          }
         }
       }
+    });
+    std::vector<PointListIndex> targetList;
+    for (auto& targets : chunkTargets) {
+      targetList.insert(targetList.end(), targets.begin(), targets.end());
     }
 
     HVA_DEBUG("targetList size: %d", targetList.size());
 
-    cfar_output_.numberDetected = targetList.size();
-    // cfar_output_.SNRArray = (float*)malloc(sizeof(float)* cfar_output_.numberDetected);
-    cfar_output_.SNRArray.resize(cfar_output_.numberDetected);
+    output.numberDetected = targetList.size();
+    output.SNRArray.resize(output.numberDetected);
+    output.points.clear();
+    output.points.reserve(output.numberDetected);
     PointList2D temp;
     for (int i = 0; i < targetList.size(); i++)
     {
       temp.range_index = targetList[i].rangeIndex;
       temp.doppler_index = targetList[i].dopplerIndex;
-      // temp.snr = cfarRD[temp.range_index][temp.doppler_index];
-      temp.snr = cfar_output_.RD_after_cfar[temp.range_index][temp.doppler_index];
-      cfar_output_.points.push_back(temp);
-      cfar_output_.SNRArray[i] = temp.snr;
+      temp.snr = output.RD_after_cfar[temp.range_index][temp.doppler_index];
+      output.points.push_back(temp);
+      output.SNRArray[i] = temp.snr;
     }
 
-    HVA_DEBUG("cfar output size: %d", cfar_output_.numberDetected);
+    HVA_DEBUG("cfar output size: %d", output.numberDetected);
+}
+
+void OSCFAR::cfar_detection(){
+    // range edge thresholds are scaled as in the original one-sided windows, x2 at the near end and x4 at the far end
+    CfarEngine dopplerCfar(OS_CFAR, dopplerPfa_, dopplerWinGuardLen_, dopplerWinTrainLen_, dopplerEdge_, 2, 2);
+    CfarEngine rangeCfar(OS_CFAR, rangePfa_, rangeWinGuardLen_, rangeWinTrainLen_, rangeEdge_, 2, 4);
+    cfar2DDetection(*RD_spec, dopplerCfar, rangeCfar, cfar_output_, thread_pool_.get());
+}
+
+void CACFAR::cfar_detection(){
+    CfarEngine dopplerCfar(CA_CFAR, dopplerPfa_, dopplerWinGuardLen_, dopplerWinTrainLen_, dopplerEdge_, 2, 2);
+    CfarEngine rangeCfar(CA_CFAR, rangePfa_, rangeWinGuardLen_, rangeWinTrainLen_, rangeEdge_, 2, 4);
+    cfar2DDetection(*RD_spec, dopplerCfar, rangeCfar, cfar_output_, thread_pool_.get());
 }
 
 // find nearest 2^n
@@ -703,107 +433,99 @@ void RadarDetection::rangeEstimation(){
     int rangeLen = m_n_samples_;
     int N_fft = rangeLen; // find nearest 2^n
     // int N_fft = roundup_pow_of_two(rangeLen);
-  
-    // if rangeLen is not 2^n, need to do zero padding
-    ComplexFloat* datain = new ComplexFloat[N_fft];
-    ComplexFloat* dataout = new ComplexFloat[N_fft];
-    float* windowArray;
-  
-    windowArray = (float*)malloc(sizeof(float) * N_fft);
-    windowing(hanning, windowArray, rangeLen);  // gene
-    for (int m = 0; m < m_n_vrx_; m++) {
-      for (int l = 0; l < m_n_chirps_; l++) {
-        for (int n = 0; n < N_fft; n++) {
-          datain[n] = getData(n, l, m);
-        }
 
-        for (int i = 0; i < N_fft; i++) {
-          datain[i] = datain[i] * windowArray[i];
-        }
-        fft_complex(datain, dataout, N_fft);
-
-        for (int p = 0; p < N_fft; p++) {
-            rangeProfilePtr->setValue(p, l, m, dataout[p]);
+    std::vector<float> windowArray(N_fft);
+    windowing(hanning, windowArray.data(), rangeLen);  // gene
+
+    // range profile is chirp-major: every chirp of every virtual antenna is one unit-stride row of samples
+    const bool chirpMajor = radarDataPtr_->layout() == RadarTensorLayout::ChirpMajor;
+    if (!chirpMajor) {
+      thread_pool_->parallelFor(m_n_vrx_, [&](int, int begin, int end) {
+        transposeLayout(*radarDataPtr_, *rangeProfilePtr, begin, end);
+      });
+    }
+
+    // window and transform contiguous chunks of rows on the pool
+    ComplexFloat* dataout = rangeProfilePtr->data();
+    const ComplexFloat* datain = radarDataPtr_->data();
+    const int numRows = m_n_chirps_ * m_n_vrx_;
+    const int numChunks = thread_pool_->numChunks(numRows, RADAR_MIN_ROWS_PER_TASK);
+    std::vector<DFTI_DESCRIPTOR_HANDLE> plans = fft_row_chunk_plans(N_fft, numRows, numChunks, *fft_plan_cache_);
+    thread_pool_->parallelFor(numRows, [&](int chunk, int begin, int end) {
+      if (chirpMajor) {
+        std::memcpy(dataout + (size_t)begin * N_fft, datain + (size_t)begin * N_fft, (size_t)(end - begin) * N_fft * sizeof(ComplexFloat));
+      }
+      for (int r = begin; r < end; r++) {
+        ComplexFloat* row = dataout + (size_t)r * N_fft;
+        for (int n = 0; n < N_fft; n++) {
+          row[n] = row[n] * windowArray[n];
         }
       }
-    }
-    free(windowArray);
-    delete []datain;
-    delete []dataout;
+      fft_row_chunk(plans[chunk], dataout + (size_t)begin * N_fft, numChunks > 1);
+    }, RADAR_MIN_ROWS_PER_TASK);
 
 };
 
 void RadarDetection::dopplerEstimation(){
     int N_fft = m_n_chirps_;
     // int N_fft = roundup_pow_of_two(m_n_chirps_);
-    TwoDimArray<ComplexFloat> avgChirp(m_n_samples_, m_n_vrx_);
-
-    for (int i = 0; i < m_n_samples_; i++) {
-      for (int m = 0; m < m_n_vrx_; m++) {
-        for (int j = 0; j < m_n_chirps_; j++) {
-          avgChirp.setValue(i, m, rangeProfilePtr->at(i, j, m) + avgChirp.at(i, m));
-        }
-
-        avgChirp.setValue(i, m, avgChirp.at(i, m) / m_n_chirps_);
-        for (int j = 0; j < m_n_chirps_; j++) {
-          rangeProfilePtr->setValue(i, j, m,
-                                rangeProfilePtr->at(i, j, m) - avgChirp.at(i, m));
-        }
-      }
-    }
-
-    // doppler fft
-
-    ComplexFloat* dopplerdatain = new ComplexFloat[N_fft];
-    ComplexFloat* dopplerdataout = new ComplexFloat[N_fft];
-    // uint16_t fft_doppler = m_n_chirps_;  // length
 
-    float* dopplerwindowArray;
-    // int dopplerLen = m_n_chirps_;
-    dopplerwindowArray = (float*)malloc(sizeof(float) * N_fft);
-    windowing(hanning, dopplerwindowArray,
+    std::vector<float> dopplerwindowArray(N_fft);
+    windowing(hanning, dopplerwindowArray.data(),
               N_fft);  // generate array of n_samples
 
-    for (int m = 0; m < m_n_vrx_; m++) {
-      for (int n = 0; n < m_n_samples_; n++) {
-        for (int l = 0; l < N_fft; l++) {
-          dopplerdatain[l] = rangeProfilePtr->at(n, l, m);
-        }
-        // windowing
-        for (int i = 0; i < N_fft; i++) {
-          dopplerdatain[i] = dopplerdatain[i] * dopplerwindowArray[i];
-        }
-
-        fft_complex(dopplerdatain, dopplerdataout, N_fft);
-        fftshift(dopplerdataout, N_fft);  // fftshift
-
-        for (int p = 0; p < N_fft; p++) {
-          dopplerProfilePtr->setValue(n, p, m, dopplerdataout[p]);
+    // corner turn into the sample-major doppler profile, then every range bin of every
+    // virtual antenna is one unit-stride row of chirps
+    thread_pool_->parallelFor(m_n_vrx_, [&](int, int begin, int end) {
+      transposeLayout(*rangeProfilePtr, *dopplerProfilePtr, begin, end);
+    });
+
+    // remove the average chirp, apply window in place, transform and shift contiguous chunks of rows on the pool
+    ComplexFloat* dopplerData = dopplerProfilePtr->data();
+    const int numRows = m_n_samples_ * m_n_vrx_;
+    const int numChunks = thread_pool_->numChunks(numRows, RADAR_MIN_ROWS_PER_TASK);
+    std::vector<DFTI_DESCRIPTOR_HANDLE> plans = fft_row_chunk_plans(N_fft, numRows, numChunks, *fft_plan_cache_);
+    thread_pool_->parallelFor(numRows, [&](int chunk, int begin, int end) {
+      for (int r = begin; r < end; r++) {
+        ComplexFloat* row = dopplerData + (size_t)r * N_fft;
+        ComplexFloat avgChirp(0, 0);
+        for (int j = 0; j < N_fft; j++) {
+          avgChirp = row[j] + avgChirp;
+        }
+        avgChirp = avgChirp / m_n_chirps_;
+        for (int j = 0; j < N_fft; j++) {
+          row[j] = (row[j] - avgChirp) * dopplerwindowArray[j];
         }
       }
-    }
 
-    free(dopplerwindowArray);
+      fft_row_chunk(plans[chunk], dopplerData + (size_t)begin * N_fft, numChunks > 1);
 
-    delete []dopplerdatain;
-    delete []dopplerdataout;
+      for (int r = begin; r < end; r++) {
+        fftshift(dopplerData + (size_t)r * N_fft, N_fft);  // fftshift
+      }
+    }, RADAR_MIN_ROWS_PER_TASK);
 
 };
 
 void RadarDetection::non_coherent_combing(){
 
-    for (int n = 0; n < m_n_samples_; n++) {
-      for (int l = 0; l < m_n_chirps_; l++) {
-        for (int m = 0; m < m_n_vrx_; m++) {
-          float real_data = dopplerProfilePtr->at(n, l, m).real();
-          float imag_data = dopplerProfilePtr->at(n, l, m).imag();
-          float sqrt_data =
-              sqrt(real_data * real_data + imag_data * imag_data);
-          float temp_data = RadarBeforeCfarPtr->at(n, l) + sqrt_data;
-          RadarBeforeCfarPtr->setValue(n, l, temp_data);
+    // both the doppler profile and the range-doppler map are sample-major, so each range bin is a unit-stride row,
+    // the pool splits the range bins and every chunk sums all virtual antennas of its rows
+    float* rd = RadarBeforeCfarPtr->data();
+    thread_pool_->parallelFor(m_n_samples_, [&](int, int begin, int end) {
+      for (int m = 0; m < m_n_vrx_; m++) {
+        const ComplexFloat* plane = dopplerProfilePtr->plane(m);
+        for (int n = begin; n < end; n++) {
+          const ComplexFloat* src = plane + n * m_n_chirps_;
+          float* dst = rd + n * m_n_chirps_;
+          for (int l = 0; l < m_n_chirps_; l++) {
+            float real_data = src[l].real();
+            float imag_data = src[l].imag();
+            dst[l] += sqrt(real_data * real_data + imag_data * imag_data);
+          }
         }
       }
-    }
+    }, RADAR_MIN_ROWS_PER_TASK);
   
 
 }
@@ -813,6 +535,7 @@ void RadarDetection::cfarDetection(){
     if(radar_detection_config_.m_range_cfar_method_==1 &&radar_detection_config_.m_doppler_cfar_method_==1){
     //ca-cfar
       auto cfar_detection =std::make_shared<CACFAR>(radar_detection_config_, m_n_samples_, m_n_chirps_, RadarBeforeCfarPtr);
+      cfar_detection->setThreadPool(thread_pool_);
 
       cfar_detection->cfar_detection();
 
@@ -821,6 +544,7 @@ void RadarDetection::cfarDetection(){
     else if(radar_detection_config_.m_range_cfar_method_==4 &&radar_detection_config_.m_doppler_cfar_method_==4){
       //os-cfar
       auto cfar_detection =std::make_shared<OSCFAR>(radar_detection_config_, m_n_samples_, m_n_chirps_, RadarBeforeCfarPtr);
+      cfar_detection->setThreadPool(thread_pool_);
 
       cfar_detection->cfar_detection();
 
@@ -853,6 +577,12 @@ void RadarDetection::doaEstimation(){
   }
 
   if(doa_estimator){
+    doa_estimator->setFFTPlanCache(fft_plan_cache_);
+    doa_engine_->setThreadPool(thread_pool_);
+    doa_estimator->setDOAEngine(doa_engine_);
+    if(point_clouds){
+      doa_estimator->setPCL(point_clouds);
+    }
     doa_estimator->setPeakSearchOutput(peak_output);
     doa_estimator->setCfarOutput(cfar_output);
     doa_estimator->init(peak_output.numberDetected);
@@ -900,23 +630,122 @@ void RadarDetection::peakGrouping(){
 
     HVA_DEBUG("peak_output size: %d", peak_output.numberDetected);
 }
+void DOAEngine::configure(int numTx, int numRx, int numChirps){
+    if (numTx == m_numTx && numRx == m_numRx && numChirps == m_numChirps && !m_steering.empty()) {
+      return;
+    }
+    m_numTx = numTx;
+    m_numRx = numRx;
+    m_numChirps = numChirps;
+    m_numVrx = numTx * numRx;
+
+    // half-wavelength spaced virtual array, a_j(theta) = exp(j * pi * j * sin(theta))
+    m_steering.resize((size_t)m_numVrx * DOA_ANGLE_GRID_SIZE);
+    m_gridAngles.resize(DOA_ANGLE_GRID_SIZE);
+    for (int g = 0; g < DOA_ANGLE_GRID_SIZE; g++) {
+      double deg = double(g - DOA_ANGLE_GRID_SIZE / 2) / 2.0;
+      m_gridAngles[g] = (float)deg;
+      for (int j = 0; j < m_numVrx; j++) {
+        double dphi = j * 2 * PI * 0.5 * std::sin(deg * PI / 180);
+        m_steering[(size_t)g * m_numVrx + j] = ComplexFloat(std::cos(dphi), std::sin(dphi));
+      }
+    }
+
+    m_compensation.resize((size_t)numChirps * m_numVrx);
+    for (int bin = 0; bin < numChirps; bin++) {
+      float phi = 2 * PI * (bin - numChirps / 2 - 1) / numChirps;
+      for (int txId = 0; txId < numTx; txId++) {
+        for (int rxId = 0; rxId < numRx; rxId++) {
+          m_compensation[(size_t)bin * m_numVrx + txId * numRx + rxId] = std::polar(1.0f, -txId * phi);
+        }
+      }
+    }
+}
+
+void DOAEngine::estimate(AoaEstimationType method, const ComplexFloat* snapshots, int numPoints, float* angles){
+    if (numPoints <= 0 || m_numVrx <= 0) {
+      return;
+    }
+
+    // response = S^H X, grid x points, column-major
+    m_response.resize((size_t)DOA_ANGLE_GRID_SIZE * numPoints);
+    MKL_Complex8 alpha = {1.0, 0.0};
+    MKL_Complex8 beta = {0.0, 0.0};
+    cblas_cgemm(CblasColMajor, CblasConjTrans, CblasNoTrans, DOA_ANGLE_GRID_SIZE, numPoints, m_numVrx, &alpha, m_steering.data(), m_numVrx,
+                snapshots, m_numVrx, &beta, m_response.data(), DOA_ANGLE_GRID_SIZE);
+
+    if (!m_threadPool) {
+      peakSearch(method, snapshots, 0, numPoints, angles);
+      return;
+    }
+    m_threadPool->parallelFor(numPoints, [&](int, int begin, int end) {
+      peakSearch(method, snapshots, begin, end, angles);
+    }, RADAR_MIN_POINTS_PER_TASK);
+}
+
+void DOAEngine::peakSearch(AoaEstimationType method, const ComplexFloat* snapshots, int begin, int end, float* angles) const{
+    for (int p = begin; p < end; p++) {
+      const ComplexFloat* x = snapshots + (size_t)p * m_numVrx;
+      const ComplexFloat* response = m_response.data() + (size_t)p * DOA_ANGLE_GRID_SIZE;
+      double norm2 = 0;
+      for (int j = 0; j < m_numVrx; j++) {
+        norm2 += std::norm(x[j]);
+      }
+
+      // spectra are evaluated in double so that they stay strictly monotonic in the response power
+      int best = 0;
+      double bestValue = -1;
+      for (int g = 0; g < DOA_ANGLE_GRID_SIZE; g++) {
+        const double power = std::norm(response[g]);
+        double value;
+        if (method == CAPON) {
+          double denom = (m_numVrx - power / (DOA_CAPON_DIAGONAL_LOADING + norm2)) / DOA_CAPON_DIAGONAL_LOADING;
+          value = 1.0 / std::max(denom, std::numeric_limits<double>::min());
+        }
+        else if (method == MUSIC) {
+          double denom = norm2 > 0 ? m_numVrx - power / norm2 : m_numVrx;
+          value = 1.0 / std::max(denom, std::numeric_limits<double>::min());
+        }
+        else {
+          value = power;
+        }
+        if (value > bestValue) {
+          bestValue = value;
+          best = g;
+        }
+      }
+      angles[p] = m_gridAngles[best];
+    }
+}
+
+void DOAEstimation::estimateBatched(AoaEstimationType method, const std::vector<PointList2D>& points, RadarTensor<ComplexFloat>& dopplerProfile,
+                                    std::vector<float>& angles){
+    if (!doa_engine_) {
+      doa_engine_ = std::make_shared<DOAEngine>();
+    }
+    doa_engine_->configure(radar_basic_config_.numTx, radar_basic_config_.numRx, radar_basic_config_.numChirps);
+
+    const int numPoints = points.size();
+    std::vector<ComplexFloat> snapshots((size_t)numPoints * n_vrx_);
+    for (int i = 0; i < numPoints; i++) {
+      RadarTensorView<ComplexFloat> antView = dopplerProfile.antennaLine(points[i].range_index, points[i].doppler_index);
+      for (int k = 0; k < n_vrx_; k++) {
+        snapshots[(size_t)i * n_vrx_ + k] = antView[k];
+      }
+    }
+    angles.resize(numPoints);
+    doa_engine_->estimate(method, snapshots.data(), numPoints, angles.data());
+}
+
 void DOAEstimation::generateCompCoff(phaseParameter &phase_parameter, int speedBin,
                                                      std::vector<ComplexFloat> &compCoffVec)
 {
-    int txNum = phase_parameter.txAntenna;
-    int rxNum = phase_parameter.rxAntenna;
-    compCoffVec.resize(txNum * rxNum);
-    float phi = 2 * PI * (speedBin - phase_parameter.dopplerBin / 2 - 1) /
-                phase_parameter.dopplerBin;
-
-    for (int txId = 0; txId < txNum; txId++)
-    {
-      for (int rxId = 0; rxId < rxNum; rxId++)
-      {
-        const int compCoffVec_index = txId * rxNum + rxId;
-        compCoffVec[compCoffVec_index] = exp(-1 * sqrt(-1) * txId * phi);
-      }
+    if (!doa_engine_) {
+      doa_engine_ = std::make_shared<DOAEngine>();
     }
+    doa_engine_->configure(phase_parameter.txAntenna, phase_parameter.rxAntenna, phase_parameter.dopplerBin);
+    const ComplexFloat* compCoff = doa_engine_->compensation(speedBin);
+    compCoffVec.assign(compCoff, compCoff + doa_engine_->numVrx());
 }
 
 void DOAEstimation::calculate_pcls(std::shared_ptr<pointClouds> &input, std::shared_ptr<pointClouds> &output, RadarBasicConfig &radar_basic_config)
@@ -975,7 +804,10 @@ void FFTAngleEstimation::angleFFT(ComplexFloat* frameData, float& angle)
     ComplexFloat* frameDatain = new ComplexFloat[angleFFTNum]();
     memcpy(frameDatain, frameData, n_vrx_*sizeof(ComplexFloat)); //zero padding
 
-    fft_complex(frameDatain, frameDataout, angleFFTNum);
+    if (!fft_plan_cache_) {
+      fft_plan_cache_ = std::make_shared<FFTPlanCache>();
+    }
+    fft_complex(frameDatain, frameDataout, angleFFTNum, *fft_plan_cache_);
     // fftshift
     fftshift(frameDataout, angleFFTNum);
 
@@ -1022,8 +854,9 @@ void FFTAngleEstimation::doa_estimation()
       dopplerIndexs.push_back(dopplerIdx);
 
       ComplexFloat* ant = new ComplexFloat[n_vrx_]();
+      RadarTensorView<ComplexFloat> antView = doppler_profile_->antennaLine(rangeIdx, dopplerIdx);
       for(int k=0;k<n_vrx_; k++){
-        ant[k] = doppler_profile_->at(rangeIdx, dopplerIdx, k);
+        ant[k] = antView[k];
       }
 
       // no phase compensation
@@ -1062,389 +895,70 @@ void FFTAngleEstimation::doa_estimation()
     calculate_pcls(pointClouds_, pointClouds_, radar_basic_config_);
 }
 
-void DBFAngleEstimation::angleDBF(ComplexFloat* frameData, float& angle)
-{
-  
-  float deg[360];
-  float dphi[n_vrx_];
-  ComplexFloat doa_dbf[360];
-  for (int i = 0; i < 360; i++) {
-    ComplexFloat weightVec[n_vrx_];
-    deg[i] = float(i - 180) / 2.0;
-    for (int j = 0; j < n_vrx_; j++) {
-      dphi[j] = j * 2 * PI * 0.5 * std::sin(deg[i] * PI / 180);
-      weightVec[j] = std::exp(ComplexFloat(0, -dphi[j]));
-    }
-
-    ComplexFloat c[n_vrx_];
-
-    ComplexFloat temp;
-    ComplexFloat result;
-    int rows = 1;
-    int cols = n_vrx_;
-    MKL_Complex8 alpha = {1.0, 0.0};
-    MKL_Complex8 beta = {0.0, 0.0};
-    int N =n_vrx_;
-    cblas_cdotu_sub(N, frameData, 1, weightVec, 1, &result);
-    doa_dbf[i] = result;
-  }
-
-  float res[360];
-  for (int i = 0; i < 360; i++) {
-    res[i] = std::sqrt(doa_dbf[i].imag() * doa_dbf[i].imag() +
-                        doa_dbf[i].real() * doa_dbf[i].real());
-  }
-  int local_max = std::max_element(res, res+360) -res;
-  angle = (local_max-180)/2.0f;
-
-}
-
 void DBFAngleEstimation::doa_estimation()
 {
-    std::vector<float> angleArrays;
-    // vector<int> angleIndexs;
-    std::vector<int> rangeIndexs;
-    std::vector<int> dopplerIndexs;
-    std::vector<float> SNRArrays;
-    angleArrays.clear();
-    // angleIndexs.clear();
-    rangeIndexs.clear();
-    dopplerIndexs.clear();
-    SNRArrays.clear();
-    phaseParameter pha_param;
-    pha_param = setPhaseParameters();
-    for (int i = 0; i < peakOutput_.points.size(); i++)
+    std::vector<float> angles;
+    estimateBatched(DBF, peakOutput_.points, *doppler_profile_, angles);
+
+    const int num = peakOutput_.points.size();
+    pointClouds_->rangeIdxArray.resize(num);
+    pointClouds_->speedIdxArray.resize(num);
+    pointClouds_->aoaVar.resize(num);
+    pointClouds_->SNRArray.resize(num);
+    for (int i = 0; i < num; i++)
     {
-      int rangeIdx = peakOutput_.points[i].range_index;
-      int dopplerIdx = peakOutput_.points[i].doppler_index;
-      rangeIndexs.push_back(rangeIdx);
-      dopplerIndexs.push_back(dopplerIdx);
-
-      ComplexFloat* ant = new ComplexFloat[n_vrx_]();
-      for(int k=0;k<n_vrx_; k++){
-        ant[k] = doppler_profile_->at(rangeIdx, dopplerIdx, k);
-      }
-
-      // no phase compensation
-
-      // int speedBin = dopplerIdx;
-      // std::vector<ComplexFloat> compCoff;
-      // generateCompCoff(pha_param, speedBin, compCoff);
-      // std::vector<ComplexFloat> ant_comp;
-      // // ant_comp = ant.*compCoff;
-      // for (int j = 0; j < ant_comp.size(); j++)
-      // {
-      //   // complex mu
-      //   ant_comp[j].real(ant[j].real() * compCoff[j].real() -
-      //                    ant[j].imag() * compCoff[j].imag());
-      //   ant_comp[j].imag(compCoff[j].imag() * ant[j].real() +
-      //                    ant[j].real() * compCoff[j].imag());
-      // }
-
-      float ang;
-
-      angleDBF(ant, ang); // no angle compensation
-
-      angleArrays.push_back(-ang);
-      SNRArrays.push_back(peakOutput_.points[i].snr);
-      // calculate pcl
-      delete []ant;
+      pointClouds_->rangeIdxArray[i] = peakOutput_.points[i].range_index;
+      pointClouds_->speedIdxArray[i] = peakOutput_.points[i].doppler_index;
+      pointClouds_->aoaVar[i] = -angles[i];
+      pointClouds_->SNRArray[i] = peakOutput_.points[i].snr;
     }
-    pointClouds_->rangeIdxArray = rangeIndexs;
-    pointClouds_->speedIdxArray =dopplerIndexs;
-    pointClouds_->aoaVar = angleArrays;
-    pointClouds_->SNRArray =SNRArrays;
 
-    pointClouds_->num = peakOutput_.points.size();
-    // pointClouds_.SNRArray = cfar_output_.SNRArray;  
+    pointClouds_->num = num;
     calculate_pcls(pointClouds_, pointClouds_, radar_basic_config_);
 }
 
 
-void CaponAngleEstimation::angleCapon(ComplexFloat* frameData, float& angle)
-{
-
-    ComplexDouble* frameDatain = new ComplexDouble[n_vrx_];
-    for (int i = 0; i < n_vrx_; ++i) {
-        frameDatain[i] = static_cast<ComplexDouble>(frameData[i]);
-    }
-    int n = n_vrx_;
-    int n_Rxx = n*n;
-    ComplexDouble Rxx[n_Rxx]={0};
-    ComplexFloat Pmusic[360] = {0};
-    
-    MKL_Complex16 alpha = {1.0, 0.0};
-    MKL_Complex16 beta = {0.0, 0.0};
-    cblas_zgerc(CblasColMajor, n, n, &alpha, frameDatain, 1, frameDatain, 1, Rxx, n);
-
-    // get inverse of Rxx
-
-    lapack_int ipiv[n];
-    int info;
-    double lambda = 1e-8;
-    for (int i = 0; i < n; ++i) {
-        Rxx[i*n+i] += lambda;
-    }
-    info = LAPACKE_zgetrf(LAPACK_ROW_MAJOR, n, n, reinterpret_cast<lapack_complex_double*>(Rxx), n, ipiv);
-    if (info < 0) {
-        // info = 0: The function completed successfully.
-        // info > 0: Indicates that the matrix is singular, and the value of info represents the position of the first zero pivot. For example, if info = 3,
-        // it means that the third pivot element is zero, and the matrix is singular.
-        // info < 0: Indicates that the -info-th parameter had an illegal value.
-        HVA_ERROR("LAPACKE_zgetrf failed with error %d", info);
-    }
-    info = LAPACKE_zgetri(LAPACK_ROW_MAJOR, n, reinterpret_cast<lapack_complex_double*>(Rxx), n, ipiv);
-    if (info < 0) {
-        // info = 0: The function completed successfully.
-        // info > 0: Indicates that the matrix is singular, and the value of info represents the position of the first zero pivot. For example, if info = 3,
-        // it means that the third pivot element is zero, and the matrix is singular.
-        // info < 0: Indicates that the -info-th parameter had an illegal value.
-        HVA_ERROR("LAPACKE_zgetri failed with error %d", info);
-    }
-
-    double deg[360];
-    double dphi[n_vrx_];
-    ComplexDouble Pcapon[360];
-    for (int i = 0; i < 360; i++) {
-      ComplexDouble weightVec[n_vrx_];
-      deg[i] = double(i - 180) / 2.0;
-      for (int j = 0; j < n_vrx_; j++) {
-        dphi[j] = j * 2 * PI * 0.5 * std::sin(deg[i] * PI / 180);
-        ComplexDouble exponent(0.0, dphi[j]);
-        weightVec[j] = std::exp(exponent);
-      }
-
-      ComplexDouble result;
-
-      int vRx = n_vrx_;
-      ComplexDouble tempVec[vRx];
-
-      cblas_zgemv(CblasColMajor, CblasNoTrans, vRx, vRx, &alpha, Rxx, vRx,
-                  weightVec, 1, &beta, tempVec, 1);
-
-      for (int i = 0; i < vRx; ++i) {
-        result += std::conj(weightVec[i]) * tempVec[i];
-      }
-
-      Pcapon[i] = ComplexDouble(1.0, 0.0) / (result);
-    }
-
-    float res[360];
-    for (int i = 0; i < 360; i++) {
-      res[i] = std::sqrt(Pcapon[i].imag() * Pcapon[i].imag() +
-                         Pcapon[i].real() * Pcapon[i].real());
-    }
-    int local_max = std::max_element(res, res + 360) - res;
-    angle = (local_max - 180) / 2.0f;
-
-    delete[] frameDatain;
-}
-
 void CaponAngleEstimation::doa_estimation()
 {
-    std::vector<float> angleArrays;
-    // vector<int> angleIndexs;
-    std::vector<int> rangeIndexs;
-    std::vector<int> dopplerIndexs;
-    std::vector<float> SNRArrays;
-    angleArrays.clear();
-    // angleIndexs.clear();
-    rangeIndexs.clear();
-    dopplerIndexs.clear();
-    SNRArrays.clear();
-    phaseParameter pha_param;
-    pha_param = setPhaseParameters();
-    for (int i = 0; i < peakOutput_.points.size(); i++)
+    std::vector<float> angles;
+    estimateBatched(CAPON, peakOutput_.points, *doppler_profile_, angles);
+
+    const int num = peakOutput_.points.size();
+    pointClouds_->rangeIdxArray.resize(num);
+    pointClouds_->speedIdxArray.resize(num);
+    pointClouds_->aoaVar.resize(num);
+    pointClouds_->SNRArray.resize(num);
+    for (int i = 0; i < num; i++)
     {
-      int rangeIdx = peakOutput_.points[i].range_index;
-      int dopplerIdx = peakOutput_.points[i].doppler_index;
-      rangeIndexs.push_back(rangeIdx);
-      dopplerIndexs.push_back(dopplerIdx);
-
-      ComplexFloat* ant = new ComplexFloat[n_vrx_]();
-      for(int k=0;k<n_vrx_; k++){
-        ant[k] = doppler_profile_->at(rangeIdx, dopplerIdx, k);
-      }
-
-      // no phase compensation
-
-      // int speedBin = dopplerIdx;
-      // std::vector<ComplexFloat> compCoff;
-      // generateCompCoff(pha_param, speedBin, compCoff);
-      // std::vector<ComplexFloat> ant_comp;
-      // // ant_comp = ant.*compCoff;
-      // for (int j = 0; j < ant_comp.size(); j++)
-      // {
-      //   // complex mu
-      //   ant_comp[j].real(ant[j].real() * compCoff[j].real() -
-      //                    ant[j].imag() * compCoff[j].imag());
-      //   ant_comp[j].imag(compCoff[j].imag() * ant[j].real() +
-      //                    ant[j].real() * compCoff[j].imag());
-      // }
-
-      float ang;
-
-      angleCapon(ant, ang); // no angle compensation
-
-      angleArrays.push_back(-ang);
-      SNRArrays.push_back(peakOutput_.points[i].snr);
-      // calculate pcl
-      delete []ant;
+      pointClouds_->rangeIdxArray[i] = peakOutput_.points[i].range_index;
+      pointClouds_->speedIdxArray[i] = peakOutput_.points[i].doppler_index;
+      pointClouds_->aoaVar[i] = -angles[i];
+      pointClouds_->SNRArray[i] = peakOutput_.points[i].snr;
     }
-    pointClouds_->rangeIdxArray = rangeIndexs;
-    pointClouds_->speedIdxArray =dopplerIndexs;
-    pointClouds_->aoaVar = angleArrays;
-    pointClouds_->SNRArray =SNRArrays;
 
-    pointClouds_->num = peakOutput_.points.size();
-    // pointClouds_.SNRArray = cfar_output_.SNRArray;  
+    pointClouds_->num = num;
     calculate_pcls(pointClouds_, pointClouds_, radar_basic_config_);
 }
 
-void MusicAngleEstimation::angleMusic(ComplexFloat* frameData, float& angle)
-{
-  ComplexFloat* frameDatain = new ComplexFloat[n_vrx_]();
-  memcpy(frameDatain, frameData, n_vrx_ * sizeof(ComplexFloat));
-
-  int n = n_vrx_;
-  int nn = n * n;
-  ComplexFloat Rxx[nn] = {0};
-  ComplexFloat Pmusic[360] = {0};
-
-  MKL_Complex8 alpha = {1.0, 0.0};
-  MKL_Complex8 beta = {0.0, 0.0};
-  MKL_INT lda = n_vrx_;
-
-  cblas_cgerc(CblasColMajor, n, n, &alpha, frameDatain, 1, frameDatain, 1, Rxx, n);
-
-  float s[n_vrx_];
-
-  MKL_INT info;
-
-  info = LAPACKE_cheevd(LAPACK_ROW_MAJOR, 'V', 'U', n, reinterpret_cast<MKL_Complex8*>(Rxx), lda, s);
-  if (info > 0) {
-    HVA_ERROR("The algorithm failed to compute eigenvalues.");
-  }
-  int n_En = n * (n - 1);
-  ComplexFloat En[n_En];
-  ComplexFloat Pn[nn];
-
-  for (int i = 0; i < n; i++) {
-    for (int j = 0; j < n / 2; j++) {
-      ComplexFloat temp = Rxx[i * n + j];
-      Rxx[i * n + j] = Rxx[i * n + (n - j - 1)];
-      Rxx[i * n + (n - j - 1)] = temp;
-    }
-  }
-
-  for (int i = 0; i < n; i++) {
-    for (int j = 0; j < n; j++) {
-      En[i * n + j] = Rxx[i * n + 1 + j];
-    }
-  }
-
-  cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, n, n, n - 1, &alpha,
-              En, n, En, n, &beta, Pn, n);
-
-  float deg[360];
-  float dphi[n_vrx_];
-
-  ComplexFloat I = ComplexFloat(0.0f, 1.0f);
-
-  for (int i = 0; i < 360; i++) {
-    ComplexFloat weightVec[n_vrx_];
-    deg[i] = float(i - 180) / 2.0;
-    for (int j = 0; j < n_vrx_; j++) {
-      dphi[j] = j * 2 * PI * 0.5 * std::sin(deg[i] * PI / 180);
-      ComplexFloat exponent(0.0f, dphi[j]);
-      weightVec[j] = std::exp(exponent);
-    }
-
-    ComplexFloat result;
-
-    int vRx = 8;
-    ComplexFloat tempVec[vRx];
-
-    cblas_cgemv(CblasColMajor, CblasNoTrans, vRx, vRx, &alpha, Pn, vRx,
-                weightVec, 1, &beta, tempVec, 1);
-
-    for (int i = 0; i < vRx; ++i) {
-      result += std::conj(weightVec[i]) * tempVec[i];
-    }
-
-    Pmusic[i] = ComplexFloat(1) / (result);
-  }
-
-  float res[360];
-  for (int i = 0; i < 360; i++) {
-    res[i] = std::abs(Pmusic[i]);
-  }
-
-  int local_max = std::max_element(res, res + 360) - res;
-
-  angle = (local_max - 180) / 2.0f;
-
-  delete[] frameDatain;
-}
-
 void MusicAngleEstimation::doa_estimation()
 {
-    std::vector<float> angleArrays;
-    // vector<int> angleIndexs;
-    std::vector<int> rangeIndexs;
-    std::vector<int> dopplerIndexs;
-    std::vector<float> SNRArrays;
-    angleArrays.clear();
-    // angleIndexs.clear();
-    rangeIndexs.clear();
-    dopplerIndexs.clear();
-    SNRArrays.clear();
-    phaseParameter pha_param;
-    pha_param = setPhaseParameters();
-    for (int i = 0; i < peakOutput_.points.size(); i++)
+    std::vector<float> angles;
+    estimateBatched(MUSIC, peakOutput_.points, *doppler_profile_, angles);
+
+    const int num = peakOutput_.points.size();
+    pointClouds_->rangeIdxArray.resize(num);
+    pointClouds_->speedIdxArray.resize(num);
+    pointClouds_->aoaVar.resize(num);
+    pointClouds_->SNRArray.resize(num);
+    for (int i = 0; i < num; i++)
     {
-      int rangeIdx = peakOutput_.points[i].range_index;
-      int dopplerIdx = peakOutput_.points[i].doppler_index;
-      rangeIndexs.push_back(rangeIdx);
-      dopplerIndexs.push_back(dopplerIdx);
-
-      ComplexFloat* ant = new ComplexFloat[n_vrx_]();
-      for(int k=0;k<n_vrx_; k++){
-        ant[k] = doppler_profile_->at(rangeIdx, dopplerIdx, k);
-      }
-
-      // no phase compensation
-
-      // int speedBin = dopplerIdx;
-      // std::vector<ComplexFloat> compCoff;
-      // generateCompCoff(pha_param, speedBin, compCoff);
-      // std::vector<ComplexFloat> ant_comp;
-      // // ant_comp = ant.*compCoff;
-      // for (int j = 0; j < ant_comp.size(); j++)
-      // {
-      //   // complex mu
-      //   ant_comp[j].real(ant[j].real() * compCoff[j].real() -
-      //                    ant[j].imag() * compCoff[j].imag());
-      //   ant_comp[j].imag(compCoff[j].imag() * ant[j].real() +
-      //                    ant[j].real() * compCoff[j].imag());
-      // }
-
-      float ang;
-
-      angleMusic(ant, ang); // no angle compensation
-
-      angleArrays.push_back(-ang);
-      SNRArrays.push_back(peakOutput_.points[i].snr);
-      // calculate pcl
-      delete []ant;
+      pointClouds_->rangeIdxArray[i] = peakOutput_.points[i].range_index;
+      pointClouds_->speedIdxArray[i] = peakOutput_.points[i].doppler_index;
+      pointClouds_->aoaVar[i] = -angles[i];
+      pointClouds_->SNRArray[i] = peakOutput_.points[i].snr;
     }
-    pointClouds_->rangeIdxArray = rangeIndexs;
-    pointClouds_->speedIdxArray =dopplerIndexs;
-    pointClouds_->aoaVar = angleArrays;
-    pointClouds_->SNRArray =SNRArrays;
 
-    pointClouds_->num = peakOutput_.points.size();
-    // pointClouds_.SNRArray = cfar_output_.SNRArray;  
+    pointClouds_->num = num;
     calculate_pcls(pointClouds_, pointClouds_, radar_basic_config_);
 }
 
@@ -23,7 +23,7 @@ namespace ai {
 
 namespace inference {
 
-ClusterTracker::ClusterTracker()
+ClusterTracker::ClusterTracker() : m_handle(nullptr)
 {
     // clusterTrackerErrorCode errorCode = clusterTrackerCreate(param);
     // if (errorCode != CLUSTERTRACKER_NO_ERROR) {
@@ -55,6 +55,7 @@ clusterTrackerErrorCode ClusterTracker::clusterTrackerCreate(RadarTrackingConfig
     m_handle->trackerForgetThreshold = param->trackerForgetThreshold;
     m_handle->measurementNoiseVariance = param->measurementNoiseVariance;
     m_handle->iirForgetFactor = param->iirForgetFactor;
+    m_handle->associationMethod = param->associationMethod;
     // m_handle->fxInputScalar = param->fxInputScalar;
 
     // memory allocation
@@ -94,15 +95,35 @@ clusterTrackerErrorCode ClusterTracker::clusterTrackerCreate(RadarTrackingConfig
     // initialized the trackerList
     clusterTrackerList_init();
 
+    // association scratch, sized for the worst case once
+    m_activeTids.reserve(CT_MAX_NUM_TRACKER);
+    m_assocGate.reserve(CT_MAX_NUM_TRACKER);
+    m_rangeOrder.reserve(CT_MAX_NUM_TRACKER);
+    m_assocEdges.reserve(CT_MAX_NUM_TRACKER * CT_MAX_NUM_CLUSTER);
+    m_nearestSlot.reserve(CT_MAX_NUM_CLUSTER);
+    m_matchedSlot.reserve(CT_MAX_NUM_CLUSTER);
+    m_assocParent.reserve(CT_MAX_NUM_TRACKER + CT_MAX_NUM_CLUSTER);
+    m_localIndex.reserve(CT_MAX_NUM_TRACKER + CT_MAX_NUM_CLUSTER);
+    m_localMeas.reserve(CT_MAX_NUM_CLUSTER);
+    m_localSlots.reserve(CT_MAX_NUM_TRACKER);
+    m_assocCosts.reserve(CT_MAX_NUM_TRACKER * CT_MAX_NUM_CLUSTER);
+    m_assignments.reserve(CT_MAX_NUM_TRACKER);
+    m_optimizer.reset(new HungarianOptimizer<float>(CT_MAX_NUM_TRACKER));
+    m_batch.reset(new trackerBatchDataType());
+
     return errorCode;
 }
 
 void ClusterTracker::clusterTrackerDelete()
 {
+    if (m_handle == nullptr) {
+        return;
+    }
     free(m_handle->trackerElementArray);
     free(m_handle->tracker);
     free(m_handle->scratchPad);
     free(m_handle);
+    m_handle = nullptr;
     // radarOsal_memFree(m_handle->trackerElementArray, CT_MAX_NUM_TRACKER * sizeof(trackerListElement));
     // radarOsal_memFree(m_handle->tracker, CT_MAX_NUM_TRACKER * sizeof(trackerInternalDataType));
     // radarOsal_memFree(m_handle->scratchPad, 2 * CT_MAX_NUM_ASSOC * CT_MAX_NUM_TRACKER * sizeof(int));
@@ -171,7 +192,10 @@ clusterTrackerErrorCode ClusterTracker::clusterTrackerRun(trackerInput *input, f
     clusterTracker_updateFQ(dt);
     clusterTracker_timeUpdateTrackers();  // compute S_apriori_hat and H_s_apriori_hat in activeTrackerList
     if (input->numCluster > 0) {
-        errorCode = clusterTracker_associateTrackers();
+        if (m_handle->associationMethod == ASSOCIATION_GLOBAL)
+            errorCode = clusterTracker_associateTrackersKM();
+        else
+            errorCode = clusterTracker_associateTrackers();
         if (errorCode > CLUSTERTRACKER_NO_ERROR)
             return errorCode;
 
@@ -180,7 +204,7 @@ clusterTrackerErrorCode ClusterTracker::clusterTrackerRun(trackerInput *input, f
             return errorCode;
     }
 
-    clusterTracker_updateTrackers((float *)&m_handle->scratchPad[index]);
+    clusterTracker_updateTrackers();
     clusterTracker_reportTrackers(output);
     return errorCode;
 }
@@ -299,21 +323,35 @@ void ClusterTracker::clusterTrackerList_removeFromList(int listId)
 
 void ClusterTracker::clusterTracker_timeUpdateTrackers()
 {
-    int i, tid;
+    int i, k, tid;
     int numTracker = m_handle->activeTrackerList.size;
     trackerListElement *tElem;
     trackerInternalDataType *tracker;
+    trackerBatchDataType *batch = m_batch.get();
+
+    // gather the states of the active trackers into the lanes
+    batch->num = numTracker;
+    batch->numHit = 0;
     tElem = m_handle->activeTrackerList.first;
     for (i = 0; i < numTracker; i++) {
         tid = tElem->tid;
         tracker = &m_handle->tracker[tid];
-        // Prediction based on state equation
-        tracker_matrixMultiply(4, 4, 1, m_handle->F, tracker->S_hat, tracker->S_apriori_hat);  // x'=fx+u, Sapr(n) =Fs(n-1) compute S_apriori_hat
-
-        // convert from spherical to Cartesian coordinates
-        tracker_computeH(tracker->S_apriori_hat, tracker->H_s_apriori_hat);
+        batch->tid[i] = tid;
+        for (k = 0; k < 4; k++)
+            batch->S_hat[k][i] = tracker->S_hat[k];
         tElem = (trackerListElement *)(tElem->next);
     }
+
+    // Prediction based on state equation, then convert from spherical to Cartesian coordinates
+    clusterTracker_batchTimeUpdate(batch, m_handle->F);
+
+    for (i = 0; i < numTracker; i++) {
+        tracker = &m_handle->tracker[batch->tid[i]];
+        for (k = 0; k < 4; k++)
+            tracker->S_apriori_hat[k] = batch->S_apriori_hat[k][i];
+        for (k = 0; k < 3; k++)
+            tracker->H_s_apriori_hat[k] = batch->H_s_apriori_hat[k][i];
+    }
 }
 
 clusterTrackerErrorCode ClusterTracker::clusterTracker_associateTrackers()
@@ -380,62 +418,198 @@ clusterTrackerErrorCode ClusterTracker::clusterTracker_associateTrackers()
     return errorCode;
 }
 
-// KM algorithm for multiple objects detection
-clusterTrackerErrorCode ClusterTracker::clusterTracker_associateTrackersKM()
+int ClusterTracker::clusterTracker_findRoot(int node)
 {
-    size_t nTrack = m_handle->activeTrackerList.size;
-    size_t nMeas = m_handle->numOfInputMeasure;
-    size_t mid, n, j, tid, index, minTid, len, assocIndex, minMid;
-    float minDist, distTH, dist;
-    float *distPtr;
+    while (m_assocParent[node] != node) {
+        m_assocParent[node] = m_assocParent[m_assocParent[node]];
+        node = m_assocParent[node];
+    }
+    return node;
+}
+
+void ClusterTracker::clusterTracker_gateCandidates()
+{
+    int nTrack = m_handle->activeTrackerList.size;
+    int nMeas = m_handle->numOfInputMeasure;
+    int j, mid, slot;
+    float maxGate, band, range, dist, minDist;
     trackerListElement *tElem;
     trackerInternalDataType *tracker;
+
+    m_activeTids.resize(nTrack);
+    m_assocGate.resize(nTrack);
+    m_rangeOrder.resize(nTrack);
+    maxGate = 0;
+    tElem = m_handle->activeTrackerList.first;
+    for (j = 0; j < nTrack; j++) {
+        tracker = &m_handle->tracker[tElem->tid];
+        m_activeTids[j] = tElem->tid;
+        m_assocGate[j] = clusterTracker_associateThresholdCalc(m_handle->trackerAssociationThreshold, tracker);
+        maxGate = std::max(maxGate, m_assocGate[j]);
+        m_rangeOrder[j] = std::make_pair(tracker->H_s_apriori_hat[0], j);
+        tElem = (trackerListElement *)(tElem->next);
+    }
+    std::sort(m_rangeOrder.begin(), m_rangeOrder.end());
+
+    // the distance is the squared euclidean distance, so it is never below the squared range difference,
+    // the band is widened a little against rounding of the distance
+    band = std::sqrt(maxGate) * 1.001f;
+
+    m_assocEdges.clear();
+    m_nearestSlot.assign(nMeas, -1);
+    for (mid = 0; mid < nMeas; mid++) {
+        range = m_handle->inputInfo[mid].range;
+        minDist = CT_MAX_DIST;
+        auto it = std::lower_bound(m_rangeOrder.begin(), m_rangeOrder.end(), std::make_pair(range - band, -1));
+        for (; (it != m_rangeOrder.end()) && (it->first <= range + band); ++it) {
+            slot = it->second;
+            clusterTracker_distCalc(&m_handle->inputInfo[mid], &m_handle->tracker[m_activeTids[slot]], &dist);
+            if (dist < m_assocGate[slot]) {
+                m_assocEdges.push_back({mid, slot, dist});
+                if (dist < minDist) {
+                    minDist = dist;
+                    m_nearestSlot[mid] = slot;
+                }
+            }
+        }
+    }
+}
+
+void ClusterTracker::clusterTracker_assignComponent(size_t begin, size_t end)
+{
+    int nMeas = m_handle->numOfInputMeasure;
+    size_t e, rows, cols, best;
+    float forbidden;
+
+    m_localMeas.clear();
+    m_localSlots.clear();
+    for (e = begin; e < end; e++) {
+        const clusterTrackerAssocEdge &edge = m_assocEdges[e];
+        if (m_localIndex[edge.mid] < 0) {
+            m_localIndex[edge.mid] = (int)m_localMeas.size();
+            m_localMeas.push_back(edge.mid);
+        }
+        if (m_localIndex[nMeas + edge.slot] < 0) {
+            m_localIndex[nMeas + edge.slot] = (int)m_localSlots.size();
+            m_localSlots.push_back(edge.slot);
+        }
+    }
+
+    if ((m_localMeas.size() == 1) || (m_localSlots.size() == 1)) {
+        // only one pair can be kept, the cheapest one is the optimal assignment
+        best = begin;
+        for (e = begin + 1; e < end; e++) {
+            if (m_assocEdges[e].dist < m_assocEdges[best].dist)
+                best = e;
+        }
+        m_matchedSlot[m_assocEdges[best].mid] = m_assocEdges[best].slot;
+    }
+    else {
+        rows = m_localMeas.size();
+        cols = m_localSlots.size();
+
+        // a pair outside the gate costs more than all the gated pairs together,
+        // so the solver first maximizes the number of gated pairs and then minimizes their distance
+        forbidden = 1;
+        for (e = begin; e < end; e++)
+            forbidden += std::max(m_assocEdges[e].dist, 0.f);
+        m_assocCosts.assign(rows * cols, forbidden);
+        for (e = begin; e < end; e++) {
+            const clusterTrackerAssocEdge &edge = m_assocEdges[e];
+            m_assocCosts[m_localIndex[edge.mid] * cols + m_localIndex[nMeas + edge.slot]] = edge.dist;
+        }
+
+        SecureMat<float> *costs = m_optimizer->costs();
+        costs->Resize(rows, cols);
+        for (size_t row = 0; row < rows; row++) {
+            for (size_t col = 0; col < cols; col++)
+                (*costs)(row, col) = m_assocCosts[row * cols + col];
+        }
+        m_optimizer->Minimize(&m_assignments);
+
+        for (auto &item : m_assignments) {
+            if (m_assocCosts[item.first * cols + item.second] < forbidden)
+                m_matchedSlot[m_localMeas[item.first]] = m_localSlots[item.second];
+        }
+    }
+
+    for (int mid : m_localMeas)
+        m_localIndex[mid] = -1;
+    for (int slot : m_localSlots)
+        m_localIndex[nMeas + slot] = -1;
+}
+
+// gated global assignment: only pairs within the association threshold are considered, and every connected group of
+// such pairs is solved on its own, so the cost follows the number of plausible pairs instead of trackers x measurements
+clusterTrackerErrorCode ClusterTracker::clusterTracker_associateTrackersKM()
+{
+    int nTrack = m_handle->activeTrackerList.size;
+    int nMeas = m_handle->numOfInputMeasure;
+    int i, mid, slot, tid, len, assocIndex;
+    size_t e, begin;
     clusterTrackerErrorCode errorCode;
-    bool hitFlag;
 
     errorCode = CLUSTERTRACKER_NO_ERROR;
+    if ((nMeas == 0) || (nTrack == 0))
+        return errorCode;
 
-   if ((nMeas > 0) && (nTrack > 0)) {
-    std::vector<std::vector<float>> costMatrix(nMeas, std::vector<float>(nTrack, 0));
-
-    for (size_t mid = 0; mid < nMeas; mid++) {
-        tElem = m_handle->activeTrackerList.first;
-        for (size_t j = 0; j < nTrack; j++) {
-            tracker = &m_handle->tracker[tElem->tid];
-            float dist;
-            clusterTracker_distCalc(&m_handle->inputInfo[mid], tracker, &dist);
-            costMatrix[mid][j] = dist;
-            tElem = (trackerListElement *)(tElem->next);
+    clusterTracker_gateCandidates();
+    m_matchedSlot.assign(nMeas, -1);
+
+    // measurements are the nodes [0, nMeas), the tracker in slot j is the node nMeas + j
+    m_assocParent.resize(nMeas + nTrack);
+    for (i = 0; i < nMeas + nTrack; i++)
+        m_assocParent[i] = i;
+    for (auto &edge : m_assocEdges) {
+        int a = clusterTracker_findRoot(edge.mid);
+        int b = clusterTracker_findRoot(nMeas + edge.slot);
+        if (a != b)
+            m_assocParent[b] = a;
+    }
+    for (i = 0; i < nMeas + nTrack; i++)
+        m_assocParent[i] = clusterTracker_findRoot(i);
+
+    // group the pairs by component, the measurement order inside a component is kept
+    std::sort(m_assocEdges.begin(), m_assocEdges.end(), [this](const clusterTrackerAssocEdge &x, const clusterTrackerAssocEdge &y) {
+        int rx = m_assocParent[x.mid];
+        int ry = m_assocParent[y.mid];
+        if (rx != ry)
+            return rx < ry;
+        if (x.mid != y.mid)
+            return x.mid < y.mid;
+        return x.slot < y.slot;
+    });
+
+    m_localIndex.assign(nMeas + nTrack, -1);
+    begin = 0;
+    for (e = 1; e <= m_assocEdges.size(); e++) {
+        if ((e == m_assocEdges.size()) || (m_assocParent[m_assocEdges[e].mid] != m_assocParent[m_assocEdges[begin].mid])) {
+            clusterTracker_assignComponent(begin, e);
+            begin = e;
         }
     }
-    HungarianOptimizer<float> optimizer;
-    std::vector<std::pair<size_t, size_t>> assignments;
-    // std::vector<int> assignments;
-    UpdateCosts(costMatrix, optimizer.costs());
-    optimizer.Minimize(&assignments);
-
-    for(size_t mid=0;mid < nMeas; mid++){
-
-        for(auto &item:assignments){
-            if(item.first == mid){
-                minTid = item.second;
-                len = m_handle->numAssoc[item.second];
-                assocIndex = item.second * CT_MAX_NUM_ASSOC + len;
-                // add to the association list
-                m_handle->associatedList[assocIndex] = mid;
-                m_handle->numAssoc[item.second]++;
-                // remove from pending Indication list
-                m_handle->pendingIndication[mid] = 0;
-                // error protection
-                if (m_handle->numAssoc[item.second] >= CT_MAX_NUM_ASSOC) {
-                    errorCode = CLUSTERTRACKER_NUM_ASSOC_EXCEED_MAX;
-                    return (errorCode);
-                }
-            }
+
+    for (mid = 0; mid < nMeas; mid++) {
+        // a gated measurement left over by the assignment is a fragment of an object already tracked,
+        // it joins its nearest tracker as in the nearest neighbour association
+        slot = (m_matchedSlot[mid] >= 0) ? m_matchedSlot[mid] : m_nearestSlot[mid];
+        if (slot < 0)
+            continue;
+        tid = m_activeTids[slot];
+        len = m_handle->numAssoc[tid];
+        assocIndex = tid * CT_MAX_NUM_ASSOC + len;
+        // add to the association list
+        m_handle->associatedList[assocIndex] = mid;
+        m_handle->numAssoc[tid]++;
+        // remove from pending Indication list
+        m_handle->pendingIndication[mid] = 0;
+        // error protection
+        if (m_handle->numAssoc[tid] >= CT_MAX_NUM_ASSOC) {
+            errorCode = CLUSTERTRACKER_NUM_ASSOC_EXCEED_MAX;
+            return (errorCode);
         }
     }
 
-   }
     return errorCode;
 }
 
@@ -537,30 +711,30 @@ void ClusterTracker::clusterTracker_updateTrackerStateMachine(trackerInternalDat
     }
 }
 
-void ClusterTracker::clusterTracker_updateTrackers(float *scratchPad)
+void ClusterTracker::clusterTracker_updateTrackers()
 {
-    float R[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
     int nTrack = m_handle->activeTrackerList.size;
     int numExpireTracker = 0;
     int expireList[CT_MAX_NUM_EXPIRE];
+    int numMiss = 0;
+    int missList[CT_MAX_NUM_TRACKER];
     trackerListElement *tElem;
     trackerInternalDataType *tracker;
-    trackerInputInternalDataType combinedInput;
     trackerInputInternalDataType *combinedInputPtr;
-    int i, tid, mid, index;
+    trackerBatchDataType *batch = m_batch.get();
+    int i, k, tid, mid, index, lane;
     int j;
     float diag2;
     bool hitFlag;
 
+    // the state machine runs per tracker in list order, the trackers with a measurement take the first lanes and the
+    // ones that only predict are queued behind them
+    batch->numHit = 0;
     tElem = m_handle->activeTrackerList.first;
-    // debug zg:
-    // printf("\n");
     for (i = 0; i < nTrack; i++) {
         tid = tElem->tid;
         index = tid * CT_MAX_NUM_ASSOC;
         tracker = &m_handle->tracker[tid];
-        // debug zg:
-        // printf("associatedList[%d] = %d   ", index, m_handle->associatedList[index] + 1);
 
         if (m_handle->associatedList[index] > -1) {
             // there is some measurement associate with this tracker
@@ -568,35 +742,25 @@ void ClusterTracker::clusterTracker_updateTrackers(float *scratchPad)
             clusterTracker_updateTrackerStateMachine(tracker, hitFlag);
 
             // calculate the new measure based on all the assocated measures, xSize and ySize will be set to the maximum xSize and ySize
+            lane = batch->numHit++;
             mid = m_handle->associatedList[index];
-            combinedInputPtr = &m_handle->inputInfo[mid];
-            if (m_handle->numAssoc[tid] > 0) {
-                clusterTracker_combineMeasure(m_handle->inputInfo, &m_handle->associatedList[index], m_handle->numAssoc[tid], &combinedInput);
-                combinedInputPtr = &combinedInput;
-            }
+            if (m_handle->numAssoc[tid] > 0)
+                clusterTracker_combineMeasure(m_handle->inputInfo, &m_handle->associatedList[index], m_handle->numAssoc[tid], &m_combinedInput[lane]);
+            else
+                m_combinedInput[lane] = m_handle->inputInfo[mid];
+            combinedInputPtr = &m_combinedInput[lane];
+
+            batch->tid[lane] = tid;
+            batch->measure[0][lane] = combinedInputPtr->range;
+            batch->measure[1][lane] = combinedInputPtr->azimuth;
+            batch->measure[2][lane] = combinedInputPtr->doppler;
 
             // construct R matrix
-            R[0] = combinedInputPtr->rangeVar * m_handle->measurementNoiseVariance;
-            R[4] = combinedInputPtr->angleVar * m_handle->measurementNoiseVariance;
-            R[8] = combinedInputPtr->dopplerVar * m_handle->measurementNoiseVariance;
-
-            // R[0] = combinedInputPtr->rangeVar * m_handle->measurementNoiseVariance*0.001;
-            // R[4] = combinedInputPtr->angleVar * m_handle->measurementNoiseVariance*0.001;
-            // R[8] = combinedInputPtr->dopplerVar * m_handle->measurementNoiseVariance*0.001;
-
-            // update tracker->S_hat
-            clusterTracker_kalmanUpdate(tracker, combinedInputPtr, m_handle->F, m_handle->Q, R, scratchPad);
-
-            // update speed2 and doppler
-            tracker->speed2 = tracker->S_hat[2] * tracker->S_hat[2] + tracker->S_hat[3] * tracker->S_hat[3];
-            tracker->doppler = combinedInputPtr->doppler;
-
-            // update xSize and ySize
-            tracker->xSize = clusterTracker_IIRFilter(tracker->xSize, combinedInputPtr->xSize, m_handle->iirForgetFactor);
-            tracker->ySize = clusterTracker_IIRFilter(tracker->ySize, combinedInputPtr->ySize, m_handle->iirForgetFactor);
-            diag2 = tracker->xSize * tracker->xSize + tracker->ySize * tracker->ySize;
-            if (diag2 > tracker->diagonal2)
-                tracker->diagonal2 = diag2;
+            for (k = 0; k < 9; k++)
+                batch->R[k][lane] = 0;
+            batch->R[0][lane] = combinedInputPtr->rangeVar * m_handle->measurementNoiseVariance;
+            batch->R[4][lane] = combinedInputPtr->angleVar * m_handle->measurementNoiseVariance;
+            batch->R[8][lane] = combinedInputPtr->dopplerVar * m_handle->measurementNoiseVariance;
         }
         else {
             hitFlag = 0;
@@ -609,10 +773,57 @@ void ClusterTracker::clusterTracker_updateTrackers(float *scratchPad)
                 numExpireTracker++;
             }
             else
-                clusterTracker_kalmanUpdateWithNoMeasure(tracker, m_handle->F, m_handle->Q);
+                missList[numMiss++] = tid;
         }
         tElem = (trackerListElement *)(tElem->next);
     }
+    for (i = 0; i < numMiss; i++)
+        batch->tid[batch->numHit + i] = missList[i];
+    batch->num = batch->numHit + numMiss;
+
+    for (lane = 0; lane < batch->num; lane++) {
+        tracker = &m_handle->tracker[batch->tid[lane]];
+        for (k = 0; k < 4; k++) {
+            batch->S_hat[k][lane] = tracker->S_hat[k];
+            batch->S_apriori_hat[k][lane] = tracker->S_apriori_hat[k];
+        }
+        for (k = 0; k < 3; k++)
+            batch->H_s_apriori_hat[k][lane] = tracker->H_s_apriori_hat[k];
+        for (k = 0; k < 16; k++)
+            batch->P[k][lane] = tracker->P[k];
+    }
+
+    // update S_hat and P of all the lanes
+    clusterTracker_batchKalmanUpdate(batch, m_handle->F, m_handle->Q);
+
+    for (lane = 0; lane < batch->num; lane++) {
+        tracker = &m_handle->tracker[batch->tid[lane]];
+        for (k = 0; k < 4; k++)
+            tracker->S_hat[k] = batch->S_hat[k][lane];
+        for (k = 0; k < 16; k++) {
+            tracker->P[k] = batch->P[k][lane];
+            tracker->P_apriori[k] = batch->P_apriori[k][lane];
+        }
+    }
+
+    for (lane = 0; lane < batch->numHit; lane++) {
+        tracker = &m_handle->tracker[batch->tid[lane]];
+        combinedInputPtr = &m_combinedInput[lane];
+        for (k = 0; k < 9; k++)
+            tracker->C[k] = batch->C[k][lane];
+
+        // update speed2 and doppler
+        tracker->speed2 = tracker->S_hat[2] * tracker->S_hat[2] + tracker->S_hat[3] * tracker->S_hat[3];
+        tracker->doppler = combinedInputPtr->doppler;
+
+        // update xSize and ySize
+        tracker->xSize = clusterTracker_IIRFilter(tracker->xSize, combinedInputPtr->xSize, m_handle->iirForgetFactor);
+        tracker->ySize = clusterTracker_IIRFilter(tracker->ySize, combinedInputPtr->ySize, m_handle->iirForgetFactor);
+        diag2 = tracker->xSize * tracker->xSize + tracker->ySize * tracker->ySize;
+        if (diag2 > tracker->diagonal2)
+            tracker->diagonal2 = diag2;
+    }
+
     // free the expired tracker
     for (j = numExpireTracker - 1; j >= 0; j--)
         clusterTrackerList_removeFromList(expireList[j]);
@@ -1124,6 +1335,243 @@ void clusterTracker_kalmanUpdateWithNoMeasure(trackerInternalDataType *tracker,
     }
 }
 
+// Batched kalman filter over the lanes of trackerBatchDataType. Each lane goes through the operations of
+// clusterTracker_kalmanUpdate() / clusterTracker_kalmanUpdateWithNoMeasure() in the same order, and the file is built
+// without floating point contraction, so a tracker gets the same result as with the per tracker functions.
+
+typedef float trackerLanes[CT_MAX_NUM_TRACKER];
+
+// C = A * B, A is m1 x m2, B is m2 x m3, all per lane
+static inline __attribute__((always_inline)) void trackerBatch_multiply(int m1, int m2, int m3, trackerLanes *A, trackerLanes *B, trackerLanes *C, int begin, int end)
+{
+    for (int i = 0; i < m1; i++) {
+        for (int j = 0; j < m3; j++) {
+            float *__restrict c = C[i * m3 + j];
+            for (int l = begin; l < end; l++)
+                c[l] = 0;
+            for (int k = 0; k < m2; k++) {
+                const float *__restrict a = A[i * m2 + k];
+                const float *__restrict b = B[k * m3 + j];
+                for (int l = begin; l < end; l++)
+                    c[l] += a[l] * b[l];
+            }
+        }
+    }
+}
+
+// C = A * B', A is m1 x m2, B is m3 x m2, all per lane
+static inline __attribute__((always_inline)) void trackerBatch_conjugateMultiply(int m1, int m2, int m3, trackerLanes *A, trackerLanes *B, trackerLanes *C, int begin, int end)
+{
+    for (int i = 0; i < m1; i++) {
+        for (int j = 0; j < m3; j++) {
+            float *__restrict c = C[i * m3 + j];
+            for (int l = begin; l < end; l++)
+                c[l] = 0;
+            for (int k = 0; k < m2; k++) {
+                const float *__restrict a = A[i * m2 + k];
+                const float *__restrict b = B[k + j * m2];
+                for (int l = begin; l < end; l++)
+                    c[l] += a[l] * b[l];
+            }
+        }
+    }
+}
+
+static inline __attribute__((always_inline)) void trackerBatch_timeUpdate(trackerBatchDataType *batch, const float *F)
+{
+    const int num = batch->num;
+    float S[4], H[3];
+
+    // S_apriori_hat = F * S_hat
+    for (int i = 0; i < 4; i++) {
+        float *__restrict c = batch->S_apriori_hat[i];
+        for (int l = 0; l < num; l++)
+            c[l] = 0;
+        for (int k = 0; k < 4; k++) {
+            const float f = F[i * 4 + k];
+            const float *__restrict s = batch->S_hat[k];
+            for (int l = 0; l < num; l++)
+                c[l] += f * s[l];
+        }
+    }
+
+    for (int l = 0; l < num; l++) {
+        for (int k = 0; k < 4; k++)
+            S[k] = batch->S_apriori_hat[k][l];
+        tracker_computeH(S, H);
+        for (int k = 0; k < 3; k++)
+            batch->H_s_apriori_hat[k][l] = H[k];
+    }
+}
+
+static inline __attribute__((always_inline)) void trackerBatch_kalmanUpdate(trackerBatchDataType *batch, const float *F, const float *Q)
+{
+    const int num = batch->num;
+    const int numHit = batch->numHit;
+    float S[4], J[12], A[9], Ainv[9];
+    float avg, H_temp;
+
+    // P_apriori = F * P * F' + Q
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            float *__restrict c = batch->temp1[i * 4 + j];
+            for (int l = 0; l < num; l++)
+                c[l] = 0;
+            for (int k = 0; k < 4; k++) {
+                const float f = F[i * 4 + k];
+                const float *__restrict p = batch->P[k * 4 + j];
+                for (int l = 0; l < num; l++)
+                    c[l] += f * p[l];
+            }
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            float *__restrict c = batch->P_apriori[i * 4 + j];
+            for (int l = 0; l < num; l++)
+                c[l] = 0;
+            for (int k = 0; k < 4; k++) {
+                const float f = F[k + j * 4];
+                const float *__restrict t = batch->temp1[i * 4 + k];
+                for (int l = 0; l < num; l++)
+                    c[l] += t[l] * f;
+            }
+            const float q = Q[i * 4 + j];
+            for (int l = 0; l < num; l++)
+                c[l] = c[l] + q;
+        }
+    }
+
+    // no measurement: P = P_apriori, S_hat = S_apriori_hat
+    for (int k = 0; k < 16; k++) {
+        for (int l = numHit; l < num; l++)
+            batch->P[k][l] = batch->P_apriori[k][l];
+    }
+    for (int k = 0; k < 4; k++) {
+        for (int l = numHit; l < num; l++)
+            batch->S_hat[k][l] = batch->S_apriori_hat[k][l];
+    }
+    if (numHit == 0)
+        return;
+
+    // Enforce symmetry constraint on P_apriori
+    for (int i = 0; i < 4; i++) {
+        for (int j = i; j < 4; j++) {
+            float *pij = batch->P_apriori[i * 4 + j];
+            float *pji = batch->P_apriori[j * 4 + i];
+            for (int l = 0; l < numHit; l++) {
+                avg = pij[l] + pji[l];
+                avg = (float)(avg * 0.5);
+                pij[l] = avg;
+                pji[l] = avg;
+            }
+        }
+    }
+
+    // Jacobian at S_apriori_hat
+    for (int l = 0; l < numHit; l++) {
+        for (int k = 0; k < 4; k++)
+            S[k] = batch->S_apriori_hat[k][l];
+        clusterTracker_computeJacobian(S, J);
+        for (int k = 0; k < 12; k++)
+            batch->J[k][l] = J[k];
+    }
+
+    // J * P_apriori * J' + R
+    trackerBatch_multiply(3, 4, 4, batch->J, batch->P_apriori, batch->temp2, 0, numHit);
+    trackerBatch_conjugateMultiply(3, 4, 3, batch->temp2, batch->J, batch->temp3, 0, numHit);
+    for (int k = 0; k < 9; k++) {
+        for (int l = 0; l < numHit; l++)
+            batch->temp3[k][l] = batch->temp3[k][l] + batch->R[k][l];
+    }
+
+    // C = J * P_apriori * J' + R - Rm, Rm is diagonal
+    for (int l = 0; l < numHit; l++) {
+        H_temp = (float)(batch->H_s_apriori_hat[0][l] * 0.5);
+        for (int k = 0; k < 9; k++)
+            A[k] = 0;
+        A[0] = 4;
+        A[4] = pow(2 * atan(H_temp), 2);
+        A[8] = 1;
+        for (int k = 0; k < 9; k++)
+            batch->C[k][l] = batch->temp3[k][l] - A[k];
+    }
+
+    // inv(J * P_apriori * J' + R)
+    for (int l = 0; l < numHit; l++) {
+        for (int k = 0; k < 9; k++)
+            A[k] = batch->temp3[k][l];
+        cluster_matInv3(A, Ainv);
+        for (int k = 0; k < 9; k++)
+            batch->invMatrix[k][l] = Ainv[k];
+    }
+
+    // K = P_apriori * J' * invMat
+    trackerBatch_conjugateMultiply(4, 4, 3, batch->P_apriori, batch->J, batch->temp2, 0, numHit);
+    trackerBatch_multiply(4, 3, 3, batch->temp2, batch->invMatrix, batch->K, 0, numHit);
+
+    // P = P_apriori - K * J * P_apriori
+    trackerBatch_multiply(4, 3, 4, batch->K, batch->J, batch->temp1, 0, numHit);
+    trackerBatch_multiply(4, 4, 4, batch->temp1, batch->P_apriori, batch->temp2, 0, numHit);
+    for (int k = 0; k < 16; k++) {
+        for (int l = 0; l < numHit; l++)
+            batch->P[k][l] = batch->P_apriori[k][l] - batch->temp2[k][l];
+    }
+
+    // S_hat = S_apriori_hat + K * (um - H_s_apriori_hat), the innovation goes to temp3
+    for (int k = 0; k < 3; k++) {
+        for (int l = 0; l < numHit; l++)
+            batch->temp3[k][l] = batch->measure[k][l] - batch->H_s_apriori_hat[k][l];
+    }
+    trackerBatch_multiply(4, 3, 1, batch->K, batch->temp3, batch->temp1, 0, numHit);
+    for (int k = 0; k < 4; k++) {
+        for (int l = 0; l < numHit; l++)
+            batch->S_hat[k][l] = batch->S_apriori_hat[k][l] + batch->temp1[k][l];
+    }
+}
+
+static void trackerBatch_timeUpdateDefault(trackerBatchDataType *batch, const float *F)
+{
+    trackerBatch_timeUpdate(batch, F);
+}
+
+__attribute__((target("avx2"))) static void trackerBatch_timeUpdateAVX2(trackerBatchDataType *batch, const float *F)
+{
+    trackerBatch_timeUpdate(batch, F);
+}
+
+static void trackerBatch_kalmanUpdateDefault(trackerBatchDataType *batch, const float *F, const float *Q)
+{
+    trackerBatch_kalmanUpdate(batch, F, Q);
+}
+
+__attribute__((target("avx2"))) static void trackerBatch_kalmanUpdateAVX2(trackerBatchDataType *batch, const float *F, const float *Q)
+{
+    trackerBatch_kalmanUpdate(batch, F, Q);
+}
+
+static bool trackerBatch_hasAVX2()
+{
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    return hasAVX2;
+}
+
+void clusterTracker_batchTimeUpdate(trackerBatchDataType *batch, float *F)
+{
+    if (trackerBatch_hasAVX2())
+        trackerBatch_timeUpdateAVX2(batch, F);
+    else
+        trackerBatch_timeUpdateDefault(batch, F);
+}
+
+void clusterTracker_batchKalmanUpdate(trackerBatchDataType *batch, float *F, float *Q)
+{
+    if (trackerBatch_hasAVX2())
+        trackerBatch_kalmanUpdateAVX2(batch, F, Q);
+    else
+        trackerBatch_kalmanUpdateDefault(batch, F, Q);
+}
+
 
 }  // namespace inference
 
@@ -75,9 +75,11 @@ class Camera4CFusionNode::Impl {
     std::vector<int> m_pclConstraints;
     camera4CFusionInPortsInfo_t m_camera2CFusionInPortsInfo;
     int32_t m_inMediaNum;
+    SensorSyncConfig m_syncConfig;
+    FusionOutputPool::Ptr m_fusionOutputPool;  // shared by all workers
 };
 
-Camera4CFusionNode::Impl::Impl(Camera4CFusionNode &ctx) : m_ctx(ctx)
+Camera4CFusionNode::Impl::Impl(Camera4CFusionNode &ctx) : m_ctx(ctx), m_fusionOutputPool(std::make_shared<FusionOutputPool>())
 {
     m_configParser.reset();
 }
@@ -130,11 +132,21 @@ hva::hvaStatus_t Camera4CFusionNode::Impl::configureByString(const std::string &
     int inMediaNum = 4;
     m_configParser.getVal<int>("InMediaNum", inMediaNum);
 
+    // optional, matches the ports by time instead of fetching them in lockstep
+    SensorSyncConfig syncConfig;
+    if (!parseSensorSyncConfig(m_configParser, syncConfig)) {
+        return hva::hvaFailure;
+    }
+    if (SENSOR_SYNC_NONE != syncConfig.mode && m_ctx.getTotalThreadNum() > 1) {
+        HVA_WARNING("Camera4CFusion node synchronizes the ports per worker, the frames are split among %d workers!", m_ctx.getTotalThreadNum());
+    }
+
     m_registrationMatrixFilePath = registrationMatrixFilePath;
     m_qMatrixFilePath = qMatrixFilePath;
     m_homographyMatrixFilePath = homographyMatrixFilePath;
     m_pclConstraints = pclConstraints;
     m_inMediaNum = inMediaNum;
+    m_syncConfig = syncConfig;
 
     m_ctx.transitStateTo(hva::hvaState_t::configured);
     return hva::hvaSuccess;
@@ -183,7 +195,8 @@ hva::hvaStatus_t Camera4CFusionNode::Impl::validateConfiguration() const
 std::shared_ptr<hva::hvaNodeWorker_t> Camera4CFusionNode::Impl::createNodeWorker(Camera4CFusionNode *parent) const
 {
     return std::shared_ptr<hva::hvaNodeWorker_t>(new Camera4CFusionNodeWorker(
-        parent, m_registrationMatrixFilePath, m_qMatrixFilePath, m_homographyMatrixFilePath, m_pclConstraints, m_inMediaNum, m_camera2CFusionInPortsInfo));
+        parent, m_registrationMatrixFilePath, m_qMatrixFilePath, m_homographyMatrixFilePath, m_pclConstraints, m_inMediaNum, m_camera2CFusionInPortsInfo,
+        m_syncConfig, m_fusionOutputPool));
 }
 
 hva::hvaStatus_t Camera4CFusionNode::Impl::prepare()
@@ -259,7 +272,9 @@ class Camera4CFusionNodeWorker::Impl {
          const std::string &homographyMatrixFilePath,
          const std::vector<int> &pclConstraints,
          const int32_t &inMediaNum,
-         const camera4CFusionInPortsInfo_t &camera2CFusionInPortsInfo);
+         const camera4CFusionInPortsInfo_t &camera2CFusionInPortsInfo,
+         const SensorSyncConfig &syncConfig,
+         const FusionOutputPool::Ptr &fusionOutputPool);
 
     ~Impl();
 
@@ -270,6 +285,13 @@ class Camera4CFusionNodeWorker::Impl {
      */
     void process(std::size_t batchIdx);
 
+    /**
+     * @brief Called by hva framework once after the last process(), the
+     * ports which fell behind are not waited for any more
+     * @param batchIdx Internal parameter handled by hvaframework
+     */
+    void processByLastRun(std::size_t batchIdx);
+
     void init();
 
     hva::hvaStatus_t rearm();
@@ -277,11 +299,34 @@ class Camera4CFusionNodeWorker::Impl {
     hva::hvaStatus_t reset();
 
   private:
+    void processSynchronized(std::size_t batchIdx);
+
+    void releaseSynchronized(std::size_t batchIdx, bool flush);
+
+    void fuse(std::size_t batchIdx,
+              const hva::hvaBlob_t::Ptr &cameraBlob1,
+              const hva::hvaBlob_t::Ptr &cameraBlob2,
+              const hva::hvaBlob_t::Ptr &cameraBlob3,
+              const hva::hvaBlob_t::Ptr &cameraBlob4,
+              const hva::hvaBlob_t::Ptr &radarBlob,
+              float radarDtSec);
+
+    /**
+     * @brief copy the detections of one camera and their radar coordinates into the fusion output
+     */
+    void addCamera(FusionOutput &fusionOutput, int32_t cameraID, const std::vector<hva::hvaROI_t> &rois);
+
     CoordinateTransformation m_coordsTrans;
     MultiCameraFuser m_multiCameraFuser;
     // std::unordered_map<unsigned, cv::Rect2f> historyBBox;
     Camera4CFusionNodeWorker &m_ctx;
     camera4CFusionInPortsInfo_t m_camera2CFusionInPortsInfo;
+    SensorSyncConfig m_syncConfig;
+    SensorSynchronizer<hva::hvaBlob_t::Ptr> m_sync;
+    std::vector<SensorSynchronizer<hva::hvaBlob_t::Ptr>::Slot> m_slots;
+    const std::vector<hva::hvaROI_t> m_noRois;
+    FusionOutputPool::Ptr m_fusionOutputPool;
+    const std::vector<trackerOutputDataType> m_noTracks;
 };
 
 Camera4CFusionNodeWorker::Impl::Impl(Camera4CFusionNodeWorker &ctx,
@@ -290,8 +335,14 @@ Camera4CFusionNodeWorker::Impl::Impl(Camera4CFusionNodeWorker &ctx,
                                      const std::string &homographyMatrixFilePath,
                                      const std::vector<int> &pclConstraints,
                                      const int32_t &inMediaNum,
-                                     const camera4CFusionInPortsInfo_t &camera2CFusionInPortsInfo)
-    : m_ctx(ctx), m_camera2CFusionInPortsInfo(camera2CFusionInPortsInfo)
+                                     const camera4CFusionInPortsInfo_t &camera2CFusionInPortsInfo,
+                                     const SensorSyncConfig &syncConfig,
+                                     const FusionOutputPool::Ptr &fusionOutputPool)
+    : m_ctx(ctx),
+      m_camera2CFusionInPortsInfo(camera2CFusionInPortsInfo),
+      m_syncConfig(syncConfig),
+      m_sync(CAMERA_4CFUSION_MODULE_INPORT_NUM, camera2CFusionInPortsInfo.fisrtMediaInputPort, syncConfig),
+      m_fusionOutputPool(fusionOutputPool)
 {
     m_coordsTrans.setParameters(registrationMatrixFilePath, qMatrixFilePath, homographyMatrixFilePath, pclConstraints);
     m_multiCameraFuser.setNmsThreshold(0.5);
@@ -308,12 +359,17 @@ void Camera4CFusionNodeWorker::Impl::init()
 }
 
 /**
- * @brief Called by hva framework for each frame, Run camera 2C fusion
+ * @brief Called by hva framework for each frame, Run camera 4C fusion
  * and pass output to following node
  * @param batchIdx Internal parameter handled by hvaframework
  */
 void Camera4CFusionNodeWorker::Impl::process(std::size_t batchIdx)
 {
+    if (SENSOR_SYNC_NONE != m_syncConfig.mode) {
+        processSynchronized(batchIdx);
+        return;
+    }
+
     std::vector<size_t> portIndices;
     for (size_t portId = 0; portId < CAMERA_4CFUSION_MODULE_INPORT_NUM; portId++) {
         portIndices.push_back(portId);
@@ -340,155 +396,225 @@ void Camera4CFusionNodeWorker::Impl::process(std::size_t batchIdx)
         HVA_ASSERT(cameraBlob4);
         HVA_ASSERT(radarBlob);
 
-        std::shared_ptr<hva::timeStampInfo> camera4CFusionIn = std::make_shared<hva::timeStampInfo>(cameraBlob1->frameId, "camera4CFusionIn");
-        m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &camera4CFusionIn);
-
-        HVA_DEBUG("Camera4CFusion node %d on frameId %d at port id: %d(Media 1); frameId %d at port id: %d(Media 2); frameId %d at port id: %d(Media 3); "
-                  "frameId %d at port id: %d(Media 4); frameId %d at port id: %d(Radar)",
-                  batchIdx, cameraBlob1->frameId, m_camera2CFusionInPortsInfo.fisrtMediaInputPort, cameraBlob2->frameId,
-                  m_camera2CFusionInPortsInfo.secondMediaInputPort, cameraBlob3->frameId, m_camera2CFusionInPortsInfo.thirdMediaInputPort, cameraBlob4->frameId,
-                  m_camera2CFusionInPortsInfo.fourthMediaInputPort, radarBlob->frameId, m_camera2CFusionInPortsInfo.radarInputPort);
-
-        /**
-         * process: media
-         */
-        hva::hvaVideoFrameWithROIBuf_t::Ptr ptrFrameBuf1 =
-            std::dynamic_pointer_cast<hva::hvaVideoFrameWithROIBuf_t>(cameraBlob1->get(m_camera2CFusionInPortsInfo.fisrtMediaBlobBuffIndex));
-        HVA_ASSERT(ptrFrameBuf1);
-        hva::hvaVideoFrameWithROIBuf_t::Ptr ptrFrameBuf2 =
-            std::dynamic_pointer_cast<hva::hvaVideoFrameWithROIBuf_t>(cameraBlob2->get(m_camera2CFusionInPortsInfo.secondMediaBlobBuffIndex));
+        fuse(batchIdx, cameraBlob1, cameraBlob2, cameraBlob3, cameraBlob4, radarBlob, 0.0f);
+    }
+}
+
+/**
+ * @brief Fetch the ports one by one and fuse every first media frame with the
+ * frames of the other ports closest to it in time
+ * @param batchIdx Internal parameter handled by hvaframework
+ */
+void Camera4CFusionNodeWorker::Impl::processSynchronized(std::size_t batchIdx)
+{
+    int buffIndices[CAMERA_4CFUSION_MODULE_INPORT_NUM];
+    buffIndices[m_camera2CFusionInPortsInfo.fisrtMediaInputPort] = m_camera2CFusionInPortsInfo.fisrtMediaBlobBuffIndex;
+    buffIndices[m_camera2CFusionInPortsInfo.secondMediaInputPort] = m_camera2CFusionInPortsInfo.secondMediaBlobBuffIndex;
+    buffIndices[m_camera2CFusionInPortsInfo.thirdMediaInputPort] = m_camera2CFusionInPortsInfo.thirdMediaBlobBuffIndex;
+    buffIndices[m_camera2CFusionInPortsInfo.fourthMediaInputPort] = m_camera2CFusionInPortsInfo.fourthMediaBlobBuffIndex;
+    buffIndices[m_camera2CFusionInPortsInfo.radarInputPort] = m_camera2CFusionInPortsInfo.radarBlobBuffIndex;
+
+    for (size_t portId = 0; portId < CAMERA_4CFUSION_MODULE_INPORT_NUM; portId++) {
+        while (true) {
+            auto vecBlobInput = m_ctx.getParentPtr()->getBatchedInput(batchIdx, {portId});
+            if (vecBlobInput.empty() || !vecBlobInput[0]) {
+                break;
+            }
+            double nowMs = sensorSyncNowMs();
+            hva::hvaBlob_t::Ptr blob = vecBlobInput[0];
+            m_sync.push(portId, blob->frameId, sensorCaptureTimeMs(blob, buffIndices[portId], nowMs), blob, nowMs);
+        }
+    }
+
+    releaseSynchronized(batchIdx, false);
+}
+
+/**
+ * @brief Send the synchronized frames ready for release
+ * @param flush release every queued frame without waiting for the ports which fell behind
+ */
+void Camera4CFusionNodeWorker::Impl::releaseSynchronized(std::size_t batchIdx, bool flush)
+{
+    while (flush ? m_sync.flush(sensorSyncNowMs(), m_slots) : m_sync.pop(sensorSyncNowMs(), m_slots)) {
+        const auto &radarSlot = m_slots[m_camera2CFusionInPortsInfo.radarInputPort];
+        float radarDtSec = radarSlot.held ? (float)(-radarSlot.skewMs / 1000.0) : 0.0f;
+        fuse(batchIdx, m_slots[m_camera2CFusionInPortsInfo.fisrtMediaInputPort].item, m_slots[m_camera2CFusionInPortsInfo.secondMediaInputPort].item,
+             m_slots[m_camera2CFusionInPortsInfo.thirdMediaInputPort].item, m_slots[m_camera2CFusionInPortsInfo.fourthMediaInputPort].item, radarSlot.item,
+             radarDtSec);
+
+        if (0 == m_sync.released() % SENSOR_SYNC_REPORT_INTERVAL) {
+            HVA_INFO("Camera4CFusion node sync statistics after %lu frames:\n%s", m_sync.released(), m_sync.summary().c_str());
+        }
+    }
+}
+
+void Camera4CFusionNodeWorker::Impl::processByLastRun(std::size_t batchIdx)
+{
+    if (SENSOR_SYNC_NONE == m_syncConfig.mode) {
+        return;
+    }
+    processSynchronized(batchIdx);
+    releaseSynchronized(batchIdx, true);
+}
+
+/**
+ * @brief Fuse one first media frame with the frames matched to it, the other
+ * media and radar blobs may be null when their sensors fell behind
+ * @param radarDtSec time the radar tracks are moved forward by
+ */
+void Camera4CFusionNodeWorker::Impl::fuse(std::size_t batchIdx,
+                                          const hva::hvaBlob_t::Ptr &cameraBlob1,
+                                          const hva::hvaBlob_t::Ptr &cameraBlob2,
+                                          const hva::hvaBlob_t::Ptr &cameraBlob3,
+                                          const hva::hvaBlob_t::Ptr &cameraBlob4,
+                                          const hva::hvaBlob_t::Ptr &radarBlob,
+                                          float radarDtSec)
+{
+    std::shared_ptr<hva::timeStampInfo> camera4CFusionIn = std::make_shared<hva::timeStampInfo>(cameraBlob1->frameId, "camera4CFusionIn");
+    m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &camera4CFusionIn);
+
+    HVA_DEBUG("Camera4CFusion node %d on frameId %d at port id: %d(Media 1); frameId %d at port id: %d(Media 2); frameId %d at port id: %d(Media 3); "
+              "frameId %d at port id: %d(Media 4); frameId %d at port id: %d(Radar)",
+              batchIdx, cameraBlob1->frameId, m_camera2CFusionInPortsInfo.fisrtMediaInputPort, cameraBlob2 ? (int)cameraBlob2->frameId : -1,
+              m_camera2CFusionInPortsInfo.secondMediaInputPort, cameraBlob3 ? (int)cameraBlob3->frameId : -1, m_camera2CFusionInPortsInfo.thirdMediaInputPort,
+              cameraBlob4 ? (int)cameraBlob4->frameId : -1, m_camera2CFusionInPortsInfo.fourthMediaInputPort, radarBlob ? (int)radarBlob->frameId : -1,
+              m_camera2CFusionInPortsInfo.radarInputPort);
+
+    /**
+     * process: media
+     */
+    hva::hvaVideoFrameWithROIBuf_t::Ptr ptrFrameBuf1 =
+        std::dynamic_pointer_cast<hva::hvaVideoFrameWithROIBuf_t>(cameraBlob1->get(m_camera2CFusionInPortsInfo.fisrtMediaBlobBuffIndex));
+    HVA_ASSERT(ptrFrameBuf1);
+    hva::hvaVideoFrameWithROIBuf_t::Ptr ptrFrameBuf2;
+    if (cameraBlob2) {
+        ptrFrameBuf2 = std::dynamic_pointer_cast<hva::hvaVideoFrameWithROIBuf_t>(cameraBlob2->get(m_camera2CFusionInPortsInfo.secondMediaBlobBuffIndex));
         HVA_ASSERT(ptrFrameBuf2);
-        hva::hvaVideoFrameWithROIBuf_t::Ptr ptrFrameBuf3 =
-            std::dynamic_pointer_cast<hva::hvaVideoFrameWithROIBuf_t>(cameraBlob3->get(m_camera2CFusionInPortsInfo.thirdMediaBlobBuffIndex));
+    }
+    hva::hvaVideoFrameWithROIBuf_t::Ptr ptrFrameBuf3;
+    if (cameraBlob3) {
+        ptrFrameBuf3 = std::dynamic_pointer_cast<hva::hvaVideoFrameWithROIBuf_t>(cameraBlob3->get(m_camera2CFusionInPortsInfo.thirdMediaBlobBuffIndex));
         HVA_ASSERT(ptrFrameBuf3);
-        hva::hvaVideoFrameWithROIBuf_t::Ptr ptrFrameBuf4 =
-            std::dynamic_pointer_cast<hva::hvaVideoFrameWithROIBuf_t>(cameraBlob4->get(m_camera2CFusionInPortsInfo.fourthMediaBlobBuffIndex));
+    }
+    hva::hvaVideoFrameWithROIBuf_t::Ptr ptrFrameBuf4;
+    if (cameraBlob4) {
+        ptrFrameBuf4 = std::dynamic_pointer_cast<hva::hvaVideoFrameWithROIBuf_t>(cameraBlob4->get(m_camera2CFusionInPortsInfo.fourthMediaBlobBuffIndex));
         HVA_ASSERT(ptrFrameBuf4);
+    }
+    const std::vector<hva::hvaROI_t> &rois1 = ptrFrameBuf1->rois;
+    const std::vector<hva::hvaROI_t> &rois2 = ptrFrameBuf2 ? ptrFrameBuf2->rois : m_noRois;
+    const std::vector<hva::hvaROI_t> &rois3 = ptrFrameBuf3 ? ptrFrameBuf3->rois : m_noRois;
+    const std::vector<hva::hvaROI_t> &rois4 = ptrFrameBuf4 ? ptrFrameBuf4->rois : m_noRois;
 
-        /**
-         * process: radar
-         */
+    /**
+     * process: radar
+     */
+    trackerOutput::Ptr radarOutput;
+    if (radarBlob) {
         hva::hvaVideoFrameWithMetaROIBuf_t::Ptr ptrRadarBuf =
             std::dynamic_pointer_cast<hva::hvaVideoFrameWithMetaROIBuf_t>(radarBlob->get(m_camera2CFusionInPortsInfo.radarBlobBuffIndex));
         HVA_ASSERT(ptrRadarBuf);
-        trackerOutput radarOutput;
-        if (ptrRadarBuf->containMeta<trackerOutput>()) {
+        if (ptrRadarBuf->containMeta<trackerOutput::Ptr>()) {
             // success
-            ptrRadarBuf->getMeta<trackerOutput>(radarOutput);
+            ptrRadarBuf->getMeta<trackerOutput::Ptr>(radarOutput);
         }
         else {
             // previous node not ever put this type of meta into hvabuf
             HVA_ERROR("Previous node not ever put this type of trackerOutput into hvabuf!");
         }
+    }
 
-        // radarOutput contains all zero tracking results, filter it
-        std::vector<trackerOutputDataType> filteredRadarOutput;
-        for (const auto &item : radarOutput.outputInfo) {
-            if (0 == item.S_hat[0] && 0 == item.S_hat[1] && 0 == item.xSize && 0 == item.ySize) {
-                // all zero, useless data
-            }
-            else {
-                filteredRadarOutput.push_back(item);
-            }
-        }
-
-        /**
-         * start processing
-         */
-        m_ctx.getLatencyMonitor().startRecording(cameraBlob1->frameId, "camera 4C fusion");
-        int cameraSize1 = ptrFrameBuf1->rois.size();
-        int cameraSize2 = ptrFrameBuf2->rois.size();
-        int cameraSize3 = ptrFrameBuf3->rois.size();
-        int cameraSize4 = ptrFrameBuf4->rois.size();
-        int radarSize = filteredRadarOutput.size();
-        HVA_DEBUG("Frame %d: cameraSize1(%d), cameraSize2(%d), cameraSize3(%d), cameraSize4(%d),radarSize(%d)", cameraBlob1->frameId, cameraSize1, cameraSize2,
-                  cameraSize3, cameraSize4, radarSize);
-
-
-        HVA_DEBUG("fusion perform camera 4C fusion on frame%d", cameraBlob1->frameId);
-        FusionOutput fusionOutput(4);
-
-        // add radar output
-        fusionOutput.setRadarOutput(filteredRadarOutput);
-
-        // add camera output
-        std::vector<BBox> cameraRadarCoords;
-        for (const auto &item : ptrFrameBuf1->rois) {
-            cv::Rect2i rect = cv::Rect2i(item.x, item.y, item.width, item.height);
-            cv::Rect2f radarCoords = m_coordsTrans.pixel2Radar(rect);
-            cameraRadarCoords.push_back(BBox(radarCoords.x, radarCoords.y, radarCoords.width, radarCoords.height));
-        }
-        fusionOutput.addCameraROI(0, ptrFrameBuf1->rois, cameraRadarCoords);
-
-        std::vector<BBox>().swap(cameraRadarCoords);
-        for (const auto &item : ptrFrameBuf2->rois) {
-            cv::Rect2i rect = cv::Rect2i(item.x, item.y, item.width, item.height);
-            cv::Rect2f radarCoords = m_coordsTrans.pixel2Radar(rect);
-            cameraRadarCoords.push_back(BBox(radarCoords.x, radarCoords.y, radarCoords.width, radarCoords.height));
-        }
-        fusionOutput.addCameraROI(1, ptrFrameBuf2->rois, cameraRadarCoords);
+    FusionOutput::Ptr fusionOutput = m_fusionOutputPool->acquire(4);
 
-        std::vector<BBox>().swap(cameraRadarCoords);
-        for (const auto &item : ptrFrameBuf3->rois) {
-            cv::Rect2i rect = cv::Rect2i(item.x, item.y, item.width, item.height);
-            cv::Rect2f radarCoords = m_coordsTrans.pixel2Radar(rect);
-            cameraRadarCoords.push_back(BBox(radarCoords.x, radarCoords.y, radarCoords.width, radarCoords.height));
+    // radarOutput contains all zero tracking results, filter it
+    for (const auto &item : radarOutput ? radarOutput->outputInfo : m_noTracks) {
+        if (0 == item.S_hat[0] && 0 == item.S_hat[1] && 0 == item.xSize && 0 == item.ySize) {
+            // all zero, useless data
         }
-        fusionOutput.addCameraROI(2, ptrFrameBuf3->rois, cameraRadarCoords);
-
-        std::vector<BBox>().swap(cameraRadarCoords);
-        for (const auto &item : ptrFrameBuf4->rois) {
-            cv::Rect2i rect = cv::Rect2i(item.x, item.y, item.width, item.height);
-            cv::Rect2f radarCoords = m_coordsTrans.pixel2Radar(rect);
-            cameraRadarCoords.push_back(BBox(radarCoords.x, radarCoords.y, radarCoords.width, radarCoords.height));
+        else {
+            fusionOutput->m_radarOutput.push_back(item);
         }
-        fusionOutput.addCameraROI(3, ptrFrameBuf4->rois, cameraRadarCoords);
+    }
+    if (0.0f != radarDtSec) {
+        // the radar frame stands in for a frame it does not match in time
+        extrapolateRadarTracks(fusionOutput->m_radarOutput, radarDtSec);
+    }
 
-        // add camera fusion result (in radar coordinate)
-        std::vector<DetectedObject> fusionResult =
-            m_multiCameraFuser.fuse4Camera(ptrFrameBuf1->rois, ptrFrameBuf2->rois, ptrFrameBuf3->rois, ptrFrameBuf4->rois);
-        fusionOutput.setCameraFusionRadarCoords(fusionResult);
+    /**
+     * start processing
+     */
+    m_ctx.getLatencyMonitor().startRecording(cameraBlob1->frameId, "camera 4C fusion");
+    int cameraSize1 = rois1.size();
+    int cameraSize2 = rois2.size();
+    int cameraSize3 = rois3.size();
+    int cameraSize4 = rois4.size();
+    int radarSize = fusionOutput->m_radarOutput.size();
+    HVA_DEBUG("Frame %d: cameraSize1(%d), cameraSize2(%d), cameraSize3(%d), cameraSize4(%d),radarSize(%d)", cameraBlob1->frameId, cameraSize1, cameraSize2,
+              cameraSize3, cameraSize4, radarSize);
+
+
+    HVA_DEBUG("fusion perform camera 4C fusion on frame%d", cameraBlob1->frameId);
+
+    // add camera output
+    addCamera(*fusionOutput, 0, rois1);
+    addCamera(*fusionOutput, 1, rois2);
+    addCamera(*fusionOutput, 2, rois3);
+    addCamera(*fusionOutput, 3, rois4);
+
+    // add camera fusion result (in radar coordinate)
+    m_multiCameraFuser.fuse4Camera(rois1, rois2, rois3, rois4, fusionOutput->m_cameraFusionRadarCoords);
+    fusionOutput->resetCameraFusionAssociation();
+
+    TimeStampAll_t timeMetaAll;
+    TimeStamp_t timeMeta;
+    if (ptrFrameBuf1->getMeta(timeMeta) == hva::hvaSuccess) {
+        timeMetaAll.timeStamp1 = timeMeta.timeStamp;
+    }
+    if (ptrFrameBuf2 && ptrFrameBuf2->getMeta(timeMeta) == hva::hvaSuccess) {
+        timeMetaAll.timeStamp2 = timeMeta.timeStamp;
+    }
+    if (ptrFrameBuf3 && ptrFrameBuf3->getMeta(timeMeta) == hva::hvaSuccess) {
+        timeMetaAll.timeStamp3 = timeMeta.timeStamp;
+    }
+    if (ptrFrameBuf4 && ptrFrameBuf4->getMeta(timeMeta) == hva::hvaSuccess) {
+        timeMetaAll.timeStamp4 = timeMeta.timeStamp;
+    }
+    ptrFrameBuf1->setMeta<TimeStampAll_t>(timeMetaAll);
 
-        TimeStampAll_t timeMetaAll;
-        TimeStamp_t timeMeta;
-        if (ptrFrameBuf1->getMeta(timeMeta) == hva::hvaSuccess) {
-            timeMetaAll.timeStamp1 = timeMeta.timeStamp;
-        }
-        if (ptrFrameBuf2->getMeta(timeMeta) == hva::hvaSuccess) {
-            timeMetaAll.timeStamp2 = timeMeta.timeStamp;
-        }
-        if (ptrFrameBuf3->getMeta(timeMeta) == hva::hvaSuccess) {
-            timeMetaAll.timeStamp3 = timeMeta.timeStamp;
-        }
-        if (ptrFrameBuf4->getMeta(timeMeta) == hva::hvaSuccess) {
-            timeMetaAll.timeStamp4 = timeMeta.timeStamp;
-        }
-        ptrFrameBuf1->setMeta<TimeStampAll_t>(timeMetaAll);
+    InferenceTimeStamp_t inferenceTimeMeta;
+    InferenceTimeAll_t inferenceTimeMetaAll;
+    if (ptrFrameBuf1->getMeta(inferenceTimeMeta) == hva::hvaSuccess) {
+        inferenceTimeMetaAll.inferenceLatencies[0] = std::chrono::duration<double, std::milli>(inferenceTimeMeta.endTime - inferenceTimeMeta.startTime).count();
+    }
+    if (ptrFrameBuf2 && ptrFrameBuf2->getMeta(inferenceTimeMeta) == hva::hvaSuccess) {
+        inferenceTimeMetaAll.inferenceLatencies[1] = std::chrono::duration<double, std::milli>(inferenceTimeMeta.endTime - inferenceTimeMeta.startTime).count();
+    }
+    if (ptrFrameBuf3 && ptrFrameBuf3->getMeta(inferenceTimeMeta) == hva::hvaSuccess) {
+        inferenceTimeMetaAll.inferenceLatencies[2] = std::chrono::duration<double, std::milli>(inferenceTimeMeta.endTime - inferenceTimeMeta.startTime).count();
+    }
+    if (ptrFrameBuf4 && ptrFrameBuf4->getMeta(inferenceTimeMeta) == hva::hvaSuccess) {
+        inferenceTimeMetaAll.inferenceLatencies[3] = std::chrono::duration<double, std::milli>(inferenceTimeMeta.endTime - inferenceTimeMeta.startTime).count();
+    }
+    ptrFrameBuf1->setMeta<InferenceTimeAll_t>(inferenceTimeMetaAll);
 
-        InferenceTimeStamp_t inferenceTimeMeta;
-        InferenceTimeAll_t inferenceTimeMetaAll;
-        if (ptrFrameBuf1->getMeta(inferenceTimeMeta) == hva::hvaSuccess) {
-            inferenceTimeMetaAll.inferenceLatencies[0] = std::chrono::duration<double, std::milli>(inferenceTimeMeta.endTime - inferenceTimeMeta.startTime).count();
-        }
-        if (ptrFrameBuf2->getMeta(inferenceTimeMeta) == hva::hvaSuccess) {
-            inferenceTimeMetaAll.inferenceLatencies[1] = std::chrono::duration<double, std::milli>(inferenceTimeMeta.endTime - inferenceTimeMeta.startTime).count();
-        }
-        if (ptrFrameBuf3->getMeta(inferenceTimeMeta) == hva::hvaSuccess) {
-            inferenceTimeMetaAll.inferenceLatencies[2] = std::chrono::duration<double, std::milli>(inferenceTimeMeta.endTime - inferenceTimeMeta.startTime).count();
-        }
-        if (ptrFrameBuf4->getMeta(inferenceTimeMeta) == hva::hvaSuccess) {
-            inferenceTimeMetaAll.inferenceLatencies[3] = std::chrono::duration<double, std::milli>(inferenceTimeMeta.endTime - inferenceTimeMeta.startTime).count();
-        }
-        ptrFrameBuf1->setMeta<InferenceTimeAll_t>(inferenceTimeMetaAll);
+    ptrFrameBuf1->setMeta<FusionOutput::Ptr>(fusionOutput);
+    HVA_DEBUG("Camera4CFusionNode sending blob with frameid %u and streamid %u", cameraBlob1->frameId, cameraBlob1->streamId);
+    m_ctx.sendOutput(cameraBlob1, 0, std::chrono::milliseconds(0));
+    HVA_DEBUG("Camera4CFusionNode completed sent blob with frameid %u and streamid %u", cameraBlob1->frameId, cameraBlob1->streamId);
+    m_ctx.getLatencyMonitor().stopRecording(cameraBlob1->frameId, "camera 4C fusion");
 
-        ptrFrameBuf1->setMeta<FusionOutput>(fusionOutput);
-        HVA_DEBUG("Camera4CFusionNode sending blob with frameid %u and streamid %u", cameraBlob1->frameId, cameraBlob1->streamId);
-        m_ctx.sendOutput(cameraBlob1, 0, std::chrono::milliseconds(0));
-        HVA_DEBUG("Camera4CFusionNode completed sent blob with frameid %u and streamid %u", cameraBlob1->frameId, cameraBlob1->streamId);
-        m_ctx.getLatencyMonitor().stopRecording(cameraBlob1->frameId, "camera 4C fusion");
+    std::shared_ptr<hva::timeStampInfo> camera4CFusionOut = std::make_shared<hva::timeStampInfo>(cameraBlob1->frameId, "camera4CFusionOut");
+    m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &camera4CFusionOut);
+}
 
-        std::shared_ptr<hva::timeStampInfo> camera4CFusionOut = std::make_shared<hva::timeStampInfo>(cameraBlob1->frameId, "camera4CFusionOut");
-        m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &camera4CFusionOut);
+void Camera4CFusionNodeWorker::Impl::addCamera(FusionOutput &fusionOutput, int32_t cameraID, const std::vector<hva::hvaROI_t> &rois)
+{
+    fusionOutput.m_cameraRois[cameraID] = rois;
+    std::vector<BBox> &cameraRadarCoords = fusionOutput.m_cameraRadarCoords[cameraID];
+    for (const auto &item : rois) {
+        cv::Rect2i rect = cv::Rect2i(item.x, item.y, item.width, item.height);
+        cv::Rect2f radarCoords = m_coordsTrans.pixel2Radar(rect);
+        cameraRadarCoords.push_back(BBox(radarCoords.x, radarCoords.y, radarCoords.width, radarCoords.height));
     }
 }
 
@@ -499,6 +625,8 @@ hva::hvaStatus_t Camera4CFusionNodeWorker::Impl::rearm()
 
 hva::hvaStatus_t Camera4CFusionNodeWorker::Impl::reset()
 {
+    // frames of the previous streams must not be matched with the new ones
+    m_sync.clear();
     return hva::hvaSuccess;
 }
 
@@ -508,9 +636,12 @@ Camera4CFusionNodeWorker::Camera4CFusionNodeWorker(hva::hvaNode_t *parentNode,
                                                    const std::string &homographyMatrixFilePath,
                                                    const std::vector<int> &pclConstraints,
                                                    const int32_t &inMediaNum,
-                                                   const camera4CFusionInPortsInfo_t &camera2CFusionInPortsInfo)
+                                                   const camera4CFusionInPortsInfo_t &camera2CFusionInPortsInfo,
+                                                   const SensorSyncConfig &syncConfig,
+                                                   const FusionOutputPool::Ptr &fusionOutputPool)
     : hva::hvaNodeWorker_t(parentNode),
-      m_impl(new Impl(*this, registrationMatrixFilePath, qMatrixFilePath, homographyMatrixFilePath, pclConstraints, inMediaNum, camera2CFusionInPortsInfo))
+      m_impl(new Impl(*this, registrationMatrixFilePath, qMatrixFilePath, homographyMatrixFilePath, pclConstraints, inMediaNum, camera2CFusionInPortsInfo,
+                      syncConfig, fusionOutputPool))
 {}
 
 Camera4CFusionNodeWorker::~Camera4CFusionNodeWorker() {}
@@ -525,6 +656,16 @@ void Camera4CFusionNodeWorker::process(std::size_t batchIdx)
     return m_impl->process(batchIdx);
 }
 
+void Camera4CFusionNodeWorker::processByLastRun(std::size_t batchIdx)
+{
+    return m_impl->processByLastRun(batchIdx);
+}
+
+hva::hvaStatus_t Camera4CFusionNodeWorker::reset()
+{
+    return m_impl->reset();
+}
+
 #ifdef HVA_NODE_COMPILE_TO_DYNAMIC_LIBRARY
 HVA_ENABLE_DYNAMIC_LOADING(Camera4CFusionNode, Camera4CFusionNode(threadNum))
 #endif  // #ifdef HVA_NODE_COMPILE_TO_DYNAMIC_LIBRARY
@@ -74,9 +74,11 @@ class CoordinateTransformationNode::Impl {
     std::string m_homographyMatrixFilePath;
     std::vector<int> m_pclConstraints;
     fusionInPortsInfo_t m_fusionInPortsInfo;
+    SensorSyncConfig m_syncConfig;
+    FusionOutputPool::Ptr m_fusionOutputPool;  // shared by all workers
 };
 
-CoordinateTransformationNode::Impl::Impl(CoordinateTransformationNode &ctx) : m_ctx(ctx)
+CoordinateTransformationNode::Impl::Impl(CoordinateTransformationNode &ctx) : m_ctx(ctx), m_fusionOutputPool(std::make_shared<FusionOutputPool>())
 {
     m_configParser.reset();
 }
@@ -142,10 +144,20 @@ hva::hvaStatus_t CoordinateTransformationNode::Impl::configureByString(const std
     // m_configParser.getVal<int>("MediaBlobBuffIndex", m_fusionInPortsInfo.mediaBlobBuffIndex);
     // m_configParser.getVal<int>("RadarBlobBuffIndex", m_fusionInPortsInfo.radarBlobBuffIndex);
 
+    // optional, matches the ports by time instead of fetching them in lockstep
+    SensorSyncConfig syncConfig;
+    if (!parseSensorSyncConfig(m_configParser, syncConfig)) {
+        return hva::hvaFailure;
+    }
+    if (SENSOR_SYNC_NONE != syncConfig.mode && m_ctx.getTotalThreadNum() > 1) {
+        HVA_WARNING("CoordinateTransformation node synchronizes the ports per worker, the frames are split among %d workers!", m_ctx.getTotalThreadNum());
+    }
+
     m_registrationMatrixFilePath = registrationMatrixFilePath;
     m_qMatrixFilePath = qMatrixFilePath;
     m_homographyMatrixFilePath = homographyMatrixFilePath;
     m_pclConstraints = pclConstraints;
+    m_syncConfig = syncConfig;
 
     m_ctx.transitStateTo(hva::hvaState_t::configured);
     return hva::hvaSuccess;
@@ -189,7 +201,8 @@ hva::hvaStatus_t CoordinateTransformationNode::Impl::validateConfiguration() con
 std::shared_ptr<hva::hvaNodeWorker_t> CoordinateTransformationNode::Impl::createNodeWorker(CoordinateTransformationNode *parent) const
 {
     return std::shared_ptr<hva::hvaNodeWorker_t>(new CoordinateTransformationNodeWorker(parent, m_registrationMatrixFilePath, m_qMatrixFilePath,
-                                                                                        m_homographyMatrixFilePath, m_pclConstraints, m_fusionInPortsInfo));
+                                                                                        m_homographyMatrixFilePath, m_pclConstraints, m_fusionInPortsInfo,
+                                                                                        m_syncConfig, m_fusionOutputPool));
 }
 
 hva::hvaStatus_t CoordinateTransformationNode::Impl::prepare()
@@ -264,7 +277,9 @@ class CoordinateTransformationNodeWorker::Impl {
          const std::string &qMatrixFilePath,
          const std::string &homographyMatrixFilePath,
          const std::vector<int> &pclConstraints,
-         const fusionInPortsInfo_t &fusionInPortsInfo);
+         const fusionInPortsInfo_t &fusionInPortsInfo,
+         const SensorSyncConfig &syncConfig,
+         const FusionOutputPool::Ptr &fusionOutputPool);
 
     ~Impl();
 
@@ -275,6 +290,13 @@ class CoordinateTransformationNodeWorker::Impl {
      */
     void process(std::size_t batchIdx);
 
+    /**
+     * @brief Called by hva framework once after the last process(), the
+     * ports which fell behind are not waited for any more
+     * @param batchIdx Internal parameter handled by hvaframework
+     */
+    void processByLastRun(std::size_t batchIdx);
+
     void init();
 
     hva::hvaStatus_t rearm();
@@ -282,10 +304,21 @@ class CoordinateTransformationNodeWorker::Impl {
     hva::hvaStatus_t reset();
 
   private:
+    void processSynchronized(std::size_t batchIdx);
+
+    void releaseSynchronized(std::size_t batchIdx, bool flush);
+
+    void transform(std::size_t batchIdx, const hva::hvaBlob_t::Ptr &cameraBlob, const hva::hvaBlob_t::Ptr &radarBlob, float radarDtSec);
+
     CoordinateTransformation m_coordsTrans;
     // std::unordered_map<unsigned, cv::Rect2f> historyBBox;
     CoordinateTransformationNodeWorker &m_ctx;
     fusionInPortsInfo_t m_fusionInPortsInfo;
+    SensorSyncConfig m_syncConfig;
+    SensorSynchronizer<hva::hvaBlob_t::Ptr> m_sync;
+    std::vector<SensorSynchronizer<hva::hvaBlob_t::Ptr>::Slot> m_slots;
+    FusionOutputPool::Ptr m_fusionOutputPool;
+    const std::vector<trackerOutputDataType> m_noTracks;
 };
 
 CoordinateTransformationNodeWorker::Impl::Impl(CoordinateTransformationNodeWorker &ctx,
@@ -293,8 +326,14 @@ CoordinateTransformationNodeWorker::Impl::Impl(CoordinateTransformationNodeWorke
                                                const std::string &qMatrixFilePath,
                                                const std::string &homographyMatrixFilePath,
                                                const std::vector<int> &pclConstraints,
-                                               const fusionInPortsInfo_t &fusionInPortsInfo)
-    : m_ctx(ctx), m_fusionInPortsInfo(fusionInPortsInfo)
+                                               const fusionInPortsInfo_t &fusionInPortsInfo,
+                                               const SensorSyncConfig &syncConfig,
+                                               const FusionOutputPool::Ptr &fusionOutputPool)
+    : m_ctx(ctx),
+      m_fusionInPortsInfo(fusionInPortsInfo),
+      m_syncConfig(syncConfig),
+      m_sync(FUSION_MODULE_INPORT_NUM, fusionInPortsInfo.mediaInputPort, syncConfig),
+      m_fusionOutputPool(fusionOutputPool)
 {
     m_coordsTrans.setParameters(registrationMatrixFilePath, qMatrixFilePath, homographyMatrixFilePath, pclConstraints);
 }
@@ -313,6 +352,11 @@ void CoordinateTransformationNodeWorker::Impl::init()
  */
 void CoordinateTransformationNodeWorker::Impl::process(std::size_t batchIdx)
 {
+    if (SENSOR_SYNC_NONE != m_syncConfig.mode) {
+        processSynchronized(batchIdx);
+        return;
+    }
+
     std::vector<size_t> portIndices;
     for (size_t portId = 0; portId < FUSION_MODULE_INPORT_NUM; portId++) {
         portIndices.push_back(portId);
@@ -333,83 +377,151 @@ void CoordinateTransformationNodeWorker::Impl::process(std::size_t batchIdx)
         hva::hvaBlob_t::Ptr radarBlob = vecBlobInput[m_fusionInPortsInfo.radarInputPort];
         HVA_ASSERT(cameraBlob);
         HVA_ASSERT(radarBlob);
-        std::shared_ptr<hva::timeStampInfo> coordinateTransIn = std::make_shared<hva::timeStampInfo>(cameraBlob->frameId, "coordinateTransIn");
-        m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &coordinateTransIn);
-
-        HVA_DEBUG("CoordinateTransformation node %d on frameId %d at port id: %d(Media); "
-                  "frameId %d at port id: %d(Radar)",
-                  batchIdx, cameraBlob->frameId, m_fusionInPortsInfo.mediaInputPort, radarBlob->frameId, m_fusionInPortsInfo.radarInputPort);
-
-        /**
-         * process: media
-         */
-        hva::hvaVideoFrameWithROIBuf_t::Ptr ptrFrameBuf =
-            std::dynamic_pointer_cast<hva::hvaVideoFrameWithROIBuf_t>(cameraBlob->get(m_fusionInPortsInfo.mediaBlobBuffIndex));
-        HVA_ASSERT(ptrFrameBuf);
-
-        /**
-         * process: radar
-         */
+
+        transform(batchIdx, cameraBlob, radarBlob, 0.0f);
+    }
+}
+
+/**
+ * @brief Fetch the ports one by one and pair every media frame with the radar
+ * frame closest to it in time
+ * @param batchIdx Internal parameter handled by hvaframework
+ */
+void CoordinateTransformationNodeWorker::Impl::processSynchronized(std::size_t batchIdx)
+{
+    int buffIndices[FUSION_MODULE_INPORT_NUM];
+    buffIndices[m_fusionInPortsInfo.mediaInputPort] = m_fusionInPortsInfo.mediaBlobBuffIndex;
+    buffIndices[m_fusionInPortsInfo.radarInputPort] = m_fusionInPortsInfo.radarBlobBuffIndex;
+
+    for (size_t portId = 0; portId < FUSION_MODULE_INPORT_NUM; portId++) {
+        while (true) {
+            auto vecBlobInput = m_ctx.getParentPtr()->getBatchedInput(batchIdx, {portId});
+            if (vecBlobInput.empty() || !vecBlobInput[0]) {
+                break;
+            }
+            double nowMs = sensorSyncNowMs();
+            hva::hvaBlob_t::Ptr blob = vecBlobInput[0];
+            m_sync.push(portId, blob->frameId, sensorCaptureTimeMs(blob, buffIndices[portId], nowMs), blob, nowMs);
+        }
+    }
+
+    releaseSynchronized(batchIdx, false);
+}
+
+/**
+ * @brief Send the synchronized frames ready for release
+ * @param flush release every queued frame without waiting for the ports which fell behind
+ */
+void CoordinateTransformationNodeWorker::Impl::releaseSynchronized(std::size_t batchIdx, bool flush)
+{
+    while (flush ? m_sync.flush(sensorSyncNowMs(), m_slots) : m_sync.pop(sensorSyncNowMs(), m_slots)) {
+        const auto &radarSlot = m_slots[m_fusionInPortsInfo.radarInputPort];
+        float radarDtSec = radarSlot.held ? (float)(-radarSlot.skewMs / 1000.0) : 0.0f;
+        transform(batchIdx, m_slots[m_fusionInPortsInfo.mediaInputPort].item, radarSlot.item, radarDtSec);
+
+        if (0 == m_sync.released() % SENSOR_SYNC_REPORT_INTERVAL) {
+            HVA_INFO("CoordinateTransformation node sync statistics after %lu frames:\n%s", m_sync.released(), m_sync.summary().c_str());
+        }
+    }
+}
+
+void CoordinateTransformationNodeWorker::Impl::processByLastRun(std::size_t batchIdx)
+{
+    if (SENSOR_SYNC_NONE == m_syncConfig.mode) {
+        return;
+    }
+    processSynchronized(batchIdx);
+    releaseSynchronized(batchIdx, true);
+}
+
+/**
+ * @brief Transform one media frame and the radar frame matched to it, the
+ * radar blob may be null when the radar fell behind
+ * @param radarDtSec time the radar tracks are moved forward by
+ */
+void CoordinateTransformationNodeWorker::Impl::transform(std::size_t batchIdx,
+                                                         const hva::hvaBlob_t::Ptr &cameraBlob,
+                                                         const hva::hvaBlob_t::Ptr &radarBlob,
+                                                         float radarDtSec)
+{
+    std::shared_ptr<hva::timeStampInfo> coordinateTransIn = std::make_shared<hva::timeStampInfo>(cameraBlob->frameId, "coordinateTransIn");
+    m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &coordinateTransIn);
+
+    HVA_DEBUG("CoordinateTransformation node %d on frameId %d at port id: %d(Media); "
+              "frameId %d at port id: %d(Radar)",
+              batchIdx, cameraBlob->frameId, m_fusionInPortsInfo.mediaInputPort, radarBlob ? (int)radarBlob->frameId : -1, m_fusionInPortsInfo.radarInputPort);
+
+    /**
+     * process: media
+     */
+    hva::hvaVideoFrameWithROIBuf_t::Ptr ptrFrameBuf =
+        std::dynamic_pointer_cast<hva::hvaVideoFrameWithROIBuf_t>(cameraBlob->get(m_fusionInPortsInfo.mediaBlobBuffIndex));
+    HVA_ASSERT(ptrFrameBuf);
+
+    /**
+     * process: radar
+     */
+    trackerOutput::Ptr radarOutput;
+    if (radarBlob) {
         hva::hvaVideoFrameWithMetaROIBuf_t::Ptr ptrRadarBuf =
             std::dynamic_pointer_cast<hva::hvaVideoFrameWithMetaROIBuf_t>(radarBlob->get(m_fusionInPortsInfo.radarBlobBuffIndex));
         HVA_ASSERT(ptrRadarBuf);
-        trackerOutput radarOutput;
-        if (ptrRadarBuf->containMeta<trackerOutput>()) {
+        if (ptrRadarBuf->containMeta<trackerOutput::Ptr>()) {
             // success
-            ptrRadarBuf->getMeta<trackerOutput>(radarOutput);
+            ptrRadarBuf->getMeta<trackerOutput::Ptr>(radarOutput);
         }
         else {
             // previous node not ever put this type of meta into hvabuf
             HVA_ERROR("Previous node not ever put this type of trackerOutput into hvabuf!");
         }
+    }
 
-        // radarOutput contains all zero tracking results, filter it
-        std::vector<trackerOutputDataType> filteredRadarOutput;
-        for (const auto &item : radarOutput.outputInfo) {
-            if (0 == item.S_hat[0] && 0 == item.S_hat[1] && 0 == item.xSize && 0 == item.ySize) {
-                // all zero, useless data
-            }
-            else {
-                filteredRadarOutput.push_back(item);
-            }
-        }
+    FusionOutput::Ptr fusionOutput = m_fusionOutputPool->acquire(1);
 
-        /**
-         * start processing
-         */
-        m_ctx.getLatencyMonitor().startRecording(cameraBlob->frameId, "coord transformation");
-        int cameraSize = ptrFrameBuf->rois.size();
-        int radarSize = filteredRadarOutput.size();
-        HVA_DEBUG("Frame %d: cameraSize(%d), radarSize(%d)", cameraBlob->frameId, cameraSize, radarSize);
-
-        HVA_DEBUG("fusion perform coordinate transformation on frame%d", cameraBlob->frameId);
-        FusionOutput fusionOutput(1);
-
-        // add radar output
-        fusionOutput.setRadarOutput(filteredRadarOutput);
-        // add camera output
-        std::vector<BBox> cameraRadarCoords;
-        std::vector<DetectedObject> fusionResult;
-        for (const auto &item : ptrFrameBuf->rois) {
-            cv::Rect2i rect = cv::Rect2i(item.x, item.y, item.width, item.height);
-            cv::Rect2f radarCoords = m_coordsTrans.pixel2Radar(rect);
-            cameraRadarCoords.push_back(BBox(radarCoords.x, radarCoords.y, radarCoords.width, radarCoords.height));
-            fusionResult.push_back(DetectedObject(BBox(radarCoords.x, radarCoords.y, 4.2, 1.7), item.confidenceDetection, item.labelDetection));
+    // radarOutput contains all zero tracking results, filter it
+    for (const auto &item : radarOutput ? radarOutput->outputInfo : m_noTracks) {
+        if (0 == item.S_hat[0] && 0 == item.S_hat[1] && 0 == item.xSize && 0 == item.ySize) {
+            // all zero, useless data
         }
-        fusionOutput.addCameraROI(0, ptrFrameBuf->rois, cameraRadarCoords);
+        else {
+            fusionOutput->m_radarOutput.push_back(item);
+        }
+    }
+    if (0.0f != radarDtSec) {
+        // the radar frame stands in for a frame it does not match in time
+        extrapolateRadarTracks(fusionOutput->m_radarOutput, radarDtSec);
+    }
 
-        // add camera fusion result (in radar coordinate), actually is camera detections in radar coordinate, for only 1 camera here
-        fusionOutput.setCameraFusionRadarCoords(fusionResult);
+    /**
+     * start processing
+     */
+    m_ctx.getLatencyMonitor().startRecording(cameraBlob->frameId, "coord transformation");
+    int cameraSize = ptrFrameBuf->rois.size();
+    int radarSize = fusionOutput->m_radarOutput.size();
+    HVA_DEBUG("Frame %d: cameraSize(%d), radarSize(%d)", cameraBlob->frameId, cameraSize, radarSize);
+
+    HVA_DEBUG("fusion perform coordinate transformation on frame%d", cameraBlob->frameId);
+
+    // add camera output and camera fusion result (in radar coordinate), actually is camera detections in radar coordinate, for only 1 camera here
+    fusionOutput->m_cameraRois[0] = ptrFrameBuf->rois;
+    std::vector<BBox> &cameraRadarCoords = fusionOutput->m_cameraRadarCoords[0];
+    std::vector<DetectedObject> &fusionResult = fusionOutput->m_cameraFusionRadarCoords;
+    for (const auto &item : ptrFrameBuf->rois) {
+        cv::Rect2i rect = cv::Rect2i(item.x, item.y, item.width, item.height);
+        cv::Rect2f radarCoords = m_coordsTrans.pixel2Radar(rect);
+        cameraRadarCoords.push_back(BBox(radarCoords.x, radarCoords.y, radarCoords.width, radarCoords.height));
+        fusionResult.push_back(DetectedObject(BBox(radarCoords.x, radarCoords.y, 4.2, 1.7), item.confidenceDetection, item.labelDetection, 0, item.trackingId));
+    }
+    fusionOutput->resetCameraFusionAssociation();
 
-        ptrFrameBuf->setMeta<FusionOutput>(fusionOutput);
-        HVA_DEBUG("CoordinateTransformation sending blob with frameid %u and streamid %u", cameraBlob->frameId, cameraBlob->streamId);
-        m_ctx.sendOutput(cameraBlob, 0, std::chrono::milliseconds(0));
-        HVA_DEBUG("CoordinateTransformation completed sent blob with frameid %u and streamid %u", cameraBlob->frameId, cameraBlob->streamId);
-        m_ctx.getLatencyMonitor().stopRecording(cameraBlob->frameId, "coord transformation");
+    ptrFrameBuf->setMeta<FusionOutput::Ptr>(fusionOutput);
+    HVA_DEBUG("CoordinateTransformation sending blob with frameid %u and streamid %u", cameraBlob->frameId, cameraBlob->streamId);
+    m_ctx.sendOutput(cameraBlob, 0, std::chrono::milliseconds(0));
+    HVA_DEBUG("CoordinateTransformation completed sent blob with frameid %u and streamid %u", cameraBlob->frameId, cameraBlob->streamId);
+    m_ctx.getLatencyMonitor().stopRecording(cameraBlob->frameId, "coord transformation");
 
-        std::shared_ptr<hva::timeStampInfo> coordinateTransOut = std::make_shared<hva::timeStampInfo>(cameraBlob->frameId, "coordinateTransOut");
-        m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &coordinateTransOut);
-    }
+    std::shared_ptr<hva::timeStampInfo> coordinateTransOut = std::make_shared<hva::timeStampInfo>(cameraBlob->frameId, "coordinateTransOut");
+    m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &coordinateTransOut);
 }
 
 hva::hvaStatus_t CoordinateTransformationNodeWorker::Impl::rearm()
@@ -419,6 +531,8 @@ hva::hvaStatus_t CoordinateTransformationNodeWorker::Impl::rearm()
 
 hva::hvaStatus_t CoordinateTransformationNodeWorker::Impl::reset()
 {
+    // frames of the previous streams must not be matched with the new ones
+    m_sync.clear();
     return hva::hvaSuccess;
 }
 
@@ -427,9 +541,12 @@ CoordinateTransformationNodeWorker::CoordinateTransformationNodeWorker(hva::hvaN
                                                                        const std::string &qMatrixFilePath,
                                                                        const std::string &homographyMatrixFilePath,
                                                                        const std::vector<int> &pclConstraints,
-                                                                       const fusionInPortsInfo_t &fusionInPortsInfo)
+                                                                       const fusionInPortsInfo_t &fusionInPortsInfo,
+                                                                       const SensorSyncConfig &syncConfig,
+                                                                       const FusionOutputPool::Ptr &fusionOutputPool)
     : hva::hvaNodeWorker_t(parentNode),
-      m_impl(new Impl(*this, registrationMatrixFilePath, qMatrixFilePath, homographyMatrixFilePath, pclConstraints, fusionInPortsInfo))
+      m_impl(new Impl(*this, registrationMatrixFilePath, qMatrixFilePath, homographyMatrixFilePath, pclConstraints, fusionInPortsInfo, syncConfig,
+                      fusionOutputPool))
 {}
 
 CoordinateTransformationNodeWorker::~CoordinateTransformationNodeWorker() {}
@@ -444,6 +561,16 @@ void CoordinateTransformationNodeWorker::process(std::size_t batchIdx)
     return m_impl->process(batchIdx);
 }
 
+void CoordinateTransformationNodeWorker::processByLastRun(std::size_t batchIdx)
+{
+    return m_impl->processByLastRun(batchIdx);
+}
+
+hva::hvaStatus_t CoordinateTransformationNodeWorker::reset()
+{
+    return m_impl->reset();
+}
+
 #ifdef HVA_NODE_COMPILE_TO_DYNAMIC_LIBRARY
 HVA_ENABLE_DYNAMIC_LOADING(CoordinateTransformationNode, CoordinateTransformationNode(threadNum))
 #endif  // #ifdef HVA_NODE_COMPILE_TO_DYNAMIC_LIBRARY
@@ -84,6 +84,8 @@ LocalMultiInputNodeWorker::LocalMultiInputNodeWorker(hva::hvaNode_t* parentNode,
         const LocalMultiSensorInputNode::InpustSensorIndices_t &sensorIndices, const size_t &inputCapacity, const size_t &stride, const float &frameRate, const std::string &controlType):
           hva::hvaNodeWorker_t(parentNode), m_ctr(0u), m_sensorIndices(sensorIndices), m_inputCapacity(inputCapacity), m_stride(stride), m_frameRate(frameRate), m_controlType(controlType), m_workStreamId(-1) {
             m_controllerMap[0] = std::make_shared<SendController>(inputCapacity, stride, controlType);
+            // at most InputCapacity frames are in flight, so that many buffers cover the steady state
+            m_radarFramePool = RadarFramePool::create(0 < inputCapacity ? inputCapacity : RADAR_FRAME_POOL_DEFAULT_IDLE);
 }
 
 void LocalMultiInputNodeWorker::process(std::size_t batchIdx){
@@ -178,10 +180,12 @@ void LocalMultiInputNodeWorker::process(std::size_t batchIdx){
                     // radar
                     else if (idx == m_sensorIndices.radarIndex) {
 
-                        auto samples_to_read = buffLen / sizeof(std::complex<float>);
-                        content.radarContent.resize(samples_to_read);
-                        fs.read(reinterpret_cast<char*>(content.radarContent.data()), buffLen);
-                        content.radarSize = content.radarContent.size();
+                        // read straight into a pooled frame, downstream nodes share it without copying
+                        auto samples_to_read = buffLen / sizeof(ComplexFloat_t);
+                        content.radarContent = m_radarFramePool->acquire();
+                        ComplexFloat_t* samples = content.radarContent->resize(samples_to_read);
+                        fs.read(reinterpret_cast<char*>(samples), samples_to_read * sizeof(ComplexFloat_t));
+                        content.radarSize = content.radarContent->size();
                         
                     }
                 }
@@ -196,7 +200,7 @@ void LocalMultiInputNodeWorker::process(std::size_t batchIdx){
             // make buffer for blob
             auto jpgHvaBuf = hva::hvaVideoFrameWithROIBuf_t::make_buffer<std::string>(content.imageContent, content.imageSize);
             jpgHvaBuf->rois.push_back(std::move(roi));
-            auto radarHvaBuf = hva::hvaVideoFrameWithROIBuf_t::make_buffer<radarVec_t>(content.radarContent, content.radarSize);
+            auto radarHvaBuf = hva::hvaVideoFrameWithROIBuf_t::make_buffer<RadarFrame::Ptr>(content.radarContent, content.radarSize);
 
             // mark buffer as empty if content is null
             if (content.imageSize == 0 || content.radarSize == 0) {
@@ -271,7 +275,7 @@ void LocalMultiInputNodeWorker::sendEmptyBlob(hva::hvaBlob_t::Ptr blob,
 
     blob->vBuf.clear();
     auto jpgHvaBuf = hva::hvaVideoFrameWithROIBuf_t::make_buffer<std::string>(std::string(), 0);
-    auto radarHvaBuf = hva::hvaVideoFrameWithROIBuf_t::make_buffer<radarVec_t>(radarVec_t(), 0);
+    auto radarHvaBuf = hva::hvaVideoFrameWithROIBuf_t::make_buffer<RadarFrame::Ptr>(RadarFrame::Ptr(), 0);
 
     // drop mark as true for empty blob
     jpgHvaBuf->drop = true;
@@ -119,9 +119,9 @@ void MediaRadarOutputNodeWorker::process(std::size_t batchIdx){
         // 
         hva::hvaVideoFrameWithMetaROIBuf_t::Ptr radarBuf = std::dynamic_pointer_cast<hva::hvaVideoFrameWithMetaROIBuf_t>(radarBlob->get(0));
 
-        hce::ai::inference::trackerOutput radarOutput;
+        hce::ai::inference::trackerOutput::Ptr radarOutput;
         if (hva::hvaSuccess == radarBuf->getMeta(radarOutput)) {
-            for (int i = 0; i < radarOutput.outputInfo.size(); ++i) {
+            for (int i = 0; i < radarOutput->outputInfo.size(); ++i) {
                 boost::property_tree::ptree roiInfoTree;
 
                 // dummy media roi
@@ -139,15 +139,15 @@ void MediaRadarOutputNodeWorker::process(std::size_t batchIdx){
 
                 // radar output
                 boost::property_tree::ptree stateTree;
-                std::vector<float> stateVal = { radarOutput.outputInfo[i].S_hat[0], 
-                                                radarOutput.outputInfo[i].S_hat[1],
-                                                radarOutput.outputInfo[i].S_hat[2],
-                                                radarOutput.outputInfo[i].S_hat[3]};
+                std::vector<float> stateVal = { radarOutput->outputInfo[i].S_hat[0], 
+                                                radarOutput->outputInfo[i].S_hat[1],
+                                                radarOutput->outputInfo[i].S_hat[2],
+                                                radarOutput->outputInfo[i].S_hat[3]};
                 putVectorToJson<float>(stateTree, stateVal);
                 roiInfoTree.add_child("fusion_roi_state", stateTree);
 
                 boost::property_tree::ptree sizeTree;
-                std::vector<float> sizeVal = {radarOutput.outputInfo[i].xSize, radarOutput.outputInfo[i].ySize};
+                std::vector<float> sizeVal = {radarOutput->outputInfo[i].xSize, radarOutput->outputInfo[i].ySize};
                 putVectorToJson<float>(sizeTree, sizeVal);
                 roiInfoTree.add_child("fusion_roi_size", sizeTree);
 
@@ -130,7 +130,7 @@ void PostFusionOutputNodeWorker::process(std::size_t batchIdx)
             inBuf->rois.clear();
         }
 
-        hce::ai::inference::FusionOutput fusionOutput;
+        hce::ai::inference::FusionOutput::Ptr fusionOutputPtr;
         hce::ai::inference::TimeStamp_t timeMeta;
         hce::ai::inference::InferenceTimeStamp_t inferenceTimeMeta;
         std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
@@ -148,14 +148,15 @@ void PostFusionOutputNodeWorker::process(std::size_t batchIdx)
             inferenceLatency = std::chrono::duration<double, std::milli>(inferenceTimeMeta.endTime - inferenceTimeMeta.startTime).count();
         }
 
-        if (hva::hvaSuccess == inBuf->getMeta(fusionOutput)) {
+        if (hva::hvaSuccess == inBuf->getMeta(fusionOutputPtr) && fusionOutputPtr) {
+            const hce::ai::inference::FusionOutput &fusionOutput = *fusionOutputPtr;
             getParentPtr()->emitEvent(hvaEvent_PipelineLatencyCapture, &inBuf->frameId);
 
             jsonTree.clear();
             roisTree.clear();
             // fusion radar output
             for (size_t roiIdx = 0; roiIdx < fusionOutput.m_fusionBBox.size(); roiIdx++) {
-                hce::ai::inference::FusionBBox fusionBBox = fusionOutput.m_fusionBBox[roiIdx];
+                const hce::ai::inference::FusionBBox &fusionBBox = fusionOutput.m_fusionBBox[roiIdx];
                 boost::property_tree::ptree roiInfoTree;
 
                 // dummy media roi
@@ -173,6 +174,7 @@ void PostFusionOutputNodeWorker::process(std::size_t batchIdx)
                 // dummy & zero if no corresponding media detection
                 roiInfoTree.put("roi_class", fusionBBox.det.label);
                 roiInfoTree.put("roi_score", fusionBBox.det.confidence);
+                roiInfoTree.put("association_score", fusionBBox.associationConfidence);
 
                 // dummy tracking
                 roiInfoTree.put("track_id", 0.0);
@@ -198,8 +200,8 @@ void PostFusionOutputNodeWorker::process(std::size_t batchIdx)
 
             // camera detections which is not associated with radar detections
             for (size_t roiIdx = 0; roiIdx < fusionOutput.m_cameraFusionRadarCoords.size(); roiIdx++) {
-                if (!fusionOutput.m_cameraFusionRadarCoordsIsAssociated[roiIdx]) {
-                    hce::ai::inference::DetectedObject detectedObject = fusionOutput.m_cameraFusionRadarCoords[roiIdx];
+                if (!fusionOutput.m_cameraFusionRadarCoordsIsAssociated.test(roiIdx)) {
+                    const hce::ai::inference::DetectedObject &detectedObject = fusionOutput.m_cameraFusionRadarCoords[roiIdx];
                     boost::property_tree::ptree roiInfoTree;
 
                     // dummy media roi
@@ -243,12 +245,12 @@ void PostFusionOutputNodeWorker::process(std::size_t batchIdx)
 
             // camera detections information
             for (size_t cameraId = 0; cameraId < fusionOutput.m_numOfCams; cameraId++) {
-                std::vector<hva::hvaROI_t> cameraDetections = fusionOutput.m_cameraRois[cameraId];
-                std::vector<BBox> cameraDetectionsRadarCoords = fusionOutput.m_cameraRadarCoords[cameraId];
+                const std::vector<hva::hvaROI_t> &cameraDetections = fusionOutput.m_cameraRois[cameraId];
+                const std::vector<BBox> &cameraDetectionsRadarCoords = fusionOutput.m_cameraRadarCoords[cameraId];
 
                 for (size_t roiIdx = 0; roiIdx < cameraDetections.size(); roiIdx++) {
-                    hva::hvaROI_t itemPixel = cameraDetections[roiIdx];
-                    BBox itemRoiRadar = cameraDetectionsRadarCoords[roiIdx];
+                    const hva::hvaROI_t &itemPixel = cameraDetections[roiIdx];
+                    const BBox &itemRoiRadar = cameraDetectionsRadarCoords[roiIdx];
                     boost::property_tree::ptree roiInfoTree;
 
                     // media roi
@@ -287,6 +289,10 @@ void PostFusionOutputNodeWorker::process(std::size_t batchIdx)
                     roisTree.push_back(std::make_pair("", roiInfoTree));
                 }
             }
+
+            // serialised, hand the fusion output back to the pool of the fusion node
+            fusionOutputPtr.reset();
+            inBuf->eraseMeta<hce::ai::inference::FusionOutput::Ptr>();
         }
         else {
             // previous node not ever put this type of meta into hvabuf
@@ -357,15 +357,19 @@ void RadarClusteringSinkFileNodeWorker::process(std::size_t batchIdx){
         unsigned tag = buf->getTag();
         HVA_DEBUG("Radar output start processing %d frame with tag %d", inBlob->frameId, tag);
         // inherit meta data from previous input field
-        clusteringDBscanOutput output;
-        if (buf->containMeta<hce::ai::inference::clusteringDBscanOutput>()) {
+        clusteringDBscanOutput::Ptr outputPtr;
+        if (buf->containMeta<hce::ai::inference::clusteringDBscanOutput::Ptr>()) {
             // success
-            buf->getMeta(output);
+            buf->getMeta(outputPtr);
         }
         else {
             // previous node not ever put this type of meta into hvabuf
             HVA_ERROR("Previous node not ever put this type of clusteringDBscanOutput into hvabuf!");
         }   
+        if (!outputPtr) {
+            outputPtr = std::make_shared<clusteringDBscanOutput>();
+        }
+        const clusteringDBscanOutput& output = *outputPtr;
 
     
         hce::ai::inference::HceDatabaseMeta videoMeta;
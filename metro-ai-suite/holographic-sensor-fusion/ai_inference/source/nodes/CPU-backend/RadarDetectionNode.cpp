@@ -173,6 +173,12 @@ private:
 
     RadarConfigParam m_radar_config; 
 
+    FFTPlanCache::Ptr m_fftPlanCache;  // committed fft descriptors reused across frames
+    DOAEngine::Ptr m_doaEngine;        // steering and doppler compensation tables reused across frames
+    RadarThreadPool::Ptr m_threadPool; // intra-frame workers, sized by the thread budget of the radar config
+    RadarMetaArena::Ptr m_metaArena;   // recycled point clouds, sized by the clustering config of the first frame
+    RadarDetection m_detection;        // profiles reused across frames, rebound to every frame by reset()
+
     // std::atomic<int32_t> m_cntAsyncEnd{0};
     // std::atomic<int32_t> m_cntAsyncStart{0};
 
@@ -183,7 +189,7 @@ private:
 };
 
 RadarDetectionNodeWorker::Impl::Impl(RadarDetectionNodeWorker& ctx, RadarConfigParam m_radar_config):
-        m_ctx(ctx) {
+        m_ctx(ctx), m_fftPlanCache(std::make_shared<FFTPlanCache>()), m_doaEngine(std::make_shared<DOAEngine>()) {
 }
 
 RadarDetectionNodeWorker::Impl::~Impl(){
@@ -220,16 +226,28 @@ void RadarDetectionNodeWorker::Impl::process(std::size_t batchIdx){
 
             HVA_DEBUG("Radar detection start processing %d frame with tag %d", blob->frameId, tag);
 
-            ThreeDimArray<ComplexFloat> frame_data = ptrFrameBuf->get<ThreeDimArray<ComplexFloat>>();
+            RadarTensor<ComplexFloat> frame_data = ptrFrameBuf->get<RadarTensor<ComplexFloat>>();
 
             size_t frame_size = ptrFrameBuf->getSize(); // frame_data_size
 
             HVA_DEBUG("Radar detection on frame %d, test frame data[0]: real%f, imag%f", blob->frameId, (float)frame_data.at(0, 0, 0).real(), (float)frame_data.at(0, 0, 0).imag());
 
-            RadarDetection *radar_detection = new RadarDetection(frame_data, blob->frameId, frame_size, params.m_radar_basic_config_, params.m_radar_detection_config_);
-            radar_detection->runDetection();
+            int numThreads = std::max(params.m_radar_detection_config_.m_num_threads_, 1);
+            if (!m_threadPool || m_threadPool->numThreads() != numThreads) {
+                HVA_DEBUG("Radar detection uses %d threads per frame", numThreads);
+                m_threadPool = std::make_shared<RadarThreadPool>(numThreads);
+            }
+
+            if (!m_metaArena) {
+                m_metaArena = RadarMetaArena::create(params.m_radar_clusterging_config_);
+            }
+
+            m_detection.reset(frame_data, blob->frameId, frame_size, params.m_radar_basic_config_, params.m_radar_detection_config_, m_fftPlanCache, m_doaEngine, m_threadPool);
+            m_detection.setPCL(m_metaArena->acquirePointClouds());
+            m_detection.runDetection();
 
-            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<pointClouds>(*radar_detection->getPCL(), sizeof(radar_detection->getPCL()));
+            pointClouds::Ptr pcl = m_detection.getPCL();
+            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<pointClouds::Ptr>(pcl, sizeof(pointClouds));
 
             TimeStamp_t time_meta;
             if (ptrFrameBuf->getMeta(time_meta) == hva::hvaSuccess) {
@@ -267,12 +285,11 @@ void RadarDetectionNodeWorker::Impl::process(std::size_t batchIdx){
             std::make_shared<hva::timeStampInfo>(blob->frameId, "RadarDetectionOut");
             m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &RadarDetectionOut);
             HVA_DEBUG("RadarDetection node completed sent blob with frameid %u and streamid %u", radarBlob->frameId, radarBlob->streamId);
-            delete radar_detection;
         }
         else
         {
-            pointClouds pcl;
-            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<pointClouds>(pcl, 0);
+            pointClouds::Ptr pcl = std::make_shared<pointClouds>();
+            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<pointClouds::Ptr>(pcl, 0);
             TimeStamp_t time_meta;
             if (ptrFrameBuf->getMeta(time_meta) == hva::hvaSuccess) {
                 hvabuf->setMeta(time_meta);
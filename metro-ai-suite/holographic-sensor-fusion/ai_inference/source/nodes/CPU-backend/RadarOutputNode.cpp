@@ -64,17 +64,18 @@ void RadarOutputNodeWorker::process(std::size_t batchIdx)
         hva::hvaVideoFrameWithMetaROIBuf_t::Ptr buf = std::dynamic_pointer_cast<hva::hvaVideoFrameWithMetaROIBuf_t>(inBlob->get(0));
 
         // inherit meta data from previous input field
-        trackerOutput output;
-        if (buf->containMeta<hce::ai::inference::trackerOutput>()) {
+        trackerOutput::Ptr output;
+        if (buf->containMeta<hce::ai::inference::trackerOutput::Ptr>()) {
             // success
             buf->getMeta(output);
         }
         else {
             // previous node not ever put this type of meta into hvabuf
             HVA_ERROR("Previous node not ever put this type of trackerOutput into hvabuf!");
+            output = std::make_shared<trackerOutput>();
         }
 
-        // printTrackerOutput(&output);
+        // printTrackerOutput(output.get());
 
         unsigned tag = buf->getTag();
         HVA_DEBUG("Radar output start processing %d frame with tag %d", inBlob->frameId, tag);
@@ -102,7 +103,7 @@ void RadarOutputNodeWorker::process(std::size_t batchIdx)
         roisTree.clear();
 
         int roi_idx = 0;
-        for (const auto &item : output.outputInfo) {
+        for (const auto &item : output->outputInfo) {
             boost::property_tree::ptree roiInfoTree;
 
             // dummy media roi
@@ -142,7 +143,7 @@ void RadarOutputNodeWorker::process(std::size_t batchIdx)
         }
 
         // if(m_bufType == "String" && buf->get<pointClouds>()){
-        if (output.outputInfo.size() > 0) {
+        if (output->outputInfo.size() > 0) {
             jsonTree.put("status_code", 0u);
             jsonTree.put("description", "succeeded");
             jsonTree.add_child("roi_info", roisTree);
@@ -337,32 +337,33 @@ void RadarPCLSinkFileNodeWorker::process(std::size_t batchIdx){
         std::string description;
         
 
-        if (buf->get<pointClouds>().num >0)
+        pointClouds::Ptr pclOutput = buf->get<pointClouds::Ptr>();
+        if (pclOutput->num >0)
         {
-            HVA_DEBUG("pcl number: %d", buf->get<pointClouds>().num);
+            HVA_DEBUG("pcl number: %d", pclOutput->num);
             m_jsonTree.put("status_code", 0u);
             m_jsonTree.put("description", "succeeded");
             // description = "succeeded";
             m_jsonTree.put("frameId", buf->frameId);
-            m_jsonTree.put("num", buf->get<pointClouds>().num);
+            m_jsonTree.put("num", pclOutput->num);
 
 
             boost::property_tree::ptree pcls;
-            for(int i=0;i<buf->get<pointClouds>().num;i++){
+            for(int i=0;i<pclOutput->num;i++){
                 boost::property_tree::ptree pcl;
-                pcl.put("rangeIdxArray", buf->get<pointClouds>().rangeIdxArray[i]);
-                pcl.put("rangeFloat", buf->get<pointClouds>().rangeFloat[i]);
-                pcl.put("speedIdxArray", buf->get<pointClouds>().speedIdxArray[i]);
-                pcl.put("speedFloat", buf->get<pointClouds>().speedFloat[i]);
-                pcl.put("SNRArray", buf->get<pointClouds>().SNRArray[i]);
-                pcl.put("aoaVar", buf->get<pointClouds>().aoaVar[i]);
+                pcl.put("rangeIdxArray", pclOutput->rangeIdxArray[i]);
+                pcl.put("rangeFloat", pclOutput->rangeFloat[i]);
+                pcl.put("speedIdxArray", pclOutput->speedIdxArray[i]);
+                pcl.put("speedFloat", pclOutput->speedFloat[i]);
+                pcl.put("SNRArray", pclOutput->SNRArray[i]);
+                pcl.put("aoaVar", pclOutput->aoaVar[i]);
                 pcls.push_back(std::make_pair("", pcl));
             }
             m_jsonTree.put("latency", latency);
             m_jsonTree.add_child("pcl", pcls);
 
             // m_localFileManager.saveResultsToFile(buf->frameId, buf->get<pointClouds>(), status_code, description);
-            m_localFileManager.saveResultsToFile(buf->frameId, buf->get<pointClouds>());
+            m_localFileManager.saveResultsToFile(buf->frameId, *pclOutput);
         }
         else{
             m_jsonTree.put("status_code", -2);
@@ -24,6 +24,8 @@
 #include "common/base64.hpp"
 #include "nodes/radarDatabaseMeta.hpp"
 #include "nodes/databaseMeta.hpp"
+#include "modules/inference_util/radar/radar_frame_pool.hpp"
+#include "modules/inference_util/radar/radar_tracking_helper.hpp"
 
 namespace hce{
 
@@ -31,6 +33,8 @@ namespace ai{
 
 namespace inference{
 
+#define RADAR_CUBE_POOL_IDLE 8  //!< released radar cubes kept for reuse, covers the frames in flight downstream
+
 class RadarPreProcessingNode::Impl{
 public:
 
@@ -149,6 +153,15 @@ hva::hvaStatus_t RadarPreProcessingNode::Impl::configureByString(const std::stri
         m_radar_config.m_radar_detection_config_.RangePfa = items["RangePfa"].get<float>();
         m_radar_config.m_radar_detection_config_.RangeWinGuardLen = items["RangeWinGuardLen"].get<int>();
         m_radar_config.m_radar_detection_config_.RangeWinTrainLen = items["RangeWinTrainLen"].get<int>();
+        if (items.contains("DopplerCfarEdge")) {
+            m_radar_config.m_radar_detection_config_.m_doppler_cfar_edge_ = items["DopplerCfarEdge"].get<CfarEdgeMode>();
+        }
+        if (items.contains("RangeCfarEdge")) {
+            m_radar_config.m_radar_detection_config_.m_range_cfar_edge_ = items["RangeCfarEdge"].get<CfarEdgeMode>();
+        }
+        if (items.contains("NumThreads")) {
+            m_radar_config.m_radar_detection_config_.m_num_threads_ = items["NumThreads"].get<int>();
+        }
     }   
 
     // read RadarClusteringConfig
@@ -170,6 +183,7 @@ hva::hvaStatus_t RadarPreProcessingNode::Impl::configureByString(const std::stri
         m_radar_config.m_radar_tracking_config_.iirForgetFactor = items["iirForgetFactor"].get<float>();
         m_radar_config.m_radar_tracking_config_.trackerActiveThreshold = items["trackerActiveThreshold"].get<int>();
         m_radar_config.m_radar_tracking_config_.trackerForgetThreshold = items["trackerForgetThreshold"].get<int>();
+        readTrackerAssociationMethod(items, m_radar_config.m_radar_tracking_config_);
     } 
 
     // after all configures being parsed, this node should be trainsitted to `configured`
@@ -244,10 +258,12 @@ private:
 
     RadarConfigParam m_radar_config;
 
+    RadarObjectPool<RadarCube>::Ptr m_cubePool;  // cubes are recycled once every downstream node released them
+
 };
 
 RadarPreprocessingNodeWorker::Impl::Impl(RadarPreprocessingNodeWorker& ctx, RadarConfigParam m_radar_config):
-        m_ctx(ctx), m_radar_config(m_radar_config) {
+        m_ctx(ctx), m_radar_config(m_radar_config), m_cubePool(RadarObjectPool<RadarCube>::create(RADAR_CUBE_POOL_IDLE)) {
 }
 
 RadarPreprocessingNodeWorker::Impl::~Impl(){
@@ -284,18 +300,23 @@ void RadarPreprocessingNodeWorker::Impl::process(std::size_t batchIdx){
         unsigned tag = ptrFrameBuf->getTag();
         if (!ptrFrameBuf->drop)
         {
-            radarVec_t frame_data = ptrFrameBuf->get<radarVec_t>();
+            // the frame is shared with the input node, only the handle is copied
+            RadarFrame::Ptr radar_frame = ptrFrameBuf->get<RadarFrame::Ptr>();
+            const ComplexFloat_t* frame_data = radar_frame->data();
 
             size_t frame_size = ptrFrameBuf->getSize(); // frame_data_size
 
             HVA_DEBUG("radar perform preprocessing on frame%d,frame[0]: real %d, imag %d", blob->frameId, (int)frame_data[0].real(), (int)frame_data[0].imag());
             HVA_DEBUG("radar perform preprocessing on frame%d,frame[%d]: real %d, imag %d", blob->frameId, frame_size, (int)frame_data[frame_size - 1].real(), (int)frame_data[frame_size - 1].imag());
-            RadarCube *radar_cube_ = new RadarCube(frame_data.data(), frame_size, blob->frameId, this->m_radar_config.m_radar_basic_config_);
+            // the reorganise kernel writes into a pooled cube, the tensor sent downstream keeps the cube out of the pool
+            std::shared_ptr<RadarCube> radar_cube_ = m_cubePool->acquire();
+            radar_cube_->reset(frame_size, blob->frameId, this->m_radar_config.m_radar_basic_config_);
 
-            radar_cube_->radarCube_format(frame_data.data());
+            radar_cube_->radarCube_format(frame_data);
             const int radar_frame_size = radar_cube_->getRadarFrameSize();
 
-            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<ThreeDimArray<ComplexFloat>>(radar_cube_->getRadarCube(), radar_frame_size);
+            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<RadarTensor<ComplexFloat>>(
+                radar_cube_->getRadarCube().shareWith(radar_cube_), radar_frame_size);
 
             hvabuf->setMeta(timeMeta);
             hvabuf->setMeta(this->m_radar_config);
@@ -318,11 +339,10 @@ void RadarPreprocessingNodeWorker::Impl::process(std::size_t batchIdx){
             std::make_shared<hva::timeStampInfo>(blob->frameId, "RadarPreprocessOut");
             m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &RadarPreprocessOut);
             HVA_DEBUG("Radar preprocessing node sent blob with frameid %u and streamid %u", radarBlob->frameId, radarBlob->streamId);
-            delete radar_cube_;
         }
         else
         {
-            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<ThreeDimArray<ComplexFloat>>(ThreeDimArray<ComplexFloat>(0, 0, 0), 0);
+            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<RadarTensor<ComplexFloat>>(RadarTensor<ComplexFloat>(), 0);
             hvabuf->frameId = blob->frameId;
             hvabuf->tagAs(tag);
             hvabuf->drop =true;
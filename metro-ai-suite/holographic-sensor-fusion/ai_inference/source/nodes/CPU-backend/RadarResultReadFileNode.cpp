@@ -24,6 +24,8 @@
 #include "common/base64.hpp"
 #include "nodes/radarDatabaseMeta.hpp"
 #include "nodes/databaseMeta.hpp"
+#include "modules/inference_util/radar/radar_frame_pool.hpp"
+#include "modules/inference_util/radar/radar_tracking_helper.hpp"
 
 namespace hce{
 
@@ -160,6 +162,15 @@ hva::hvaStatus_t RadarResultReadFileNode::Impl::configureByString(const std::str
         m_radar_config.m_radar_detection_config_.RangePfa = items["RangePfa"].get<float>();
         m_radar_config.m_radar_detection_config_.RangeWinGuardLen = items["RangeWinGuardLen"].get<int>();
         m_radar_config.m_radar_detection_config_.RangeWinTrainLen = items["RangeWinTrainLen"].get<int>();
+        if (items.contains("DopplerCfarEdge")) {
+            m_radar_config.m_radar_detection_config_.m_doppler_cfar_edge_ = items["DopplerCfarEdge"].get<CfarEdgeMode>();
+        }
+        if (items.contains("RangeCfarEdge")) {
+            m_radar_config.m_radar_detection_config_.m_range_cfar_edge_ = items["RangeCfarEdge"].get<CfarEdgeMode>();
+        }
+        if (items.contains("NumThreads")) {
+            m_radar_config.m_radar_detection_config_.m_num_threads_ = items["NumThreads"].get<int>();
+        }
     }   
 
     // read RadarClusteringConfig
@@ -181,6 +192,7 @@ hva::hvaStatus_t RadarResultReadFileNode::Impl::configureByString(const std::str
         m_radar_config.m_radar_tracking_config_.iirForgetFactor = items["iirForgetFactor"].get<float>();
         m_radar_config.m_radar_tracking_config_.trackerActiveThreshold = items["trackerActiveThreshold"].get<int>();
         m_radar_config.m_radar_tracking_config_.trackerForgetThreshold = items["trackerForgetThreshold"].get<int>();
+        readTrackerAssociationMethod(items, m_radar_config.m_radar_tracking_config_);
     } 
 
     // after all configures being parsed, this node should be trainsitted to `configured`
@@ -266,11 +278,12 @@ private:
     int m_workStreamId;
     std::atomic<unsigned> m_ctr;
     //std::string CSVFilePath;
+    RadarMetaArena::Ptr m_metaArena;  // recycled tracker outputs
 
 };
 
 RadarResultReadFileNodeWorker::Impl::Impl(RadarResultReadFileNodeWorker& ctx, RadarConfigParam m_radar_config):
-        m_ctx(ctx), m_radar_config(m_radar_config), m_workStreamId(-1) {
+        m_ctx(ctx), m_radar_config(m_radar_config), m_workStreamId(-1), m_metaArena(RadarMetaArena::create(0, 0)) {
 }
 
 RadarResultReadFileNodeWorker::Impl::~Impl(){
@@ -281,22 +294,22 @@ void RadarResultReadFileNodeWorker::Impl::sendEmptyBuf(hva::hvaBlob_t::Ptr inBlo
     auto RadarHvaBuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<std::string>(
         std::string(), 0);
     size_t numTrackers = 0;
-    trackerOutput output;
-    output.outputInfo.resize(1);
-    output.outputInfo[0].state = 0;
-    output.outputInfo[0].trackerID = 0;
-    output.outputInfo[0].xSize = 0;
-    output.outputInfo[0].ySize = 0;
-    output.outputInfo[0].S_hat[0] = 0;
-    output.outputInfo[0].S_hat[1] = 0;
+    trackerOutput::Ptr output = m_metaArena->acquireTracks();
+    output->outputInfo.resize(1);
+    output->outputInfo[0].state = 0;
+    output->outputInfo[0].trackerID = 0;
+    output->outputInfo[0].xSize = 0;
+    output->outputInfo[0].ySize = 0;
+    output->outputInfo[0].S_hat[0] = 0;
+    output->outputInfo[0].S_hat[1] = 0;
     float azimuth = 0;
-    output.outputInfo[0].S_hat[2] = 0;
-    output.outputInfo[0].S_hat[3] = 0;
+    output->outputInfo[0].S_hat[2] = 0;
+    output->outputInfo[0].S_hat[3] = 0;
 
 
     // drop mark as true for empty blob
     RadarHvaBuf->drop = true;
-    RadarHvaBuf->setMeta<trackerOutput>(output);
+    RadarHvaBuf->setMeta<trackerOutput::Ptr>(output);
 
     if (tag == 1) {
         // last one in the batch. Mark it
@@ -395,7 +408,7 @@ void RadarResultReadFileNodeWorker::Impl::process(std::size_t batchIdx) {
                     continue;
                 }
 
-                trackerOutput trackerData;
+                trackerOutput::Ptr trackerData = m_metaArena->acquireTracks();
                 for (size_t i = 0; i < numTrackers; ++i) {
                     trackerOutputDataType outputData;
                     outputData.trackerID = radarIDValues[i];
@@ -405,7 +418,7 @@ void RadarResultReadFileNodeWorker::Impl::process(std::size_t batchIdx) {
                     }
                     outputData.xSize = radarSizeValues[i * 2];
                     outputData.ySize = radarSizeValues[i * 2 + 1];
-                    trackerData.outputInfo.push_back(outputData);
+                    trackerData->outputInfo.push_back(outputData);
                 }
 
                 // Create and send blob
@@ -413,8 +426,8 @@ void RadarResultReadFileNodeWorker::Impl::process(std::size_t batchIdx) {
                 radarBlob->frameId = frameId;
                 radarBlob->streamId = m_workStreamId;
 
-                hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<ThreeDimArray<ComplexFloat>>(ThreeDimArray<ComplexFloat>(0, 0, 0), 0);
-                hvabuf->setMeta<trackerOutput>(trackerData);
+                hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<RadarTensor<ComplexFloat>>(RadarTensor<ComplexFloat>(), 0);
+                hvabuf->setMeta<trackerOutput::Ptr>(trackerData);
                 hvabuf->frameId = frameId;
                 hvabuf->tagAs(0); // Tag as regular data
 
@@ -310,14 +310,15 @@ void RadarResultSinkFileNodeWorker::process(std::size_t batchIdx){
         unsigned tag = buf->getTag();
         HVA_DEBUG("Radar output start processing %d frame with tag %d", inBlob->frameId, tag);
         // inherit meta data from previous input field
-        trackerOutput output;
-        if (buf->containMeta<hce::ai::inference::trackerOutput>()) {
+        trackerOutput::Ptr output;
+        if (buf->containMeta<hce::ai::inference::trackerOutput::Ptr>()) {
             // success
             buf->getMeta(output);
         }
         else {
             // previous node not ever put this type of meta into hvabuf
             HVA_ERROR("Previous node not ever put this type of trackerOutput into hvabuf!");
+            output = std::make_shared<trackerOutput>();
         }   
 
 
@@ -338,10 +339,10 @@ void RadarResultSinkFileNodeWorker::process(std::size_t batchIdx){
         int status_code;
         std::string description;
        
-        HVA_DEBUG("output size %d", output.outputInfo.size());
+        HVA_DEBUG("output size %d", output->outputInfo.size());
 
         // if(m_bufType == "String" && buf->get<pointClouds>()){
-        if (output.outputInfo.size() !=0)
+        if (output->outputInfo.size() !=0)
         {
             // HVA_DEBUG("pcl number: %d", buf->get<pointClouds>().num);
             m_jsonTree.put("status_code", 0u);
@@ -349,7 +350,7 @@ void RadarResultSinkFileNodeWorker::process(std::size_t batchIdx){
             description = "succeeded";
             m_jsonTree.put("latency", latency);
             // m_localFileManager.saveResultsToFile(buf->frameId, buf->get<pointClouds>(), status_code, description);
-            m_localFileManager.saveResultsToFile(buf->frameId, output);
+            m_localFileManager.saveResultsToFile(buf->frameId, *output);
         }
         else{
             m_jsonTree.put("status_code", -2);
@@ -26,6 +26,7 @@
 #include "nodes/databaseMeta.hpp"
 #include "nodes/radarDatabaseMeta.hpp"
 #include "libradar.h"
+#include "modules/inference_util/radar/radar_frame_pool.hpp"
 #include <memory>
 #ifdef ENABLE_SANITIZE
     #define ALIGN_ALLOC(align, size) malloc((size))
@@ -89,6 +90,7 @@ private:
     // int m_numInferStreams;
 
     RadarConfigParam  m_radar_config;
+    RadarAdmissionConfig m_admissionConfig;
 
 
     // RadarPreProcessingNode::Ptr m_model;
@@ -121,6 +123,22 @@ hva::hvaStatus_t RadarSignalProcessingNode::Impl::configureByString(const std::s
     m_configParser.getVal<std::string>("RadarConfigPath", radarConfigPath);
     HVA_DEBUG("radarConfigPath (%s) read", radarConfigPath.c_str());
 
+    // load shedding, off unless a latency objective is given
+    float latencySloMs = 0.0f;
+    m_configParser.getVal<float>("LatencySloMs", latencySloMs);
+    bool degradeDoa = true;
+    m_configParser.getVal<bool>("AdmissionDegradeDoa", degradeDoa);
+    int maxDecimation = RADAR_ADMISSION_MAX_DECIMATION;
+    m_configParser.getVal<int>("AdmissionMaxDecimation", maxDecimation);
+    if (latencySloMs < 0.0f || maxDecimation < 0) {
+        HVA_ERROR("LatencySloMs and AdmissionMaxDecimation must not be negative, receiving %f and %d", latencySloMs, maxDecimation);
+        return hva::hvaFailure;
+    }
+    m_admissionConfig.latencySloMs = latencySloMs;
+    m_admissionConfig.degradeDoa = degradeDoa;
+    m_admissionConfig.maxDecimation = maxDecimation;
+    HVA_DEBUG("Radar signal processing latency objective %f ms, degrade doa %d, max decimation %d", latencySloMs, degradeDoa, maxDecimation);
+
     //parser json
 
     // HVA_DEBUG("Parsing model_proc json from file: %s", radarConfigPath.c_str());
@@ -161,6 +179,15 @@ hva::hvaStatus_t RadarSignalProcessingNode::Impl::configureByString(const std::s
         m_radar_config.m_radar_detection_config_.RangePfa = items["RangePfa"].get<float>();
         m_radar_config.m_radar_detection_config_.RangeWinGuardLen = items["RangeWinGuardLen"].get<int>();
         m_radar_config.m_radar_detection_config_.RangeWinTrainLen = items["RangeWinTrainLen"].get<int>();
+        if (items.contains("DopplerCfarEdge")) {
+            m_radar_config.m_radar_detection_config_.m_doppler_cfar_edge_ = items["DopplerCfarEdge"].get<CfarEdgeMode>();
+        }
+        if (items.contains("RangeCfarEdge")) {
+            m_radar_config.m_radar_detection_config_.m_range_cfar_edge_ = items["RangeCfarEdge"].get<CfarEdgeMode>();
+        }
+        if (items.contains("NumThreads")) {
+            m_radar_config.m_radar_detection_config_.m_num_threads_ = items["NumThreads"].get<int>();
+        }
     }   
 
     // read RadarClusteringConfig
@@ -195,7 +222,7 @@ hva::hvaStatus_t RadarSignalProcessingNode::Impl::configureByString(const std::s
 * @param void
 */
 std::shared_ptr<hva::hvaNodeWorker_t> RadarSignalProcessingNode::Impl::createNodeWorker(RadarSignalProcessingNode* parent) const{
-    return std::shared_ptr<hva::hvaNodeWorker_t>{new RadarSignalProcessingNodeWorker{parent, m_radar_config}};
+    return std::shared_ptr<hva::hvaNodeWorker_t>{new RadarSignalProcessingNodeWorker{parent, m_radar_config, m_admissionConfig}};
 }
 
 hva::hvaStatus_t RadarSignalProcessingNode::Impl::rearm(){
@@ -237,7 +264,7 @@ hva::hvaStatus_t RadarSignalProcessingNode::reset(){
 class RadarSignalProcessingNodeWorker::Impl{
 public:
 
-    Impl(RadarSignalProcessingNodeWorker& ctx, RadarConfigParam m_radar_config);
+    Impl(RadarSignalProcessingNodeWorker& ctx, RadarConfigParam m_radar_config, const RadarAdmissionConfig& admissionConfig);
 
     ~Impl();
     
@@ -266,6 +293,17 @@ private:
     //  */
     // bool runPostproc(const std::string layerName, const InferenceEngine::Blob::Ptr &ptrBlob, ClassificationObject_t &object);
 
+    /**
+     * @brief age of the frame and number of frames in flight, for the admission controller
+     */
+    float frameAgeMs(const hva::hvaVideoFrameWithROIBuf_t::Ptr& buf, std::chrono::time_point<std::chrono::high_resolution_clock> now);
+    uint32_t framesInFlight(const hva::hvaVideoFrameWithROIBuf_t::Ptr& buf);
+
+    /**
+     * @brief hand the frame slot back to the input node once the frame is through detection
+     */
+    void releaseSendController(const hva::hvaVideoFrameWithROIBuf_t::Ptr& buf);
+
     RadarSignalProcessingNodeWorker& m_ctx;
 
     // float m_durationAve {0.0f};
@@ -277,15 +315,22 @@ private:
     RadarParam m_lib_radar_param;
     std::unique_ptr<RadarTracker> m_motTracker;
     RadarHandle* m_handle =nullptr;
+    RadarMetaArena::Ptr m_metaArena;  // recycled point clouds, clustering and tracker outputs
     void *buf =nullptr;
     // bool m_isTrackerInitialized;
     // std::shared_ptr<void> buf = nullptr;
     RadarCube rc;
 
+    // load shedding, the degraded handle runs FFT DOA in place of the configured estimator
+    RadarAdmissionController m_admission;
+    RadarHandle* m_degradedHandle = nullptr;
+    void* m_degradedBuf = nullptr;
+
 };
 
-RadarSignalProcessingNodeWorker::Impl::Impl(RadarSignalProcessingNodeWorker& ctx, RadarConfigParam m_radar_config):
-        m_ctx(ctx), m_radar_config(m_radar_config) {
+RadarSignalProcessingNodeWorker::Impl::Impl(RadarSignalProcessingNodeWorker& ctx, RadarConfigParam m_radar_config, const RadarAdmissionConfig& admissionConfig):
+        m_ctx(ctx), m_radar_config(m_radar_config), m_metaArena(RadarMetaArena::create(m_radar_config.m_radar_clusterging_config_)),
+        m_admission(admissionConfig, false) {
     // radarInit();
     HVA_DEBUG("Radar Signal Processing node init");
     m_lib_radar_param = convertToLibRadarParam(m_radar_config);
@@ -325,6 +370,20 @@ RadarSignalProcessingNodeWorker::Impl::Impl(RadarSignalProcessingNodeWorker& ctx
     rc.sn = m_lib_radar_param.sn;
     rc.cn = m_lib_radar_param.cn;
     rc.mat =(cfloat*)ALIGN_ALLOC(64, sz);
+
+    // a second handle with FFT DOA to fall back to under load, set up now so that overload does not allocate
+    if (admissionConfig.latencySloMs > 0.0f && admissionConfig.degradeDoa && FFT_DOA != m_lib_radar_param.doaType) {
+        RadarParam degradedParam = m_lib_radar_param;
+        degradedParam.doaType = FFT_DOA;
+        ulong degradedSize = 0;
+        radarGetMemSize(&degradedParam, &degradedSize);
+        m_degradedBuf = ALIGN_ALLOC(64, degradedSize);
+        if (radarInitHandle(&m_degradedHandle, &degradedParam, m_degradedBuf, degradedSize) != R_SUCCESS) {
+            HVA_WARNING("radarInitHandle failed for the FFT DOA fallback, load shedding will only drop frames");
+            m_degradedHandle = nullptr;
+        }
+    }
+    m_admission = RadarAdmissionController(admissionConfig, nullptr != m_degradedHandle);
 }
 
 RadarSignalProcessingNodeWorker::Impl::~Impl(){
@@ -340,6 +399,13 @@ RadarSignalProcessingNodeWorker::Impl::~Impl(){
     }
     free(buf);
 
+    if (m_degradedHandle) {
+        radarDestroyHandle(m_degradedHandle);
+        m_degradedHandle = nullptr;
+    }
+    ALIGN_FREE(m_degradedBuf);
+    m_degradedBuf = nullptr;
+
     //free(m_motTracker->GetRadarTrackingResult().td);
     m_motTracker.reset();
     
@@ -433,6 +499,10 @@ RadarParam RadarSignalProcessingNodeWorker::Impl::convertToLibRadarParam(RadarCo
     m_lib_radar_param.iff = params.m_radar_tracking_config_.iirForgetFactor;
     m_lib_radar_param.at = params.m_radar_tracking_config_.trackerActiveThreshold;
     m_lib_radar_param.ft = params.m_radar_tracking_config_.trackerForgetThreshold;
+
+    // only read by the in-tree libradar, the prebuilt library ignores the trailing fields
+    m_lib_radar_param.nt = std::max(params.m_radar_detection_config_.m_num_threads_, 1);
+    m_lib_radar_param.backend = m_lib_radar_param.nt > 1 ? MULTITHREAD_BACKEND : SIMD_BACKEND;
     return m_lib_radar_param;
     
 }
@@ -469,21 +539,34 @@ void RadarSignalProcessingNodeWorker::Impl::process(std::size_t batchIdx){
         // }
 
         unsigned tag = ptrFrameBuf->getTag();
-        if (!ptrFrameBuf->drop)
+
+        RadarAdmissionDecision admission;
+        if (!ptrFrameBuf->drop && m_admission.enabled()) {
+            admission = m_admission.decide(frameAgeMs(ptrFrameBuf, currentTime), framesInFlight(ptrFrameBuf));
+            HVA_DEBUG("Radar signal processing frame %d admitted as %s, age %f ms, %u in flight, predicted latency %f ms", blob->frameId,
+                      radarAdmissionActionName(admission.action), admission.ageMs, admission.inFlight, admission.predictedMs);
+            if (0 == m_admission.decisions() % RADAR_ADMISSION_REPORT_INTERVAL) {
+                HVA_INFO("Radar signal processing admission over %lu frames: %lu full, %lu degraded, %lu decimated, %lu dropped, service time %f ms full, %f ms degraded",
+                         m_admission.decisions(), m_admission.count(RADAR_ADMISSION_FULL), m_admission.count(RADAR_ADMISSION_DEGRADED),
+                         m_admission.count(RADAR_ADMISSION_DECIMATED), m_admission.count(RADAR_ADMISSION_DROPPED), m_admission.serviceMs(false),
+                         m_admission.serviceMs(true));
+            }
+        }
+        bool shed = (RADAR_ADMISSION_DECIMATED == admission.action) || (RADAR_ADMISSION_DROPPED == admission.action);
+
+        if (!ptrFrameBuf->drop && !shed)
         {
 
             HVA_DEBUG("Radar signal processing start processing %d frame with tag %d", blob->frameId, tag);
 
-            radarVec_t frame_data = ptrFrameBuf->get<radarVec_t>();
+            // the frame is shared with the input node, only the handle is copied
+            RadarFrame::Ptr radar_frame = ptrFrameBuf->get<RadarFrame::Ptr>();
+            const ComplexFloat_t* frame_data = radar_frame->data();
 
             size_t frame_size = ptrFrameBuf->getSize(); // frame_data_size
 
             HVA_DEBUG("Radar signal processing on frame%d,frame[0]: real %d, imag %d", blob->frameId, (int)frame_data[0].real(), (int)frame_data[0].imag());
 
-            size_t trn = m_radar_config.m_radar_basic_config_.numRx * m_radar_config.m_radar_basic_config_.numTx;
-            size_t cn = m_radar_config.m_radar_basic_config_.numChirps;
-            size_t sn = m_radar_config.m_radar_basic_config_.adcSamples;
-   
             const int maxRadarPointCloudsLen	= m_radar_config.m_radar_clusterging_config_.maxPoints;
             const int maxCluster	= m_radar_config.m_radar_clusterging_config_.maxClusters;
             const int maxTrackerNum	= 64;
@@ -506,106 +589,87 @@ void RadarSignalProcessingNodeWorker::Impl::process(std::size_t batchIdx){
             };
 
 
-            for(size_t tr = 0; tr < trn; ++tr){/* cube is organized as tr x c x s */
-            for(size_t c = 0; c < cn; ++c){
-                cfloat avg = {.real = 0.f, .imag = 0.f};
-                for(size_t s = 0; s < sn; ++s){
-                cfloat* v   = &(rc.mat[tr * cn * sn + c * sn + s]);
-                cfloat* r = reinterpret_cast<cfloat*>(&frame_data[c * trn * sn + tr * sn + s]);
-                memcpy(v, r, sizeof(cfloat));
-                avg.real    += v->real;
-                avg.imag    += v->imag;
-                }
-                float r = 1.f / sn;
-                avg.real *= r;
-                avg.imag *= r;
-                for(size_t s = 0; s < sn; ++s){
-                cfloat* v  = &(rc.mat[tr * cn * sn + c * sn + s]);
-                v->real	   -= avg.real;
-                v->imag	   -= avg.imag;
-                }
-            }
-            }
+            /* cube is organized as tr x c x s, reorganise and remove static clutter in one pass */
+            formatRadarCube(reinterpret_cast<const cfloat*>(frame_data), rc);
 
-            if(radarDetection(m_handle, &rc, &rr) != R_SUCCESS){
+            // detection and clustering are stateless, a degraded frame runs them on the FFT DOA handle,
+            // tracking always runs on the main handle which holds the tracks
+            RadarHandle* detectionHandle = (RADAR_ADMISSION_DEGRADED == admission.action) ? m_degradedHandle : m_handle;
+            if(radarDetection(detectionHandle, &rc, &rr) != R_SUCCESS){
                 HVA_ERROR("radarDetection failed");
             }
 
-            SendController::Ptr controllerMeta;
-            if(ptrFrameBuf->getMeta(controllerMeta) == hva::hvaSuccess){
-                if (("Radar" == controllerMeta->controlType) && (0 < controllerMeta->capacity)) {
-                    std::unique_lock<std::mutex> lock(controllerMeta->mtx);
-                    (controllerMeta->count)--;
-                    if (controllerMeta->count % controllerMeta->stride == 0) {
-                        (controllerMeta->notFull).notify_all();
-                    }
-                    lock.unlock();
-                }
-            }
+            releaseSendController(ptrFrameBuf);
             
-            if(radarClustering(m_handle, &rr, &cr)!= R_SUCCESS){
+            if(radarClustering(detectionHandle, &rr, &cr)!= R_SUCCESS){
                 HVA_ERROR("radarClustering failed");
             }
 
             m_motTracker->RunTracking(m_handle, cr);
             auto tr = m_motTracker->GetRadarTrackingResult();
+
+            if (m_admission.enabled()) {
+                m_admission.record(admission.action,
+                                   std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - currentTime).count());
+            }
     
             HVA_DEBUG("Radar signal processing node, point clouds output len %d", rr.len);         
             HVA_DEBUG("Radar signal processing node, clustering output len %d", cr.n);
             HVA_DEBUG("Radar signal processing node, tracking output len %d", tr.len);
 
             //// rpc output
-            pointClouds pointClouds_;
-            pointClouds_.num = rr.len;
-            if(pointClouds_.num > 0){
-                pointClouds_.rangeIdxArray.assign(rr.rangeIdx, rr.rangeIdx + rr.len);
-                pointClouds_.rangeFloat.assign(rr.range, rr.range + rr.len);
-                pointClouds_.speedIdxArray.assign(rr.speedIdx, rr.speedIdx + rr.len);
-                pointClouds_.speedFloat.assign(rr.speed, rr.speed + rr.len);
-                pointClouds_.SNRArray.assign(rr.snr, rr.snr + rr.len);
-                pointClouds_.aoaVar.assign(rr.angle, rr.angle + rr.len);
+            pointClouds::Ptr pointClouds_ = m_metaArena->acquirePointClouds();
+            pointClouds_->num = rr.len;
+            if(pointClouds_->num > 0){
+                pointClouds_->rangeIdxArray.assign(rr.rangeIdx, rr.rangeIdx + rr.len);
+                pointClouds_->rangeFloat.assign(rr.range, rr.range + rr.len);
+                pointClouds_->speedIdxArray.assign(rr.speedIdx, rr.speedIdx + rr.len);
+                pointClouds_->speedFloat.assign(rr.speed, rr.speed + rr.len);
+                pointClouds_->SNRArray.assign(rr.snr, rr.snr + rr.len);
+                pointClouds_->aoaVar.assign(rr.angle, rr.angle + rr.len);
             }else{
                 HVA_DEBUG("Radar signal processing node, no point clouds output");
             }
-            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<pointClouds>(pointClouds_, sizeof(pointClouds_));
+            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<pointClouds::Ptr>(pointClouds_, sizeof(pointClouds));
 
             // radar clustering output
-            clusteringDBscanOutput clusterOutput;
-            clusterOutput.numCluster = cr.n;
-            clusterOutput.InputArray.assign(cr.idx, cr.idx + cr.n);
-            clusterOutput.report.resize(cr.n);
+            clusteringDBscanOutput::Ptr clusterOutput = m_metaArena->acquireClusters();
+            clusterOutput->numCluster = cr.n;
+            clusterOutput->InputArray.assign(cr.idx, cr.idx + cr.n);
+            clusterOutput->report.resize(cr.n);
             for(int i=0; i<cr.n; ++i){
-                clusterOutput.report[i].numPoints = cr.cd[i].n;
-                clusterOutput.report[i].xCenter = cr.cd[i].cx;
-                clusterOutput.report[i].yCenter = cr.cd[i].cy;
-                clusterOutput.report[i].xSize = cr.cd[i].rx;
-                clusterOutput.report[i].ySize = cr.cd[i].ry;
-                clusterOutput.report[i].avgVel = cr.cd[i].av;
-                clusterOutput.report[i].centerRangeVar = cr.cd[i].vr;
-                clusterOutput.report[i].centerAngleVar = cr.cd[i].va;
-                clusterOutput.report[i].centerDopplerVar = cr.cd[i].vv;
+                clusterOutput->report[i].numPoints = cr.cd[i].n;
+                clusterOutput->report[i].xCenter = cr.cd[i].cx;
+                clusterOutput->report[i].yCenter = cr.cd[i].cy;
+                clusterOutput->report[i].xSize = cr.cd[i].rx;
+                clusterOutput->report[i].ySize = cr.cd[i].ry;
+                clusterOutput->report[i].avgVel = cr.cd[i].av;
+                clusterOutput->report[i].centerRangeVar = cr.cd[i].vr;
+                clusterOutput->report[i].centerAngleVar = cr.cd[i].va;
+                clusterOutput->report[i].centerDopplerVar = cr.cd[i].vv;
 
             }
 
-            hvabuf->setMeta<clusteringDBscanOutput>(clusterOutput);
+            hvabuf->setMeta<clusteringDBscanOutput::Ptr>(clusterOutput);
 
-            trackerOutput output;
-            output.outputInfo.resize(tr.len);
+            trackerOutput::Ptr output = m_metaArena->acquireTracks();
+            output->outputInfo.resize(tr.len);
 
             for(int i=0; i<tr.len; ++i){
-                output.outputInfo[i].trackerID = tr.td[i].tid;
-                output.outputInfo[i].S_hat[0] = tr.td[i].sHat[0];
-                output.outputInfo[i].S_hat[1] = tr.td[i].sHat[1];
-                output.outputInfo[i].S_hat[2] = tr.td[i].sHat[2];
-                output.outputInfo[i].S_hat[3] = tr.td[i].sHat[3];
-                output.outputInfo[i].xSize = tr.td[i].rx;
-                output.outputInfo[i].ySize = tr.td[i].ry;
+                output->outputInfo[i].trackerID = tr.td[i].tid;
+                output->outputInfo[i].S_hat[0] = tr.td[i].sHat[0];
+                output->outputInfo[i].S_hat[1] = tr.td[i].sHat[1];
+                output->outputInfo[i].S_hat[2] = tr.td[i].sHat[2];
+                output->outputInfo[i].S_hat[3] = tr.td[i].sHat[3];
+                output->outputInfo[i].xSize = tr.td[i].rx;
+                output->outputInfo[i].ySize = tr.td[i].ry;
             }
 
-            hvabuf->setMeta<trackerOutput>(output);
+            hvabuf->setMeta<trackerOutput::Ptr>(output);
 
             hvabuf->setMeta(timeMeta);
             hvabuf->setMeta(m_radar_config);
+            hvabuf->setMeta(admission);
             hvabuf->frameId = blob->frameId;
             hvabuf->tagAs(tag);
 
@@ -624,14 +688,16 @@ void RadarSignalProcessingNodeWorker::Impl::process(std::size_t batchIdx){
         }
         else
         {
-            pointClouds pcl;
-            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<pointClouds>(pcl, 0);
+            // a shed frame frees its slot in the input node at once
+            releaseSendController(ptrFrameBuf);
+
+            pointClouds::Ptr pcl = m_metaArena->acquirePointClouds();
+            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<pointClouds::Ptr>(pcl, 0);
             
-            clusteringDBscanOutput clusterOutput;
-            ptrFrameBuf->setMeta<clusteringDBscanOutput>(clusterOutput);
+            clusteringDBscanOutput::Ptr clusterOutput = m_metaArena->acquireClusters();
+            ptrFrameBuf->setMeta<clusteringDBscanOutput::Ptr>(clusterOutput);
 
-            trackerOutput output;
-            ptrFrameBuf->setMeta<trackerOutput>(output);            
+            ptrFrameBuf->setMeta<trackerOutput::Ptr>(m_metaArena->acquireTracks());
             
             TimeStamp_t time_meta;
             if (ptrFrameBuf->getMeta(time_meta) == hva::hvaSuccess) {
@@ -642,6 +708,7 @@ void RadarSignalProcessingNodeWorker::Impl::process(std::size_t batchIdx){
                 // previous node not ever put this type of meta into hvabuf
                 HVA_ERROR("Previous node not ever put this type of TimeStamp_t into hvabuf!");
             }
+            hvabuf->setMeta(admission);
             hvabuf->frameId = blob->frameId;
             hvabuf->tagAs(tag);
             hvabuf->drop = true;
@@ -662,6 +729,38 @@ void RadarSignalProcessingNodeWorker::Impl::process(std::size_t batchIdx){
   
 }
 
+float RadarSignalProcessingNodeWorker::Impl::frameAgeMs(const hva::hvaVideoFrameWithROIBuf_t::Ptr& buf,
+                                                        std::chrono::time_point<std::chrono::high_resolution_clock> now){
+    TimeStamp_t timeMeta;
+    if (buf->getMeta(timeMeta) != hva::hvaSuccess) {
+        return 0.0f;
+    }
+    return std::chrono::duration<float, std::milli>(now - timeMeta.timeStamp).count();
+}
+
+uint32_t RadarSignalProcessingNodeWorker::Impl::framesInFlight(const hva::hvaVideoFrameWithROIBuf_t::Ptr& buf){
+    SendController::Ptr controllerMeta;
+    if (buf->getMeta(controllerMeta) != hva::hvaSuccess || "Radar" != controllerMeta->controlType || 0 == controllerMeta->capacity) {
+        return 1;
+    }
+    std::lock_guard<std::mutex> lock(controllerMeta->mtx);
+    return (uint32_t)(controllerMeta->count / std::max(controllerMeta->stride, (size_t)1));
+}
+
+void RadarSignalProcessingNodeWorker::Impl::releaseSendController(const hva::hvaVideoFrameWithROIBuf_t::Ptr& buf){
+    SendController::Ptr controllerMeta;
+    if(buf->getMeta(controllerMeta) == hva::hvaSuccess){
+        if (("Radar" == controllerMeta->controlType) && (0 < controllerMeta->capacity)) {
+            std::unique_lock<std::mutex> lock(controllerMeta->mtx);
+            (controllerMeta->count)--;
+            if (controllerMeta->count % controllerMeta->stride == 0) {
+                (controllerMeta->notFull).notify_all();
+            }
+            lock.unlock();
+        }
+    }
+}
+
 void RadarSignalProcessingNodeWorker::Impl::init(){
 
 }
@@ -675,8 +774,8 @@ hva::hvaStatus_t RadarSignalProcessingNodeWorker::Impl::reset(){
     return hva::hvaSuccess;
 }
 
-RadarSignalProcessingNodeWorker::RadarSignalProcessingNodeWorker(hva::hvaNode_t *parentNode, RadarConfigParam m_radar_config): 
-        hva::hvaNodeWorker_t(parentNode), m_impl(new Impl(*this, m_radar_config)) {
+RadarSignalProcessingNodeWorker::RadarSignalProcessingNodeWorker(hva::hvaNode_t *parentNode, RadarConfigParam m_radar_config, const RadarAdmissionConfig& admissionConfig): 
+        hva::hvaNodeWorker_t(parentNode), m_impl(new Impl(*this, m_radar_config, admissionConfig)) {
     
 }
 
@@ -18,10 +18,13 @@
 #include "inc/buffer/hvaVideoFrameWithROIBuf.hpp"
 #include "inc/buffer/hvaVideoFrameWithMetaROIBuf.hpp"
 #include "nodes/databaseMeta.hpp"
+#include "modules/inference_util/radar/radar_frame_sequencer.hpp"
+#include "modules/inference_util/radar/radar_frame_pool.hpp"
 
 #include <chrono>
 #include <cmath>
 #include <algorithm>
+#include <unordered_map>
 
 #include <immintrin.h>
 
@@ -120,9 +123,16 @@ class RadarTrackingNode::Impl {
 
   private:
     RadarTrackingNode &m_ctx;
+
+    hva::hvaConfigStringParser_t m_configParser;
+
+    size_t m_maxReorderFrames;  // frames held back while waiting for an earlier frame
 };
 
-RadarTrackingNode::Impl::Impl(RadarTrackingNode &ctx) : m_ctx(ctx) {}
+RadarTrackingNode::Impl::Impl(RadarTrackingNode &ctx) : m_ctx(ctx), m_maxReorderFrames(RADAR_TRACKING_MAX_REORDER_FRAMES)
+{
+    m_configParser.reset();
+}
 
 RadarTrackingNode::Impl::~Impl() {}
 
@@ -133,7 +143,20 @@ RadarTrackingNode::Impl::~Impl() {}
  */
 hva::hvaStatus_t RadarTrackingNode::Impl::configureByString(const std::string &config)
 {
-    //! TODO:
+    if (!config.empty()) {
+        if (!m_configParser.parse(config)) {
+            HVA_ERROR("Illegal parse string!");
+            return hva::hvaFailure;
+        }
+        int maxReorderFrames = RADAR_TRACKING_MAX_REORDER_FRAMES;
+        m_configParser.getVal<int>("MaxReorderFrames", maxReorderFrames);
+        if (maxReorderFrames < 1) {
+            HVA_ERROR("MaxReorderFrames must be at least 1, receiving %d", maxReorderFrames);
+            return hva::hvaFailure;
+        }
+        m_maxReorderFrames = maxReorderFrames;
+    }
+
     m_ctx.transitStateTo(hva::hvaState_t::configured);
     return hva::hvaSuccess;
 }
@@ -155,7 +178,7 @@ hva::hvaStatus_t RadarTrackingNode::Impl::validateConfiguration() const
  */
 std::shared_ptr<hva::hvaNodeWorker_t> RadarTrackingNode::Impl::createNodeWorker(RadarTrackingNode *parent) const
 {
-    return std::shared_ptr<hva::hvaNodeWorker_t>(new RadarTrackingNodeWorker(parent));
+    return std::shared_ptr<hva::hvaNodeWorker_t>(new RadarTrackingNodeWorker(parent, m_maxReorderFrames));
 }
 
 hva::hvaStatus_t RadarTrackingNode::Impl::prepare()
@@ -223,7 +246,7 @@ hva::hvaStatus_t RadarTrackingNode::prepare()
 
 class RadarTrackingNodeWorker::Impl {
   public:
-    Impl(RadarTrackingNodeWorker &ctx);
+    Impl(RadarTrackingNodeWorker &ctx, size_t maxReorderFrames);
 
     ~Impl();
 
@@ -239,7 +262,25 @@ class RadarTrackingNodeWorker::Impl {
 
     hva::hvaStatus_t reset();
 
+    /**
+     * @brief track the frames still held back by the sequencers in frameId order and forget the streams,
+     * called at the end of the streams and on reset
+     */
+    void flush();
+
   private:
+    /**
+     * @brief run the tracker on one frame and send it, frames must come in frameId order
+     * @param blob input blob
+     */
+    void track(hva::hvaBlob_t::Ptr blob);
+
+    /**
+     * @brief send a frame with an empty tracker output
+     * @param blob input blob
+     */
+    void sendUntracked(hva::hvaBlob_t::Ptr blob);
+
     RadarTrackingNodeWorker &m_ctx;
 
     ClusterTracker tracker;
@@ -247,9 +288,16 @@ class RadarTrackingNodeWorker::Impl {
     bool m_isTrackerInitialized;
 
     std::chrono::high_resolution_clock::time_point m_prevTimestamp;
+
+    size_t m_maxReorderFrames;
+    std::unordered_map<unsigned, FrameSequencer<hva::hvaBlob_t::Ptr>> m_sequencers;  // keyed by stream id
+
+    RadarMetaArena::Ptr m_metaArena;  // recycled tracker outputs
 };
 
-RadarTrackingNodeWorker::Impl::Impl(RadarTrackingNodeWorker &ctx) : m_ctx(ctx), m_isTrackerInitialized(false) {}
+RadarTrackingNodeWorker::Impl::Impl(RadarTrackingNodeWorker &ctx, size_t maxReorderFrames)
+    : m_ctx(ctx), m_isTrackerInitialized(false), m_maxReorderFrames(maxReorderFrames), m_metaArena(RadarMetaArena::create(0, 0))
+{}
 
 RadarTrackingNodeWorker::Impl::~Impl() {}
 
@@ -276,116 +324,150 @@ void RadarTrackingNodeWorker::Impl::process(std::size_t batchIdx)
         std::shared_ptr<hva::timeStampInfo> RadarTrackingIn =
         std::make_shared<hva::timeStampInfo>(blob->frameId, "RadarTrackingIn");
         m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &RadarTrackingIn);
-        hva::hvaVideoFrameWithMetaROIBuf_t::Ptr ptrFrameBuf = std::dynamic_pointer_cast<hva::hvaVideoFrameWithMetaROIBuf_t>(blob->get(0));
-        HVA_ASSERT(ptrFrameBuf);
-        // inherit meta data from previous input field
-        if (!ptrFrameBuf->drop) {
-            RadarConfigParam radarParams;
-            if (ptrFrameBuf->containMeta<RadarConfigParam>()) {
-                // success
-                ptrFrameBuf->getMeta(radarParams);
-            }
-            else {
-                // previous node not ever put this type of meta into hvabuf
-                HVA_ERROR("Previous node not ever put this type of RadarConfigParam into hvabuf!");
-            }
-
-            if (!m_isTrackerInitialized) {
-                clusterTrackerErrorCode errorCode = tracker.clusterTrackerCreate(&radarParams.m_radar_tracking_config_);
-                if (errorCode != CLUSTERTRACKER_NO_ERROR) {
-                    HVA_ERROR("Create clusterTracker Instance Failed!");
-                }
-                m_isTrackerInitialized = true;
-                m_prevTimestamp = std::chrono::high_resolution_clock::now();
-            }
 
-            trackerInput input;
-            if (ptrFrameBuf->containMeta<clusteringDBscanOutput>()) {
-                // success
-                ptrFrameBuf->getMeta<clusteringDBscanOutput>(input);
-            }
-            else {
-                // previous node not ever put this type of meta into hvabuf
-                HVA_ERROR("Previous node not ever put this type of trackerInput into hvabuf!");
-            }
+        // upstream radar nodes may run several workers, the tracker only ever sees frames in frameId order
+        auto sequencer = m_sequencers.find(blob->streamId);
+        if (sequencer == m_sequencers.end()) {
+            sequencer = m_sequencers.emplace(blob->streamId, FrameSequencer<hva::hvaBlob_t::Ptr>(m_maxReorderFrames)).first;
+        }
+        std::vector<hva::hvaBlob_t::Ptr> ready;
+        std::vector<hva::hvaBlob_t::Ptr> late;
+        unsigned skipped = sequencer->second.push(blob->frameId, blob, ready, late);
+        if (skipped > 0) {
+            HVA_WARNING("RadarTracking node gave up waiting for %u frames before frameId %u on stream %u", skipped, ready.front()->frameId,
+                        blob->streamId);
+        }
+        for (auto &lateBlob : late) {
+            HVA_WARNING("RadarTracking node received frameId %u on stream %u after it was skipped, sending it untracked", lateBlob->frameId,
+                        lateBlob->streamId);
+            sendUntracked(lateBlob);
+        }
+        for (auto &readyBlob : ready) {
+            track(readyBlob);
+        }
+    }
+}
 
-            // trackerInput input = ptrFrameBuf->get<clusteringDBscanOutput>();
-            // printTrackInput(&input);
-            trackerOutput output;
-            // output.outputInfo.resize(CT_MAX_NUM_TRACKER);
+void RadarTrackingNodeWorker::Impl::track(hva::hvaBlob_t::Ptr blob)
+{
+    hva::hvaVideoFrameWithMetaROIBuf_t::Ptr ptrFrameBuf = std::dynamic_pointer_cast<hva::hvaVideoFrameWithMetaROIBuf_t>(blob->get(0));
+    HVA_ASSERT(ptrFrameBuf);
+    // inherit meta data from previous input field
+    if (!ptrFrameBuf->drop) {
+        RadarConfigParam radarParams;
+        if (ptrFrameBuf->containMeta<RadarConfigParam>()) {
+            // success
+            ptrFrameBuf->getMeta(radarParams);
+        }
+        else {
+            // previous node not ever put this type of meta into hvabuf
+            HVA_ERROR("Previous node not ever put this type of RadarConfigParam into hvabuf!");
+        }
 
-            // float dt =
-            //     (float)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - m_prevTimestamp).count() / 1000.0;
+        if (!m_isTrackerInitialized) {
+            clusterTrackerErrorCode errorCode = tracker.clusterTrackerCreate(&radarParams.m_radar_tracking_config_);
+            if (errorCode != CLUSTERTRACKER_NO_ERROR) {
+                HVA_ERROR("Create clusterTracker Instance Failed!");
+            }
+            m_isTrackerInitialized = true;
+            m_prevTimestamp = std::chrono::high_resolution_clock::now();
+        }
 
-            // m_prevTimestamp = std::chrono::high_resolution_clock::now();
-            float dt = (float)1000/radarParams.m_radar_tracking_config_.timePerFrame/1000;  //ms
+        trackerInput::Ptr input;
+        if (ptrFrameBuf->containMeta<clusteringDBscanOutput::Ptr>()) {
+            // success
+            ptrFrameBuf->getMeta<clusteringDBscanOutput::Ptr>(input);
+        }
+        else {
+            // previous node not ever put this type of meta into hvabuf
+            HVA_ERROR("Previous node not ever put this type of trackerInput into hvabuf!");
+        }
 
-            if (tracker.clusterTrackerRun(&input, dt, &output) != CLUSTERTRACKER_NO_ERROR)
-            {
-                HVA_ERROR("clusterTrackerRun Failed!");
-            }
+        // trackerInput input = ptrFrameBuf->get<clusteringDBscanOutput>();
+        // printTrackInput(&input);
+        trackerOutput::Ptr output = m_metaArena->acquireTracks();
+        // output.outputInfo.resize(CT_MAX_NUM_TRACKER);
 
-            // printTrackerOutput(&output);
-
-            ptrFrameBuf->setMeta<trackerOutput>(output);
-
-            HVA_DEBUG("RadarTracking node sending blob with frameid %u and streamid %u, tag %d", blob->frameId, blob->streamId, ptrFrameBuf->getTag());
-            m_ctx.sendOutput(blob, 0, std::chrono::milliseconds(0));
-            std::shared_ptr<hva::timeStampInfo> RadarTrackingOut =
-            std::make_shared<hva::timeStampInfo>(blob->frameId, "RadarTrackingOut");
-            m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &RadarTrackingOut);
-            HVA_DEBUG("RadarTracking node sent blob with frameid %u and streamid %u", blob->frameId, blob->streamId);
-
-            //no tracking
-            // if (input.numCluster > 0)
-            // {
-            //     output.outputInfo.resize(1);
-            //     output.outputInfo[0].state = 0;
-            //     output.outputInfo[0].trackerID = 0;
-            //     output.outputInfo[0].xSize = input.report[0].xSize;
-            //     output.outputInfo[0].ySize = input.report[0].ySize;
-            //     output.outputInfo[0].S_hat[0] = input.report[0].xCenter;
-            //     output.outputInfo[0].S_hat[1] = input.report[0].yCenter;
-            //     float azimuth = (float)(atan(output.outputInfo[0].S_hat[1] / output.outputInfo[0].S_hat[0]));
-            //     output.outputInfo[0].S_hat[2] = input.report[0].avgVel * cos(azimuth);
-            //     output.outputInfo[0].S_hat[3] = input.report[0].avgVel * sin(azimuth);
-
-            //     printTrackerOutput(&output);
-
-            //     ptrFrameBuf->setMeta<trackerOutput>(output);
-
-            //     HVA_DEBUG("RadarTracking node sending blob with frameid %u and streamid %u, tag %d", blob->frameId, blob->streamId, ptrFrameBuf->getTag());
-            //     m_ctx.sendOutput(blob, 0, std::chrono::milliseconds(0));
-            //     HVA_DEBUG("RadarTracking node sent blob with frameid %u and streamid %u", blob->frameId, blob->streamId);
-            // }
-            // else
-            // {
-            //     trackerOutput output;
-            //     ptrFrameBuf->setMeta<trackerOutput>(output);
-
-            //     HVA_DEBUG("RadarTracking node sending blob with frameid %u and streamid %u, tag %d, drop is true", blob->frameId, blob->streamId,
-            //               ptrFrameBuf->getTag());
-            //     m_ctx.sendOutput(blob, 0, std::chrono::milliseconds(0));
-            //     HVA_DEBUG("RadarTracking node sent blob with frameid %u and streamid %u", blob->frameId, blob->streamId);
-            // }
+        // float dt =
+        //     (float)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - m_prevTimestamp).count() / 1000.0;
 
+        // m_prevTimestamp = std::chrono::high_resolution_clock::now();
+        float dt = (float)1000/radarParams.m_radar_tracking_config_.timePerFrame/1000;  //ms
 
+        if (!input) {
+            input = m_metaArena->acquireClusters();
         }
-        else {
-            trackerOutput output;
-            ptrFrameBuf->setMeta<trackerOutput>(output);
-
-            HVA_DEBUG("RadarTracking node sending blob with frameid %u and streamid %u, tag %d, drop is true", blob->frameId, blob->streamId,
-                      ptrFrameBuf->getTag());
-            m_ctx.sendOutput(blob, 0, std::chrono::milliseconds(0));
-            std::shared_ptr<hva::timeStampInfo> RadarTrackingOut =
-            std::make_shared<hva::timeStampInfo>(blob->frameId, "RadarTrackingOut");
-            m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &RadarTrackingOut);
-            HVA_DEBUG("RadarTracking node sent blob with frameid %u and streamid %u", blob->frameId, blob->streamId);
+        if (tracker.clusterTrackerRun(input.get(), dt, output.get()) != CLUSTERTRACKER_NO_ERROR)
+        {
+            HVA_ERROR("clusterTrackerRun Failed!");
         }
+
+        // printTrackerOutput(output.get());
+
+        ptrFrameBuf->setMeta<trackerOutput::Ptr>(output);
+
+        HVA_DEBUG("RadarTracking node sending blob with frameid %u and streamid %u, tag %d", blob->frameId, blob->streamId, ptrFrameBuf->getTag());
+        m_ctx.sendOutput(blob, 0, std::chrono::milliseconds(0));
+        std::shared_ptr<hva::timeStampInfo> RadarTrackingOut =
+        std::make_shared<hva::timeStampInfo>(blob->frameId, "RadarTrackingOut");
+        m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &RadarTrackingOut);
+        HVA_DEBUG("RadarTracking node sent blob with frameid %u and streamid %u", blob->frameId, blob->streamId);
+
+        //no tracking
+        // if (input.numCluster > 0)
+        // {
+        //     output.outputInfo.resize(1);
+        //     output.outputInfo[0].state = 0;
+        //     output.outputInfo[0].trackerID = 0;
+        //     output.outputInfo[0].xSize = input.report[0].xSize;
+        //     output.outputInfo[0].ySize = input.report[0].ySize;
+        //     output.outputInfo[0].S_hat[0] = input.report[0].xCenter;
+        //     output.outputInfo[0].S_hat[1] = input.report[0].yCenter;
+        //     float azimuth = (float)(atan(output.outputInfo[0].S_hat[1] / output.outputInfo[0].S_hat[0]));
+        //     output.outputInfo[0].S_hat[2] = input.report[0].avgVel * cos(azimuth);
+        //     output.outputInfo[0].S_hat[3] = input.report[0].avgVel * sin(azimuth);
+
+        //     printTrackerOutput(&output);
+
+        //     ptrFrameBuf->setMeta<trackerOutput>(output);
+
+        //     HVA_DEBUG("RadarTracking node sending blob with frameid %u and streamid %u, tag %d", blob->frameId, blob->streamId, ptrFrameBuf->getTag());
+        //     m_ctx.sendOutput(blob, 0, std::chrono::milliseconds(0));
+        //     HVA_DEBUG("RadarTracking node sent blob with frameid %u and streamid %u", blob->frameId, blob->streamId);
+        // }
+        // else
+        // {
+        //     trackerOutput output;
+        //     ptrFrameBuf->setMeta<trackerOutput>(output);
+
+        //     HVA_DEBUG("RadarTracking node sending blob with frameid %u and streamid %u, tag %d, drop is true", blob->frameId, blob->streamId,
+        //               ptrFrameBuf->getTag());
+        //     m_ctx.sendOutput(blob, 0, std::chrono::milliseconds(0));
+        //     HVA_DEBUG("RadarTracking node sent blob with frameid %u and streamid %u", blob->frameId, blob->streamId);
+        // }
+
+
+    }
+    else {
+        sendUntracked(blob);
     }
 }
 
+void RadarTrackingNodeWorker::Impl::sendUntracked(hva::hvaBlob_t::Ptr blob)
+{
+    hva::hvaVideoFrameWithMetaROIBuf_t::Ptr ptrFrameBuf = std::dynamic_pointer_cast<hva::hvaVideoFrameWithMetaROIBuf_t>(blob->get(0));
+    HVA_ASSERT(ptrFrameBuf);
+    ptrFrameBuf->setMeta<trackerOutput::Ptr>(m_metaArena->acquireTracks());
+
+    HVA_DEBUG("RadarTracking node sending blob with frameid %u and streamid %u, tag %d, untracked", blob->frameId, blob->streamId,
+              ptrFrameBuf->getTag());
+    m_ctx.sendOutput(blob, 0, std::chrono::milliseconds(0));
+    std::shared_ptr<hva::timeStampInfo> RadarTrackingOut =
+    std::make_shared<hva::timeStampInfo>(blob->frameId, "RadarTrackingOut");
+    m_ctx.getParentPtr()->emitEvent(hvaEvent_PipelineTimeStampRecord, &RadarTrackingOut);
+    HVA_DEBUG("RadarTracking node sent blob with frameid %u and streamid %u", blob->frameId, blob->streamId);
+}
+
 
 hva::hvaStatus_t RadarTrackingNodeWorker::Impl::rearm()
 {
@@ -394,11 +476,29 @@ hva::hvaStatus_t RadarTrackingNodeWorker::Impl::rearm()
 
 hva::hvaStatus_t RadarTrackingNodeWorker::Impl::reset()
 {
+    flush();
     return hva::hvaSuccess;
 }
 
+void RadarTrackingNodeWorker::Impl::flush()
+{
+    for (auto &sequencer : m_sequencers) {
+        std::vector<hva::hvaBlob_t::Ptr> ready;
+        sequencer.second.flush(ready);
+        if (!ready.empty()) {
+            HVA_DEBUG("RadarTracking node flushing %zu held frames of stream %u", ready.size(), sequencer.first);
+        }
+        for (auto &readyBlob : ready) {
+            track(readyBlob);
+        }
+    }
+    m_sequencers.clear();
+}
+
 
-RadarTrackingNodeWorker::RadarTrackingNodeWorker(hva::hvaNode_t *parentNode) : hva::hvaNodeWorker_t(parentNode), m_impl(new Impl(*this)) {}
+RadarTrackingNodeWorker::RadarTrackingNodeWorker(hva::hvaNode_t *parentNode, size_t maxReorderFrames)
+    : hva::hvaNodeWorker_t(parentNode), m_impl(new Impl(*this, maxReorderFrames))
+{}
 
 RadarTrackingNodeWorker::~RadarTrackingNodeWorker() {}
 
@@ -412,6 +512,16 @@ void RadarTrackingNodeWorker::process(std::size_t batchIdx)
     return m_impl->process(batchIdx);
 }
 
+void RadarTrackingNodeWorker::processByLastRun(std::size_t batchIdx)
+{
+    m_impl->flush();
+}
+
+hva::hvaStatus_t RadarTrackingNodeWorker::reset()
+{
+    return m_impl->reset();
+}
+
 #ifdef HVA_NODE_COMPILE_TO_DYNAMIC_LIBRARY
 HVA_ENABLE_DYNAMIC_LOADING(RadarTrackingNode, RadarTrackingNode(threadNum))
 #endif  // #ifdef HVA_NODE_COMPILE_TO_DYNAMIC_LIBRARY
@@ -16,11 +16,10 @@
 
 #include "nodes/CPU-backend/Track2TrackAssociationNode.hpp"
 
-#include <cmath>
 #include <opencv2/opencv.hpp>
 
 #include "inc/buffer/hvaVideoFrameWithMetaROIBuf.hpp"
-#include "modules/vas/components/ot/mtt/hungarian_wrap.h"
+#include "modules/inference_util/fusion/track_association_helper.hpp"
 #include "nodes/databaseMeta.hpp"
 #include "nodes/radarDatabaseMeta.hpp"
 
@@ -69,9 +68,13 @@ class Track2TrackAssociationNode::Impl {
   private:
     Track2TrackAssociationNode &m_ctx;
     hva::hvaConfigStringParser_t m_configParser;
+
+    float m_costThreshold;  // radar / camera pairs at or above this 1 - CIoU are never associated
+    bool m_trackMode;       // keep the radar / camera track pairs across frames
 };
 
-Track2TrackAssociationNode::Impl::Impl(Track2TrackAssociationNode &ctx) : m_ctx(ctx)
+Track2TrackAssociationNode::Impl::Impl(Track2TrackAssociationNode &ctx)
+    : m_ctx(ctx), m_costThreshold(T2T_ASSOCIATION_COST_THRESHOLD), m_trackMode(false)
 {
     m_configParser.reset();
 }
@@ -84,6 +87,37 @@ Track2TrackAssociationNode::Impl::~Impl() {}
  */
 hva::hvaStatus_t Track2TrackAssociationNode::Impl::configureByString(const std::string &config)
 {
+    if (!config.empty()) {
+        if (!m_configParser.parse(config)) {
+            HVA_ERROR("Illegal parse string!");
+            return hva::hvaFailure;
+        }
+        float costThreshold = T2T_ASSOCIATION_COST_THRESHOLD;
+        m_configParser.getVal<float>("AssociationCostThreshold", costThreshold);
+        if (costThreshold <= 0.0f) {
+            HVA_ERROR("AssociationCostThreshold must be positive, receiving %f", costThreshold);
+            return hva::hvaFailure;
+        }
+        m_costThreshold = costThreshold;
+
+        // "frame": associate every frame anew, "track": keep the track pairs of the previous frame while they hold
+        std::string associationMode = "frame";
+        m_configParser.getVal<std::string>("AssociationMode", associationMode);
+        if ("frame" == associationMode) {
+            m_trackMode = false;
+        }
+        else if ("track" == associationMode) {
+            m_trackMode = true;
+        }
+        else {
+            HVA_ERROR("Unknown AssociationMode %s, should be frame or track", associationMode.c_str());
+            return hva::hvaFailure;
+        }
+        if (m_trackMode && m_ctx.getTotalThreadNum() > 1) {
+            HVA_WARNING("Track2TrackAssociation node keeps the track pairs per worker, the frames are split among %d workers!", m_ctx.getTotalThreadNum());
+        }
+    }
+
     // m_ctx.transitStateTo(hva::hvaState_t::configured);
     return hva::hvaSuccess;
 }
@@ -95,7 +129,7 @@ hva::hvaStatus_t Track2TrackAssociationNode::Impl::validateConfiguration() const
 
 std::shared_ptr<hva::hvaNodeWorker_t> Track2TrackAssociationNode::Impl::createNodeWorker(Track2TrackAssociationNode *parent) const
 {
-    return std::shared_ptr<hva::hvaNodeWorker_t>{new Track2TrackAssociationNodeWorker{parent}};
+    return std::shared_ptr<hva::hvaNodeWorker_t>{new Track2TrackAssociationNodeWorker{parent, m_costThreshold, m_trackMode}};
 }
 
 hva::hvaStatus_t Track2TrackAssociationNode::Impl::prepare()
@@ -123,6 +157,16 @@ Track2TrackAssociationNode::Track2TrackAssociationNode(std::size_t totalThreadNu
 
 Track2TrackAssociationNode::~Track2TrackAssociationNode() {}
 
+hva::hvaStatus_t Track2TrackAssociationNode::configureByString(const std::string &config)
+{
+    return m_impl->configureByString(config);
+}
+
+hva::hvaStatus_t Track2TrackAssociationNode::validateConfiguration() const
+{
+    return m_impl->validateConfiguration();
+}
+
 /**
  * @brief Constructs and returns a node worker instance:
  * Track2TrackAssociationNodeWorker.
@@ -150,7 +194,7 @@ hva::hvaStatus_t Track2TrackAssociationNode::prepare()
 
 class Track2TrackAssociationNodeWorker::Impl {
   public:
-    Impl(Track2TrackAssociationNodeWorker &ctx);
+    Impl(Track2TrackAssociationNodeWorker &ctx, float costThreshold, bool trackMode);
 
     ~Impl();
 
@@ -170,16 +214,18 @@ class Track2TrackAssociationNodeWorker::Impl {
   private:
     Track2TrackAssociationNodeWorker &m_ctx;
 
-    static float normalizedCenterDistance(const cv::Rect2f &r1, const cv::Rect2f &r2);
-
-    static float normalizedShapeDistance(const cv::Rect2f &r1, const cv::Rect2f &r2);
-
-    static float computeIoU(const cv::Rect2f &r1, const cv::Rect2f &r2);
-
-    static float computeDifferentIoU(const cv::Rect2f &r1, const cv::Rect2f &r2, bool GIou = false, bool DIoU = false, bool CIoU = false, bool EIoU = false);
+    Track2TrackAssociator m_associator;
+    bool m_trackMode;
+    std::vector<cv::Rect2f> m_cameraDetections;
+    std::vector<cv::Rect2f> m_radarDetections;
+    std::vector<uint64_t> m_cameraIds;  // cameraTrackKey() of every camera detection, track mode only
+    std::vector<int32_t> m_radarIds;    // tracker id of every radar detection, track mode only
+    std::vector<AssociationPair> m_pairs;
 };
 
-Track2TrackAssociationNodeWorker::Impl::Impl(Track2TrackAssociationNodeWorker &ctx) : m_ctx(ctx) {}
+Track2TrackAssociationNodeWorker::Impl::Impl(Track2TrackAssociationNodeWorker &ctx, float costThreshold, bool trackMode)
+    : m_ctx(ctx), m_associator(costThreshold), m_trackMode(trackMode)
+{}
 
 Track2TrackAssociationNodeWorker::Impl::~Impl() {}
 
@@ -195,6 +241,7 @@ hva::hvaStatus_t Track2TrackAssociationNodeWorker::Impl::rearm()
 
 hva::hvaStatus_t Track2TrackAssociationNodeWorker::Impl::reset()
 {
+    m_associator.resetTracks();
     return hva::hvaSuccess;
 }
 
@@ -223,9 +270,9 @@ void Track2TrackAssociationNodeWorker::Impl::process(std::size_t batchIdx)
 
         m_ctx.getLatencyMonitor().startRecording(blob->frameId, "Track2Track");
 
-        // inherit meta data from previous input field
-        FusionOutput fusionOutput;
-        if (ptrFrameBuf->containMeta<FusionOutput>()) {
+        // inherit meta data from previous input field, the association is added to it in place
+        FusionOutput::Ptr fusionOutput;
+        if (ptrFrameBuf->containMeta<FusionOutput::Ptr>()) {
             // success
             ptrFrameBuf->getMeta(fusionOutput);
         }
@@ -235,7 +282,7 @@ void Track2TrackAssociationNodeWorker::Impl::process(std::size_t batchIdx)
                       "coordinateTransformationOutput into hvabuf!");
         }
 
-        if (0 == fusionOutput.m_radarOutput.size()) {
+        if (!fusionOutput || 0 == fusionOutput->m_radarOutput.size()) {
             HVA_DEBUG("Track-to-Track Association sending blob with frameid %u and streamid %u", blob->frameId, blob->streamId);
             m_ctx.sendOutput(blob, 0, std::chrono::milliseconds(0));
             // auto now = std::chrono::high_resolution_clock::now();
@@ -251,48 +298,53 @@ void Track2TrackAssociationNodeWorker::Impl::process(std::size_t batchIdx)
             return;
         }
 
-        int32_t nRadarDetections = static_cast<int32_t>(fusionOutput.m_radarOutput.size());
-        int32_t nCameraDetections = static_cast<int32_t>(fusionOutput.m_cameraFusionRadarCoords.size());
+        int32_t nRadarDetections = static_cast<int32_t>(fusionOutput->m_radarOutput.size());
+        int32_t nCameraDetections = static_cast<int32_t>(fusionOutput->m_cameraFusionRadarCoords.size());
 
-        std::vector<cv::Rect2f> cameraDetections;
-        std::vector<cv::Rect2f> radarDetections;
+        m_cameraDetections.clear();
+        m_radarDetections.clear();
         for (int32_t c = 0; c < nCameraDetections; ++c) {
-            cameraDetections.push_back(cv::Rect2f(fusionOutput.m_cameraFusionRadarCoords[c].bbox.x, fusionOutput.m_cameraFusionRadarCoords[c].bbox.y,
-                                                  fusionOutput.m_cameraFusionRadarCoords[c].bbox.width, fusionOutput.m_cameraFusionRadarCoords[c].bbox.height));
+            const BBox &bbox = fusionOutput->m_cameraFusionRadarCoords[c].bbox;
+            m_cameraDetections.push_back(cv::Rect2f(bbox.x, bbox.y, bbox.width, bbox.height));
         }
         for (int32_t r = 0; r < nRadarDetections; ++r) {
-            radarDetections.push_back(cv::Rect2f(fusionOutput.m_radarOutput[r].S_hat[0], fusionOutput.m_radarOutput[r].S_hat[1], 4.2, 1.7));
+            m_radarDetections.push_back(cv::Rect2f(fusionOutput->m_radarOutput[r].S_hat[0], fusionOutput->m_radarOutput[r].S_hat[1], 4.2, 1.7));
         }
-        cv::Mat_<float> r2c_cost_table;
-        r2c_cost_table.create(nRadarDetections, nCameraDetections + nRadarDetections);
-        r2c_cost_table = 2.0f;
-        for (int32_t r = 0; r < nRadarDetections; ++r) {
+
+        // pairs come sorted by radar index
+        if (m_trackMode) {
+            m_cameraIds.clear();
+            m_radarIds.clear();
             for (int32_t c = 0; c < nCameraDetections; ++c) {
-                r2c_cost_table(r, c) = 1.0 - computeDifferentIoU(radarDetections[r], cameraDetections[c], false, false, true, false);
+                const DetectedObject &det = fusionOutput->m_cameraFusionRadarCoords[c];
+                m_cameraIds.push_back(cameraTrackKey(det.cameraId, det.trackingId));
+            }
+            for (int32_t r = 0; r < nRadarDetections; ++r) {
+                m_radarIds.push_back(fusionOutput->m_radarOutput[r].trackerID);
             }
+            m_associator.associateTracks(m_radarDetections, m_radarIds, m_cameraDetections, m_cameraIds, m_pairs);
+            HVA_DEBUG("Track-to-Track Association kept %zu of %zu pairs from the previous frame", m_associator.getKeptPairs(), m_pairs.size());
+        }
+        else {
+            m_associator.associate(m_radarDetections, m_cameraDetections, m_pairs);
         }
 
-        vas::ot::HungarianAlgo hungarian(r2c_cost_table);
-        cv::Mat_<uint8_t> r2c_assign_table = hungarian.Solve();
-
+        size_t pairIdx = 0;
         for (int32_t r = 0; r < nRadarDetections; ++r) {
-            bool isAssociated = false;
             FusionBBox fusionBBox;
-            fusionBBox.radarOutput = fusionOutput.m_radarOutput[r];
-            for (int32_t c = 0; c < nCameraDetections; ++c) {
-                if (r2c_assign_table(r, c) && r2c_cost_table(r, c) < 1.60) {
-                    fusionBBox.det = fusionOutput.m_cameraFusionRadarCoords[c];
-                    fusionOutput.m_cameraFusionRadarCoordsIsAssociated[c] = 1;
-                    isAssociated = true;
-                    break;
-                }
+            fusionBBox.radarOutput = fusionOutput->m_radarOutput[r];
+            if (pairIdx < m_pairs.size() && m_pairs[pairIdx].radarIdx == r) {
+                int32_t c = m_pairs[pairIdx].cameraIdx;
+                fusionBBox.det = fusionOutput->m_cameraFusionRadarCoords[c];
+                fusionBBox.associationConfidence = m_pairs[pairIdx].confidence;
+                fusionOutput->m_cameraFusionRadarCoordsIsAssociated.set(c);
+                pairIdx++;
             }
-            if (!isAssociated) {
+            else {
                 fusionBBox.det = DetectedObject(BBox(), 0.0f, "dummy");
             }
-            fusionOutput.addRadarFusionBBox(fusionBBox);
+            fusionOutput->addRadarFusionBBox(fusionBBox);
         }
-        ptrFrameBuf->setMeta<FusionOutput>(fusionOutput);
         HVA_DEBUG("Track-to-Track Association sending blob with frameid %u and streamid %u", blob->frameId, blob->streamId);
         m_ctx.getLatencyMonitor().stopRecording(blob->frameId, "Track2Track");
         m_ctx.sendOutput(blob, 0, std::chrono::milliseconds(0));
@@ -309,90 +361,9 @@ void Track2TrackAssociationNodeWorker::Impl::process(std::size_t batchIdx)
     }
 }
 
-float Track2TrackAssociationNodeWorker::Impl::normalizedCenterDistance(const cv::Rect2f &r1, const cv::Rect2f &r2)
-{
-    float normalizer = std::min(0.5f * (r1.width + r1.height), 0.5f * (r2.width + r2.height));
-
-    float r1x = r1.x + 0.5f * r1.width;
-    float r1y = r1.y + 0.5f * r1.height;
-    float r2x = r2.x + 0.5f * r2.width;
-    float r2y = r2.y + 0.5f * r2.height;
-    float dx = (r2x - r1x) / normalizer;
-    float dy = (r2y - r1y) / normalizer;
-    return std::sqrt(dx * dx + dy * dy);
-}
-
-float Track2TrackAssociationNodeWorker::Impl::normalizedShapeDistance(const cv::Rect2f &r1, const cv::Rect2f &r2)
-{
-    int32_t normalize_w = r1.width;
-    int32_t normalize_h = r1.height;
-
-    if (r2.width + r2.height < r1.width + r1.height) {
-        normalize_w = r2.width;
-        normalize_h = r2.height;
-    }
-
-    float dw = (r2.width - r1.width) / normalize_w;
-    float dh = (r2.height - r1.height) / normalize_h;
-    return std::sqrt(dw * dw + dh * dh);
-}
-
-float Track2TrackAssociationNodeWorker::Impl::computeIoU(const cv::Rect2f &r1, const cv::Rect2f &r2)
-{
-    cv::Rect2f a = r1 | r2;
-    cv::Rect2f u = r1 & r2;
-
-    return u.area() * 1.0 / a.area();
-}
-
-float Track2TrackAssociationNodeWorker::Impl::computeDifferentIoU(const cv::Rect2f &r1, const cv::Rect2f &r2, bool GIou, bool DIoU, bool CIoU, bool EIoU)
-{
-    cv::Rect2f unionBox = r1 | r2;
-    cv::Rect2f interBox = r1 & r2;
-    float eps = 1e-9;
-    float interArea = interBox.area();
-    float unionArea = unionBox.area();
-    float iou = interArea * 1.0 / (unionArea + eps);
-
-    if (GIou || DIoU || CIoU || EIoU) {
-        if (CIoU || DIoU || EIoU) {
-            // Calculate the diagonal length of the smallest bounding rectangle of two
-            // BOX
-            float c2 = std::pow(unionBox.width, 2) + std::pow(unionBox.height, 2) + eps;
-            // Calculate the center point distance, the center point coordinates:
-            // x+width/2, y+height/2, as the Euclidean distance, get the square value
-            // centerDist
-            float centerDist = std::pow(r1.x + r1.width / 2.0 - r2.x - r2.width / 2.0, 2) + std::pow(r1.y + r1.height / 2.0 - r2.y - r2.height / 2.0, 2);
-            if (DIoU) {
-                return iou - centerDist / 2;
-            }
-            else if (CIoU) {
-                // DIoU only considers the coverage area and center point distance,
-                // so CIOU adds the factor of aspect ratio to DIoU
-                float v = (4 / std::pow(M_PI, 2)) * std::pow(std::atan(r1.width / r1.height) - std::atan(r2.width / r2.height), 2);
-                float alpha = v / (1 - iou + v + eps);
-                return iou - (centerDist / c2 + v * alpha);
-            }
-            else {
-                // EIoU
-                float wDist = std::pow(r1.width - r2.width, 2);
-                float hDist = std::pow(r1.height - r2.height, 2);
-                float cw2 = std::pow(unionBox.width, 2) + eps;
-                float ch2 = std::pow(unionBox.height, 2) + eps;
-                return iou - (centerDist / c2 + wDist / cw2 + hDist / ch2);
-            }
-        }
-        else {
-            // GIoU
-            return iou - (interArea - unionArea) / interArea;
-        }
-    }
-    else {
-        return iou;
-    }
-}
-
-Track2TrackAssociationNodeWorker::Track2TrackAssociationNodeWorker(hva::hvaNode_t *parentNode) : hva::hvaNodeWorker_t(parentNode), m_impl(new Impl(*this)) {}
+Track2TrackAssociationNodeWorker::Track2TrackAssociationNodeWorker(hva::hvaNode_t *parentNode, float costThreshold, bool trackMode)
+    : hva::hvaNodeWorker_t(parentNode), m_impl(new Impl(*this, costThreshold, trackMode))
+{}
 
 Track2TrackAssociationNodeWorker::~Track2TrackAssociationNodeWorker() {}
 
@@ -0,0 +1,181 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and your use of
+ * them is governed by the express license under which they were provided to you (License).
+ * Unless the License provides otherwise, you may not use, modify, copy, publish, distribute,
+ * disclose or transmit this software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express or implied warranties,
+ * other than those that are expressly stated in the License.
+ */
+
+/**
+ * unit test of the anchor_transform decoding, checked with a per-cell scalar reference
+ *
+ * The reference walks every anchor and cell and decodes them with std::exp, as the processor did before the candidate
+ * pass. Random blobs are decoded for both layouts, with and without sigmoid, exp and square transforms, with and
+ * without objectness; the detections must come out in the same order, with values agreeing to float rounding.
+ */
+
+#include "modules/inference_util/detection/detection_post_processor.hpp"
+#include "utils/testCheck.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace hce::ai::inference;
+
+struct AnchorCase {
+    DetOutputDimsLayout_t layout;
+    bool sigmoid;
+    bool exponential;  // pred_bbox_wh transform, exp or square
+    bool objectness;
+};
+
+static const size_t kNumClasses = 7;
+static const size_t kBoxSize = 5 + kNumClasses;
+static const size_t kFeatureW = 13;
+static const size_t kFeatureH = 11;
+static const std::vector<float> kAnchors = {10, 13, 16, 30, 33, 23};
+static const float kConfThresh = 0.3f;
+
+static DetectionModelOutput_t makeConfig(const AnchorCase &c)
+{
+    DetectionModelOutput_t cfg;
+    cfg.layout = c.layout;
+    cfg.num_classes = kNumClasses;
+    cfg.conf_thresh = kConfThresh;
+    cfg.detection_output.size = kBoxSize;
+    cfg.detection_output.location_index = {0, 1, 2, 3};
+    cfg.detection_output.confidence_index = c.objectness ? 4 : -1;
+    cfg.detection_output.first_class_prob_index = 5;
+    cfg.detection_output.bbox_format = DetBBoxFormat_t::CENTER_SIZE;
+    return cfg;
+}
+
+static nlohmann::json makeParams(const AnchorCase &c)
+{
+    nlohmann::json params;
+    params["anchors"] = kAnchors;
+    params["out_feature"] = {kFeatureW, kFeatureH};
+    params["output_sigmoid_activation"] = c.sigmoid;
+    params["bbox_prediction"]["pred_bbox_xy"] = {{"factor", 2.0}, {"grid_offset", -0.5}};
+    params["bbox_prediction"]["pred_bbox_wh"] = {
+        {"factor", 2.0}, {"transform", c.exponential ? "exp" : "square"}, {"scale_w", 640}, {"scale_h", 640}};
+    return params;
+}
+
+/**
+ * @brief per-cell decoding of one blob, in anchor, cell x, cell y order
+ */
+static std::vector<std::vector<float>> referenceDecode(const AnchorCase &c, const std::vector<float> &blob)
+{
+    const size_t numAnchors = kAnchors.size() / 2;
+    const size_t featureSize = kFeatureW * kFeatureH;
+    auto index = [&](size_t field, size_t anchor, size_t x, size_t y) {
+        if (c.layout == DetOutputDimsLayout_t::BCxCy) {
+            return field * featureSize + anchor * kBoxSize * featureSize + y * kFeatureW + x;
+        }
+        return (y * kFeatureW + x) * numAnchors * kBoxSize + anchor * kBoxSize + field;
+    };
+    auto trySigmoid = [&](float x) { return c.sigmoid ? 1 / (1 + std::exp(-x)) : x; };
+    auto tryTransform = [&](float x) { return c.exponential ? std::exp(x) : std::pow(x, 2); };
+
+    std::vector<std::vector<float>> boxes;
+    for (size_t anchor = 0; anchor < numAnchors; anchor++) {
+        for (size_t x = 0; x < kFeatureW; x++) {
+            for (size_t y = 0; y < kFeatureH; y++) {
+                float confidence = 1.0f;
+                if (c.objectness) {
+                    confidence = trySigmoid(blob[index(4, anchor, x, y)]);
+                    if (confidence < kConfThresh) {
+                        continue;
+                    }
+                }
+                float maxClassProb = blob[index(5, anchor, x, y)];
+                for (size_t cls = 1; cls < kNumClasses; cls++) {
+                    maxClassProb = std::max(maxClassProb, blob[index(5 + cls, anchor, x, y)]);
+                }
+                confidence = confidence * trySigmoid(maxClassProb);
+                if (confidence < kConfThresh) {
+                    continue;
+                }
+
+                const float xCenter = (x + trySigmoid(blob[index(0, anchor, x, y)]) * 2.0f - 0.5f) / kFeatureW;
+                const float yCenter = (y + trySigmoid(blob[index(1, anchor, x, y)]) * 2.0f - 0.5f) / kFeatureH;
+                const float w = (tryTransform(trySigmoid(blob[index(2, anchor, x, y)]) * 2.0f) * kAnchors[anchor * 2]) / 640;
+                const float h = (tryTransform(trySigmoid(blob[index(3, anchor, x, y)]) * 2.0f) * kAnchors[anchor * 2 + 1]) / 640;
+
+                std::vector<float> box(kBoxSize);
+                box[0] = xCenter - w / 2;
+                box[1] = yCenter - h / 2;
+                box[2] = w;
+                box[3] = h;
+                for (size_t field = 4; field < kBoxSize; field++) {
+                    box[field] = trySigmoid(blob[index(field, anchor, x, y)]);
+                }
+                boxes.push_back(box);
+            }
+        }
+    }
+    return boxes;
+}
+
+/**
+ * @brief decode one random blob with both implementations
+ */
+static void checkDecode(TestReport &report, const AnchorCase &c, uint32_t seed)
+{
+    // raw logits around the threshold with sigmoid, probabilities and small offsets without
+    std::mt19937 rng(seed);
+    const float mean = c.sigmoid ? -2.0f : 0.2f;
+    const float spread = c.sigmoid ? 4.0f : 0.6f;
+    std::vector<float> blob(kAnchors.size() / 2 * kFeatureW * kFeatureH * kBoxSize);
+    for (float &v : blob) {
+        v = mean + spread * ((rng() >> 8) * (1.0f / 16777216.0f) - 0.5f) * 2.0f;
+    }
+
+    const std::vector<std::vector<float>> expected = referenceDecode(c, blob);
+
+    AnchorTransformProcessor processor(makeConfig(c), makeParams(c));
+    std::vector<float *> actual = {blob.data()};
+    processor.process(actual);
+
+    const std::string name = std::string(c.layout == DetOutputDimsLayout_t::BCxCy ? "BCxCy" : "CxCyB") +
+                             (c.sigmoid ? ", sigmoid" : ", no sigmoid") + (c.exponential ? ", exp" : ", square") +
+                             (c.objectness ? ", objectness" : ", no objectness");
+    TEST_CHECK(report, !expected.empty(), name << ": no detection, the case checks nothing");
+    if (!report.check(actual.size() == expected.size())) {
+        std::cerr << name << ": expected " << expected.size() << " detections, got " << actual.size() << std::endl;
+        return;
+    }
+    for (size_t i = 0; i < expected.size(); i++) {
+        for (size_t field = 0; field < kBoxSize; field++) {
+            const float e = expected[i][field];
+            const float a = actual[i][field];
+            TEST_CHECK(report, std::fabs(a - e) <= 1e-5f * std::max(1.0f, std::fabs(e)),
+                       name << ": detection " << i << " field " << field << " expected " << e << ", got " << a);
+        }
+    }
+}
+
+int main()
+{
+    TestReport report("testAnchorDecode");
+    // every combination of layout, sigmoid, bbox_wh transform and objectness, bit i of the case selects option i
+    for (int options = 0; options < 16; options++) {
+        const AnchorCase c = {(options & 1) ? DetOutputDimsLayout_t::CxCyB : DetOutputDimsLayout_t::BCxCy, (options & 2) != 0,
+                              (options & 4) != 0, (options & 8) != 0};
+        for (uint32_t seed = 0; seed < 4; seed++) {
+            checkDecode(report, c, seed);
+        }
+    }
+    return report.result();
+}
@@ -0,0 +1,94 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and your use of
+ * them is governed by the express license under which they were provided to you (License).
+ * Unless the License provides otherwise, you may not use, modify, copy, publish, distribute,
+ * disclose or transmit this software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express or implied warranties,
+ * other than those that are expressly stated in the License.
+ */
+
+/**
+ * checks the image transformation reported for the model_proc resize and padding folded into the model
+ *
+ * With the IE pre-processor the image is resized and padded inside the model, letterbox_transform() reports what was
+ * done to post-processing. The report has to be the one CustomImageConvert() of the OpenCV pre-processor gives for the
+ * same model_proc, so boxes are mapped back the same way whichever pre-processor runs.
+ */
+
+#include "letterbox.h"
+#include "opencv_pre_proc.h"
+#include "utils/testCheck.hpp"
+
+#include <opencv2/core.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace InferenceBackend;
+using namespace hce::ai::inference;
+
+struct Size {
+    size_t width;
+    size_t height;
+};
+
+/**
+ * @brief the reports of both pre-processors for one image, model input and model_proc have to be equal
+ */
+static void checkTransform(TestReport &report, const Size &image, const Size &model, size_t stride_x, size_t stride_y, bool keep_aspect_ratio)
+{
+    auto desc = std::make_shared<InputImageLayerDesc>(
+        keep_aspect_ratio ? InputImageLayerDesc::Resize::ASPECT_RATIO : InputImageLayerDesc::Resize::NO_ASPECT_RATIO,
+        InputImageLayerDesc::Crop::NO, InputImageLayerDesc::ColorSpace::NO, InputImageLayerDesc::RangeNormalization(),
+        InputImageLayerDesc::DistribNormalization(), InputImageLayerDesc::Padding(stride_x, stride_y));
+    auto expected = std::make_shared<ImageTransformationParams>();
+    cv::Mat mat((int)image.height, (int)image.width, CV_8UC3, cv::Scalar(0, 0, 0));
+    CustomImageConvert(mat, FOURCC_BGR, cv::Size((int)model.width, (int)model.height), desc, expected);
+
+    Letterbox lb;
+    lb.enabled = true;
+    lb.keep_aspect_ratio = keep_aspect_ratio;
+    lb.model_w = model.width;
+    lb.model_h = model.height;
+    lb.stride_x = stride_x;
+    lb.stride_y = stride_y;
+    ImageTransformationParams actual;
+    letterbox_transform(lb, image.width, image.height, actual);
+
+    TEST_CHECK(report,
+               expected->WasResize() == actual.WasResize() && expected->resize_scale_x == actual.resize_scale_x &&
+                   expected->resize_scale_y == actual.resize_scale_y && expected->WasPadding() == actual.WasPadding() &&
+                   expected->padding_size_x == actual.padding_size_x && expected->padding_size_y == actual.padding_size_y,
+               image.width << "x" << image.height << " into " << model.width << "x" << model.height << ", stride " << stride_x
+                           << "x" << stride_y << (keep_aspect_ratio ? ", aspect-ratio" : ", no-aspect-ratio")
+                           << ": expected resize " << expected->WasResize() << " " << expected->resize_scale_x << "x"
+                           << expected->resize_scale_y << " padding " << expected->padding_size_x << "x"
+                           << expected->padding_size_y << ", got resize " << actual.WasResize() << " "
+                           << actual.resize_scale_x << "x" << actual.resize_scale_y << " padding "
+                           << actual.padding_size_x << "x" << actual.padding_size_y);
+}
+
+int main()
+{
+    // usual camera frames, ROIs of odd sizes and images already of the model input size
+    const std::vector<Size> images = {{1920, 1080}, {1280, 720}, {640, 480}, {640, 640}, {416, 416}, {300, 300},
+                                      {408, 408},   {97, 211},   {211, 97},  {1, 1},     {2000, 30}};
+    const std::vector<Size> models = {{416, 416}, {640, 384}, {300, 300}, {512, 288}};
+    const std::vector<std::pair<size_t, size_t>> strides = {{0, 0}, {4, 4}, {8, 2}};
+
+    TestReport report("testLetterboxTransform");
+    for (const Size &model : models) {
+        for (const auto &stride : strides) {
+            for (const Size &image : images) {
+                checkTransform(report, image, model, stride.first, stride.second, false);
+                checkTransform(report, image, model, stride.first, stride.second, true);
+            }
+        }
+    }
+    return report.result();
+}
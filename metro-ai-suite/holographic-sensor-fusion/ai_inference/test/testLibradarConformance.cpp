@@ -0,0 +1,465 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and your use of
+ * them is governed by the express license under which they were provided to you (License).
+ * Unless the License provides otherwise, you may not use, modify, copy, publish, distribute,
+ * disclose or transmit this software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express or implied warranties,
+ * other than those that are expressly stated in the License.
+ */
+
+/**
+ * compares two libradar builds, usually the prebuilt libradar.so and the in-tree one, stage by stage
+ *
+ * Both libraries are loaded with dlopen, so that their symbols do not clash, and run on the same recorded radar
+ * frames. Every stage of the candidate gets the input the reference stage got: clustering runs on the reference point
+ * cloud and tracking on the reference clusters, so a difference is reported by the stage that caused it. Points are
+ * matched by range / doppler bin, clusters and tracks by nearest center. The time per stage of both libraries is
+ * reported as well.
+ */
+
+#include <nlohmann/json.hpp>
+#include "libradar.h"
+#include "utils/testCheck.hpp"
+
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace hce::ai::inference;
+
+#define CONFORMANCE_VALUE_TOL (1e-3f)   //!< relative tolerance of range, speed and cluster values
+#define CONFORMANCE_ANGLE_TOL (0.5f)    //!< degrees
+#define CONFORMANCE_SNR_TOL (1e-2f)     //!< relative
+#define CONFORMANCE_CENTER_TOL (0.05f)  //!< meters between matched cluster / track centers
+#define CONFORMANCE_SPEED_TOL (0.05f)   //!< m/s between matched track velocities
+
+struct LibRadar {
+    void *lib = nullptr;
+    RadarErrorCode (*getMemSize)(RadarParam *, ulong *) = nullptr;
+    RadarErrorCode (*initHandle)(RadarHandle **, RadarParam *, void *, ulong) = nullptr;
+    RadarErrorCode (*detection)(RadarHandle *, RadarCube *, RadarPointClouds *) = nullptr;
+    RadarErrorCode (*clustering)(RadarHandle *, RadarPointClouds *, ClusterResult *) = nullptr;
+    RadarErrorCode (*tracking)(RadarHandle *, ClusterResult *, TrackingResult *) = nullptr;
+    RadarErrorCode (*destroyHandle)(RadarHandle *) = nullptr;
+
+    bool load(const std::string &path)
+    {
+        lib = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!lib) {
+            std::cerr << "Failed to load " << path << ": " << dlerror() << std::endl;
+            return false;
+        }
+        getMemSize = (decltype(getMemSize))dlsym(lib, "radarGetMemSize");
+        initHandle = (decltype(initHandle))dlsym(lib, "radarInitHandle");
+        detection = (decltype(detection))dlsym(lib, "radarDetection");
+        clustering = (decltype(clustering))dlsym(lib, "radarClustering");
+        tracking = (decltype(tracking))dlsym(lib, "radarTracking");
+        destroyHandle = (decltype(destroyHandle))dlsym(lib, "radarDestroyHandle");
+        if (!getMemSize || !initHandle || !detection || !clustering || !tracking || !destroyHandle) {
+            std::cerr << path << " does not export the libradar API" << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief one handle of a library, with the time spent per stage
+ */
+struct RadarRunner {
+    LibRadar *api = nullptr;
+    RadarHandle *handle = nullptr;
+    void *buf = nullptr;
+    std::vector<TrackingDescription> td;
+    double detectionMs = 0, clusteringMs = 0, trackingMs = 0;
+
+    bool init(LibRadar *lib, RadarParam param)
+    {
+        api = lib;
+        ulong size = 0;
+        if (api->getMemSize(&param, &size) != R_SUCCESS) {
+            std::cerr << "radarGetMemSize failed" << std::endl;
+            return false;
+        }
+        buf = aligned_alloc(64, (size + 63) & ~(ulong)63);
+        if (api->initHandle(&handle, &param, buf, size) != R_SUCCESS) {
+            std::cerr << "radarInitHandle failed" << std::endl;
+            return false;
+        }
+        td.resize(64);
+        return true;
+    }
+
+    ~RadarRunner()
+    {
+        if (handle) {
+            api->destroyHandle(handle);
+        }
+        free(buf);
+    }
+};
+
+template <typename F>
+static double timeMs(F &&f)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static bool close(float a, float b, float relTol)
+{
+    return std::fabs(a - b) <= relTol * std::max(1.0f, std::max(std::fabs(a), std::fabs(b)));
+}
+
+static bool readRadarParam(const std::string &path, RadarParam &rp)
+{
+    try {
+        std::ifstream configFile(path);
+        nlohmann::json config;
+        configFile >> config;
+        for (auto &items : config.at("RadarBasicConfig")) {
+            rp.rn = items["numRx"].get<int>();
+            rp.tn = items["numTx"].get<int>();
+            rp.startFreq = items["Start_frequency"].get<double>();
+            rp.idle = items["idle"].get<double>();
+            rp.adcStartTime = items["adcStartTime"].get<double>();
+            rp.rampEndTime = items["rampEndTime"].get<double>();
+            rp.freqSlopeConst = items["freqSlopeConst"].get<double>();
+            rp.sn = items["adcSamples"].get<int>();
+            rp.adcSampleRate = items["adcSampleRate"].get<double>();
+            rp.cn = items["numChirps"].get<int>();
+            rp.fps = items["fps"].get<float>();
+        }
+        for (auto &items : config.at("RadarDetectionConfig")) {
+            int aoa = items["AoaEstimationType"].get<int>();
+            // AoaEstimationType counts from 1 in the order FFT, MUSIC, DBF, CAPON, as RadarDoaType does from 0
+            rp.doaType = (aoa >= 1 && aoa <= 4) ? (RadarDoaType)(aoa - 1) : MAXLEN_DOA;
+            rp.dFAR = items["DopplerPfa"].get<float>();
+            rp.dGWL = items["DopplerWinGuardLen"].get<int>();
+            rp.dTWL = items["DopplerWinTrainLen"].get<int>();
+            rp.rFAR = items["RangePfa"].get<float>();
+            rp.rGWL = items["RangeWinGuardLen"].get<int>();
+            rp.rTWL = items["RangeWinTrainLen"].get<int>();
+        }
+        for (auto &items : config.at("RadarClusteringConfig")) {
+            rp.eps = items["eps"].get<float>();
+            rp.weight = items["weight"].get<float>();
+            rp.mpc = items["minPointsInCluster"].get<int>();
+            rp.mc = items["maxClusters"].get<int>();
+            rp.mp = items["maxPoints"].get<int>();
+        }
+        for (auto &items : config.at("RadarTrackingConfig")) {
+            rp.tat = items["trackerAssociationThreshold"].get<float>();
+            rp.mnv = items["measurementNoiseVariance"].get<float>();
+            rp.tpf = items["timePerFrame"].get<float>();
+            rp.iff = items["iirForgetFactor"].get<float>();
+            rp.at = items["trackerActiveThreshold"].get<int>();
+            rp.ft = items["trackerForgetThreshold"].get<int>();
+        }
+    }
+    catch (std::exception const &e) {
+        std::cerr << "Failed to read radar config from " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief raw cn x (tn x rn) x sn frame into the tr x c x s cube with the per-chirp mean removed, as formatRadarCube
+ */
+static void formatCube(const std::vector<cfloat> &frame, RadarCube &rc)
+{
+    const int trn = rc.rn * rc.tn;
+    for (int c = 0; c < rc.cn; ++c) {
+        for (int tr = 0; tr < trn; ++tr) {
+            const cfloat *src = &frame[((size_t)c * trn + tr) * rc.sn];
+            cfloat *dst = rc.mat + ((size_t)tr * rc.cn + c) * rc.sn;
+            float real = 0, imag = 0;
+            for (int s = 0; s < rc.sn; ++s) {
+                real += src[s].real;
+                imag += src[s].imag;
+            }
+            real /= rc.sn;
+            imag /= rc.sn;
+            for (int s = 0; s < rc.sn; ++s) {
+                dst[s].real = src[s].real - real;
+                dst[s].imag = src[s].imag - imag;
+            }
+        }
+    }
+}
+
+/**
+ * @brief number of points of either cloud without a conforming point in the other
+ */
+static int comparePoints(const RadarPointClouds &ref, const RadarPointClouds &cand)
+{
+    auto order = [](const RadarPointClouds &pc) {
+        std::vector<int> idx(pc.len);
+        for (int i = 0; i < pc.len; i++) {
+            idx[i] = i;
+        }
+        std::sort(idx.begin(), idx.end(), [&](int a, int b) {
+            return pc.rangeIdx[a] != pc.rangeIdx[b] ? pc.rangeIdx[a] < pc.rangeIdx[b] : pc.speedIdx[a] < pc.speedIdx[b];
+        });
+        return idx;
+    };
+    std::vector<int> r = order(ref), c = order(cand);
+
+    int matched = 0;
+    size_t i = 0, j = 0;
+    while (i < r.size() && j < c.size()) {
+        int a = r[i], b = c[j];
+        long keyA = (long)ref.rangeIdx[a] << 16 | ref.speedIdx[a];
+        long keyB = (long)cand.rangeIdx[b] << 16 | cand.speedIdx[b];
+        if (keyA < keyB) {
+            i++;
+        }
+        else if (keyB < keyA) {
+            j++;
+        }
+        else {
+            if (close(ref.range[a], cand.range[b], CONFORMANCE_VALUE_TOL) && close(ref.speed[a], cand.speed[b], CONFORMANCE_VALUE_TOL) &&
+                std::fabs(ref.angle[a] - cand.angle[b]) <= CONFORMANCE_ANGLE_TOL && close(ref.snr[a], cand.snr[b], CONFORMANCE_SNR_TOL)) {
+                matched++;
+            }
+            i++;
+            j++;
+        }
+    }
+    return ref.len + cand.len - 2 * matched;
+}
+
+/**
+ * @brief number of entries of either list without a conforming entry in the other, matched greedily by nearest center
+ */
+template <typename T, typename Center, typename Same>
+static int compareByCenter(const T *ref, int refLen, const T *cand, int candLen, Center center, Same same)
+{
+    std::vector<char> taken(candLen, 0);
+    int matched = 0;
+    for (int i = 0; i < refLen; i++) {
+        int best = -1;
+        float bestDist = CONFORMANCE_CENTER_TOL;
+        for (int j = 0; j < candLen; j++) {
+            if (taken[j]) {
+                continue;
+            }
+            float dx = center(ref[i])[0] - center(cand[j])[0];
+            float dy = center(ref[i])[1] - center(cand[j])[1];
+            float dist = std::sqrt(dx * dx + dy * dy);
+            if (dist <= bestDist) {
+                best = j;
+                bestDist = dist;
+            }
+        }
+        if (best >= 0 && same(ref[i], cand[best])) {
+            taken[best] = 1;
+            matched++;
+        }
+    }
+    return refLen + candLen - 2 * matched;
+}
+
+static int compareClusters(const ClusterResult &ref, const ClusterResult &cand)
+{
+    return compareByCenter(
+        ref.cd, ref.n, cand.cd, cand.n,
+        [](const ClusterDescription &cd) {
+            return std::vector<float>{cd.cx, cd.cy};
+        },
+        [](const ClusterDescription &a, const ClusterDescription &b) {
+            return a.n == b.n && close(a.rx, b.rx, CONFORMANCE_VALUE_TOL) && close(a.ry, b.ry, CONFORMANCE_VALUE_TOL) &&
+                   close(a.av, b.av, CONFORMANCE_VALUE_TOL);
+        });
+}
+
+static int compareTracks(const TrackingResult &ref, const TrackingResult &cand)
+{
+    return compareByCenter(
+        ref.td, ref.len, cand.td, cand.len,
+        [](const TrackingDescription &td) {
+            return std::vector<float>{td.sHat[0], td.sHat[1]};
+        },
+        [](const TrackingDescription &a, const TrackingDescription &b) {
+            return std::fabs(a.sHat[2] - b.sHat[2]) <= CONFORMANCE_SPEED_TOL && std::fabs(a.sHat[3] - b.sHat[3]) <= CONFORMANCE_SPEED_TOL;
+        });
+}
+
+static const char *backendName(RadarBackendType backend)
+{
+    switch (backend) {
+        case REFERENCE_BACKEND:
+            return "reference";
+        case SIMD_BACKEND:
+            return "simd";
+        case MULTITHREAD_BACKEND:
+            return "multithread";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * @brief run all frames through both libraries, one check per frame
+ */
+static void runConformance(TestReport &report, LibRadar &refLib, LibRadar &candLib, RadarParam param, RadarBackendType backend,
+                           int numThreads, const std::vector<std::string> &frames)
+{
+    RadarParam refParam = param;
+    refParam.backend = REFERENCE_BACKEND;
+    refParam.nt = 1;
+    RadarParam candParam = param;
+    candParam.backend = backend;
+    candParam.nt = numThreads;
+
+    RadarRunner ref, cand;
+    if (!ref.init(&refLib, refParam) || !cand.init(&candLib, candParam)) {
+        TEST_CHECK(report, false, "backend " << backendName(backend) << " could not be initialized");
+        return;
+    }
+
+    const size_t cubeSize = (size_t)param.rn * param.tn * param.sn * param.cn;
+    std::vector<cfloat> frame(cubeSize);
+    cfloat *mat = (cfloat *)aligned_alloc(64, cubeSize * sizeof(cfloat));
+    RadarCube rc = {param.rn, param.tn, param.sn, param.cn, mat};
+
+    int badFrames = 0, badPoints = 0, badClusters = 0, badTracks = 0;
+    int numPoints = 0, numClusters = 0, numTracks = 0;
+    for (size_t f = 0; f < frames.size(); f++) {
+        std::ifstream fs(frames[f], std::ios::binary);
+        fs.read(reinterpret_cast<char *>(frame.data()), cubeSize * sizeof(cfloat));
+        if (fs.gcount() != (std::streamsize)(cubeSize * sizeof(cfloat))) {
+            std::cerr << frames[f] << " does not hold a frame of " << cubeSize << " samples, skipped" << std::endl;
+            continue;
+        }
+        formatCube(frame, rc);
+
+        RadarPointClouds refPoints = {0, param.mp, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+        RadarPointClouds candPoints = refPoints;
+        ClusterResult refClusters = {0, nullptr, nullptr};
+        ClusterResult candClusters = refClusters;
+        TrackingResult refTracks = {0, (int)ref.td.size(), ref.td.data()};
+        TrackingResult candTracks = {0, (int)cand.td.size(), cand.td.data()};
+
+        ref.detectionMs += timeMs([&] { refLib.detection(ref.handle, &rc, &refPoints); });
+        ref.clusteringMs += timeMs([&] { refLib.clustering(ref.handle, &refPoints, &refClusters); });
+        ref.trackingMs += timeMs([&] { refLib.tracking(ref.handle, &refClusters, &refTracks); });
+
+        // every candidate stage takes the input of the reference stage
+        cand.detectionMs += timeMs([&] { candLib.detection(cand.handle, &rc, &candPoints); });
+        cand.clusteringMs += timeMs([&] { candLib.clustering(cand.handle, &refPoints, &candClusters); });
+        cand.trackingMs += timeMs([&] { candLib.tracking(cand.handle, &refClusters, &candTracks); });
+
+        int points = comparePoints(refPoints, candPoints);
+        int clusters = compareClusters(refClusters, candClusters);
+        int tracks = compareTracks(refTracks, candTracks);
+        if (points || clusters || tracks) {
+            badFrames++;
+        }
+        TEST_CHECK(report, !points && !clusters && !tracks,
+                   "backend " << backendName(backend) << " frame " << f << " (" << frames[f] << "): points " << refPoints.len << "/"
+                              << candPoints.len << " mismatch " << points << ", clusters " << refClusters.n << "/" << candClusters.n
+                              << " mismatch " << clusters << ", tracks " << refTracks.len << "/" << candTracks.len << " mismatch " << tracks);
+        badPoints += points;
+        badClusters += clusters;
+        badTracks += tracks;
+        numPoints += refPoints.len;
+        numClusters += refClusters.n;
+        numTracks += refTracks.len;
+    }
+    free(mat);
+
+    const double n = std::max<size_t>(frames.size(), 1);
+    std::cout << "backend " << backendName(backend) << (MULTITHREAD_BACKEND == backend ? " x" + std::to_string(numThreads) : std::string())
+              << ": " << badFrames << " of " << frames.size() << " frames differ" << std::endl
+              << "    points   " << numPoints << ", mismatch " << badPoints << ", ms/frame reference " << ref.detectionMs / n << " candidate "
+              << cand.detectionMs / n << std::endl
+              << "    clusters " << numClusters << ", mismatch " << badClusters << ", ms/frame reference " << ref.clusteringMs / n << " candidate "
+              << cand.clusteringMs / n << std::endl
+              << "    tracks   " << numTracks << ", mismatch " << badTracks << ", ms/frame reference " << ref.trackingMs / n << " candidate "
+              << cand.trackingMs / n << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 5 || argc > 7) {
+        std::cerr << "Usage: testLibradarConformance <reference_libradar> <candidate_libradar> <radar_config> <radar_frame_dir> [backend] [threads]\n"
+                  << "    backend: reference, simd, multithread or all (default), selects the backend of the candidate library\n"
+                  << "    threads: threads of the multithread backend, default 4\n"
+                  << "Example:\n"
+                  << "    testLibradarConformance ../../build/lib/libradar.so ../ai_inference/libradar/libradar.so "
+                     "../../ai_inference/deployment/datasets/RadarConfig.json /path/to/radar_bin_dir\n";
+        return EXIT_FAILURE;
+    }
+
+    std::string backendArg = argc > 5 ? argv[5] : "all";
+    int numThreads = argc > 6 ? atoi(argv[6]) : 4;
+    std::vector<RadarBackendType> backends;
+    if ("all" == backendArg) {
+        backends = {REFERENCE_BACKEND, SIMD_BACKEND, MULTITHREAD_BACKEND};
+    }
+    else {
+        for (int b = REFERENCE_BACKEND; b < MAXLEN_BACKEND; b++) {
+            if (backendArg == backendName((RadarBackendType)b)) {
+                backends.push_back((RadarBackendType)b);
+            }
+        }
+    }
+    if (backends.empty() || numThreads < 1) {
+        std::cerr << "Unknown backend " << backendArg << " or thread count " << numThreads << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    RadarParam param;
+    memset(&param, 0, sizeof(param));
+    if (!readRadarParam(argv[3], param)) {
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> frames;
+    try {
+        for (auto &entry : std::filesystem::directory_iterator(argv[4])) {
+            if (entry.is_regular_file() && entry.path().extension() == ".bin") {
+                frames.push_back(entry.path().string());
+            }
+        }
+    }
+    catch (std::exception const &e) {
+        std::cerr << "Failed to list radar frames in " << argv[4] << ": " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::sort(frames.begin(), frames.end());
+    if (frames.empty()) {
+        std::cerr << "No .bin radar frame in " << argv[4] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    LibRadar refLib, candLib;
+    if (!refLib.load(argv[1]) || !candLib.load(argv[2])) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "Loaded " << frames.size() << " frames of " << param.cn << " chirps x " << param.tn * param.rn << " antennas x " << param.sn
+              << " samples" << std::endl;
+
+    TestReport report("testLibradarConformance");
+    for (RadarBackendType backend : backends) {
+        runConformance(report, refLib, candLib, param, backend, numThreads, frames);
+    }
+    return report.result();
+}
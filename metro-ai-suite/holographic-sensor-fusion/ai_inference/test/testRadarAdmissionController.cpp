@@ -0,0 +1,196 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and your use of
+ * them is governed by the express license under which they were provided to you (License).
+ * Unless the License provides otherwise, you may not use, modify, copy, publish, distribute,
+ * disclose or transmit this software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express or implied warranties,
+ * other than those that are expressly stated in the License.
+ */
+
+/**
+ * unit test of the radar admission controller
+ *
+ * Every scenario feeds fixed frame ages, backlogs and service times, so the expected decisions follow from the
+ * prediction age + in flight * service time alone, no clock is involved.
+ */
+
+#include "modules/inference_util/radar/radar_admission_controller.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace hce::ai::inference;
+
+static int g_failures = 0;
+
+#define EXPECT_ACTION(decision, expected)                                                                                    \
+    do {                                                                                                                     \
+        RadarAdmissionAction _action = (decision).action;                                                                    \
+        if (_action != (expected)) {                                                                                         \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": expected " << radarAdmissionActionName(expected) << ", got "       \
+                      << radarAdmissionActionName(_action) << std::endl;                                                    \
+            g_failures++;                                                                                                    \
+        }                                                                                                                    \
+    } while (0)
+
+#define EXPECT_NEAR(value, expected)                                                                                         \
+    do {                                                                                                                     \
+        float _value = (value);                                                                                              \
+        if (std::fabs(_value - (expected)) > 1e-4f) {                                                                        \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": expected " << (expected) << ", got " << _value << std::endl;      \
+            g_failures++;                                                                                                    \
+        }                                                                                                                    \
+    } while (0)
+
+static RadarAdmissionConfig makeConfig(float latencySloMs, int32_t maxDecimation = RADAR_ADMISSION_MAX_DECIMATION)
+{
+    RadarAdmissionConfig config;
+    config.latencySloMs = latencySloMs;
+    config.maxDecimation = maxDecimation;
+    return config;
+}
+
+/**
+ * @brief without an SLO, or before the first measurement, every frame is processed in full
+ */
+static void testFullUntilMeasured()
+{
+    RadarAdmissionController disabled(makeConfig(0.0f), true);
+    disabled.record(RADAR_ADMISSION_FULL, 50.0f);
+    RadarAdmissionDecision decision = disabled.decide(100.0f, 10);
+    EXPECT_ACTION(decision, RADAR_ADMISSION_FULL);
+    EXPECT_NEAR(decision.predictedMs, 150.0f);
+
+    RadarAdmissionController controller(makeConfig(30.0f), true);
+    decision = controller.decide(100.0f, 10);
+    EXPECT_ACTION(decision, RADAR_ADMISSION_FULL);
+    EXPECT_NEAR(decision.predictedMs, 0.0f);
+}
+
+/**
+ * @brief the service time estimates are exponential moving averages, kept apart for full and degraded frames
+ */
+static void testServiceTimeAverage()
+{
+    RadarAdmissionController controller(makeConfig(30.0f), true);
+    EXPECT_NEAR(controller.serviceMs(false), -1.0f);
+    EXPECT_NEAR(controller.serviceMs(true), -1.0f);
+
+    controller.record(RADAR_ADMISSION_FULL, 10.0f);
+    controller.record(RADAR_ADMISSION_FULL, 20.0f);
+    EXPECT_NEAR(controller.serviceMs(false), RADAR_ADMISSION_EWMA_ALPHA * 20.0f + (1.0f - RADAR_ADMISSION_EWMA_ALPHA) * 10.0f);
+    EXPECT_NEAR(controller.serviceMs(true), -1.0f);
+
+    controller.record(RADAR_ADMISSION_DEGRADED, 4.0f);
+    EXPECT_NEAR(controller.serviceMs(true), 4.0f);
+}
+
+/**
+ * @brief an overloaded stage degrades, and only resumes full processing well under the SLO
+ */
+static void testDegradeAndRecover()
+{
+    RadarAdmissionController controller(makeConfig(30.0f), true);
+    controller.record(RADAR_ADMISSION_FULL, 10.0f);
+
+    // 2 * 10 ms fit in 30 ms
+    RadarAdmissionDecision decision = controller.decide(5.0f, 2);
+    EXPECT_ACTION(decision, RADAR_ADMISSION_FULL);
+    EXPECT_NEAR(decision.predictedMs, 15.0f);
+
+    // 4 * 10 ms do not, the degraded mode is not measured yet so it is tried
+    decision = controller.decide(0.0f, 4);
+    EXPECT_ACTION(decision, RADAR_ADMISSION_DEGRADED);
+    controller.record(RADAR_ADMISSION_DEGRADED, 5.0f);
+
+    // 4 * 5 ms fit
+    decision = controller.decide(0.0f, 4);
+    EXPECT_ACTION(decision, RADAR_ADMISSION_DEGRADED);
+    EXPECT_NEAR(decision.predictedMs, 5.0f);
+
+    // 25 ms would fit in full, but not under RADAR_ADMISSION_RECOVER_RATIO of the SLO
+    decision = controller.decide(5.0f, 2);
+    EXPECT_ACTION(decision, RADAR_ADMISSION_DEGRADED);
+
+    // 20 ms do
+    decision = controller.decide(0.0f, 2);
+    EXPECT_ACTION(decision, RADAR_ADMISSION_FULL);
+
+    // back to normal, 25 ms fit again
+    decision = controller.decide(5.0f, 2);
+    EXPECT_ACTION(decision, RADAR_ADMISSION_FULL);
+}
+
+/**
+ * @brief without a degraded mode a long backlog processes one frame of k, k the overshoot of the backlog
+ */
+static void testDecimation()
+{
+    RadarAdmissionController controller(makeConfig(30.0f), false);
+    controller.record(RADAR_ADMISSION_FULL, 10.0f);
+
+    // 8 * 10 ms overshoot 30 ms by a factor of 3
+    const RadarAdmissionAction expected[] = {RADAR_ADMISSION_DECIMATED, RADAR_ADMISSION_DECIMATED, RADAR_ADMISSION_FULL,
+                                             RADAR_ADMISSION_DECIMATED, RADAR_ADMISSION_DECIMATED, RADAR_ADMISSION_FULL};
+    for (RadarAdmissionAction action : expected) {
+        EXPECT_ACTION(controller.decide(0.0f, 8), action);
+    }
+
+    // the factor is capped by maxDecimation + 1
+    RadarAdmissionController capped(makeConfig(30.0f, 1), false);
+    capped.record(RADAR_ADMISSION_FULL, 10.0f);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_ACTION(capped.decide(0.0f, 20), RADAR_ADMISSION_DECIMATED);
+        EXPECT_ACTION(capped.decide(0.0f, 20), RADAR_ADMISSION_FULL);
+    }
+
+    EXPECT_NEAR((float)controller.decisions(), 6.0f);
+    EXPECT_NEAR((float)controller.count(RADAR_ADMISSION_DECIMATED), 4.0f);
+    EXPECT_NEAR((float)controller.count(RADAR_ADMISSION_FULL), 2.0f);
+}
+
+/**
+ * @brief a frame too old to meet the SLO is dropped, at most maxDecimation frames in a row
+ */
+static void testDrop()
+{
+    RadarAdmissionController controller(makeConfig(30.0f), false);
+    controller.record(RADAR_ADMISSION_FULL, 10.0f);
+
+    for (int i = 0; i < RADAR_ADMISSION_MAX_DECIMATION; i++) {
+        RadarAdmissionDecision decision = controller.decide(25.0f, 1);
+        EXPECT_ACTION(decision, RADAR_ADMISSION_DROPPED);
+        EXPECT_NEAR(decision.predictedMs, 35.0f);
+    }
+    // the tracker has to be fed
+    EXPECT_ACTION(controller.decide(25.0f, 1), RADAR_ADMISSION_FULL);
+    EXPECT_ACTION(controller.decide(25.0f, 1), RADAR_ADMISSION_DROPPED);
+
+    // with shedding off the frame is processed in the cheapest mode
+    RadarAdmissionController noShedding(makeConfig(30.0f, 0), true);
+    noShedding.record(RADAR_ADMISSION_FULL, 10.0f);
+    noShedding.record(RADAR_ADMISSION_DEGRADED, 5.0f);
+    EXPECT_ACTION(noShedding.decide(28.0f, 1), RADAR_ADMISSION_DEGRADED);
+}
+
+int main()
+{
+    testFullUntilMeasured();
+    testServiceTimeAverage();
+    testDegradeAndRecover();
+    testDecimation();
+    testDrop();
+
+    if (g_failures > 0) {
+        std::cerr << g_failures << " check(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "All radar admission controller checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,226 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2024 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and your use of
+ * them is governed by the express license under which they were provided to you (License).
+ * Unless the License provides otherwise, you may not use, modify, copy, publish, distribute,
+ * disclose or transmit this software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express or implied warranties,
+ * other than those that are expressly stated in the License.
+ */
+
+/**
+ * micro-benchmark of the DBSCAN neighbour kernels (scalar / AVX2 / AVX-512) on recorded point clouds
+ *
+ * Every point of every frame is queried once with nothing visited, the neighbour lists of the vector kernels are
+ * checked against the scalar kernel before the timings are reported.
+ */
+
+#include <nlohmann/json.hpp>
+#include "nodes/radarDatabaseMeta.hpp"
+#include "modules/inference_util/radar/radar_clustering_helper.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace hce::ai::inference;
+
+struct BenchFrame {
+    std::vector<float> pointArray;  // x, y interleaved as in RadarClusteringNode
+    std::vector<float> speed;
+};
+
+/**
+ * @brief parse the bracketed arrays of one csv row: frameIdx, num, [rangeIdx], [rangeFloat], [speedIdx], [speedFloat], [aoaVar], [SNR]
+ */
+static bool parseRow(const std::string &line, pointClouds &pcl)
+{
+    size_t cur = line.find(',');
+    if (cur == std::string::npos) {
+        return false;
+    }
+    pcl.num = atoi(line.c_str() + cur + 1);
+
+    std::vector<std::vector<float>> arrays;
+    while ((cur = line.find('[', cur)) != std::string::npos) {
+        size_t end = line.find(']', cur);
+        if (end == std::string::npos) {
+            return false;
+        }
+        std::vector<float> values;
+        const char *p = line.c_str() + cur + 1;
+        const char *last = line.c_str() + end;
+        while (p < last) {
+            char *next = nullptr;
+            float v = strtof(p, &next);
+            if (next == p) {
+                break;
+            }
+            values.push_back(v);
+            p = next;
+            while (p < last && (*p == ',' || *p == ' ')) {
+                ++p;
+            }
+        }
+        arrays.push_back(values);
+        cur = end + 1;
+    }
+
+    if (pcl.num == 0) {
+        return true;
+    }
+    if (arrays.size() < 6) {
+        return false;
+    }
+    for (auto &values : arrays) {
+        if ((int)values.size() != pcl.num) {
+            return false;
+        }
+    }
+    pcl.rangeFloat = arrays[1];
+    pcl.speedFloat = arrays[3];
+    pcl.aoaVar = arrays[4];
+    pcl.SNRArray = arrays[5];
+    return true;
+}
+
+static int readFrames(const std::string &csvFile, std::vector<BenchFrame> &frames)
+{
+    std::ifstream in(csvFile);
+    if (!in) {
+        std::cerr << "Failed to open point cloud file: " << csvFile << std::endl;
+        return -1;
+    }
+    std::string line;
+    std::getline(in, line);  // skip the header
+    while (std::getline(in, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        pointClouds pcl;
+        if (!parseRow(line, pcl)) {
+            std::cerr << "Skip malformed row " << frames.size() + 1 << std::endl;
+            continue;
+        }
+        BenchFrame frame;
+        frame.pointArray.resize(pcl.num * 2);
+        for (int i = 0; i < pcl.num; ++i) {
+            frame.pointArray[i * 2] = pcl.rangeFloat[i] * cos(pcl.aoaVar[i] * M_PI / 180);
+            frame.pointArray[i * 2 + 1] = pcl.rangeFloat[i] * sin(pcl.aoaVar[i] * M_PI / 180);
+        }
+        frame.speed = pcl.speedFloat;
+        frames.push_back(std::move(frame));
+    }
+    return 0;
+}
+
+/**
+ * @brief query every point of every frame, returns the query time in microseconds
+ */
+static double runKernel(DBscanKernel kernel, const std::vector<BenchFrame> &frames, float eps, float weight, unsigned repeats,
+                        std::vector<std::vector<int>> &neighbours)
+{
+    DBscanGridIndex index;
+    index.setKernel(kernel);
+
+    std::vector<char> visited;
+    std::vector<int> scope;
+    std::vector<int> neigh;
+    double elapsed = 0;
+    neighbours.assign(frames.size(), std::vector<int>());
+
+    for (unsigned r = 0; r < repeats; ++r) {
+        for (size_t f = 0; f < frames.size(); ++f) {
+            const BenchFrame &frame = frames[f];
+            const int numPoints = (int)frame.speed.size();
+            visited.assign(numPoints, POINT_UNKNOWN);
+            scope.assign(numPoints, 0);
+            neigh.resize(numPoints);
+            index.build((const clusteringDBscanPoint2d *)frame.pointArray.data(), frame.speed.data(), numPoints, eps, weight);
+
+            auto start = std::chrono::steady_clock::now();
+            for (int point = 0; point < numPoints; ++point) {
+                int count = index.findNeighbors(point, visited.data(), scope.data(), 1, neigh.data());
+                if (r == 0) {
+                    neighbours[f].push_back(count);
+                    neighbours[f].insert(neighbours[f].end(), neigh.begin(), neigh.begin() + count);
+                }
+            }
+            elapsed += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+    return elapsed;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 4) {
+        std::cerr << "Usage: testRadarClusteringKernel <repeats> <radar_config> <point_clouds_csv_file>\n"
+                  << "Example:\n"
+                  << "    testRadarClusteringKernel 100 ../../ai_inference/deployment/datasets/RadarConfig.json /path/to/point_clouds_csv_file\n";
+        return EXIT_FAILURE;
+    }
+
+    unsigned repeats(atoi(argv[1]));
+    std::string radarConfigPath(argv[2]);
+    std::string csvFile(argv[3]);
+    if (repeats == 0) {
+        repeats = 1;
+    }
+
+    float eps = 0;
+    float weight = 0;
+    try {
+        std::ifstream configFile(radarConfigPath);
+        nlohmann::json config;
+        configFile >> config;
+        for (auto &items : config.at("RadarClusteringConfig")) {
+            eps = items["eps"].get<float>();
+            weight = items["weight"].get<float>();
+        }
+    }
+    catch (std::exception const &e) {
+        std::cerr << "Failed to read RadarClusteringConfig from " << radarConfigPath << ": " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<BenchFrame> frames;
+    if (readFrames(csvFile, frames) != 0 || frames.empty()) {
+        return EXIT_FAILURE;
+    }
+    size_t totalPoints = 0;
+    for (auto &frame : frames) {
+        totalPoints += frame.speed.size();
+    }
+    std::cout << "Loaded " << frames.size() << " frames, " << totalPoints << " points, eps: " << eps << ", weight: " << weight
+              << ", detected kernel: " << DBscanGridIndex::kernelName(DBscanGridIndex::detectKernel()) << std::endl;
+
+    std::vector<std::vector<int>> reference;
+    double scalarTime = runKernel(DBscanKernel::Scalar, frames, eps, weight, repeats, reference);
+    std::cout << "scalar: " << scalarTime / (repeats * frames.size()) << " us/frame" << std::endl;
+
+    int ret = EXIT_SUCCESS;
+    for (DBscanKernel kernel : {DBscanKernel::AVX2, DBscanKernel::AVX512}) {
+        if (!DBscanGridIndex::isKernelSupported(kernel)) {
+            std::cout << DBscanGridIndex::kernelName(kernel) << ": not supported by this cpu" << std::endl;
+            continue;
+        }
+        std::vector<std::vector<int>> neighbours;
+        double time = runKernel(kernel, frames, eps, weight, repeats, neighbours);
+        bool identical = neighbours == reference;
+        std::cout << DBscanGridIndex::kernelName(kernel) << ": " << time / (repeats * frames.size()) << " us/frame, speedup " << scalarTime / time
+                  << ", neighbours " << (identical ? "identical" : "MISMATCH") << std::endl;
+        if (!identical) {
+            ret = EXIT_FAILURE;
+        }
+    }
+    return ret;
+}
@@ -149,6 +149,9 @@ void readRadarConfigParam(RadarConfigParam &m_radar_config, std::string radarCon
         m_radar_config.m_radar_tracking_config_.iirForgetFactor = items["iirForgetFactor"].get<float>();
         m_radar_config.m_radar_tracking_config_.trackerActiveThreshold = items["trackerActiveThreshold"].get<int>();
         m_radar_config.m_radar_tracking_config_.trackerForgetThreshold = items["trackerForgetThreshold"].get<int>();
+        if (items.contains("associationMethod")) {
+            m_radar_config.m_radar_tracking_config_.associationMethod = items["associationMethod"].get<TrackerAssociationMethod>();
+        }
     }
 }
 
@@ -429,7 +432,7 @@ int main(int argc, char **argv)
         unsigned frameIdx = 0;
         for (size_t cnt = 0; cnt < repeats; cnt++) {
             HVA_DEBUG("Send pointClouds %d", cnt);
-            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<pointClouds>(pclArray[cnt], sizeof(pointClouds));
+            hva::hvaVideoFrameWithMetaROIBuf_t::Ptr hvabuf = hva::hvaVideoFrameWithMetaROIBuf_t::make_buffer<pointClouds::Ptr>(std::make_shared<pointClouds>(pclArray[cnt]), sizeof(pointClouds));
 
             hvabuf->frameId = frameIdx;
             ++frameIdx;
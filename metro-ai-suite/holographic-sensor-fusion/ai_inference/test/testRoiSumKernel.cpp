@@ -0,0 +1,147 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and your use of
+ * them is governed by the express license under which they were provided to you (License).
+ * Unless the License provides otherwise, you may not use, modify, copy, publish, distribute,
+ * disclose or transmit this software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express or implied warranties,
+ * other than those that are expressly stated in the License.
+ */
+
+/**
+ * checks that the AVX2 ROI reductions of the coordinate transformation select what the scalar ones select
+ *
+ * Random disparity maps and point clouds, with invalid disparities and NaN points mixed in, are reduced over ROIs of
+ * every width up to two vectors and a few larger ones. The number of selected points has to be the same, the sums may
+ * only differ by the summation order.
+ */
+
+#include "modules/inference_util/fusion/data_fusion_helper.hpp"
+#include "utils/testCheck.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace hce::ai::inference;
+
+static const int kRows = 61;
+static const int kCols = 97;
+
+// stereo reprojection with the principal point in the middle of the frame and a 0.12 m baseline, the bounds cut
+// through the reprojected disparities in every coordinate
+static const double kQ[4][4] = {{1, 0, 0, -48.5}, {0, 1, 0, -30.5}, {0, 0, 0, 1100.0}, {0, 0, 1 / 0.12, 0}};
+static const float kBounds[6] = {-0.5f, 0.5f, -0.4f, 0.3f, 1, 30};
+static const float kLowerBounds[3] = {-6, -3, 1};
+static const float kMaxCoordinate = 70;  // of a selected point
+
+/**
+ * @brief sums of the same points, every point may be off by its rounding to float
+ *
+ * The kernels round the reprojected points to float, as cv::reprojectImageTo3D does, but the compiler is free to
+ * keep the scalar ones in double, GCC 12 does when it vectorizes the scalar loop.
+ */
+static bool closeSums(const double a[3], const double b[3], size_t count)
+{
+    const double tol = kMaxCoordinate * FLT_EPSILON * std::max<size_t>(count, 1);
+    return std::fabs(a[0] - b[0]) <= tol && std::fabs(a[1] - b[1]) <= tol && std::fabs(a[2] - b[2]) <= tol;
+}
+
+static void checkRois(TestReport &report, const char *name, const cv::Mat &frame, uint32_t seed,
+                      size_t (*sum)(RoiSumKernel kernel, const cv::Mat &frame, int x0, int y0, int x1, int y1, double sums[3]))
+{
+    std::mt19937 rng(seed);
+    std::vector<int> widths;
+    for (int w = 1; w <= 17; w++) {
+        widths.push_back(w);
+    }
+    widths.insert(widths.end(), {31, 64, kCols});
+
+    for (int width : widths) {
+        const int x0 = (int)(rng() % (kCols - width + 1));
+        const int y0 = (int)(rng() % (kRows / 2));
+        const int x1 = x0 + width - 1;
+        const int y1 = y0 + (int)(rng() % (kRows - y0));
+        double expected[3], actual[3];
+        const size_t expectedCount = sum(RoiSumKernel::Scalar, frame, x0, y0, x1, y1, expected);
+        const size_t actualCount = sum(RoiSumKernel::AVX2, frame, x0, y0, x1, y1, actual);
+        TEST_CHECK(report, actualCount == expectedCount && closeSums(actual, expected, expectedCount),
+                   name << " seed " << seed << " [" << x0 << ", " << x1 << "] x [" << y0 << ", " << y1 << "]: expected " << expectedCount
+                        << " points (" << expected[0] << ", " << expected[1] << ", " << expected[2] << "), got " << actualCount << " ("
+                        << actual[0] << ", " << actual[1] << ", " << actual[2] << ")");
+    }
+}
+
+static size_t sumDisparity(RoiSumKernel kernel, const cv::Mat &disparityMap, int x0, int y0, int x1, int y1, double sums[3])
+{
+    return sumDisparityRoi(kernel, disparityMap, x0, y0, x1, y1, kQ, kBounds, sums);
+}
+
+static size_t sumPcl(RoiSumKernel kernel, const cv::Mat &pcl, int x0, int y0, int x1, int y1, double sums[3])
+{
+    return sumPclRoi(kernel, pcl, x0, y0, x1, y1, kLowerBounds, sums);
+}
+
+int main()
+{
+    TestReport report("testRoiSumKernel");
+    if (!isRoiSumKernelSupported(RoiSumKernel::AVX2)) {
+        std::cout << "AVX2 is not supported by this CPU, nothing to compare" << std::endl;
+        return report.result();
+    }
+
+    for (uint32_t seed = 0; seed < 8; seed++) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> disparity(0.0f, 200.0f);
+        std::uniform_real_distribution<float> coordinate(-10.0f, kMaxCoordinate);
+
+        // one disparity in eight is invalid: zero, negative or NaN
+        cv::Mat disparityMap(kRows, kCols, CV_32F);
+        for (int y = 0; y < kRows; y++) {
+            float *row = disparityMap.ptr<float>(y);
+            for (int x = 0; x < kCols; x++) {
+                switch (rng() % 24) {
+                    case 0:
+                        row[x] = 0.0f;
+                        break;
+                    case 1:
+                        row[x] = -1.0f;
+                        break;
+                    case 2:
+                        row[x] = std::numeric_limits<float>::quiet_NaN();
+                        break;
+                    default:
+                        row[x] = disparity(rng);
+                }
+            }
+        }
+        checkRois(report, "disparity", disparityMap, seed, sumDisparity);
+
+        // one coordinate in sixteen is NaN and one is on its lower bound
+        cv::Mat pcl(kRows, kCols, CV_32FC3);
+        for (int y = 0; y < kRows; y++) {
+            float *row = pcl.ptr<float>(y);
+            for (int k = 0; k < 3 * kCols; k++) {
+                switch (rng() % 16) {
+                    case 0:
+                        row[k] = std::numeric_limits<float>::quiet_NaN();
+                        break;
+                    case 1:
+                        row[k] = kLowerBounds[k % 3];
+                        break;
+                    default:
+                        row[k] = coordinate(rng);
+                }
+            }
+        }
+        checkRois(report, "pcl", pcl, seed, sumPcl);
+    }
+    return report.result();
+}
@@ -0,0 +1,149 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and your use of
+ * them is governed by the express license under which they were provided to you (License).
+ * Unless the License provides otherwise, you may not use, modify, copy, publish, distribute,
+ * disclose or transmit this software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express or implied warranties,
+ * other than those that are expressly stated in the License.
+ */
+
+/**
+ * unit test of the track to track association kept across frames
+ *
+ * One radar track sits on a camera track it was paired with, then a camera box that fits the radar box better shows
+ * up. associate() takes the better box every frame, associateTracks() holds on to the kept pair until the tracks
+ * change or resetTracks() forgets it.
+ */
+
+#include "modules/inference_util/fusion/track_association_helper.hpp"
+#include "utils/testCheck.hpp"
+
+#include <vector>
+
+using namespace hce::ai::inference;
+
+static const int32_t kRadarId = 7;
+static const uint32_t kTrackingId = 5;
+
+// the radar box, a camera box off by 0.6 and one on top of it
+static const cv::Rect2f kRadarBox(0.0f, 0.0f, 2.0f, 2.0f);
+static const cv::Rect2f kShiftedBox(0.6f, 0.0f, 2.0f, 2.0f);
+static const cv::Rect2f kSameBox(0.0f, 0.0f, 2.0f, 2.0f);
+
+/**
+ * @brief camera index of the pair of the only radar box, -1 if it is not paired
+ */
+static int32_t pairedCamera(const std::vector<AssociationPair> &pairs)
+{
+    return pairs.empty() ? -1 : pairs[0].cameraIdx;
+}
+
+/**
+ * @brief pair the radar track with the shifted camera box, the only one around
+ */
+static void pairWithShifted(TestReport &report, Track2TrackAssociator &associator, uint64_t cameraKey)
+{
+    std::vector<AssociationPair> pairs;
+    associator.associateTracks({kRadarBox}, {kRadarId}, {kShiftedBox}, {cameraKey}, pairs);
+    TEST_CHECK(report, pairedCamera(pairs) == 0, "the first frame pairs camera " << pairedCamera(pairs) << ", expected 0");
+    TEST_CHECK(report, associator.getKeptPairs() == 0, "the first frame kept " << associator.getKeptPairs() << " pairs");
+}
+
+static void testCameraTrackKey(TestReport &report)
+{
+    TEST_CHECK(report, cameraTrackKey(0, 0) == 0 && cameraTrackKey(3, 0) == 0, "an untracked detection has key 0");
+    TEST_CHECK(report, cameraTrackKey(0, kTrackingId) != 0, "camera 0 gives key 0 to a tracked detection");
+    TEST_CHECK(report, cameraTrackKey(0, kTrackingId) != cameraTrackKey(1, kTrackingId),
+               "one tracking id on two cameras gives one key");
+    TEST_CHECK(report, cameraTrackKey(1, kTrackingId) == cameraTrackKey(1, kTrackingId), "the key of a track changes");
+}
+
+/**
+ * @brief associate() matches every frame anew, associateTracks() keeps the pair of the previous frame
+ */
+static void testModes(TestReport &report)
+{
+    const std::vector<cv::Rect2f> cameraBoxes = {kShiftedBox, kSameBox};
+    const std::vector<uint64_t> cameraIds = {cameraTrackKey(0, kTrackingId), cameraTrackKey(0, kTrackingId + 1)};
+    std::vector<AssociationPair> pairs;
+
+    Track2TrackAssociator associator;
+    TEST_CHECK(report, Track2TrackAssociator::computeCost(kRadarBox, kShiftedBox) < associator.getCostThreshold(),
+               "the shifted box is not a match");
+    TEST_CHECK(report,
+               Track2TrackAssociator::computeCost(kRadarBox, kSameBox) < Track2TrackAssociator::computeCost(kRadarBox, kShiftedBox),
+               "the box on top of the radar box is not the better match");
+
+    associator.associate({kRadarBox}, cameraBoxes, pairs);
+    TEST_CHECK(report, pairedCamera(pairs) == 1, "associate() pairs camera " << pairedCamera(pairs) << ", expected 1");
+
+    pairWithShifted(report, associator, cameraIds[0]);
+    associator.associateTracks({kRadarBox}, {kRadarId}, cameraBoxes, cameraIds, pairs);
+    TEST_CHECK(report, pairedCamera(pairs) == 0, "associateTracks() pairs camera " << pairedCamera(pairs) << ", expected the kept 0");
+    TEST_CHECK(report, associator.getKeptPairs() == 1, "associateTracks() kept " << associator.getKeptPairs() << " pairs, expected 1");
+
+    // associate() in between neither uses nor drops the kept pairs
+    associator.associate({kRadarBox}, cameraBoxes, pairs);
+    TEST_CHECK(report, pairedCamera(pairs) == 1, "associate() pairs camera " << pairedCamera(pairs) << " after associateTracks()");
+    associator.associateTracks({kRadarBox}, {kRadarId}, cameraBoxes, cameraIds, pairs);
+    TEST_CHECK(report, pairedCamera(pairs) == 0, "associateTracks() lost the kept pair after associate()");
+}
+
+/**
+ * @brief the kept pair goes with a reset, an untracked camera box and a camera box of another camera
+ */
+static void testTrackKeys(TestReport &report)
+{
+    const std::vector<cv::Rect2f> cameraBoxes = {kShiftedBox, kSameBox};
+    const uint64_t shiftedKey = cameraTrackKey(0, kTrackingId);
+    const uint64_t sameKey = cameraTrackKey(0, kTrackingId + 1);
+    std::vector<AssociationPair> pairs;
+    Track2TrackAssociator associator;
+
+    pairWithShifted(report, associator, shiftedKey);
+    associator.resetTracks();
+    TEST_CHECK(report, associator.getKeptPairs() == 0, "resetTracks() left " << associator.getKeptPairs() << " kept pairs");
+    associator.associateTracks({kRadarBox}, {kRadarId}, cameraBoxes, {shiftedKey, sameKey}, pairs);
+    TEST_CHECK(report, pairedCamera(pairs) == 1, "after resetTracks() camera " << pairedCamera(pairs) << " is paired, expected 1");
+
+    // a camera box without a track is matched anew every frame
+    associator.resetTracks();
+    pairWithShifted(report, associator, 0);
+    associator.associateTracks({kRadarBox}, {kRadarId}, cameraBoxes, {0, sameKey}, pairs);
+    TEST_CHECK(report, pairedCamera(pairs) == 1, "the untracked camera box was kept");
+    TEST_CHECK(report, associator.getKeptPairs() == 0, "an untracked pair was counted as kept");
+
+    // the same tracking id on another camera is another track
+    associator.resetTracks();
+    pairWithShifted(report, associator, shiftedKey);
+    associator.associateTracks({kRadarBox}, {kRadarId}, cameraBoxes, {cameraTrackKey(1, kTrackingId), sameKey}, pairs);
+    TEST_CHECK(report, pairedCamera(pairs) == 1, "the track of camera 0 was kept for camera 1");
+
+    // a radar id reused far away from the kept camera box fails the threshold check
+    associator.resetTracks();
+    pairWithShifted(report, associator, shiftedKey);
+    const cv::Rect2f farBox(40.0f, 40.0f, 2.0f, 2.0f);
+    associator.associateTracks({farBox}, {kRadarId}, {kShiftedBox, farBox}, {shiftedKey, sameKey}, pairs);
+    TEST_CHECK(report, pairedCamera(pairs) == 1, "the reused radar id kept camera " << pairedCamera(pairs) << ", expected 1");
+    TEST_CHECK(report, associator.getKeptPairs() == 0, "the reused radar id was counted as kept");
+
+    // another radar id does not take over the pair
+    associator.resetTracks();
+    pairWithShifted(report, associator, shiftedKey);
+    associator.associateTracks({kRadarBox}, {kRadarId + 1}, cameraBoxes, {shiftedKey, sameKey}, pairs);
+    TEST_CHECK(report, pairedCamera(pairs) == 1, "radar track " << kRadarId + 1 << " took the pair of track " << kRadarId);
+}
+
+int main()
+{
+    TestReport report("testTrackAssociation");
+    testCameraTrackKey(report);
+    testModes(report);
+    testTrackKeys(report);
+    return report.result();
+}
@@ -0,0 +1,89 @@
+/*
+ * INTEL CONFIDENTIAL
+ *
+ * Copyright (C) 2025 Intel Corporation.
+ *
+ * This software and the related documents are Intel copyrighted materials, and your use of
+ * them is governed by the express license under which they were provided to you (License).
+ * Unless the License provides otherwise, you may not use, modify, copy, publish, distribute,
+ * disclose or transmit this software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express or implied warranties,
+ * other than those that are expressly stated in the License.
+ */
+
+#ifndef HCE_AI_INF_TEST_CHECK_HPP
+#define HCE_AI_INF_TEST_CHECK_HPP
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace hce{
+
+namespace ai{
+
+namespace inference{
+
+/**
+ * @brief checks counted by the standalone tests, which run without a test framework
+ */
+class TestReport {
+public:
+    explicit TestReport(const std::string& name) : m_name(name) {}
+
+    /**
+     * @brief count one check
+     * @return ok
+     */
+    bool check(bool ok)
+    {
+        m_checks++;
+        if (!ok) {
+            m_failures++;
+        }
+        return ok;
+    }
+
+    int failures() const
+    {
+        return m_failures;
+    }
+
+    /**
+     * @brief print the summary line
+     * @return the exit code of the test
+     */
+    int result() const
+    {
+        if (m_failures > 0) {
+            std::cerr << m_name << ": " << m_failures << " of " << m_checks << " checks failed" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << m_name << ": " << m_checks << " checks passed" << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+private:
+    std::string m_name;
+    int m_checks = 0;
+    int m_failures = 0;
+};
+
+}   // namespace inference
+
+}   // namespace ai
+
+}   // namespace hce
+
+/**
+ * @brief count cond as one check of report, and print where it failed followed by the streamed message
+ */
+#define TEST_CHECK(report, cond, message)                                                        \
+    do {                                                                                         \
+        if (!(report).check(cond)) {                                                             \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " << message << std::endl;            \
+        }                                                                                        \
+    } while (0)
+
+#endif //HCE_AI_INF_TEST_CHECK_HPP